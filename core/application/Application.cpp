@@ -50,6 +50,7 @@
 #include "plugin/input/InputFeedbackInterfaceRegistry.h"
 #include "runner/FlusherRunner.h"
 #include "runner/ProcessorRunner.h"
+#include "runner/sink/file/FileSink.h"
 #include "runner/sink/http/HttpSink.h"
 #include "task_pipeline/TaskPipelineManager.h"
 #ifdef __ENTERPRISE__
@@ -230,6 +231,7 @@ void Application::Start() { // GCOVR_EXCL_START
     // runner
     BoundedSenderQueueInterface::SetFeedback(ProcessQueueManager::GetInstance());
     HttpSink::GetInstance()->Init();
+    FileSink::GetInstance()->Init();
     FlusherRunner::GetInstance()->Init();
     ProcessorRunner::GetInstance()->Init();
 
@@ -373,6 +375,7 @@ void Application::Exit() {
 
     FlusherRunner::GetInstance()->Stop();
     HttpSink::GetInstance()->Stop();
+    FileSink::GetInstance()->Stop();
 
     // TODO: make it common
     FlusherSLS::RecycleResourceIfNotUsed();
@@ -383,6 +386,7 @@ void Application::Exit() {
     ReleaseWindowsSignalObject();
 #endif
     LOG_INFO(sLogger, ("exit", "bye!"));
+    BinaryLogger::GetInstance()->Stop();
     exit(0);
 }
 
@@ -395,6 +399,7 @@ void Application::CheckCriticalCondition(int32_t curTime) {
         AlarmManager::GetInstance()->SendAlarm(
             LOGTAIL_CRASH_ALARM, "last config get time is too old: " + ToString(lastGetConfigTime) + " force exit");
         AlarmManager::GetInstance()->ForceToSend();
+        BinaryLogger::GetInstance()->Stop();
         sleep(10);
         _exit(1);
     }
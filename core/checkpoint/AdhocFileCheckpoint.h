@@ -34,6 +34,8 @@ enum FileReadStatus {
 std::string TransStatusToString(FileReadStatus status);
 FileReadStatus GetStatusFromString(std::string statusStr);
 
+// Progress of reading a file, from mOffset up to mSize. A file may also be split into several checkpoints, each
+// covering a range of it, in which case mSize is the end offset of the range rather than the size of the file.
 class AdhocFileCheckpoint {
 private:
     /* data */
@@ -68,8 +70,8 @@ public:
     FileReadStatus mStatus;
     std::string mJobName;
     std::string mRealFileName;
-    int32_t mStartTime;
-    int32_t mLastUpdateTime;
+    int32_t mStartTime = 0;
+    int32_t mLastUpdateTime = 0;
 };
 
 struct AdhocFileKey {
@@ -116,7 +116,10 @@ bool AdhocJobCheckpoint::Load(const std::string& path) {
                     case STATUS_WAITING:
                         fileCheckpoint->mDevInode.dev = file.get("dev", 0).asUInt64();
                         fileCheckpoint->mDevInode.inode = file.get("inode", 0).asUInt64();
+                        fileCheckpoint->mOffset = file.get("offset", 0).asInt64();
                         fileCheckpoint->mSize = file.get("size", 0).asInt64();
+                        fileCheckpoint->mSignatureHash = file.get("sig_hash", 0).asUInt64();
+                        fileCheckpoint->mSignatureSize = file.get("sig_size", 0).asUInt();
                         break;
                     case STATUS_LOADING:
                         fileCheckpoint->mDevInode.dev = file.get("dev", 0).asUInt64();
@@ -178,7 +181,10 @@ void AdhocJobCheckpoint::Dump(const std::string& path, bool isAutoDump) {
             case STATUS_WAITING:
                 file["dev"] = fileCheckpoint->mDevInode.dev;
                 file["inode"] = fileCheckpoint->mDevInode.inode;
+                file["offset"] = fileCheckpoint->mOffset;
                 file["size"] = fileCheckpoint->mSize;
+                file["sig_hash"] = fileCheckpoint->mSignatureHash;
+                file["sig_size"] = fileCheckpoint->mSignatureSize;
                 break;
             case STATUS_LOADING:
                 file["dev"] = fileCheckpoint->mDevInode.dev;
@@ -246,4 +252,8 @@ std::string AdhocJobCheckpoint::GetJobName() {
     return mAdhocJobName;
 }
 
+const std::vector<AdhocFileCheckpointPtr>& AdhocJobCheckpoint::GetFileCheckpointList() const {
+    return mAdhocFileCheckpointList;
+}
+
 } // namespace logtail
@@ -42,6 +42,7 @@ public:
 
     int32_t GetCurrentFileIndex();
     std::string GetJobName();
+    const std::vector<AdhocFileCheckpointPtr>& GetFileCheckpointList() const;
 };
 
 typedef std::shared_ptr<AdhocJobCheckpoint> AdhocJobCheckpointPtr;
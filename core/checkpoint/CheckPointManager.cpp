@@ -15,7 +15,13 @@
 #include "CheckPointManager.h"
 
 #include <fcntl.h>
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
+#include <cstring>
 #include <fstream>
 #include <string>
 #include <thread>
@@ -25,6 +31,8 @@
 #include "common/Flags.h"
 #include "common/HashUtil.h"
 #include "common/StringTools.h"
+#include "common/StringView.h"
+#include "common/xxhash/xxhash.h"
 #include "file_server/ConfigManager.h"
 #include "file_server/FileDiscoveryOptions.h"
 #include "logger/Logger.h"
@@ -40,9 +48,215 @@ DEFINE_FLAG_INT32(check_point_version, "now check point version xx.xx.xx such as
 DEFINE_FLAG_INT32(check_point_dump_interval, "default 15 min", 15 * 60);
 DEFINE_FLAG_INT32(check_point_max_count, "max check point count", 100000);
 DEFINE_FLAG_INT32(checkpoint_find_max_file_count, "", 1000);
+DEFINE_FLAG_BOOL(enable_binary_check_point,
+                 "dump file checkpoints incrementally to a binary log instead of the json file, turn it off and let "
+                 "one dump pass before downgrading to a version without the binary log",
+                 false);
+DEFINE_FLAG_INT32(check_point_binary_log_compact_ratio,
+                  "rewrite binary checkpoint log when it is larger than its live records by this ratio",
+                  4);
+DEFINE_FLAG_INT32(check_point_binary_log_compact_min_size,
+                  "binary checkpoint log smaller than this is never rewritten, bytes",
+                  4 * 1024 * 1024);
 
 namespace logtail {
 
+namespace {
+
+// Layout of the binary checkpoint log, with integers in host byte order:
+//   header: magic, uint32 format version, int32 check_point_version
+//   record: uint32 payload size, uint32 payload checksum, payload starting with the record type
+// Records appended by one dump are followed by a commit record holding their count, so that records of a dump
+// interrupted halfway are ignored on load.
+const char kBinaryCheckPointMagic[4] = {'L', 'C', 'C', 'P'};
+const uint32_t kBinaryCheckPointFormatVersion = 1;
+const size_t kBinaryCheckPointHeaderSize = sizeof(kBinaryCheckPointMagic) + sizeof(uint32_t) + sizeof(int32_t);
+const size_t kBinaryCheckPointRecordHeaderSize = sizeof(uint32_t) * 2;
+
+enum BinaryCheckPointRecordType : uint8_t {
+    kFileCheckPointRecord = 1,
+    kFileCheckPointDeletedRecord = 2,
+    kDirCheckPointRecord = 3,
+    kDirCheckPointDeletedRecord = 4,
+    kCommitRecord = 5,
+};
+
+template <typename T>
+void AppendInteger(string& buf, T value) {
+    buf.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void AppendString(string& buf, const string& value) {
+    AppendInteger<uint32_t>(buf, value.size());
+    buf.append(value);
+}
+
+size_t BeginRecord(string& buf, BinaryCheckPointRecordType type) {
+    size_t pos = buf.size();
+    buf.append(kBinaryCheckPointRecordHeaderSize, '\0');
+    AppendInteger<uint8_t>(buf, type);
+    return pos;
+}
+
+// fills in the header of the record starting at pos, and returns the hash of its payload
+uint64_t FinishRecord(string& buf, size_t pos) {
+    uint32_t size = buf.size() - pos - kBinaryCheckPointRecordHeaderSize;
+    uint64_t hash = XXH64(buf.data() + pos + kBinaryCheckPointRecordHeaderSize, size, 0);
+    uint32_t checksum = static_cast<uint32_t>(hash);
+    memcpy(&buf[pos], &size, sizeof(size));
+    memcpy(&buf[pos + sizeof(size)], &checksum, sizeof(checksum));
+    return hash;
+}
+
+void AppendFileCheckPointKey(string& buf, const DevInode& devInode, const string& configName) {
+    AppendInteger<uint64_t>(buf, devInode.dev);
+    AppendInteger<uint64_t>(buf, devInode.inode);
+    AppendString(buf, configName);
+}
+
+void AppendFileCheckPoint(string& buf, const CheckPoint& checkPoint) {
+    AppendFileCheckPointKey(buf, checkPoint.mDevInode, checkPoint.mConfigName);
+    AppendInteger<int64_t>(buf, checkPoint.mOffset);
+    AppendInteger<uint64_t>(buf, checkPoint.mSignatureHash);
+    AppendInteger<uint32_t>(buf, checkPoint.mSignatureSize);
+    AppendInteger<int32_t>(buf, checkPoint.mLastUpdateTime);
+    AppendInteger<int32_t>(buf, checkPoint.mIdxInReaderArray);
+    AppendInteger<uint8_t>(buf,
+                           (checkPoint.mFileOpenFlag ? 1 : 0) | (checkPoint.mContainerStopped ? 2 : 0)
+                               | (checkPoint.mLastForceRead ? 4 : 0));
+    AppendString(buf, checkPoint.mFileName);
+    AppendString(buf, checkPoint.mRealFileName);
+    AppendString(buf, checkPoint.mContainerID);
+}
+
+void AppendDirCheckPoint(string& buf, const string& dirName, const DirCheckPoint& checkPoint) {
+    AppendString(buf, dirName);
+    AppendInteger<int32_t>(buf, checkPoint.mUpdateTime);
+    AppendInteger<uint32_t>(buf, checkPoint.mSubDir.size());
+    for (const auto& subDir : checkPoint.mSubDir) {
+        AppendString(buf, subDir);
+    }
+}
+
+class BinaryCheckPointReader {
+public:
+    explicit BinaryCheckPointReader(StringView data) : mPos(data.data()), mEnd(data.data() + data.size()) {}
+
+    template <typename T>
+    bool ReadInteger(T& value) {
+        if (static_cast<size_t>(mEnd - mPos) < sizeof(T)) {
+            return false;
+        }
+        memcpy(&value, mPos, sizeof(T));
+        mPos += sizeof(T);
+        return true;
+    }
+
+    bool ReadString(string& value) {
+        uint32_t size = 0;
+        if (!ReadInteger(size) || static_cast<size_t>(mEnd - mPos) < size) {
+            return false;
+        }
+        value.assign(mPos, size);
+        mPos += size;
+        return true;
+    }
+
+private:
+    const char* mPos;
+    const char* mEnd;
+};
+
+bool ReadFileCheckPointKey(BinaryCheckPointReader& reader, CheckPointManager::CheckPointKey& key) {
+    return reader.ReadInteger(key.mDevInode.dev) && reader.ReadInteger(key.mDevInode.inode)
+        && reader.ReadString(key.mConfigName);
+}
+
+// the whole file, mapped into memory where possible
+class ReadOnlyFile {
+public:
+    ReadOnlyFile() = default;
+    ReadOnlyFile(const ReadOnlyFile&) = delete;
+    ReadOnlyFile& operator=(const ReadOnlyFile&) = delete;
+    ~ReadOnlyFile() {
+#if defined(__linux__)
+        if (mData != nullptr) {
+            munmap(const_cast<char*>(mData), mSize);
+        }
+#endif
+    }
+
+    bool Open(const string& path) {
+#if defined(__linux__)
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat buf;
+        if (fstat(fd, &buf) != 0) {
+            close(fd);
+            return false;
+        }
+        mSize = buf.st_size;
+        if (mSize > 0) {
+            void* addr = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                close(fd);
+                return false;
+            }
+            madvise(addr, mSize, MADV_SEQUENTIAL);
+            mData = static_cast<const char*>(addr);
+        }
+        close(fd);
+        return true;
+#else
+        std::ifstream fin(path, std::ios::binary);
+        if (!fin) {
+            return false;
+        }
+        mContent.assign(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>());
+        mSize = mContent.size();
+        return !fin.bad();
+#endif
+    }
+
+    StringView Data() const {
+#if defined(__linux__)
+        return StringView(mData, mSize);
+#else
+        return StringView(mContent.data(), mSize);
+#endif
+    }
+
+private:
+#if defined(__linux__)
+    const char* mData = nullptr;
+#else
+    string mContent;
+#endif
+    size_t mSize = 0;
+};
+
+bool ReplaceFile(const string& tempFile, const string& file) {
+#if defined(_MSC_VER)
+    // The rename on Windows will fail if the destination is existing.
+    remove(file.c_str());
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+#endif
+    return rename(tempFile.c_str(), file.c_str()) != -1;
+}
+
+string GetBinaryCheckPointFilePath() {
+    return AppConfig::GetInstance()->GetCheckPointFilePath() + ".bin";
+}
+
+bool CheckPointCmpByKey(const CheckPoint* left, const CheckPoint* right) {
+    return CheckPointManager::CheckPointKey(left->mDevInode, left->mConfigName)
+        < CheckPointManager::CheckPointKey(right->mDevInode, right->mConfigName);
+}
+
+} // namespace
+
 bool CheckPointManager::CheckVersion() {
     return (mLoadVersion == NO_CHECKPOINT_VERSION) || (mLoadVersion / 10000 == INT32_FLAG(check_point_version) / 10000);
 }
@@ -128,6 +342,11 @@ void CheckPointManager::AddDirCheckPoint(const string& dirname) {
     ptr->mSubDir.insert(dirname);
 }
 void CheckPointManager::LoadCheckPoint() {
+    string binaryCheckPointFile = GetBinaryCheckPointFilePath();
+    if (CheckExistance(binaryCheckPointFile) && LoadBinaryCheckPoint(binaryCheckPointFile)) {
+        return;
+    }
+
     Json::Value root;
     ParseConfResult cptRes = ParseConfig(AppConfig::GetInstance()->GetCheckPointFilePath(), root);
     // if new checkpoint file not exist, check old checkpoint file.
@@ -338,70 +557,50 @@ bool CheckPointManager::DumpCheckPointToLocal() {
         return false;
     }
 
-    Json::Value root;
     mReaderCount = mDevInodeCheckPointPtrMap.size();
-    if (mDevInodeCheckPointPtrMap.size() <= (size_t)INT32_FLAG(check_point_max_count)) {
-        CheckPointManager::DevInodeCheckPointHashMap::iterator it;
-        for (it = mDevInodeCheckPointPtrMap.begin(); it != mDevInodeCheckPointPtrMap.end(); ++it) {
-            CheckPoint* checkPointPtr = it->second.get();
-            Json::Value leaf;
-            leaf["file_name"] = Json::Value(checkPointPtr->mFileName);
-            leaf["real_file_name"] = Json::Value(checkPointPtr->mRealFileName);
-            leaf["offset"] = Json::Value(ToString(checkPointPtr->mOffset));
-            leaf["sig_size"] = Json::Value(Json::UInt(checkPointPtr->mSignatureSize));
-            leaf["sig_hash"] = Json::Value(Json::UInt64(checkPointPtr->mSignatureHash));
-            leaf["update_time"] = Json::Value(checkPointPtr->mLastUpdateTime);
-            leaf["inode"] = Json::Value(Json::UInt64(checkPointPtr->mDevInode.inode));
-            leaf["dev"] = Json::Value(Json::UInt64(checkPointPtr->mDevInode.dev));
-            leaf["file_open"] = Json::Value(checkPointPtr->mFileOpenFlag ? 1 : 0);
-            leaf["container_stopped"] = Json::Value(checkPointPtr->mContainerStopped ? 1 : 0);
-            leaf["container_id"] = Json::Value(checkPointPtr->mContainerID);
-            leaf["last_force_read"] = Json::Value(checkPointPtr->mLastForceRead ? 1 : 0);
-            leaf["config_name"] = Json::Value(checkPointPtr->mConfigName);
-            // forward compatible
-            leaf["sig"] = Json::Value(string(""));
-            leaf["idx_in_reader_array"] = Json::Value(checkPointPtr->mIdxInReaderArray);
-            // use filename + dev + inode + configName to prevent same filename conflict
-            root[checkPointPtr->mFileName + "*" + ToString(checkPointPtr->mDevInode.dev) + "*"
-                 + ToString(checkPointPtr->mDevInode.inode) + "*" + checkPointPtr->mConfigName]
-                = leaf;
-        }
-    } else {
-        vector<CheckPoint*> sortedCheckPointVec;
-        CheckPointManager::DevInodeCheckPointHashMap::iterator it;
-        for (it = mDevInodeCheckPointPtrMap.begin(); it != mDevInodeCheckPointPtrMap.end(); ++it) {
-            sortedCheckPointVec.push_back(it->second.get());
-        }
-        sort(sortedCheckPointVec.begin(), sortedCheckPointVec.end(), CheckPointManager::CheckPointCmpByUpdateTime);
-        for (int32_t i = 0; i < INT32_FLAG(check_point_max_count); ++i) {
-            CheckPoint* checkPointPtr = sortedCheckPointVec[i];
-            Json::Value leaf;
-            leaf["file_name"] = Json::Value(checkPointPtr->mFileName);
-            leaf["real_file_name"] = Json::Value(checkPointPtr->mRealFileName);
-            leaf["offset"] = Json::Value(ToString(checkPointPtr->mOffset));
-            leaf["sig_size"] = Json::Value(Json::UInt(checkPointPtr->mSignatureSize));
-            leaf["sig_hash"] = Json::Value(Json::UInt64(checkPointPtr->mSignatureHash));
-            leaf["update_time"] = Json::Value(checkPointPtr->mLastUpdateTime);
-            leaf["inode"] = Json::Value(Json::UInt64(checkPointPtr->mDevInode.inode));
-            leaf["dev"] = Json::Value(Json::UInt64(checkPointPtr->mDevInode.dev));
-            leaf["file_open"] = Json::Value(checkPointPtr->mFileOpenFlag ? 1 : 0);
-            leaf["container_stopped"] = Json::Value(checkPointPtr->mContainerStopped ? 1 : 0);
-            leaf["container_id"] = Json::Value(checkPointPtr->mContainerID);
-            leaf["last_force_read"] = Json::Value(checkPointPtr->mLastForceRead ? 1 : 0);
-            leaf["config_name"] = Json::Value(checkPointPtr->mConfigName);
-            // forward compatible
-            leaf["sig"] = Json::Value(string(""));
-            leaf["idx_in_reader_array"] = Json::Value(checkPointPtr->mIdxInReaderArray);
-            // use filename + dev + inode + configName to prevent same filename conflict
-            root[checkPointPtr->mFileName + "*" + ToString(checkPointPtr->mDevInode.dev) + "*"
-                 + ToString(checkPointPtr->mDevInode.inode) + "*" + checkPointPtr->mConfigName]
-                = leaf;
-        }
+    vector<CheckPoint*> checkPoints;
+    checkPoints.reserve(mDevInodeCheckPointPtrMap.size());
+    for (auto it = mDevInodeCheckPointPtrMap.begin(); it != mDevInodeCheckPointPtrMap.end(); ++it) {
+        checkPoints.push_back(it->second.get());
+    }
+    if (checkPoints.size() > (size_t)INT32_FLAG(check_point_max_count)) {
+        sort(checkPoints.begin(), checkPoints.end(), CheckPointManager::CheckPointCmpByUpdateTime);
+        checkPoints.resize(INT32_FLAG(check_point_max_count));
+        // binary dump walks checkpoints in key order
+        sort(checkPoints.begin(), checkPoints.end(), CheckPointCmpByKey);
         LOG_WARNING(sLogger, ("Too many check point", mDevInodeCheckPointPtrMap.size()));
         AlarmManager::GetInstance()->SendAlarm(CHECKPOINT_ALARM,
                                                "Too many check point:" + ToString(mDevInodeCheckPointPtrMap.size()));
     }
 
+    if (BOOL_FLAG(enable_binary_check_point)) {
+        return DumpBinaryCheckPoint(GetBinaryCheckPointFilePath(), checkPoints);
+    }
+
+    Json::Value root;
+    for (CheckPoint* checkPointPtr : checkPoints) {
+        Json::Value leaf;
+        leaf["file_name"] = Json::Value(checkPointPtr->mFileName);
+        leaf["real_file_name"] = Json::Value(checkPointPtr->mRealFileName);
+        leaf["offset"] = Json::Value(ToString(checkPointPtr->mOffset));
+        leaf["sig_size"] = Json::Value(Json::UInt(checkPointPtr->mSignatureSize));
+        leaf["sig_hash"] = Json::Value(Json::UInt64(checkPointPtr->mSignatureHash));
+        leaf["update_time"] = Json::Value(checkPointPtr->mLastUpdateTime);
+        leaf["inode"] = Json::Value(Json::UInt64(checkPointPtr->mDevInode.inode));
+        leaf["dev"] = Json::Value(Json::UInt64(checkPointPtr->mDevInode.dev));
+        leaf["file_open"] = Json::Value(checkPointPtr->mFileOpenFlag ? 1 : 0);
+        leaf["container_stopped"] = Json::Value(checkPointPtr->mContainerStopped ? 1 : 0);
+        leaf["container_id"] = Json::Value(checkPointPtr->mContainerID);
+        leaf["last_force_read"] = Json::Value(checkPointPtr->mLastForceRead ? 1 : 0);
+        leaf["config_name"] = Json::Value(checkPointPtr->mConfigName);
+        // forward compatible
+        leaf["sig"] = Json::Value(string(""));
+        leaf["idx_in_reader_array"] = Json::Value(checkPointPtr->mIdxInReaderArray);
+        // use filename + dev + inode + configName to prevent same filename conflict
+        root[checkPointPtr->mFileName + "*" + ToString(checkPointPtr->mDevInode.dev) + "*"
+             + ToString(checkPointPtr->mDevInode.inode) + "*" + checkPointPtr->mConfigName]
+            = leaf;
+    }
 
     Json::Value dirJson;
     for (unordered_map<string, DirCheckPointPtr>::iterator it = mDirNameMap.begin(); it != mDirNameMap.end(); ++it) {
@@ -434,12 +633,7 @@ bool CheckPointManager::DumpCheckPointToLocal() {
         return false;
     }
     fout.close();
-#if defined(_MSC_VER)
-    // The rename on Windows will fail if the destination is existing.
-    remove(checkPointFile.c_str());
-    std::this_thread::sleep_for(std::chrono::milliseconds(1));
-#endif
-    if (rename(checkPointTempFile.c_str(), checkPointFile.c_str()) == -1) {
+    if (!ReplaceFile(checkPointTempFile, checkPointFile)) {
         LOG_ERROR(sLogger, ("rename check point file fail, errno", errno));
         AlarmManager::GetInstance()->SendAlarm(CHECKPOINT_ALARM,
                                                std::string("rename check point file fail, errno ") + ToString(errno));
@@ -448,10 +642,352 @@ bool CheckPointManager::DumpCheckPointToLocal() {
     LOG_DEBUG(sLogger,
               ("dump checkpoint, version", INT32_FLAG(check_point_version))(
                   "file check point", mDevInodeCheckPointPtrMap.size())("dir check point", mDirNameMap.size()));
+    // the binary log would be loaded instead of the json file if it were left behind
+    RemoveBinaryCheckPoint(GetBinaryCheckPointFilePath());
+    return true;
+}
 
+bool CheckPointManager::LoadBinaryCheckPoint(const string& checkPointFile) {
+    ReadOnlyFile file;
+    if (!file.Open(checkPointFile)) {
+        LOG_ERROR(sLogger, ("open binary check point file error", checkPointFile)("errno", errno));
+        AlarmManager::GetInstance()->SendAlarm(CHECKPOINT_ALARM, "open binary check point file failed");
+        return false;
+    }
+    StringView data = file.Data();
+    uint32_t formatVersion = 0;
+    int32_t version = NO_CHECKPOINT_VERSION;
+    if (data.size() < kBinaryCheckPointHeaderSize
+        || memcmp(data.data(), kBinaryCheckPointMagic, sizeof(kBinaryCheckPointMagic)) != 0) {
+        LOG_ERROR(sLogger, ("load binary check point file fail, invalid header", checkPointFile));
+        AlarmManager::GetInstance()->SendAlarm(CHECKPOINT_ALARM, "header of binary check point file is invalid");
+        return false;
+    }
+    memcpy(&formatVersion, data.data() + sizeof(kBinaryCheckPointMagic), sizeof(formatVersion));
+    memcpy(&version, data.data() + sizeof(kBinaryCheckPointMagic) + sizeof(formatVersion), sizeof(version));
+    if (formatVersion != kBinaryCheckPointFormatVersion) {
+        LOG_ERROR(sLogger,
+                  ("load binary check point file fail, unknown format version", formatVersion)("file", checkPointFile));
+        AlarmManager::GetInstance()->SendAlarm(CHECKPOINT_ALARM,
+                                               "unknown binary check point format version " + ToString(formatVersion));
+        return false;
+    }
+
+    // replay the log, keeping the payload of the last record of each entry
+    map<CheckPointKey, StringView> filePayloads;
+    unordered_map<string, StringView> dirPayloads;
+    vector<StringView> pendingPayloads;
+    size_t pos = kBinaryCheckPointHeaderSize;
+    size_t committedPos = pos;
+    CheckPointKey key;
+    string dirName;
+    while (data.size() - pos >= kBinaryCheckPointRecordHeaderSize) {
+        uint32_t size = 0;
+        uint32_t checksum = 0;
+        memcpy(&size, data.data() + pos, sizeof(size));
+        memcpy(&checksum, data.data() + pos + sizeof(size), sizeof(checksum));
+        pos += kBinaryCheckPointRecordHeaderSize;
+        if (size == 0 || data.size() - pos < size
+            || static_cast<uint32_t>(XXH64(data.data() + pos, size, 0)) != checksum) {
+            break;
+        }
+        StringView payload = data.substr(pos + 1, size - 1);
+        uint8_t type = data[pos];
+        pos += size;
+        if (type != kCommitRecord) {
+            pendingPayloads.emplace_back(data.data() + pos - size, size);
+            continue;
+        }
+        uint32_t count = 0;
+        if (!BinaryCheckPointReader(payload).ReadInteger(count) || count != pendingPayloads.size()) {
+            break;
+        }
+        for (const auto& pending : pendingPayloads) {
+            BinaryCheckPointReader reader(pending.substr(1));
+            bool valid = false;
+            switch (pending[0]) {
+                case kFileCheckPointRecord:
+                case kFileCheckPointDeletedRecord:
+                    valid = ReadFileCheckPointKey(reader, key);
+                    if (valid && pending[0] == kFileCheckPointRecord) {
+                        filePayloads[key] = pending;
+                    } else if (valid) {
+                        filePayloads.erase(key);
+                    }
+                    break;
+                case kDirCheckPointRecord:
+                case kDirCheckPointDeletedRecord:
+                    valid = reader.ReadString(dirName);
+                    if (valid && pending[0] == kDirCheckPointRecord) {
+                        dirPayloads[dirName] = pending;
+                    } else if (valid) {
+                        dirPayloads.erase(dirName);
+                    }
+                    break;
+                default:
+                    break;
+            }
+            if (!valid) {
+                LOG_WARNING(sLogger, ("invalid binary check point record, ignore", ToString(pending[0])));
+            }
+        }
+        pendingPayloads.clear();
+        committedPos = pos;
+    }
+    // a dump interrupted halfway leaves records after the last commit, which are dropped by rewriting the log
+    mBinaryCheckPointNeedCompact = committedPos != data.size() || version != INT32_FLAG(check_point_version);
+    if (committedPos != data.size()) {
+        LOG_WARNING(sLogger,
+                    ("binary check point file has uncommitted tail, ignore",
+                     checkPointFile)("committed size", committedPos)("file size", data.size()));
+    }
+
+    mLoadVersion = version;
+    mBinaryFileCheckPointRecords.clear();
+    mBinaryDirCheckPointRecords.clear();
+    mBinaryCheckPointLogSize = committedPos;
+    // header and one commit record
+    mBinaryCheckPointLiveSize = kBinaryCheckPointHeaderSize + kBinaryCheckPointRecordHeaderSize + 1 + sizeof(uint32_t);
+    for (const auto& item : filePayloads) {
+        BinaryCheckPointReader reader(item.second.substr(1));
+        int64_t offset = 0;
+        uint64_t sigHash = 0;
+        uint32_t sigSize = 0;
+        int32_t updateTime = 0;
+        int32_t idxInReaderArray = LogFileReader::CHECKPOINT_IDX_OF_NEW_READER_IN_ARRAY;
+        uint8_t flags = 0;
+        string filePath;
+        string realFilePath;
+        string containerID;
+        if (!ReadFileCheckPointKey(reader, key) || !reader.ReadInteger(offset) || !reader.ReadInteger(sigHash)
+            || !reader.ReadInteger(sigSize) || !reader.ReadInteger(updateTime) || !reader.ReadInteger(idxInReaderArray)
+            || !reader.ReadInteger(flags) || !reader.ReadString(filePath) || !reader.ReadString(realFilePath)
+            || !reader.ReadString(containerID)) {
+            LOG_WARNING(sLogger, ("invalid binary file check point, discard it", key.mConfigName));
+            continue;
+        }
+        mBinaryFileCheckPointRecords[key]
+            = {XXH64(item.second.data(), item.second.size(), 0),
+               static_cast<uint32_t>(kBinaryCheckPointRecordHeaderSize + item.second.size())};
+        mBinaryCheckPointLiveSize += kBinaryCheckPointRecordHeaderSize + item.second.size();
+        if (!key.mDevInode.IsValid()) {
+            LOG_WARNING(sLogger, ("can not find check point dev inode, discard it", filePath));
+            continue;
+        }
+        CheckPoint* ptr = new CheckPoint(filePath,
+                                         offset,
+                                         sigSize,
+                                         sigHash,
+                                         key.mDevInode,
+                                         key.mConfigName,
+                                         realFilePath,
+                                         (flags & 1) != 0,
+                                         (flags & 2) != 0,
+                                         containerID,
+                                         (flags & 4) != 0);
+        ptr->mLastUpdateTime = updateTime;
+        ptr->mIdxInReaderArray = idxInReaderArray;
+        AddCheckPoint(ptr);
+    }
+    mReaderCount = mDevInodeCheckPointPtrMap.size();
+
+    for (const auto& item : dirPayloads) {
+        BinaryCheckPointReader reader(item.second.substr(1));
+        int32_t updateTime = 0;
+        uint32_t subDirCount = 0;
+        if (!reader.ReadString(dirName) || !reader.ReadInteger(updateTime) || !reader.ReadInteger(subDirCount)) {
+            LOG_WARNING(sLogger, ("invalid binary dir check point, discard it", item.first));
+            continue;
+        }
+        mBinaryDirCheckPointRecords[item.first]
+            = {XXH64(item.second.data(), item.second.size(), 0),
+               static_cast<uint32_t>(kBinaryCheckPointRecordHeaderSize + item.second.size())};
+        mBinaryCheckPointLiveSize += kBinaryCheckPointRecordHeaderSize + item.second.size();
+        if (updateTime < (time(NULL) - INT32_FLAG(file_check_point_time_out))) {
+            LOG_INFO(sLogger, ("load timeout dir check point, ignore", item.first)(ToString(updateTime), time(NULL)));
+            continue;
+        }
+        DirCheckPointPtr dir(new DirCheckPoint(item.first));
+        string subDir;
+        for (uint32_t i = 0; i < subDirCount && reader.ReadString(subDir); ++i) {
+            dir->mSubDir.insert(subDir);
+        }
+        mDirNameMap.insert(make_pair(item.first, dir));
+    }
+    LOG_INFO(sLogger,
+             ("load binary checkpoint, version", mLoadVersion)("file check point", mDevInodeCheckPointPtrMap.size())(
+                 "dir check point", mDirNameMap.size())("log size", mBinaryCheckPointLogSize));
     return true;
 }
 
+bool CheckPointManager::DumpBinaryCheckPoint(const string& checkPointFile, const vector<CheckPoint*>& checkPoints) {
+    if (mBinaryCheckPointNeedCompact
+        || (mBinaryCheckPointLogSize > (uint64_t)INT32_FLAG(check_point_binary_log_compact_min_size)
+            && mBinaryCheckPointLogSize
+                > mBinaryCheckPointLiveSize * (uint64_t)INT32_FLAG(check_point_binary_log_compact_ratio))) {
+        return CompactBinaryCheckPoint(checkPointFile, checkPoints);
+    }
+
+    // both checkpoints and records are in key order, so they are merged in one pass. Each entry is encoded at the
+    // end of the buffer and dropped again if it has not changed since the last dump.
+    string buf;
+    uint32_t count = 0;
+    auto recordIt = mBinaryFileCheckPointRecords.begin();
+    auto deleteRecord = [&](map<CheckPointKey, BinaryCheckPointRecord>::iterator it) {
+        size_t pos = BeginRecord(buf, kFileCheckPointDeletedRecord);
+        AppendFileCheckPointKey(buf, it->first.mDevInode, it->first.mConfigName);
+        FinishRecord(buf, pos);
+        ++count;
+        mBinaryCheckPointLiveSize -= it->second.mSize;
+        return mBinaryFileCheckPointRecords.erase(it);
+    };
+    for (CheckPoint* checkPointPtr : checkPoints) {
+        CheckPointKey key(checkPointPtr->mDevInode, checkPointPtr->mConfigName);
+        while (recordIt != mBinaryFileCheckPointRecords.end() && recordIt->first < key) {
+            recordIt = deleteRecord(recordIt);
+        }
+        size_t pos = BeginRecord(buf, kFileCheckPointRecord);
+        AppendFileCheckPoint(buf, *checkPointPtr);
+        BinaryCheckPointRecord record{FinishRecord(buf, pos), static_cast<uint32_t>(buf.size() - pos)};
+        if (recordIt != mBinaryFileCheckPointRecords.end() && !(key < recordIt->first)) {
+            if (recordIt->second.mHash == record.mHash) {
+                buf.resize(pos);
+            } else {
+                mBinaryCheckPointLiveSize += record.mSize;
+                mBinaryCheckPointLiveSize -= recordIt->second.mSize;
+                recordIt->second = record;
+                ++count;
+            }
+            ++recordIt;
+        } else {
+            mBinaryFileCheckPointRecords.emplace_hint(recordIt, key, record);
+            mBinaryCheckPointLiveSize += record.mSize;
+            ++count;
+        }
+    }
+    while (recordIt != mBinaryFileCheckPointRecords.end()) {
+        recordIt = deleteRecord(recordIt);
+    }
+
+    for (const auto& item : mDirNameMap) {
+        size_t pos = BeginRecord(buf, kDirCheckPointRecord);
+        AppendDirCheckPoint(buf, item.first, *item.second);
+        BinaryCheckPointRecord record{FinishRecord(buf, pos), static_cast<uint32_t>(buf.size() - pos)};
+        auto& last = mBinaryDirCheckPointRecords[item.first];
+        if (last.mHash == record.mHash) {
+            buf.resize(pos);
+            continue;
+        }
+        mBinaryCheckPointLiveSize += record.mSize;
+        mBinaryCheckPointLiveSize -= last.mSize;
+        last = record;
+        ++count;
+    }
+    for (auto it = mBinaryDirCheckPointRecords.begin(); it != mBinaryDirCheckPointRecords.end();) {
+        if (mDirNameMap.find(it->first) != mDirNameMap.end()) {
+            ++it;
+            continue;
+        }
+        size_t pos = BeginRecord(buf, kDirCheckPointDeletedRecord);
+        AppendString(buf, it->first);
+        FinishRecord(buf, pos);
+        ++count;
+        mBinaryCheckPointLiveSize -= it->second.mSize;
+        it = mBinaryDirCheckPointRecords.erase(it);
+    }
+
+    if (count == 0) {
+        return true;
+    }
+    size_t pos = BeginRecord(buf, kCommitRecord);
+    AppendInteger<uint32_t>(buf, count);
+    FinishRecord(buf, pos);
+
+    std::ofstream fout(checkPointFile.c_str(), std::ios::binary | std::ios::app);
+    if (fout) {
+        fout.write(buf.data(), buf.size());
+    }
+    if (!fout) {
+        LOG_ERROR(sLogger, ("append binary check point file failed", checkPointFile)("errno", errno));
+        AlarmManager::GetInstance()->SendAlarm(CHECKPOINT_ALARM, "append binary check point file failed");
+        // records kept in memory may no longer match the file
+        mBinaryCheckPointNeedCompact = true;
+        return false;
+    }
+    fout.close();
+    mBinaryCheckPointLogSize += buf.size();
+    LOG_DEBUG(sLogger,
+              ("dump binary checkpoint, changed records", count)("appended bytes", buf.size())(
+                  "log size", mBinaryCheckPointLogSize)("live size", mBinaryCheckPointLiveSize));
+    return true;
+}
+
+bool CheckPointManager::CompactBinaryCheckPoint(const string& checkPointFile,
+                                                const vector<CheckPoint*>& checkPoints) {
+    mBinaryCheckPointNeedCompact = true;
+    mBinaryFileCheckPointRecords.clear();
+    mBinaryDirCheckPointRecords.clear();
+
+    string buf;
+    buf.append(kBinaryCheckPointMagic, sizeof(kBinaryCheckPointMagic));
+    AppendInteger<uint32_t>(buf, kBinaryCheckPointFormatVersion);
+    AppendInteger<int32_t>(buf, INT32_FLAG(check_point_version));
+    for (CheckPoint* checkPointPtr : checkPoints) {
+        size_t pos = BeginRecord(buf, kFileCheckPointRecord);
+        AppendFileCheckPoint(buf, *checkPointPtr);
+        uint64_t hash = FinishRecord(buf, pos);
+        mBinaryFileCheckPointRecords.emplace_hint(
+            mBinaryFileCheckPointRecords.end(),
+            CheckPointKey(checkPointPtr->mDevInode, checkPointPtr->mConfigName),
+            BinaryCheckPointRecord{hash, static_cast<uint32_t>(buf.size() - pos)});
+    }
+    for (const auto& item : mDirNameMap) {
+        size_t pos = BeginRecord(buf, kDirCheckPointRecord);
+        AppendDirCheckPoint(buf, item.first, *item.second);
+        uint64_t hash = FinishRecord(buf, pos);
+        mBinaryDirCheckPointRecords[item.first] = {hash, static_cast<uint32_t>(buf.size() - pos)};
+    }
+    size_t pos = BeginRecord(buf, kCommitRecord);
+    AppendInteger<uint32_t>(buf, checkPoints.size() + mDirNameMap.size());
+    FinishRecord(buf, pos);
+
+    string checkPointTempFile = checkPointFile + ".bak";
+    std::ofstream fout(checkPointTempFile.c_str(), std::ios::binary | std::ios::trunc);
+    if (fout) {
+        fout.write(buf.data(), buf.size());
+    }
+    if (!fout) {
+        LOG_ERROR(sLogger, ("dump binary check point file failed", checkPointTempFile)("errno", errno));
+        AlarmManager::GetInstance()->SendAlarm(CHECKPOINT_ALARM, "dump binary check point file failed");
+        return false;
+    }
+    fout.close();
+    if (!ReplaceFile(checkPointTempFile, checkPointFile)) {
+        LOG_ERROR(sLogger, ("rename binary check point file fail, errno", errno));
+        AlarmManager::GetInstance()->SendAlarm(
+            CHECKPOINT_ALARM, std::string("rename binary check point file fail, errno ") + ToString(errno));
+        return false;
+    }
+    mBinaryCheckPointNeedCompact = false;
+    mBinaryCheckPointLogSize = buf.size();
+    mBinaryCheckPointLiveSize = buf.size();
+    LOG_INFO(sLogger,
+             ("rewrite binary checkpoint, version", INT32_FLAG(check_point_version))(
+                 "file check point", checkPoints.size())("dir check point", mDirNameMap.size())("size", buf.size()));
+    return true;
+}
+
+void CheckPointManager::RemoveBinaryCheckPoint(const string& checkPointFile) {
+    mBinaryFileCheckPointRecords.clear();
+    mBinaryDirCheckPointRecords.clear();
+    mBinaryCheckPointNeedCompact = true;
+    if (remove(checkPointFile.c_str()) == -1 && errno != ENOENT) {
+        LOG_ERROR(sLogger, ("remove binary check point file fail", checkPointFile)("errno", errno));
+        AlarmManager::GetInstance()->SendAlarm(
+            CHECKPOINT_ALARM, std::string("remove binary check point file fail, errno ") + ToString(errno));
+    }
+}
+
 int32_t CheckPointManager::GetReaderCount() {
     return mReaderCount;
 }
@@ -565,6 +1101,7 @@ void CheckPointManager::RemoveLocalCheckPoint() {
     std::string checkPointFile = AppConfig::GetInstance()->GetCheckPointFilePath();
     if (remove(checkPointFile.c_str()) == -1) {
     }
+    RemoveBinaryCheckPoint(GetBinaryCheckPointFilePath());
 }
 
 void CheckPointManager::PrintStatus() {
@@ -17,10 +17,12 @@
 #pragma once
 #include <ctime>
 
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "boost/optional.hpp"
 #include "json/json.h"
@@ -116,24 +118,47 @@ public:
     typedef std::map<CheckPointKey, CheckPointPtr> DevInodeCheckPointHashMap;
 
 private:
+    // a record in the binary checkpoint log which is still live, kept to tell whether an entry changed since
+    // the last dump without reading the log back
+    struct BinaryCheckPointRecord {
+        uint64_t mHash = 0;
+        uint32_t mSize = 0;
+    };
+
     DevInodeCheckPointHashMap mDevInodeCheckPointPtrMap;
     std::unordered_map<std::string, DirCheckPointPtr> mDirNameMap;
     int32_t mLastCheckTime;
     int32_t mLastDumpTime;
     int32_t mLoadVersion;
     int32_t mReaderCount;
+
+    std::map<CheckPointKey, BinaryCheckPointRecord> mBinaryFileCheckPointRecords;
+    std::unordered_map<std::string, BinaryCheckPointRecord> mBinaryDirCheckPointRecords;
+    uint64_t mBinaryCheckPointLogSize = 0;
+    uint64_t mBinaryCheckPointLiveSize = 0;
+    bool mBinaryCheckPointNeedCompact = true;
+
     CheckPointManager()
         : mLastCheckTime(time(NULL)), mLastDumpTime(time(NULL)), mLoadVersion(NO_CHECKPOINT_VERSION), mReaderCount(0) {}
 
+    bool LoadBinaryCheckPoint(const std::string& checkPointFile);
+    bool DumpBinaryCheckPoint(const std::string& checkPointFile, const std::vector<CheckPoint*>& checkPoints);
+    bool CompactBinaryCheckPoint(const std::string& checkPointFile, const std::vector<CheckPoint*>& checkPoints);
+    void RemoveBinaryCheckPoint(const std::string& checkPointFile);
+
 public:
     bool CheckVersion();
     void AddCheckPoint(CheckPoint* checkPointPtr);
     void AddDirCheckPoint(const std::string& dirname);
     void DeleteCheckPoint(DevInode devInode, const std::string& configName);
     void DeleteDirCheckPoint(const std::string& dirname);
+    // The binary checkpoint log is loaded if it exists, since it is removed whenever the json file is dumped.
+    // Otherwise the json file is loaded, and the next binary dump migrates it by writing a full log.
     void LoadCheckPoint();
     void LoadDirCheckPoint(const Json::Value& root);
     void LoadFileCheckPoint(const Json::Value& root);
+    // With enable_binary_check_point, only entries changed since the last dump are appended to the binary
+    // checkpoint log, which is rewritten once stale records make up most of it.
     bool DumpCheckPointToLocal();
     int32_t GetReaderCount();
     bool GetCheckPoint(DevInode devInode, const std::string& configName, CheckPointPtr& checkPointPtr);
@@ -155,6 +180,7 @@ public:
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class ConfigUpdatorUnittest;
+    friend class CheckpointManagerUnittest;
     void RemoveLocalCheckPoint();
     void PrintStatus();
 #endif
@@ -14,6 +14,8 @@
 
 #include "CheckpointManagerV2.h"
 
+#include <future>
+
 #include "leveldb/write_batch.h"
 
 #include "app_config/AppConfig.h"
@@ -29,6 +31,13 @@ DEFINE_FLAG_INT32(logtail_checkpoint_gc_threshold_sec, "30 minutes", 30 * 60);
 DEFINE_FLAG_DOUBLE(logtail_checkpoint_max_gc_count_ratio_per_round, "10%", 0.1);
 DEFINE_FLAG_INT64(logtail_checkpoint_max_used_time_per_round_in_msec, "500ms", 500);
 DEFINE_FLAG_INT32(logtail_checkpoint_expired_threshold_sec, "6 hours", 6 * 60 * 60);
+DEFINE_FLAG_BOOL(enable_checkpoint_v2_group_commit,
+                 "write exactly once checkpoints in batches by a commit thread",
+                 true);
+DEFINE_FLAG_INT32(checkpoint_v2_group_commit_interval_ms,
+                  "max time an async checkpoint write waits for others to join its batch",
+                  5);
+DEFINE_FLAG_INT32(checkpoint_v2_group_commit_max_batch_size, "commit at once when so many keys are waiting", 1024);
 
 DECLARE_FLAG_INT32(max_exactly_once_concurrency);
 
@@ -303,6 +312,18 @@ uint64_t CheckpointManagerV2::DeleteCheckpoints(const std::vector<std::string>&
     }
 
     auto const startTimeInMs = GetCurrentTimeInMilliSeconds();
+    if (mCommitThreadPtr) {
+        // queued with the writes, so that a write of the same key is never committed after its later deletion
+        std::vector<std::pair<std::string, std::optional<std::string>>> items;
+        items.reserve(keys.size());
+        for (auto& k : keys) {
+            items.emplace_back(k, std::nullopt);
+        }
+        if (submitBatch(std::move(items))) {
+            LOG_DEBUG(sLogger, ("delete checkpoints, count", keys.size()));
+        }
+        return GetCurrentTimeInMilliSeconds() - startTimeInMs;
+    }
     leveldb::WriteBatch batch;
     for (auto& k : keys) {
         batch.Delete(k);
@@ -321,6 +342,7 @@ uint64_t CheckpointManagerV2::UpdatePrimaryCheckpoints(
     const std::vector<std::pair<std::string, PrimaryCheckpointPB>*>& checkpoints) {
 #define METHOD_LOG_PATTERN ("method", "UpdatePrimaryCheckpoints")("count", checkpoints.size())
     auto const startTimeInMs = GetCurrentTimeInMilliSeconds();
+    std::vector<std::pair<std::string, std::optional<std::string>>> items;
     leveldb::WriteBatch batch;
     for (auto& cptPair : checkpoints) {
         auto& key = cptPair->first;
@@ -330,7 +352,14 @@ uint64_t CheckpointManagerV2::UpdatePrimaryCheckpoints(
             LOG_ERROR(sLogger, METHOD_LOG_PATTERN("serialize error", key)("checkpoint", cpt.DebugString()));
             continue;
         }
-        batch.Put(key, data);
+        if (mCommitThreadPtr) {
+            items.emplace_back(key, std::move(data));
+        } else {
+            batch.Put(key, data);
+        }
+    }
+    if (mCommitThreadPtr) {
+        return submitBatch(std::move(items)) ? GetCurrentTimeInMilliSeconds() - startTimeInMs : 0;
     }
     auto status = mDatabase->Write(mDefaultWriteOption, &batch);
     if (status.ok()) {
@@ -363,11 +392,17 @@ bool CheckpointManagerV2::open() {
         return false;
     }
     LOG_DEBUG(sLogger, METHOD_LOG_PATTERN("checkpoint database opened", ""));
+    if (BOOL_FLAG(enable_checkpoint_v2_group_commit)) {
+        mStopCommitThread = false;
+        mCommitThreadPtr.reset(new std::thread([&]() { runCommitLoop(); }));
+    }
     return true;
 #undef METHOD_LOG_PATTERN
 }
 
 bool CheckpointManagerV2::close() {
+    // the commit thread drains queued writes before exit, and must not outlive the database
+    stopCommitThread();
     bool opened = mDatabase != nullptr;
     if (opened) {
         delete mDatabase;
@@ -391,7 +426,13 @@ bool CheckpointManagerV2::readDatabase(const std::string& key, std::string& valu
 }
 
 bool CheckpointManagerV2::read(const std::string& key, std::string& value) {
-    if (!readDatabase(key, value)) {
+    std::optional<std::string> queued;
+    if (readUncommitted(key, queued)) {
+        if (!queued) {
+            return false;
+        }
+        value = std::move(*queued);
+    } else if (!readDatabase(key, value)) {
         return false;
     }
 
@@ -411,6 +452,13 @@ bool CheckpointManagerV2::read(const std::string& key, std::string& value) {
 bool CheckpointManagerV2::write(const std::string& key, const std::string& value) {
     ASSERT_LEVELDB_STATUS;
 
+    if (mCommitThreadPtr) {
+        std::promise<bool> committed;
+        auto result = committed.get_future();
+        submitWrite(key, std::string(value), [&committed](bool success) { committed.set_value(success); }, true);
+        return result.get();
+    }
+
     leveldb::Status s = mDatabase->Put(mDefaultWriteOption, key, value);
     if (s.ok()) {
         return true;
@@ -419,6 +467,140 @@ bool CheckpointManagerV2::write(const std::string& key, const std::string& value
     return false;
 }
 
+void CheckpointManagerV2::asyncWrite(const std::string& key, std::string&& value, WriteCallback&& callback) {
+    if (nullptr == mDatabase || !mCommitThreadPtr) {
+        bool success = write(key, value);
+        if (callback) {
+            callback(success);
+        }
+        return;
+    }
+    submitWrite(key, std::move(value), std::move(callback), false);
+}
+
+void CheckpointManagerV2::submitWrite(const std::string& key,
+                                      std::string&& value,
+                                      WriteCallback&& callback,
+                                      bool flushNow) {
+    {
+        std::lock_guard<std::mutex> lock(mCommitMux);
+        mPendingWrites[key] = std::move(value);
+        if (callback) {
+            mPendingCallbacks.push_back(std::move(callback));
+        }
+        mFlushNow = mFlushNow || flushNow;
+    }
+    mCommitCV.notify_one();
+}
+
+bool CheckpointManagerV2::submitBatch(std::vector<std::pair<std::string, std::optional<std::string>>>&& items) {
+    // the commit thread only wakes up for queued keys
+    if (items.empty()) {
+        return true;
+    }
+    std::promise<bool> committed;
+    auto result = committed.get_future();
+    {
+        std::lock_guard<std::mutex> lock(mCommitMux);
+        for (auto& item : items) {
+            mPendingWrites[item.first] = std::move(item.second);
+        }
+        mPendingCallbacks.push_back([&committed](bool success) { committed.set_value(success); });
+        mFlushNow = true;
+    }
+    mCommitCV.notify_one();
+    return result.get();
+}
+
+bool CheckpointManagerV2::readUncommitted(const std::string& key, std::optional<std::string>& value) {
+    if (!mCommitThreadPtr) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mCommitMux);
+    auto iter = mPendingWrites.find(key);
+    if (iter != mPendingWrites.end()) {
+        value = iter->second;
+        return true;
+    }
+    iter = mCommittingWrites.find(key);
+    if (iter != mCommittingWrites.end()) {
+        value = iter->second;
+        return true;
+    }
+    return false;
+}
+
+void CheckpointManagerV2::Flush() {
+    if (!mCommitThreadPtr) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(mCommitMux);
+    if (!mPendingWrites.empty()) {
+        mFlushNow = true;
+        mCommitCV.notify_one();
+    }
+    mCommittedCV.wait(lock, [this]() { return mPendingWrites.empty() && !mCommitting; });
+}
+
+void CheckpointManagerV2::runCommitLoop() {
+    std::vector<WriteCallback> callbacks;
+    std::unique_lock<std::mutex> lock(mCommitMux);
+    while (true) {
+        mCommitCV.wait(lock, [this]() { return mStopCommitThread || !mPendingWrites.empty(); });
+        if (mPendingWrites.empty()) {
+            break;
+        }
+        // Give writes from other readers and flushers a chance to join the batch, unless
+        //  someone is blocked on it.
+        const size_t maxBatchSize = INT32_FLAG(checkpoint_v2_group_commit_max_batch_size);
+        mCommitCV.wait_for(
+            lock, std::chrono::milliseconds(INT32_FLAG(checkpoint_v2_group_commit_interval_ms)), [&]() {
+                return mStopCommitThread || mFlushNow || mPendingWrites.size() >= maxBatchSize;
+            });
+        mCommittingWrites.swap(mPendingWrites);
+        callbacks.swap(mPendingCallbacks);
+        mFlushNow = false;
+        mCommitting = true;
+        lock.unlock();
+
+        leveldb::WriteBatch batch;
+        for (auto& item : mCommittingWrites) {
+            if (item.second) {
+                batch.Put(item.first, *item.second);
+            } else {
+                batch.Delete(item.first);
+            }
+        }
+        auto status = mDatabase->Write(mDefaultWriteOption, &batch);
+        if (!status.ok()) {
+            detail::logDatabaseError("group_commit", std::to_string(mCommittingWrites.size()), status);
+        }
+        for (auto& callback : callbacks) {
+            callback(status.ok());
+        }
+        callbacks.clear();
+
+        lock.lock();
+        mCommittingWrites.clear();
+        mCommitting = false;
+        mCommittedCV.notify_all();
+    }
+    LOG_INFO(sLogger, ("runCommitLoop exit", "done"));
+}
+
+void CheckpointManagerV2::stopCommitThread() {
+    if (!mCommitThreadPtr) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mCommitMux);
+        mStopCommitThread = true;
+    }
+    mCommitCV.notify_one();
+    mCommitThreadPtr->join();
+    mCommitThreadPtr.reset();
+}
+
 void CheckpointManagerV2::MarkGC(const std::string& primaryKey) {
     {
         std::lock_guard<std::mutex> lock(mMutex);
@@ -15,8 +15,11 @@
  */
 
 #pragma once
+#include <condition_variable>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
 #include <unordered_map>
@@ -47,8 +50,15 @@ namespace logtail {
 //  range checkpoints, that is why we call N concurrency.
 // - If order is import, the 1 primary checkpoint + N range checkpoints model downgrades
 //  to 1 primary + 1 range, ie. there is only one concurrency for the file.
+//
+// Writes are group committed when enable_checkpoint_v2_group_commit is set: a commit
+//  thread gathers the writes of all readers and flushers into one leveldb batch, so
+//  that a sync write is shared by all of them. SetPB still returns after its write is
+//  durable, while AsyncSetPB returns at once and reports through a callback.
 class CheckpointManagerV2 {
 public:
+    using WriteCallback = std::function<void(bool /* success */)>;
+
     static std::string MakeRangeKey(const std::string& primaryKey, uint32_t idx);
 
     // Append key of range checkpoints to keys.
@@ -96,6 +106,26 @@ public:
         return write(key, data);
     }
 
+    // AsyncSetPB queues the write to the next group commit, callback is called from the
+    //  commit thread once it is durable or failed, so it must not wait for other writes.
+    //  Writes and deletions of the same key are applied in the order of calls, and GetPB
+    //  sees a queued value before it is committed.
+    template <class PBType>
+    void AsyncSetPB(const std::string& key, const PBType& value, WriteCallback callback = nullptr) {
+        std::string data;
+        if (!value.SerializeToString(&data)) {
+            if (callback) {
+                callback(false);
+            }
+            return;
+        }
+
+        asyncWrite(key, std::move(data), std::move(callback));
+    }
+
+    // Block until all queued writes are committed.
+    void Flush();
+
     // Add primaryKey to GC list, called in destructor of LogFileReader.
     //
     // GetPB will remove primaryKey from GC list, so for config update case, primary
@@ -124,9 +154,9 @@ private:
     CheckpointManagerV2();
     ~CheckpointManagerV2();
 
-    // Open database, return true if succeed.
+    // Open database and start the commit thread, return true if succeed.
     bool open();
-    // Close database, return true if the database is opened before.
+    // Stop the commit thread and close database, return true if the database is opened before.
     bool close();
 
     bool readDatabase(const std::string& key, std::string& value);
@@ -135,6 +165,18 @@ private:
     // @return true if succeed.
     bool read(const std::string& key, std::string& value);
     bool write(const std::string& key, const std::string& value);
+    void asyncWrite(const std::string& key, std::string&& value, WriteCallback&& callback);
+    // Queue a write to the commit thread, flushNow skips waiting for more writes.
+    void submitWrite(const std::string& key, std::string&& value, WriteCallback&& callback, bool flushNow);
+    // Queue writes or deletions (nullopt) to the commit thread and wait until they are committed.
+    bool submitBatch(std::vector<std::pair<std::string, std::optional<std::string>>>&& items);
+    // Look up a key queued but not committed yet, value is nullopt if it is queued for deletion.
+    // @return true if the key is queued.
+    bool readUncommitted(const std::string& key, std::optional<std::string>& value);
+
+    // Routine of commit thread.
+    void runCommitLoop();
+    void stopCommitThread();
 
     // Routine of GC thread.
     void runGCLoop();
@@ -171,6 +213,19 @@ private:
     leveldb::DB* mDatabase = nullptr;
     leveldb::WriteOptions mDefaultWriteOption;
 
+    std::mutex mCommitMux;
+    std::condition_variable mCommitCV;
+    std::condition_variable mCommittedCV;
+    // Latest value of each key waiting for the next batch, nullopt means deletion.
+    std::unordered_map<std::string, std::optional<std::string>> mPendingWrites;
+    std::vector<WriteCallback> mPendingCallbacks;
+    // Batch being written by the commit thread, only changed with mCommitMux held.
+    std::unordered_map<std::string, std::optional<std::string>> mCommittingWrites;
+    bool mCommitting = false;
+    bool mFlushNow = false;
+    bool mStopCommitThread = false;
+    std::unique_ptr<std::thread> mCommitThreadPtr;
+
     volatile bool mStopGCThread = false;
     std::unique_ptr<std::thread> mGCThreadPtr;
     std::mutex mMutex;
@@ -182,6 +237,7 @@ private:
     friend class CheckpointManagerV2Unittest;
     friend class ExactlyOnceReaderUnittest;
     friend class SenderUnittest;
+    friend class CheckpointManagerV2Benchmark;
 
     void rebuild();
 #endif
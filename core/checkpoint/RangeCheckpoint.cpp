@@ -18,10 +18,14 @@
 
 namespace logtail {
 
-void RangeCheckpoint::save() {
+void RangeCheckpoint::save(bool waitDurable) {
     static auto sCptM = CheckpointManagerV2::GetInstance();
     data.set_update_time(time(NULL));
-    sCptM->SetPB(key, data);
+    if (waitDurable) {
+        sCptM->SetPB(key, data);
+    } else {
+        sCptM->AsyncSetPB(key, data);
+    }
 }
 
 } // namespace logtail
@@ -31,14 +31,17 @@ public:
     QueueKey fbKey;
     RangeCheckpointPB data;
 
+    // Data of the range is sent only after Prepare returns, so it must be durable.
     inline void Prepare() {
         data.set_committed(false);
-        save();
+        save(true);
     }
 
+    // A commit lost on crash leaves the range prepared, which is resent with the same
+    //  sequence id and rejected by the server as duplicated, so Commit does not wait.
     inline void Commit() {
         data.set_committed(true);
-        save();
+        save(false);
     }
 
     inline void IncreaseSequenceID() { data.set_sequence_id(data.sequence_id() + 1); }
@@ -46,7 +49,7 @@ public:
     inline bool IsComplete() const { return data.has_hash_key(); }
 
 private:
-    void save();
+    void save(bool waitDurable);
 };
 
 typedef std::shared_ptr<RangeCheckpoint> RangeCheckpointPtr;
@@ -82,6 +82,7 @@ private:
     friend class CommonConfigProviderUnittest;
     friend class FlusherUnittest;
     friend class PipelineUnittest;
+    friend class ProcessorRunnerBenchmark;
 #endif
 };
 
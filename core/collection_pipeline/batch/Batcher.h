@@ -18,9 +18,12 @@
 
 #include <cstdint>
 
+#include <algorithm>
 #include <map>
 #include <mutex>
 #include <optional>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "json/json.h"
@@ -41,10 +44,12 @@ namespace logtail {
 template <typename T = EventBatchStatus>
 class Batcher {
 public:
+    // @shardCnt: number of threads calling Add concurrently, usually the processor thread count
     bool Init(const Json::Value& config,
               Flusher* flusher,
               const DefaultFlushStrategyOptions& strategy,
-              bool enableGroupBatch = false) {
+              bool enableGroupBatch = false,
+              size_t shardCnt = 1) {
         std::string errorMsg;
         CollectionPipelineContext& ctx = flusher->GetContext();
 
@@ -101,6 +106,8 @@ public:
 
         mFlusher = flusher;
 
+        mShards = std::vector<Shard>(std::min(std::max<size_t>(shardCnt, 1), kMaxShards));
+
         std::vector<std::pair<std::string, std::string>> labels{
             {METRIC_LABEL_KEY_PROJECT, ctx.GetProjectName()},
             {METRIC_LABEL_KEY_PIPELINE_NAME, ctx.GetConfigName()},
@@ -127,14 +134,21 @@ public:
     }
 
     // when group level batch is disabled, there should be only 1 element in BatchedEventsList
-    void Add(PipelineEventGroup&& g, std::vector<BatchedEventsList>& res) {
+    // @threadNo: the processor thread calling, which picks the shard
+    void Add(PipelineEventGroup&& g, std::vector<BatchedEventsList>& res, size_t threadNo = 0) {
         auto before = std::chrono::system_clock::now();
-        std::lock_guard<std::mutex> lock(mMux);
+        size_t shardIdx = threadNo % mShards.size();
+        Shard& shard = mShards[shardIdx];
+        std::lock_guard<std::mutex> lock(shard.mMux);
         size_t key = g.GetTagsHash();
-        EventBatchItem<T>& item = mEventQueueMap[key];
+        auto [iter, inserted] = shard.mEventQueueMap.try_emplace(key);
+        EventBatchItem<T>& item = iter->second;
         ADD_COUNTER(mInEventsTotal, g.GetEvents().size());
         ADD_COUNTER(mInGroupDataSizeBytes, g.DataSize());
-        SET_GAUGE(mEventBatchItemsTotal, mEventQueueMap.size());
+        if (inserted) {
+            AssignTimeoutKey(shard, shardIdx, key);
+            ADD_GAUGE(mEventBatchItemsTotal, 1);
+        }
 
         if (g.DataSize() > mEventFlushStrategy.GetMinSizeBytes()) {
             // for group size larger than min batch size, separate group only if size is larger than max batch size
@@ -171,22 +185,7 @@ public:
                         UpdateMetricsOnFlushingEventQueue(item);
                         item.Flush(res);
                     } else {
-                        if (!mGroupQueue->IsEmpty() && mGroupFlushStrategy->NeedFlushByTime(mGroupQueue->GetStatus())) {
-                            UpdateMetricsOnFlushingGroupQueue();
-                            mGroupQueue->Flush(res);
-                        }
-                        if (mGroupQueue->IsEmpty()) {
-                            TimeoutFlushManager::GetInstance()->UpdateRecord(mFlusher->GetContext().GetConfigName(),
-                                                                             mFlusher->GetFlusherIndex(),
-                                                                             0,
-                                                                             mGroupFlushStrategy->GetTimeoutSecs(),
-                                                                             mFlusher);
-                        }
-                        item.Flush(mGroupQueue.value());
-                        if (mGroupFlushStrategy->NeedFlushBySize(mGroupQueue->GetStatus())) {
-                            UpdateMetricsOnFlushingGroupQueue();
-                            mGroupQueue->Flush(res);
-                        }
+                        FlushToGroupQueue(item, res);
                     }
                 }
                 if (item.IsEmpty()) {
@@ -196,7 +195,7 @@ public:
                                g.GetMetadata(EventGroupMetaKey::SOURCE_ID));
                     TimeoutFlushManager::GetInstance()->UpdateRecord(mFlusher->GetContext().GetConfigName(),
                                                                      mFlusher->GetFlusherIndex(),
-                                                                     key,
+                                                                     shard.mTimeoutKeys[key],
                                                                      mEventFlushStrategy.GetTimeoutSecs(),
                                                                      mFlusher);
                     ADD_GAUGE(mBufferedGroupsTotal, 1);
@@ -217,11 +216,11 @@ public:
         ADD_COUNTER(mTotalAddTimeMs, std::chrono::system_clock::now() - before);
     }
 
-    // key != 0: event level queue
+    // key != 0: event level queue, as registered to TimeoutFlushManager
     // key = 0: group level queue
     void FlushQueue(size_t key, BatchedEventsList& res) {
-        std::lock_guard<std::mutex> lock(mMux);
         if (key == 0) {
+            std::lock_guard<std::mutex> lock(mGroupMux);
             if (!mGroupQueue) {
                 return;
             }
@@ -229,63 +228,68 @@ public:
             return mGroupQueue->Flush(res);
         }
 
-        auto iter = mEventQueueMap.find(key);
-        if (iter == mEventQueueMap.end()) {
+        std::pair<size_t, size_t> target;
+        {
+            std::lock_guard<std::mutex> lock(mTimeoutKeysMux);
+            auto it = mTimeoutKeys.find(key);
+            if (it == mTimeoutKeys.end()) {
+                return;
+            }
+            target = it->second;
+        }
+        Shard& shard = mShards[target.first];
+        std::lock_guard<std::mutex> lock(shard.mMux);
+        auto keyIter = shard.mTimeoutKeys.find(target.second);
+        // the queue may have been flushed and its key given to another one in between
+        if (keyIter == shard.mTimeoutKeys.end() || keyIter->second != key) {
+            return;
+        }
+        auto iter = shard.mEventQueueMap.find(target.second);
+        if (iter == shard.mEventQueueMap.end()) {
             return;
         }
-
         if (!mGroupQueue) {
             UpdateMetricsOnFlushingEventQueue(iter->second);
             iter->second.Flush(res);
-            mEventQueueMap.erase(iter);
-            SET_GAUGE(mEventBatchItemsTotal, mEventQueueMap.size());
-            return;
-        }
-
-        if (!mGroupQueue->IsEmpty() && mGroupFlushStrategy->NeedFlushByTime(mGroupQueue->GetStatus())) {
-            UpdateMetricsOnFlushingGroupQueue();
-            mGroupQueue->Flush(res);
-        }
-        if (mGroupQueue->IsEmpty()) {
-            TimeoutFlushManager::GetInstance()->UpdateRecord(mFlusher->GetContext().GetConfigName(),
-                                                             mFlusher->GetFlusherIndex(),
-                                                             0,
-                                                             mGroupFlushStrategy->GetTimeoutSecs(),
-                                                             mFlusher);
-        }
-        iter->second.Flush(mGroupQueue.value());
-        mEventQueueMap.erase(iter);
-        SET_GAUGE(mEventBatchItemsTotal, mEventQueueMap.size());
-        if (mGroupFlushStrategy->NeedFlushBySize(mGroupQueue->GetStatus())) {
-            UpdateMetricsOnFlushingGroupQueue();
-            mGroupQueue->Flush(res);
+        } else {
+            FlushToGroupQueue(iter->second, res);
         }
+        shard.mEventQueueMap.erase(iter);
+        ReleaseTimeoutKey(shard, target.second);
+        SUB_GAUGE(mEventBatchItemsTotal, 1);
     }
 
     void FlushAll(std::vector<BatchedEventsList>& res) {
-        std::lock_guard<std::mutex> lock(mMux);
-        for (auto& item : mEventQueueMap) {
-            if (!mGroupQueue) {
-                UpdateMetricsOnFlushingEventQueue(item.second);
-                item.second.Flush(res);
-            } else {
-                if (!mGroupQueue->IsEmpty() && mGroupFlushStrategy->NeedFlushByTime(mGroupQueue->GetStatus())) {
-                    UpdateMetricsOnFlushingGroupQueue();
-                    mGroupQueue->Flush(res);
-                }
-                item.second.Flush(mGroupQueue.value());
-                if (mGroupFlushStrategy->NeedFlushBySize(mGroupQueue->GetStatus())) {
-                    UpdateMetricsOnFlushingGroupQueue();
-                    mGroupQueue->Flush(res);
+        for (auto& shard : mShards) {
+            std::lock_guard<std::mutex> lock(shard.mMux);
+            for (auto& item : shard.mEventQueueMap) {
+                if (!mGroupQueue) {
+                    UpdateMetricsOnFlushingEventQueue(item.second);
+                    item.second.Flush(res);
+                } else {
+                    std::lock_guard<std::mutex> groupLock(mGroupMux);
+                    if (!mGroupQueue->IsEmpty() && mGroupFlushStrategy->NeedFlushByTime(mGroupQueue->GetStatus())) {
+                        UpdateMetricsOnFlushingGroupQueue();
+                        mGroupQueue->Flush(res);
+                    }
+                    item.second.Flush(mGroupQueue.value());
+                    if (mGroupFlushStrategy->NeedFlushBySize(mGroupQueue->GetStatus())) {
+                        UpdateMetricsOnFlushingGroupQueue();
+                        mGroupQueue->Flush(res);
+                    }
                 }
             }
+            for (const auto& item : shard.mEventQueueMap) {
+                ReleaseTimeoutKey(shard, item.first);
+            }
+            shard.mEventQueueMap.clear();
         }
         if (mGroupQueue) {
+            std::lock_guard<std::mutex> groupLock(mGroupMux);
             UpdateMetricsOnFlushingGroupQueue();
             mGroupQueue->Flush(res);
         }
         SET_GAUGE(mEventBatchItemsTotal, 0);
-        mEventQueueMap.clear();
     }
 
 #ifdef APSARA_UNIT_TEST_MAIN
@@ -294,6 +298,66 @@ public:
 #endif
 
 private:
+    // Event level queues are sharded by processor thread, so that threads sending to the same flusher, even with the
+    // same tags, do not contend with each other. Each thread fills its own batch, which is flushed on its own.
+    struct alignas(64) Shard {
+        std::mutex mMux;
+        std::map<size_t, EventBatchItem<T>> mEventQueueMap;
+        // tag hash -> key registered to TimeoutFlushManager
+        std::unordered_map<size_t, size_t> mTimeoutKeys;
+    };
+
+    static constexpr size_t kMaxShards = 64;
+
+    // Each event level queue registers its own key to TimeoutFlushManager, so that a busy queue never delays the
+    // timeout flush of another one. The key is the tag hash mixed with the shard index, which leaves it unchanged for
+    // shard 0, and is moved to the next free value on collision. 0 is reserved for the group level queue.
+    // should be called with the shard lock held
+    void AssignTimeoutKey(Shard& shard, size_t shardIdx, size_t tagHash) {
+        std::lock_guard<std::mutex> lock(mTimeoutKeysMux);
+        size_t key = tagHash ^ (shardIdx * 0x9E3779B97F4A7C15ULL);
+        while (key == 0 || mTimeoutKeys.find(key) != mTimeoutKeys.end()) {
+            ++key;
+        }
+        mTimeoutKeys.emplace(key, std::make_pair(shardIdx, tagHash));
+        shard.mTimeoutKeys[tagHash] = key;
+    }
+
+    // should be called with the shard lock held
+    void ReleaseTimeoutKey(Shard& shard, size_t tagHash) {
+        auto it = shard.mTimeoutKeys.find(tagHash);
+        if (it == shard.mTimeoutKeys.end()) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mTimeoutKeysMux);
+            mTimeoutKeys.erase(it->second);
+        }
+        shard.mTimeoutKeys.erase(it);
+    }
+
+    // should be called with the shard lock held
+    template <typename R>
+    void FlushToGroupQueue(EventBatchItem<T>& item, R& res) {
+        std::lock_guard<std::mutex> lock(mGroupMux);
+        if (!mGroupQueue->IsEmpty() && mGroupFlushStrategy->NeedFlushByTime(mGroupQueue->GetStatus())) {
+            UpdateMetricsOnFlushingGroupQueue();
+            mGroupQueue->Flush(res);
+        }
+        if (mGroupQueue->IsEmpty()) {
+            TimeoutFlushManager::GetInstance()->UpdateRecord(mFlusher->GetContext().GetConfigName(),
+                                                             mFlusher->GetFlusherIndex(),
+                                                             0,
+                                                             mGroupFlushStrategy->GetTimeoutSecs(),
+                                                             mFlusher);
+        }
+        item.Flush(mGroupQueue.value());
+        if (mGroupFlushStrategy->NeedFlushBySize(mGroupQueue->GetStatus())) {
+            UpdateMetricsOnFlushingGroupQueue();
+            mGroupQueue->Flush(res);
+        }
+    }
+
     void UpdateMetricsOnFlushingEventQueue(const EventBatchItem<T>& item) {
         ADD_COUNTER(mOutEventsTotal, item.EventSize());
         // ADD_COUNTER(mTotalDelayMs,
@@ -320,10 +384,15 @@ private:
         SUB_GAUGE(mBufferedDataSizeByte, mGroupQueue->DataSize());
     }
 
-    std::mutex mMux;
-    std::map<size_t, EventBatchItem<T>> mEventQueueMap;
+    std::vector<Shard> mShards = std::vector<Shard>(1);
     EventFlushStrategy<T> mEventFlushStrategy;
 
+    // key registered to TimeoutFlushManager -> (shard index, tag hash), lock order: shard lock first
+    std::mutex mTimeoutKeysMux;
+    std::unordered_map<size_t, std::pair<size_t, size_t>> mTimeoutKeys;
+
+    // shared by all shards, lock order: shard lock first, then mGroupMux
+    std::mutex mGroupMux;
     std::optional<GroupBatchItem> mGroupQueue;
     std::optional<GroupFlushStrategy> mGroupFlushStrategy;
 
@@ -14,12 +14,52 @@
 
 #include "collection_pipeline/limiter/ConcurrencyLimiter.h"
 
+#include <algorithm>
+
+#include "common/Flags.h"
 #include "common/StringTools.h"
 #include "logger/Logger.h"
+#include "monitor/MetricManager.h"
+
+DEFINE_FLAG_BOOL(enable_concurrency_response_time_limit,
+                 "decrease send concurrency when response time increases even if requests do not fail",
+                 true);
+DEFINE_FLAG_DOUBLE(concurrency_response_time_tolerance,
+                   "recent response time exceeding min response time by the ratio is taken as queuing",
+                   2.0);
+DEFINE_FLAG_INT32(concurrency_min_response_time_reset_interval_sec,
+                  "interval to reset min response time to the recent one, seconds",
+                  600);
 
 using namespace std;
 
 namespace logtail {
+
+// the limit is not decreased by more than half in a statistic round due to response time
+static constexpr double kMinResponseTimeGradient = 0.5;
+
+ConcurrencyLimiter::ConcurrencyLimiter(const std::string& description,
+                                       uint32_t maxConcurrency,
+                                       uint32_t minConcurrency,
+                                       double concurrencyFastFallBackRatio,
+                                       double concurrencySlowFallBackRatio)
+    : mDescription(description),
+      mMaxConcurrency(maxConcurrency),
+      mMinConcurrency(minConcurrency),
+      mCurrenctConcurrency(maxConcurrency),
+      mConcurrencyFastFallBackRatio(concurrencyFastFallBackRatio),
+      mConcurrencySlowFallBackRatio(concurrencySlowFallBackRatio) {
+    WriteMetrics::GetInstance()->PrepareMetricsRecordRef(
+        mMetricsRecordRef,
+        MetricCategory::METRIC_CATEGORY_COMPONENT,
+        {{METRIC_LABEL_KEY_COMPONENT_NAME, METRIC_LABEL_VALUE_COMPONENT_NAME_CONCURRENCY_LIMITER},
+         {METRIC_LABEL_KEY_LIMITER_DESCRIPTION, mDescription}});
+    mConcurrencyLimit = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_LIMITER_CONCURRENCY_LIMIT);
+    mMinResponseTime = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_LIMITER_MIN_RESPONSE_TIME_MS);
+    mRecentResponseTime = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_LIMITER_RECENT_RESPONSE_TIME_MS);
+    SET_GAUGE(mConcurrencyLimit, mCurrenctConcurrency);
+}
+
 #ifdef APSARA_UNIT_TEST_MAIN
 uint32_t ConcurrencyLimiter::GetCurrentLimit() const {
     lock_guard<mutex> lock(mLimiterMux);
@@ -42,6 +82,16 @@ uint32_t ConcurrencyLimiter::GetStatisticThreshold() const {
     return CONCURRENCY_STATISTIC_THRESHOLD;
 }
 
+double ConcurrencyLimiter::GetMinResponseTimeMs() const {
+    lock_guard<mutex> lock(mStatisticsMux);
+    return mMinResponseTimeMs;
+}
+
+double ConcurrencyLimiter::GetRecentResponseTimeMs() const {
+    lock_guard<mutex> lock(mStatisticsMux);
+    return mRecentResponseTimeMs;
+}
+
 #endif
 
 bool ConcurrencyLimiter::IsValidToPop() {
@@ -60,12 +110,13 @@ void ConcurrencyLimiter::OnSendDone() {
     --mInSendingCnt;
 }
 
-void ConcurrencyLimiter::OnSuccess(std::chrono::system_clock::time_point currentTime) {
-    AdjustConcurrency(true, currentTime);
+void ConcurrencyLimiter::OnSuccess(std::chrono::system_clock::time_point currentTime,
+                                   std::chrono::milliseconds responseTime) {
+    AdjustConcurrency(true, currentTime, responseTime);
 }
 
 void ConcurrencyLimiter::OnFail(std::chrono::system_clock::time_point currentTime) {
-    AdjustConcurrency(false, currentTime);
+    AdjustConcurrency(false, currentTime, chrono::milliseconds::zero());
 }
 
 void ConcurrencyLimiter::Increase() {
@@ -81,6 +132,7 @@ void ConcurrencyLimiter::Increase() {
                       ("increase send concurrency, type",
                        mDescription)("from", mCurrenctConcurrency - 1)("to", mCurrenctConcurrency));
         }
+        SET_GAUGE(mConcurrencyLimit, mCurrenctConcurrency);
     }
 }
 
@@ -96,17 +148,24 @@ void ConcurrencyLimiter::Decrease(double fallBackRatio) {
             LOG_INFO(sLogger, ("decrease send concurrency to min, type", mDescription)("to", mCurrenctConcurrency));
         }
     }
+    SET_GAUGE(mConcurrencyLimit, mCurrenctConcurrency);
 }
 
 
-void ConcurrencyLimiter::AdjustConcurrency(bool success, std::chrono::system_clock::time_point currentTime) {
+void ConcurrencyLimiter::AdjustConcurrency(bool success,
+                                           std::chrono::system_clock::time_point currentTime,
+                                           std::chrono::milliseconds responseTime) {
     uint32_t failPercentage = 0;
     bool finishStatistics = false;
+    double gradient = 1.0;
     {
         lock_guard<mutex> lock(mStatisticsMux);
         mStatisticsTotal++;
         if (!success) {
             mStatisticsFailTotal++;
+        } else if (responseTime.count() > 0) {
+            mStatisticsResponseTotal++;
+            mStatisticsResponseTimeMs += responseTime.count();
         }
         if (mLastStatisticsTime == std::chrono::system_clock::time_point()) {
             mLastStatisticsTime = currentTime;
@@ -118,8 +177,11 @@ void ConcurrencyLimiter::AdjustConcurrency(bool success, std::chrono::system_clo
             LOG_DEBUG(sLogger,
                       ("AdjustConcurrency", mDescription)("mStatisticsFailTotal",
                                                           mStatisticsFailTotal)("mStatisticsTotal", mStatisticsTotal));
+            gradient = UpdateResponseTime(currentTime);
             mStatisticsTotal = 0;
             mStatisticsFailTotal = 0;
+            mStatisticsResponseTotal = 0;
+            mStatisticsResponseTimeMs = 0;
             mLastStatisticsTime = currentTime;
             finishStatistics = true;
         }
@@ -127,7 +189,12 @@ void ConcurrencyLimiter::AdjustConcurrency(bool success, std::chrono::system_clo
     if (finishStatistics) {
         if (failPercentage == 0) {
             // 成功
-            Increase();
+            if (gradient < 1.0) {
+                // 响应时间变长，按梯度回退
+                Decrease(gradient);
+            } else {
+                Increase();
+            }
         } else if (failPercentage <= NO_FALL_BACK_FAIL_PERCENTAGE) {
             // 不调整
         } else if (failPercentage <= SLOW_FALL_BACK_FAIL_PERCENTAGE) {
@@ -140,5 +207,30 @@ void ConcurrencyLimiter::AdjustConcurrency(bool success, std::chrono::system_clo
     }
 }
 
+double ConcurrencyLimiter::UpdateResponseTime(std::chrono::system_clock::time_point currentTime) {
+    if (mStatisticsResponseTotal == 0) {
+        return 1.0;
+    }
+    mRecentResponseTimeMs = static_cast<double>(mStatisticsResponseTimeMs) / mStatisticsResponseTotal;
+    if (mMinResponseTimeMs == 0.0 || mRecentResponseTimeMs < mMinResponseTimeMs
+        || chrono::duration_cast<chrono::seconds>(currentTime - mMinResponseTimeUpdateTime).count()
+            > INT32_FLAG(concurrency_min_response_time_reset_interval_sec)) {
+        mMinResponseTimeMs = mRecentResponseTimeMs;
+        mMinResponseTimeUpdateTime = currentTime;
+    }
+    SET_GAUGE(mMinResponseTime, static_cast<uint64_t>(mMinResponseTimeMs));
+    SET_GAUGE(mRecentResponseTime, static_cast<uint64_t>(mRecentResponseTimeMs));
+    if (!BOOL_FLAG(enable_concurrency_response_time_limit)) {
+        return 1.0;
+    }
+    double gradient = mMinResponseTimeMs * DOUBLE_FLAG(concurrency_response_time_tolerance) / mRecentResponseTimeMs;
+    if (gradient < 1.0) {
+        LOG_DEBUG(sLogger,
+                  ("response time increases, type", mDescription)("min response time ms", mMinResponseTimeMs)(
+                      "recent response time ms", mRecentResponseTimeMs));
+    }
+    return min(max(gradient, kMinResponseTimeGradient), 1.0);
+}
+
 
 } // namespace logtail
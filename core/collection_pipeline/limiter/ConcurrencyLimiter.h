@@ -25,27 +25,29 @@
 
 #include "app_config/AppConfig.h"
 #include "monitor/metric_constants/MetricConstants.h"
+#include "monitor/metric_models/MetricRecord.h"
 
 namespace logtail {
+
+// ConcurrencyLimiter adjusts the concurrency of sending requests by both the fail percentage and the response time.
+// Failures fall back the limit as before. When no request fails, the limit is scaled by the gradient between the
+// minimum and the recent response time (gradient2 style), so that queuing delay in the backend is bounded to
+// concurrency_response_time_tolerance times the minimum response time, even if requests do not fail.
 class ConcurrencyLimiter {
 public:
     ConcurrencyLimiter(const std::string& description,
                        uint32_t maxConcurrency,
                        uint32_t minConcurrency = 1,
                        double concurrencyFastFallBackRatio = 0.5,
-                       double concurrencySlowFallBackRatio = 0.8)
-        : mDescription(description),
-          mMaxConcurrency(maxConcurrency),
-          mMinConcurrency(minConcurrency),
-          mCurrenctConcurrency(maxConcurrency),
-          mConcurrencyFastFallBackRatio(concurrencyFastFallBackRatio),
-          mConcurrencySlowFallBackRatio(concurrencySlowFallBackRatio) {}
+                       double concurrencySlowFallBackRatio = 0.8);
 
     bool IsValidToPop();
     void PostPop();
     void OnSendDone();
 
-    void OnSuccess(std::chrono::system_clock::time_point currentTime);
+    // @responseTime: time from sending the request to receiving the response, zero if not measured.
+    void OnSuccess(std::chrono::system_clock::time_point currentTime,
+                   std::chrono::milliseconds responseTime = std::chrono::milliseconds::zero());
     void OnFail(std::chrono::system_clock::time_point currentTime);
 
 
@@ -67,6 +69,8 @@ public:
     void SetInSendingCount(uint32_t count);
     uint32_t GetInSendingCount() const;
     uint32_t GetStatisticThreshold() const;
+    double GetMinResponseTimeMs() const;
+    double GetRecentResponseTimeMs() const;
 
 #endif
 
@@ -90,10 +94,26 @@ private:
     std::chrono::system_clock::time_point mLastStatisticsTime;
     uint32_t mStatisticsTotal = 0;
     uint32_t mStatisticsFailTotal = 0;
+    uint32_t mStatisticsResponseTotal = 0;
+    int64_t mStatisticsResponseTimeMs = 0;
+
+    // the minimum is reset to the recent one periodically to follow changes of the backend
+    double mMinResponseTimeMs = 0.0;
+    std::chrono::system_clock::time_point mMinResponseTimeUpdateTime;
+    double mRecentResponseTimeMs = 0.0;
+
+    MetricsRecordRef mMetricsRecordRef;
+    IntGaugePtr mConcurrencyLimit;
+    IntGaugePtr mMinResponseTime;
+    IntGaugePtr mRecentResponseTime;
 
     void Increase();
     void Decrease(double fallBackRatio);
-    void AdjustConcurrency(bool success, std::chrono::system_clock::time_point currentTime);
+    void AdjustConcurrency(bool success,
+                           std::chrono::system_clock::time_point currentTime,
+                           std::chrono::milliseconds responseTime);
+    // @return gradient in (0, 1] to scale the limit, 1 if the response time does not indicate queuing.
+    double UpdateResponseTime(std::chrono::system_clock::time_point currentTime);
 };
 
 } // namespace logtail
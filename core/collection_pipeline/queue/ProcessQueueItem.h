@@ -20,6 +20,8 @@
 #include <memory>
 
 #include "collection_pipeline/CollectionPipelineManager.h"
+#include "collection_pipeline/queue/QueueKey.h"
+#include "common/memory/MemoryBudget.h"
 #include "models/PipelineEventGroup.h"
 
 namespace logtail {
@@ -33,6 +35,21 @@ struct ProcessQueueItem {
     std::chrono::system_clock::time_point mEnqueTime;
 
     ProcessQueueItem(PipelineEventGroup&& group, size_t index) : mEventGroup(std::move(group)), mInputIndex(index) {}
+    ~ProcessQueueItem() {
+        if (mBudgetBytes > 0) {
+            MemoryBudget::GetInstance()->ReleaseForPipeline(mBudgetKey, mBudgetBytes);
+        }
+    }
+
+    // charges the memory held by the event group to the pipeline until the item is destructed
+    void ChargeMemoryBudget(QueueKey key) {
+        if (mBudgetBytes > 0 || !mEventGroup.GetSourceBuffer()) {
+            return;
+        }
+        mBudgetKey = key;
+        mBudgetBytes = mEventGroup.GetSourceBuffer()->GetAllocatedSize();
+        MemoryBudget::GetInstance()->AllocateForPipeline(mBudgetKey, mBudgetBytes);
+    }
 
     void AddPipelineInProcessCnt(const std::string& configName) {
         const auto& p = CollectionPipelineManager::GetInstance()->FindConfigByName(configName);
@@ -40,6 +57,10 @@ struct ProcessQueueItem {
             p->AddInProcessCnt();
         }
     }
+
+private:
+    QueueKey mBudgetKey = 0;
+    int64_t mBudgetBytes = 0;
 };
 
 } // namespace logtail
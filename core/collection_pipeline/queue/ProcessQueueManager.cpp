@@ -19,6 +19,7 @@
 #include "collection_pipeline/queue/ExactlyOnceQueueManager.h"
 #include "collection_pipeline/queue/QueueKeyManager.h"
 #include "common/Flags.h"
+#include "common/memory/MemoryBudget.h"
 
 DEFINE_FLAG_INT32(bounded_process_queue_capacity, "", 5);
 
@@ -99,6 +100,9 @@ bool ProcessQueueManager::DeleteQueue(QueueKey key) {
 }
 
 bool ProcessQueueManager::IsValidToPush(QueueKey key) const {
+    if (!MemoryBudget::GetInstance()->IsValidToPush(key)) {
+        return false;
+    }
     lock_guard<mutex> lock(mQueueMux);
     auto iter = mQueues.find(key);
     if (iter != mQueues.end()) {
@@ -112,6 +116,7 @@ bool ProcessQueueManager::IsValidToPush(QueueKey key) const {
 }
 
 QueueStatus ProcessQueueManager::PushQueue(QueueKey key, unique_ptr<ProcessQueueItem>&& item) {
+    item->ChargeMemoryBudget(key);
     {
         lock_guard<mutex> lock(mQueueMux);
         auto iter = mQueues.find(key);
@@ -131,13 +136,48 @@ QueueStatus ProcessQueueManager::PushQueue(QueueKey key, unique_ptr<ProcessQueue
 }
 
 bool ProcessQueueManager::PopItem(int64_t threadNo, unique_ptr<ProcessQueueItem>& item, string& configName) {
+    vector<unique_ptr<ProcessQueueItem>> items;
+    if (!PopItems(threadNo, 1, 0, items, configName)) {
+        return false;
+    }
+    item = std::move(items.front());
+    return true;
+}
+
+// pops the first item from the queue and then keeps draining it until maxCount items or maxBytes bytes are taken
+static bool PopFromQueue(ProcessQueueInterface& que,
+                         size_t maxCount,
+                         size_t maxBytes,
+                         vector<unique_ptr<ProcessQueueItem>>& items) {
+    unique_ptr<ProcessQueueItem> item;
+    if (!que.Pop(item)) {
+        return false;
+    }
+    if (maxCount <= 1) {
+        items.emplace_back(std::move(item));
+        return true;
+    }
+    size_t bytes = item->mEventGroup.DataSize();
+    items.emplace_back(std::move(item));
+    for (size_t cnt = 1; cnt < maxCount && bytes < maxBytes && que.Pop(item); ++cnt) {
+        bytes += item->mEventGroup.DataSize();
+        items.emplace_back(std::move(item));
+    }
+    return true;
+}
+
+bool ProcessQueueManager::PopItems(int64_t threadNo,
+                                   size_t maxCount,
+                                   size_t maxBytes,
+                                   vector<unique_ptr<ProcessQueueItem>>& items,
+                                   string& configName) {
     configName.clear();
     lock_guard<mutex> lock(mQueueMux);
     for (size_t i = 0; i <= sMaxPriority; ++i) {
         ProcessQueueIterator iter;
         if (mCurrentQueueIndex.first == i) {
             for (iter = mCurrentQueueIndex.second; iter != mPriorityQueue[i].end(); ++iter) {
-                if (!(*iter)->Pop(item)) {
+                if (!PopFromQueue(**iter, maxCount, maxBytes, items)) {
                     continue;
                 }
                 configName = (*iter)->GetConfigName();
@@ -145,7 +185,7 @@ bool ProcessQueueManager::PopItem(int64_t threadNo, unique_ptr<ProcessQueueItem>
             }
             if (configName.empty()) {
                 for (iter = mPriorityQueue[i].begin(); iter != mCurrentQueueIndex.second; ++iter) {
-                    if (!(*iter)->Pop(item)) {
+                    if (!PopFromQueue(**iter, maxCount, maxBytes, items)) {
                         continue;
                     }
                     configName = (*iter)->GetConfigName();
@@ -154,7 +194,7 @@ bool ProcessQueueManager::PopItem(int64_t threadNo, unique_ptr<ProcessQueueItem>
             }
         } else {
             for (iter = mPriorityQueue[i].begin(); iter != mPriorityQueue[i].end(); ++iter) {
-                if (!(*iter)->Pop(item)) {
+                if (!PopFromQueue(**iter, maxCount, maxBytes, items)) {
                     continue;
                 }
                 configName = (*iter)->GetConfigName();
@@ -179,7 +219,8 @@ bool ProcessQueueManager::PopItem(int64_t threadNo, unique_ptr<ProcessQueueItem>
                 if (iter->GetKey() % INT32_FLAG(process_thread_count) != threadNo) {
                     continue;
                 }
-                if (!iter->Pop(item)) {
+                // items of exactly once queues are bound to checkpoints, so they are popped one at a time
+                if (!PopFromQueue(*iter, 1, 0, items)) {
                     continue;
                 }
                 configName = iter->GetConfigName();
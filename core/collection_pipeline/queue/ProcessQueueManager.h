@@ -63,6 +63,12 @@ public:
     // 0: success, 1: queue is full, 2: queue not found
     QueueStatus PushQueue(QueueKey key, std::unique_ptr<ProcessQueueItem>&& item);
     bool PopItem(int64_t threadNo, std::unique_ptr<ProcessQueueItem>& item, std::string& configName);
+    // pops up to maxCount items, or until maxBytes is reached, from the same queue, at least one item is popped on success
+    bool PopItems(int64_t threadNo,
+                  size_t maxCount,
+                  size_t maxBytes,
+                  std::vector<std::unique_ptr<ProcessQueueItem>>& items,
+                  std::string& configName);
     bool IsAllQueueEmpty() const;
     bool SetDownStreamQueues(QueueKey key, std::vector<BoundedSenderQueueInterface*>&& ques);
     bool SetFeedbackInterface(QueueKey key, std::vector<FeedbackInterface*>&& feedback);
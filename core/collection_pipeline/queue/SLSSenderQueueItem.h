@@ -18,6 +18,7 @@
 
 #include "checkpoint/RangeCheckpoint.h"
 #include "collection_pipeline/queue/SenderQueueItem.h"
+#include "common/HashUtil.h"
 
 namespace logtail {
 
@@ -51,6 +52,17 @@ struct SLSSenderQueueItem : public SenderQueueItem {
           mExactlyOnceCheckpoint(std::move(exactlyOnceCheckpoint)) {}
 
     SenderQueueItem* Clone() override { return new SLSSenderQueueItem(*this); }
+
+    // md5 of mData is calculated on the first sending, so that retries only need to sign the headers again
+    const std::string& GetContentMd5() {
+        if (mContentMd5.empty()) {
+            mContentMd5 = CalcMD5(mData);
+        }
+        return mContentMd5;
+    }
+
+private:
+    std::string mContentMd5;
 };
 
 } // namespace logtail
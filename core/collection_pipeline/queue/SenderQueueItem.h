@@ -24,6 +24,7 @@
 #include <string>
 
 #include "collection_pipeline/queue/QueueKey.h"
+#include "common/memory/MemoryBudget.h"
 
 namespace logtail {
 
@@ -59,8 +60,10 @@ struct SenderQueueItem {
           mBufferOrNot(bufferOrNot),
           mFlusher(flusher),
           mQueueKey(key),
-          mStatus(SendingStatus::IDLE) {}
-    virtual ~SenderQueueItem() = default;
+          mStatus(SendingStatus::IDLE) {
+        MemoryBudget::GetInstance()->Allocate(mData.size());
+    }
+    virtual ~SenderQueueItem() { MemoryBudget::GetInstance()->Release(mData.size()); }
 
     // for Clone only
     SenderQueueItem(const SenderQueueItem& item)
@@ -74,7 +77,9 @@ struct SenderQueueItem {
           mStatus(item.mStatus.load()),
           mFirstEnqueTime(item.mFirstEnqueTime),
           mLastSendTime(item.mLastSendTime),
-          mTryCnt(item.mTryCnt) {}
+          mTryCnt(item.mTryCnt) {
+        MemoryBudget::GetInstance()->Allocate(mData.size());
+    }
 
     virtual SenderQueueItem* Clone() { return new SenderQueueItem(*this); }
 };
@@ -0,0 +1,164 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+#include <string>
+
+#include "rapidjson/internal/dtoa.h"
+#include "rapidjson/internal/itoa.h"
+
+#include "common/StringView.h"
+
+namespace logtail {
+
+// escape of each byte in a json string, 'u' for \u00XX and 0 for none, the same as rapidjson::Writer
+struct JsonEscapeTable {
+    char mEscape[256] = {};
+
+    constexpr JsonEscapeTable() {
+        for (int i = 0; i < 0x20; ++i) {
+            mEscape[i] = 'u';
+        }
+        mEscape[static_cast<unsigned char>('\b')] = 'b';
+        mEscape[static_cast<unsigned char>('\t')] = 't';
+        mEscape[static_cast<unsigned char>('\n')] = 'n';
+        mEscape[static_cast<unsigned char>('\f')] = 'f';
+        mEscape[static_cast<unsigned char>('\r')] = 'r';
+        mEscape[static_cast<unsigned char>('"')] = '"';
+        mEscape[static_cast<unsigned char>('\\')] = '\\';
+    }
+};
+
+inline constexpr JsonEscapeTable kJsonEscapeTable;
+
+// JsonWriter appends compact json straight to the output string. Keys and values are written from string views with
+// explicit lengths, and runs of bytes needing no escape are copied at once, so no intermediate string is built. For
+// valid input, the output is the same as that of rapidjson::Writer with default flags.
+class JsonWriter {
+public:
+    explicit JsonWriter(std::string& out) : mOut(out) {}
+
+    void StartObject() {
+        Prefix();
+        mOut.push_back('{');
+        mNeedComma = false;
+    }
+
+    void EndObject() {
+        mOut.push_back('}');
+        mNeedComma = true;
+    }
+
+    void StartArray() {
+        Prefix();
+        mOut.push_back('[');
+        mNeedComma = false;
+    }
+
+    void EndArray() {
+        mOut.push_back(']');
+        mNeedComma = true;
+    }
+
+    void Key(StringView key) {
+        Prefix();
+        WriteString(key);
+        mOut.push_back(':');
+        mNeedComma = false;
+    }
+
+    void String(StringView value) {
+        Prefix();
+        WriteString(value);
+        mNeedComma = true;
+    }
+
+    void Uint64(uint64_t value) {
+        Prefix();
+        char buffer[20];
+        mOut.append(buffer, rapidjson::internal::u64toa(value, buffer) - buffer);
+        mNeedComma = true;
+    }
+
+    void Int64(int64_t value) {
+        Prefix();
+        char buffer[21];
+        mOut.append(buffer, rapidjson::internal::i64toa(value, buffer) - buffer);
+        mNeedComma = true;
+    }
+
+    void Double(double value) {
+        Prefix();
+        // rapidjson::Writer fails on them, leaving the key without a value
+        if (!std::isfinite(value)) {
+            mOut.append("null", 4);
+        } else {
+            char buffer[25];
+            mOut.append(buffer, rapidjson::internal::dtoa(value, buffer) - buffer);
+        }
+        mNeedComma = true;
+    }
+
+    // appends key value pairs written by another JsonWriter without an enclosing object
+    void Fields(const std::string& fields) {
+        if (fields.empty()) {
+            return;
+        }
+        Prefix();
+        mOut.append(fields);
+        mNeedComma = true;
+    }
+
+private:
+    void Prefix() {
+        if (mNeedComma) {
+            mOut.push_back(',');
+        }
+    }
+
+    void WriteString(StringView value) {
+        static const char kHex[] = "0123456789ABCDEF";
+        mOut.push_back('"');
+        const char* run = value.data();
+        const char* end = value.data() + value.size();
+        for (const char* p = run; p != end; ++p) {
+            char escape = kJsonEscapeTable.mEscape[static_cast<unsigned char>(*p)];
+            if (escape == 0) {
+                continue;
+            }
+            mOut.append(run, p - run);
+            mOut.push_back('\\');
+            mOut.push_back(escape);
+            if (escape == 'u') {
+                mOut.append("00", 2);
+                mOut.push_back(kHex[static_cast<unsigned char>(*p) >> 4]);
+                mOut.push_back(kHex[static_cast<unsigned char>(*p) & 0xF]);
+            }
+            run = p + 1;
+        }
+        mOut.append(run, end - run);
+        mOut.push_back('"');
+    }
+
+    std::string& mOut;
+    bool mNeedComma = false;
+};
+
+} // namespace logtail
@@ -14,11 +14,12 @@
 
 #include "collection_pipeline/serializer/SLSSerializer.h"
 
-#include <array>
+#include <iterator>
 
-#include "json/json.h"
+#include "spdlog/fmt/fmt.h"
 
 #include "collection_pipeline/serializer/JsonSerializer.h"
+#include "collection_pipeline/serializer/JsonWriter.h"
 #include "common/Flags.h"
 #include "common/compression/CompressType.h"
 #include "constants/SpanConstants.h"
@@ -33,29 +34,151 @@ using namespace std;
 
 namespace logtail {
 
-std::string SerializeSpanLinksToString(const SpanEvent& event) {
-    if (event.GetLinks().empty()) {
-        return "";
+namespace {
+
+// SLSSerializerContext holds the per thread caches of SLSEventGroupSerializer. They are kept across batches, so that
+// sizing a log group needs no allocation once their capacities are large enough.
+class SLSSerializerContext {
+public:
+    void Reset(size_t eventCnt) {
+        mLogSZ.assign(eventCnt, 0);
+        mMetricLabelSZ.assign(eventCnt, 0);
+        mValues.clear();
+        mCursor = 0;
+        // a scratch buffer grown by an unusually large batch is not kept
+        if (mScratch.capacity() > kMaxRetainedScratchSize) {
+            string().swap(mScratch);
+        } else {
+            mScratch.clear();
+        }
+    }
+
+    // content values that do not exist in events, e.g., formatted numbers and span attributes, are written to the
+    // scratch buffer between StartValue and EndValue during sizing, and then read back in the same order during
+    // serialization. Values are referred to by offset, since the buffer may be reallocated as it grows.
+    string& StartValue() {
+        mValueStart = mScratch.size();
+        return mScratch;
+    }
+
+    size_t EndValue() {
+        mValues.emplace_back(mValueStart, mScratch.size() - mValueStart);
+        return mValues.back().second;
+    }
+
+    StringView NextValue() {
+        const auto& value = mValues[mCursor++];
+        return StringView(mScratch.data() + value.first, value.second);
+    }
+
+    vector<size_t> mLogSZ;
+    vector<size_t> mMetricLabelSZ;
+
+private:
+    static constexpr size_t kMaxRetainedScratchSize = 1024 * 1024;
+
+    string mScratch;
+    vector<pair<size_t, size_t>> mValues;
+    size_t mValueStart = 0;
+    size_t mCursor = 0;
+};
+
+void AppendUInt64(uint64_t value, string& out) {
+    char buffer[20];
+    out.append(buffer, rapidjson::internal::u64toa(value, buffer) - buffer);
+}
+
+void WriteJsonTags(std::map<StringView, StringView>::const_iterator begin,
+                   std::map<StringView, StringView>::const_iterator end,
+                   JsonWriter& writer) {
+    for (auto it = begin; it != end; ++it) {
+        writer.Key(it->first);
+        writer.String(it->second);
+    }
+}
+
+// the following functions produce the same json values as jsoncpp does for SpanEvent::ToJson, only compact, i.e., keys
+// are sorted, and an object without any member is null.
+
+void WriteSpanAttributes(const SpanEvent& e, string& out) {
+    if (e.TagsSize() == 0 && e.ScopeTagsSize() == 0) {
+        out.append("null");
+        return;
     }
-    Json::Value jsonLinks(Json::arrayValue);
-    for (const auto& link : event.GetLinks()) {
-        jsonLinks.append(link.ToJson());
+    JsonWriter writer(out);
+    writer.StartObject();
+    // both are sorted, so they are merged in order, and scope tags take precedence over tags with the same key
+    auto tag = e.TagsBegin();
+    auto scopeTag = e.ScopeTagsBegin();
+    while (tag != e.TagsEnd() || scopeTag != e.ScopeTagsEnd()) {
+        if (scopeTag == e.ScopeTagsEnd() || (tag != e.TagsEnd() && tag->first < scopeTag->first)) {
+            writer.Key(tag->first);
+            writer.String(tag->second);
+            ++tag;
+            continue;
+        }
+        if (tag != e.TagsEnd() && tag->first == scopeTag->first) {
+            ++tag;
+        }
+        writer.Key(scopeTag->first);
+        writer.String(scopeTag->second);
+        ++scopeTag;
     }
-    Json::StreamWriterBuilder writer;
-    return Json::writeString(writer, jsonLinks);
+    writer.EndObject();
 }
-std::string SerializeSpanEventsToString(const SpanEvent& event) {
-    if (event.GetEvents().empty()) {
-        return "";
+
+void WriteSpanLinks(const SpanEvent& e, string& out) {
+    if (e.GetLinks().empty()) {
+        return;
     }
-    Json::Value jsonEvents(Json::arrayValue);
-    for (const auto& event : event.GetEvents()) {
-        jsonEvents.append(event.ToJson());
+    JsonWriter writer(out);
+    writer.StartArray();
+    for (const auto& link : e.GetLinks()) {
+        writer.StartObject();
+        if (link.TagsSize() > 0) {
+            writer.Key(DEFAULT_TRACE_TAG_ATTRIBUTES);
+            writer.StartObject();
+            WriteJsonTags(link.TagsBegin(), link.TagsEnd(), writer);
+            writer.EndObject();
+        }
+        writer.Key(DEFAULT_TRACE_TAG_SPAN_ID);
+        writer.String(link.GetSpanId());
+        writer.Key(DEFAULT_TRACE_TAG_TRACE_ID);
+        writer.String(link.GetTraceId());
+        if (!link.GetTraceState().empty()) {
+            writer.Key(DEFAULT_TRACE_TAG_TRACE_STATE);
+            writer.String(link.GetTraceState());
+        }
+        writer.EndObject();
     }
-    Json::StreamWriterBuilder writer;
-    return Json::writeString(writer, jsonEvents);
+    writer.EndArray();
 }
 
+void WriteSpanEvents(const SpanEvent& e, string& out) {
+    if (e.GetEvents().empty()) {
+        return;
+    }
+    JsonWriter writer(out);
+    writer.StartArray();
+    for (const auto& event : e.GetEvents()) {
+        writer.StartObject();
+        if (event.TagsSize() > 0) {
+            writer.Key(DEFAULT_TRACE_TAG_ATTRIBUTES);
+            writer.StartObject();
+            WriteJsonTags(event.TagsBegin(), event.TagsEnd(), writer);
+            writer.EndObject();
+        }
+        writer.Key(DEFAULT_TRACE_TAG_SPAN_EVENT_NAME);
+        writer.String(event.GetName());
+        writer.Key(DEFAULT_TRACE_TAG_TIMESTAMP);
+        writer.Int64(static_cast<int64_t>(event.GetTimestampNs()));
+        writer.EndObject();
+    }
+    writer.EndArray();
+}
+
+} // namespace
+
 template <>
 bool Serializer<vector<CompressedLogGroup>>::DoSerialize(vector<CompressedLogGroup>&& p,
                                                          std::string& output,
@@ -97,9 +220,9 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
     bool enableNs = mFlusher->GetContext().GetGlobalConfig().mEnableTimestampNanosecond;
 
     // caculate serialized logGroup size first, where some critical results can be cached
-    vector<size_t> logSZ(group.mEvents.size());
-    vector<pair<string, size_t>> metricEventContentCache(group.mEvents.size());
-    vector<array<string, 6>> spanEventContentCache(group.mEvents.size());
+    thread_local SLSSerializerContext ctx;
+    ctx.Reset(group.mEvents.size());
+    auto& logSZ = ctx.mLogSZ;
     size_t logGroupSZ = 0;
     switch (eventType) {
         case PipelineEvent::Type::LOG: {
@@ -125,8 +248,11 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
                                     "timestamp", e.GetTimestamp())("config", mFlusher->GetContext().GetConfigName()));
                     continue;
                 }
+                size_t valueSZ = 0;
                 if (e.Is<UntypedSingleValue>()) {
-                    metricEventContentCache[i].first = to_string(e.GetValue<UntypedSingleValue>()->mValue);
+                    // same as to_string
+                    fmt::format_to(back_inserter(ctx.StartValue()), "{:.6f}", e.GetValue<UntypedSingleValue>()->mValue);
+                    valueSZ = ctx.EndValue();
                 } else {
                     // untyped multi value is not supported
                     LOG_WARNING(sLogger,
@@ -134,15 +260,14 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
                                                                                mFlusher->GetContext().GetConfigName()));
                     continue;
                 }
-                metricEventContentCache[i].second = GetMetricLabelSize(e);
+                ctx.mMetricLabelSZ[i] = GetMetricLabelSize(e);
 
                 size_t contentSZ = 0;
                 contentSZ += GetLogContentSize(METRIC_RESERVED_KEY_NAME.size(), e.GetName().size());
-                contentSZ
-                    += GetLogContentSize(METRIC_RESERVED_KEY_VALUE.size(), metricEventContentCache[i].first.size());
+                contentSZ += GetLogContentSize(METRIC_RESERVED_KEY_VALUE.size(), valueSZ);
                 contentSZ
                     += GetLogContentSize(METRIC_RESERVED_KEY_TIME_NANO.size(), e.GetTimestampNanosecond() ? 19U : 10U);
-                contentSZ += GetLogContentSize(METRIC_RESERVED_KEY_LABELS.size(), metricEventContentCache[i].second);
+                contentSZ += GetLogContentSize(METRIC_RESERVED_KEY_LABELS.size(), ctx.mMetricLabelSZ[i]);
                 logGroupSZ += GetLogSize(contentSZ, false, logSZ[i]);
             }
             break;
@@ -161,34 +286,20 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
                 contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_TRACE_STATE.size(), e.GetTraceState().size());
 
                 // set tags and scope tags
-                Json::Value jsonVal;
-                for (auto it = e.TagsBegin(); it != e.TagsEnd(); ++it) {
-                    jsonVal[it->first.to_string()] = it->second.to_string();
-                }
-                for (auto it = e.ScopeTagsBegin(); it != e.ScopeTagsEnd(); ++it) {
-                    jsonVal[it->first.to_string()] = it->second.to_string();
-                }
-                Json::StreamWriterBuilder writer;
-                std::string attrString = Json::writeString(writer, jsonVal);
-                contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_ATTRIBUTES.size(), attrString.size());
-                spanEventContentCache[i][0] = std::move(attrString);
-                auto linkString = SerializeSpanLinksToString(e);
-                contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_LINKS.size(), linkString.size());
-                spanEventContentCache[i][1] = std::move(linkString);
-                auto eventString = SerializeSpanEventsToString(e);
-                contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_EVENTS.size(), eventString.size());
-                spanEventContentCache[i][2] = std::move(eventString);
+                WriteSpanAttributes(e, ctx.StartValue());
+                contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_ATTRIBUTES.size(), ctx.EndValue());
+                WriteSpanLinks(e, ctx.StartValue());
+                contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_LINKS.size(), ctx.EndValue());
+                WriteSpanEvents(e, ctx.StartValue());
+                contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_EVENTS.size(), ctx.EndValue());
 
                 // time related
-                auto startTsNs = std::to_string(e.GetStartTimeNs());
-                contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_START_TIME_NANO.size(), startTsNs.size());
-                spanEventContentCache[i][3] = std::move(startTsNs);
-                auto endTsNs = std::to_string(e.GetEndTimeNs());
-                contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_END_TIME_NANO.size(), endTsNs.size());
-                spanEventContentCache[i][4] = std::move(endTsNs);
-                auto durationNs = std::to_string(e.GetEndTimeNs() - e.GetStartTimeNs());
-                contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_DURATION.size(), durationNs.size());
-                spanEventContentCache[i][5] = std::move(durationNs);
+                AppendUInt64(e.GetStartTimeNs(), ctx.StartValue());
+                contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_START_TIME_NANO.size(), ctx.EndValue());
+                AppendUInt64(e.GetEndTimeNs(), ctx.StartValue());
+                contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_END_TIME_NANO.size(), ctx.EndValue());
+                AppendUInt64(e.GetEndTimeNs() - e.GetStartTimeNs(), ctx.StartValue());
+                contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_DURATION.size(), ctx.EndValue());
                 logGroupSZ += GetLogSize(contentSZ, false, logSZ[i]);
             }
             break;
@@ -251,9 +362,9 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
                 serializer.StartToAddLog(logSZ[i]);
                 serializer.AddLogTime(e.GetTimestamp());
                 e.SortTags();
-                serializer.AddLogContentMetricLabel(e, metricEventContentCache[i].second);
+                serializer.AddLogContentMetricLabel(e, ctx.mMetricLabelSZ[i]);
                 serializer.AddLogContentMetricTimeNano(e);
-                serializer.AddLogContent(METRIC_RESERVED_KEY_VALUE, metricEventContentCache[i].first);
+                serializer.AddLogContent(METRIC_RESERVED_KEY_VALUE, ctx.NextValue());
                 serializer.AddLogContent(METRIC_RESERVED_KEY_NAME, e.GetName());
             }
             break;
@@ -276,17 +387,17 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
                 // trace state
                 serializer.AddLogContent(DEFAULT_TRACE_TAG_TRACE_STATE, spanEvent.GetTraceState());
 
-                serializer.AddLogContent(DEFAULT_TRACE_TAG_ATTRIBUTES, spanEventContentCache[i][0]);
+                serializer.AddLogContent(DEFAULT_TRACE_TAG_ATTRIBUTES, ctx.NextValue());
 
-                serializer.AddLogContent(DEFAULT_TRACE_TAG_LINKS, spanEventContentCache[i][1]);
-                serializer.AddLogContent(DEFAULT_TRACE_TAG_EVENTS, spanEventContentCache[i][2]);
+                serializer.AddLogContent(DEFAULT_TRACE_TAG_LINKS, ctx.NextValue());
+                serializer.AddLogContent(DEFAULT_TRACE_TAG_EVENTS, ctx.NextValue());
 
                 // start_time
-                serializer.AddLogContent(DEFAULT_TRACE_TAG_START_TIME_NANO, spanEventContentCache[i][3]);
+                serializer.AddLogContent(DEFAULT_TRACE_TAG_START_TIME_NANO, ctx.NextValue());
                 // end_time
-                serializer.AddLogContent(DEFAULT_TRACE_TAG_END_TIME_NANO, spanEventContentCache[i][4]);
+                serializer.AddLogContent(DEFAULT_TRACE_TAG_END_TIME_NANO, ctx.NextValue());
                 // duration
-                serializer.AddLogContent(DEFAULT_TRACE_TAG_DURATION, spanEventContentCache[i][5]);
+                serializer.AddLogContent(DEFAULT_TRACE_TAG_DURATION, ctx.NextValue());
             }
             break;
         case PipelineEvent::Type::RAW:
@@ -49,6 +49,7 @@ void CrashBackTrace(int signum) {
     }
     g_crash_process_flag = true;
     if (g_crashBackTraceFilePtr == NULL) {
+        BinaryLogger::GetInstance()->FlushOnCrash();
         _exit(10);
     }
     fprintf(g_crashBackTraceFilePtr, "signal : %d \n", signum);
@@ -86,6 +87,8 @@ void CrashBackTrace(int signum) {
     }
     fflush(g_crashBackTraceFilePtr);
     fclose(g_crashBackTraceFilePtr);
+    // after the back trace is saved, in case it crashes again
+    BinaryLogger::GetInstance()->FlushOnCrash();
     _exit(10);
 }
 #elif defined(_MSC_VER)
@@ -18,6 +18,9 @@
 #include "logger/Logger.h"
 #if defined(__linux__)
 #include <iconv.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 #elif defined(_MSC_VER)
 #include <Windows.h>
 #endif
@@ -25,34 +28,104 @@
 namespace logtail {
 
 #if defined(__linux__)
-static iconv_t mGbk2Utf8Cd = (iconv_t)-1;
+namespace {
+
+const size_t kGbkLeadBegin = 0x81;
+const size_t kGbkLeadEnd = 0xFF;
+const size_t kGbkTrailBegin = 0x40;
+const size_t kGbkTrailEnd = 0xFF;
+
+// UTF-8 of each GBK double-byte character, indexed by (lead, trail), mLen is 0 for invalid ones.
+struct Utf8Char {
+    uint8_t mLen;
+    char mBytes[3];
+};
+
+std::vector<Utf8Char> sGbk2Utf8Table;
+// UTF-8 of single bytes not less than 0x80, e.g. 0x80 is mapped to euro sign by glibc.
+Utf8Char sGbkSingleByteTable[0x80];
+
+// ConvertByIconv converts @in to @entry, @entry is left invalid if @in is not a complete valid character.
+void ConvertByIconv(iconv_t cd, char* in, size_t inLen, Utf8Char& entry) {
+    char out[8];
+    char* outPtr = out;
+    size_t outLeft = sizeof(out);
+    bool succeeded = iconv(cd, &in, &inLen, &outPtr, &outLeft) != (size_t)(-1) && inLen == 0
+        && outPtr - out <= static_cast<long>(sizeof(entry.mBytes));
+    if (succeeded) {
+        entry.mLen = outPtr - out;
+        memcpy(entry.mBytes, out, entry.mLen);
+    }
+    iconv(cd, NULL, NULL, NULL, NULL);
+}
+
+inline size_t GbkIndex(uint8_t lead, uint8_t trail) {
+    return (lead - kGbkLeadBegin) * (kGbkTrailEnd - kGbkTrailBegin) + (trail - kGbkTrailBegin);
+}
+
+// AsciiPrefixLength returns the length of the leading ASCII bytes of [@src, @end).
+inline size_t AsciiPrefixLength(const char* src, const char* end) {
+    const char* p = src;
+#if defined(__SSE2__)
+    for (; end - p >= 16; p += 16) {
+        int mask = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+        if (mask != 0) {
+            return p - src + __builtin_ctz(mask);
+        }
+    }
+#else
+    for (; end - p >= 8; p += 8) {
+        uint64_t word;
+        memcpy(&word, p, sizeof(word));
+        if (word & 0x8080808080808080ULL) {
+            break;
+        }
+    }
+#endif
+    while (p < end && static_cast<uint8_t>(*p) < 0x80) {
+        ++p;
+    }
+    return p - src;
+}
+
+} // namespace
 #endif
 
 EncodingConverter::EncodingConverter() {
 #if defined(__linux__)
-    mGbk2Utf8Cd = iconv_open("UTF-8", "GBK");
-    if (mGbk2Utf8Cd == (iconv_t)(-1))
+    // The table is built from iconv once, so that the conversion keeps the same mapping as iconv without calling it.
+    iconv_t cd = iconv_open("UTF-8", "GBK");
+    if (cd == (iconv_t)(-1)) {
         LOG_ERROR(sLogger, ("create Gbk2Utf8 iconv descriptor fail, errno", strerror(errno)));
-    else
-        iconv(mGbk2Utf8Cd, NULL, NULL, NULL, NULL);
+        return;
+    }
+    sGbk2Utf8Table.resize((kGbkLeadEnd - kGbkLeadBegin) * (kGbkTrailEnd - kGbkTrailBegin));
+    for (size_t lead = kGbkLeadBegin; lead < kGbkLeadEnd; ++lead) {
+        for (size_t trail = kGbkTrailBegin; trail < kGbkTrailEnd; ++trail) {
+            char in[2] = {static_cast<char>(lead), static_cast<char>(trail)};
+            ConvertByIconv(cd, in, sizeof(in), sGbk2Utf8Table[GbkIndex(lead, trail)]);
+        }
+    }
+    for (size_t byte = 0x80; byte <= 0xFF; ++byte) {
+        char in = static_cast<char>(byte);
+        ConvertByIconv(cd, &in, 1, sGbkSingleByteTable[byte - 0x80]);
+    }
+    iconv_close(cd);
 #endif
 }
 
 EncodingConverter::~EncodingConverter() {
-#if defined(__linux__)
-    if (mGbk2Utf8Cd != (iconv_t)(-1))
-        iconv_close(mGbk2Utf8Cd);
-#endif
 }
 
 // TODO: Refactor it, do not use the output params to do calculations, set them before return.
 size_t EncodingConverter::ConvertGbk2Utf8(
     const char* src, size_t* srcLength, char* desOut, size_t desLength, const std::vector<long>& linePosVec) const {
 #if defined(__linux__)
-    if (src == NULL || *srcLength == 0 || mGbk2Utf8Cd == (iconv_t)(-1)) {
-        LOG_ERROR(sLogger, ("invalid iconv descriptor fail or invalid buffer pointer, cd", mGbk2Utf8Cd));
+    if (src == NULL || *srcLength == 0 || sGbk2Utf8Table.empty()) {
+        LOG_ERROR(sLogger, ("invalid GBK table or invalid buffer pointer, table size", sGbk2Utf8Table.size()));
         return 0;
     }
+    // a double-byte character is 3 bytes at most in UTF-8
     size_t maxRequire = *srcLength * 2;
     if (desOut == nullptr) {
         return maxRequire;
@@ -60,35 +133,54 @@ size_t EncodingConverter::ConvertGbk2Utf8(
     if (desLength < maxRequire + 1) {
         return 0;
     }
+    const char* srcBegin = src;
+    const char* srcEnd = src + *srcLength;
     char* des = desOut;
-    des[*srcLength * 2] = '\0';
-    const char* originSrc = src;
-    char* originDes = des;
-    size_t beginIndex = 0;
-    size_t endIndex = *srcLength;
-    size_t destIndex = 0;
-    size_t maxDestSize = desLength;
-    for (size_t i = 0; i < linePosVec.size(); ++i) {
-        endIndex = linePosVec[i];
-        src = originSrc + beginIndex;
-        des = originDes + destIndex;
-        // include '\n'
-        *srcLength = endIndex - beginIndex + 1;
-        desLength = maxDestSize - destIndex;
-        size_t ret = iconv(mGbk2Utf8Cd, const_cast<char**>(&src), srcLength, &des, &desLength);
-        if (ret == (size_t)(-1)) {
-            LOG_ERROR(sLogger, ("convert GBK to UTF8 fail, errno", strerror(errno)));
-            iconv(mGbk2Utf8Cd, NULL, NULL, NULL, NULL); // Clear status.
-            AlarmManager::GetInstance()->SendAlarm(ENCODING_CONVERT_ALARM, "convert GBK to UTF8 fail");
-            // use memcpy
-            memcpy(originDes + destIndex, originSrc + beginIndex, endIndex - beginIndex + 1);
-            destIndex += endIndex - beginIndex + 1;
-        } else {
-            destIndex = des - originDes;
+    while (src < srcEnd) {
+        size_t asciiLen = AsciiPrefixLength(src, srcEnd);
+        memcpy(des, src, asciiLen);
+        src += asciiLen;
+        des += asciiLen;
+        if (src == srcEnd) {
+            break;
+        }
+        uint8_t lead = *src;
+        if (lead >= kGbkLeadBegin && lead < kGbkLeadEnd && src + 1 < srcEnd
+            && static_cast<uint8_t>(src[1]) >= kGbkTrailBegin && static_cast<uint8_t>(src[1]) < kGbkTrailEnd) {
+            const Utf8Char& ch = sGbk2Utf8Table[GbkIndex(lead, src[1])];
+            if (ch.mLen > 0) {
+                memcpy(des, ch.mBytes, sizeof(ch.mBytes));
+                des += ch.mLen;
+                src += 2;
+                continue;
+            }
+        }
+        // a single byte may expand to 3 bytes, it is converted only if twice the size of the remaining input still
+        // fits in @maxRequire, otherwise it is treated as invalid
+        const Utf8Char& single = sGbkSingleByteTable[lead - 0x80];
+        if (single.mLen > 0 && static_cast<size_t>(des - desOut) + single.mLen + 2 * (srcEnd - src - 1) <= maxRequire) {
+            memcpy(des, single.mBytes, sizeof(single.mBytes));
+            des += single.mLen;
+            ++src;
+            continue;
         }
-        beginIndex = endIndex + 1;
+        // '\n' never appears in a double-byte character, so the line containing the invalid sequence can be found by
+        // '\n' both in source and destination, and it is copied without converting
+        LOG_ERROR(sLogger, ("convert GBK to UTF8 fail, invalid sequence at", src - srcBegin));
+        AlarmManager::GetInstance()->SendAlarm(ENCODING_CONVERT_ALARM, "convert GBK to UTF8 fail");
+        const char* lineBegin = static_cast<const char*>(memrchr(srcBegin, '\n', src - srcBegin));
+        lineBegin = lineBegin == nullptr ? srcBegin : lineBegin + 1;
+        char* desLineBegin = static_cast<char*>(memrchr(desOut, '\n', des - desOut));
+        desLineBegin = desLineBegin == nullptr ? desOut : desLineBegin + 1;
+        const char* lineEnd = static_cast<const char*>(memchr(src, '\n', srcEnd - src));
+        lineEnd = lineEnd == nullptr ? srcEnd : lineEnd + 1;
+        memcpy(desLineBegin, lineBegin, lineEnd - lineBegin);
+        des = desLineBegin + (lineEnd - lineBegin);
+        src = lineEnd;
     }
-    return destIndex;
+    *des = '\0';
+    *srcLength = 0;
+    return des - desOut;
 
 #elif defined(_MSC_VER)
     int wcLen = MultiByteToWideChar(CP_ACP, 0, src, *srcLength, NULL, 0);
@@ -48,9 +48,9 @@ public:
     //          This API design mimics snprintf.
     //
     // Different platforms have different implementations:
-    // - For Linux, ConvertGbk2Utf8 converts line by line according to @linePosVec.
-    //   If there is error happened during converting, corresponding line will be copied
-    //   to @des without converting.
+    // - For Linux, ConvertGbk2Utf8 converts whole @src by a table built from iconv, with an ASCII fast path.
+    //   If there is error happened during converting, the line containing it will be copied
+    //   to @des without converting. @linePosVec is ignored since lines are found by '\n' directly.
     // - For Windows, ConvertGbk2Utf8 converts whole @src, if any errors happened,
     //   0 will be returned (ignore @linePosVec).
     size_t ConvertGbk2Utf8(
@@ -22,9 +22,14 @@
 #include <direct.h>
 #include <fcntl.h>
 #elif defined(__linux__)
+#include <fcntl.h>
 #include <fnmatch.h>
 #include <sys/statvfs.h>
+#include <sys/syscall.h>
+#include <sys/sysmacros.h>
+#include <unistd.h>
 #endif
+#include <atomic>
 #include <fstream>
 
 #include "boost/filesystem.hpp"
@@ -636,6 +641,35 @@ bool PathStat::stat(const std::string& path, PathStat& ps) {
 #endif
 }
 
+#if defined(__linux__)
+bool PathStat::statat(int dirFd, const char* name, PathStat& ps) {
+#if defined(SYS_statx) && defined(STATX_TYPE)
+    // statx is called by syscall to keep compatible with old glibc, ENOSYS means the kernel is older than 4.11.
+    static std::atomic_bool sStatxUnsupported(false);
+    if (!sStatxUnsupported.load(std::memory_order_relaxed)) {
+        struct statx stx;
+        if (0
+            == syscall(
+                SYS_statx, dirFd, name, 0, STATX_TYPE | STATX_MODE | STATX_INO | STATX_SIZE | STATX_MTIME, &stx)) {
+            memset(&ps.mRawStat, 0, sizeof(ps.mRawStat));
+            ps.mRawStat.st_mode = stx.stx_mode;
+            ps.mRawStat.st_dev = makedev(stx.stx_dev_major, stx.stx_dev_minor);
+            ps.mRawStat.st_ino = stx.stx_ino;
+            ps.mRawStat.st_size = stx.stx_size;
+            ps.mRawStat.st_mtim.tv_sec = stx.stx_mtime.tv_sec;
+            ps.mRawStat.st_mtim.tv_nsec = stx.stx_mtime.tv_nsec;
+            return true;
+        }
+        if (errno != ENOSYS) {
+            return false;
+        }
+        sStatxUnsupported.store(true, std::memory_order_relaxed);
+    }
+#endif
+    return 0 == ::fstatat(dirFd, name, &(ps.mRawStat), 0);
+}
+#endif
+
 bool PathStat::IsDir() const {
 #if defined(__linux__)
     return S_ISDIR(mRawStat.st_mode);
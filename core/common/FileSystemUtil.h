@@ -244,6 +244,13 @@ public:
     bool IsDir() const;
     bool IsRegFile() const;
 
+#if defined(__linux__)
+    // statat stats @name relative to the directory @dirFd, following symbolic links, so that the kernel needn't
+    // resolve the whole path. statx is used when available to ask only for type, mode, dev, inode, size and mtime,
+    // other fields are left zero.
+    static bool statat(int dirFd, const char* name, PathStat& ps);
+#endif
+
     // lstat wrappers Linux ::lstat and implements it with ::stat on Windows.
     static bool lstat(const std::string& path, PathStat& ps);
     bool IsLink() const;
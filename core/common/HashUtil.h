@@ -23,7 +23,6 @@
 namespace logtail {
 
 // Hash(string(@poolIn, @inputBytesNum)) => @md5.
-// TODO: Same implementation in sdk module, merge them.
 void DoMd5(const uint8_t* poolIn, const uint64_t inputBytesNum, uint8_t md5[16]);
 std::string CalcMD5(const std::string& message);
 
@@ -0,0 +1,148 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/memory/ChunkPool.h"
+
+#include <algorithm>
+
+#include "common/Flags.h"
+
+DEFINE_FLAG_BOOL(enable_chunk_pool, "recycle memory chunks of event groups instead of freeing them", true);
+DEFINE_FLAG_INT32(chunk_pool_thread_cache_size_kb, "max size of free chunks cached by each thread, kb", 2048);
+DEFINE_FLAG_INT32(chunk_pool_shared_cache_size_mb, "max size of free chunks shared by all threads, mb", 32);
+
+using namespace std;
+
+namespace logtail {
+
+// chunks taken from the shared cache at a time when the thread cache is empty
+static constexpr size_t kRefillBytes = 256 * 1024;
+
+class ChunkPool::ThreadCache {
+public:
+    ThreadCache() : mPool(ChunkPool::GetInstance()) {}
+    ~ThreadCache() {
+        for (size_t i = 1; i < kSizeClassCnt; ++i) {
+            if (!mChunks[i].empty()) {
+                mPool->ReleaseToShared(mChunks[i], i);
+            }
+        }
+        sDestroyed = true;
+    }
+
+    ChunkPool* mPool = nullptr;
+    vector<uint8_t*> mChunks[kSizeClassCnt];
+    size_t mCachedBytes = 0;
+
+    // chunks released by other thread local objects during thread exit are freed directly
+    static thread_local bool sDestroyed;
+};
+
+thread_local bool ChunkPool::ThreadCache::sDestroyed = false;
+
+ChunkPool::~ChunkPool() {
+    for (auto& shared : mSharedCaches) {
+        for (auto chunk : shared.mChunks) {
+            delete[] chunk;
+        }
+    }
+}
+
+ChunkPool::ThreadCache& ChunkPool::GetThreadCache() {
+    static thread_local ThreadCache sCache;
+    return sCache;
+}
+
+uint8_t* ChunkPool::Acquire(size_t& size) {
+    if (!BOOL_FLAG(enable_chunk_pool) || size > kMaxPooledChunkSize || ThreadCache::sDestroyed) {
+        mMissCnt.fetch_add(1, memory_order_relaxed);
+        return new uint8_t[size];
+    }
+    size_t sizeClass = max<size_t>((size + kPageSize - 1) / kPageSize, 1);
+    size = sizeClass * kPageSize;
+
+    auto& cache = GetThreadCache();
+    auto& chunks = cache.mChunks[sizeClass];
+    if (!chunks.empty()) {
+        mThreadCacheHitCnt.fetch_add(1, memory_order_relaxed);
+    } else {
+        auto& shared = mSharedCaches[sizeClass];
+        {
+            lock_guard<mutex> lock(shared.mMux);
+            size_t cnt = min(shared.mChunks.size(), max<size_t>(kRefillBytes / size, 1));
+            chunks.insert(chunks.end(), shared.mChunks.end() - cnt, shared.mChunks.end());
+            shared.mChunks.resize(shared.mChunks.size() - cnt);
+        }
+        if (chunks.empty()) {
+            mMissCnt.fetch_add(1, memory_order_relaxed);
+            return new uint8_t[size];
+        }
+        mSharedCachedBytes.fetch_sub(chunks.size() * size, memory_order_relaxed);
+        cache.mCachedBytes += chunks.size() * size;
+        mSharedCacheHitCnt.fetch_add(1, memory_order_relaxed);
+    }
+    uint8_t* chunk = chunks.back();
+    chunks.pop_back();
+    cache.mCachedBytes -= size;
+    return chunk;
+}
+
+void ChunkPool::Release(uint8_t* chunk, size_t size) {
+    if (!BOOL_FLAG(enable_chunk_pool) || size == 0 || size > kMaxPooledChunkSize || size % kPageSize != 0
+        || ThreadCache::sDestroyed) {
+        mFreeCnt.fetch_add(1, memory_order_relaxed);
+        delete[] chunk;
+        return;
+    }
+    size_t sizeClass = size / kPageSize;
+    auto& cache = GetThreadCache();
+    auto& chunks = cache.mChunks[sizeClass];
+    chunks.push_back(chunk);
+    cache.mCachedBytes += size;
+    if (cache.mCachedBytes > static_cast<size_t>(INT32_FLAG(chunk_pool_thread_cache_size_kb)) * 1024) {
+        cache.mCachedBytes -= chunks.size() * size;
+        ReleaseToShared(chunks, sizeClass);
+    }
+}
+
+ChunkPoolStat ChunkPool::GetStat() const {
+    ChunkPoolStat stat;
+    stat.mThreadCacheHitCnt = mThreadCacheHitCnt.load(memory_order_relaxed);
+    stat.mSharedCacheHitCnt = mSharedCacheHitCnt.load(memory_order_relaxed);
+    stat.mMissCnt = mMissCnt.load(memory_order_relaxed);
+    stat.mFreeCnt = mFreeCnt.load(memory_order_relaxed);
+    stat.mSharedCachedBytes = mSharedCachedBytes.load(memory_order_relaxed);
+    return stat;
+}
+
+void ChunkPool::ReleaseToShared(vector<uint8_t*>& chunks, size_t sizeClass) {
+    const int64_t size = sizeClass * kPageSize;
+    const int64_t limit = static_cast<int64_t>(INT32_FLAG(chunk_pool_shared_cache_size_mb)) * 1024 * 1024;
+    auto& shared = mSharedCaches[sizeClass];
+    {
+        lock_guard<mutex> lock(shared.mMux);
+        while (!chunks.empty() && mSharedCachedBytes.load(memory_order_relaxed) + size <= limit) {
+            shared.mChunks.push_back(chunks.back());
+            chunks.pop_back();
+            mSharedCachedBytes.fetch_add(size, memory_order_relaxed);
+        }
+    }
+    mFreeCnt.fetch_add(chunks.size(), memory_order_relaxed);
+    for (auto chunk : chunks) {
+        delete[] chunk;
+    }
+    chunks.clear();
+}
+
+} // namespace logtail
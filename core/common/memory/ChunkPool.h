@@ -0,0 +1,92 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace logtail {
+
+struct ChunkPoolStat {
+    uint64_t mThreadCacheHitCnt = 0;
+    uint64_t mSharedCacheHitCnt = 0;
+    uint64_t mMissCnt = 0;
+    uint64_t mFreeCnt = 0;
+    int64_t mSharedCachedBytes = 0;
+};
+
+// ChunkPool recycles the memory chunks used by BufferAllocator. Chunk sizes are rounded up to a multiple of
+// kPageSize, and each size up to kMaxPooledChunkSize forms a size class.
+//
+// Each thread keeps a small cache of free chunks per size class, so that acquiring and releasing chunks needs no lock
+// in most cases. Since an event group is usually destructed in a thread other than the one creating it, chunks
+// released by a thread whose cache is full are moved to the shared cache of the size class, from which threads
+// with an empty cache take chunks in batches. Chunks exceeding the capacity of the shared cache are freed.
+class ChunkPool {
+public:
+    static constexpr size_t kPageSize = 4096;
+    static constexpr size_t kMaxPooledChunkSize = 2 * 1024 * 1024;
+    static constexpr size_t kSizeClassCnt = kMaxPooledChunkSize / kPageSize + 1;
+
+    ChunkPool(const ChunkPool&) = delete;
+    ChunkPool& operator=(const ChunkPool&) = delete;
+
+    static ChunkPool* GetInstance() {
+        static ChunkPool instance;
+        return &instance;
+    }
+
+    // returns a chunk of at least size bytes, with size set to the actual capacity of the chunk
+    uint8_t* Acquire(size_t& size);
+    // size must be the capacity returned by Acquire
+    void Release(uint8_t* chunk, size_t size);
+
+    ChunkPoolStat GetStat() const;
+
+private:
+    class ThreadCache;
+
+    struct SharedCache {
+        std::mutex mMux;
+        std::vector<uint8_t*> mChunks;
+    };
+
+    ChunkPool() = default;
+    ~ChunkPool();
+
+    static ThreadCache& GetThreadCache();
+    // moves chunks in the thread cache of the size class to the shared cache
+    void ReleaseToShared(std::vector<uint8_t*>& chunks, size_t sizeClass);
+
+    SharedCache mSharedCaches[kSizeClassCnt];
+    std::atomic_int64_t mSharedCachedBytes = 0;
+
+    std::atomic_uint64_t mThreadCacheHitCnt = 0;
+    std::atomic_uint64_t mSharedCacheHitCnt = 0;
+    std::atomic_uint64_t mMissCnt = 0;
+    std::atomic_uint64_t mFreeCnt = 0;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class ChunkPoolUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -0,0 +1,79 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/memory/MemoryBudget.h"
+
+#include "common/Flags.h"
+
+DEFINE_FLAG_INT64(memory_budget_mb,
+                  "memory budget for data held by pipelines in MB, 0 means derived from mem_usage_limit, negative "
+                  "means unlimited",
+                  0);
+DEFINE_FLAG_INT32(memory_budget_mem_limit_percent,
+                  "percent of mem_usage_limit used as memory budget when memory_budget_mb is 0",
+                  50);
+DEFINE_FLAG_INT32(memory_budget_fair_share_percent,
+                  "percent of memory budget above which each pipeline is limited to its fair share",
+                  80);
+
+using namespace std;
+
+namespace logtail {
+
+void MemoryBudget::AllocateForPipeline(QueueKey key, int64_t bytes) {
+    lock_guard<mutex> lock(mPipelineMux);
+    mPipelineBytes[key] += bytes;
+}
+
+void MemoryBudget::ReleaseForPipeline(QueueKey key, int64_t bytes) {
+    lock_guard<mutex> lock(mPipelineMux);
+    auto iter = mPipelineBytes.find(key);
+    if (iter == mPipelineBytes.end()) {
+        return;
+    }
+    iter->second -= bytes;
+    if (iter->second <= 0) {
+        mPipelineBytes.erase(iter);
+    }
+}
+
+bool MemoryBudget::IsValidToPush(QueueKey key) const {
+    int64_t limit = GetLimit();
+    if (limit <= 0) {
+        return true;
+    }
+    int64_t used = GetUsedBytes();
+    if (used >= limit) {
+        return false;
+    }
+    if (used < limit / 100 * INT32_FLAG(memory_budget_fair_share_percent)) {
+        return true;
+    }
+    lock_guard<mutex> lock(mPipelineMux);
+    auto iter = mPipelineBytes.find(key);
+    if (iter == mPipelineBytes.end()) {
+        return true;
+    }
+    return iter->second < limit / static_cast<int64_t>(mPipelineBytes.size());
+}
+
+void MemoryBudget::UpdateLimit(int64_t memUsageUpLimitMB) {
+    int64_t limitMB = INT64_FLAG(memory_budget_mb);
+    if (limitMB == 0) {
+        limitMB = memUsageUpLimitMB * INT32_FLAG(memory_budget_mem_limit_percent) / 100;
+    }
+    SetLimit(limitMB > 0 ? limitMB * 1024 * 1024 : 0);
+}
+
+} // namespace logtail
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#include "collection_pipeline/queue/QueueKey.h"
+
+namespace logtail {
+
+// MemoryBudget keeps track of the bytes held by data flowing through pipelines, i.e., chunks allocated by
+// SourceBuffer and serialized data in sender queues, and decides whether inputs are allowed to bring in more data.
+//
+// Admission works in two stages. Below the fair share threshold, every pipeline is admitted. Above it, only pipelines
+// whose event groups waiting in process queue take less than their fair share of the budget are admitted, so that a
+// bursting pipeline is slowed down first. Once the budget is used up, no pipeline is admitted.
+class MemoryBudget {
+public:
+    MemoryBudget(const MemoryBudget&) = delete;
+    MemoryBudget& operator=(const MemoryBudget&) = delete;
+
+    static MemoryBudget* GetInstance() {
+        static MemoryBudget instance;
+        return &instance;
+    }
+
+    void Allocate(int64_t bytes) { mUsedBytes.fetch_add(bytes, std::memory_order_relaxed); }
+    void Release(int64_t bytes) { mUsedBytes.fetch_sub(bytes, std::memory_order_relaxed); }
+
+    // bytes charged to a pipeline are also counted by Allocate, they are only used to compute fair shares
+    void AllocateForPipeline(QueueKey key, int64_t bytes);
+    void ReleaseForPipeline(QueueKey key, int64_t bytes);
+
+    bool IsValidToPush(QueueKey key) const;
+
+    // memUsageUpLimitMB is used to derive the budget when memory_budget_mb is not set
+    void UpdateLimit(int64_t memUsageUpLimitMB);
+    void SetLimit(int64_t bytes) { mLimitBytes.store(bytes, std::memory_order_relaxed); }
+    int64_t GetLimit() const { return mLimitBytes.load(std::memory_order_relaxed); }
+    int64_t GetUsedBytes() const { return mUsedBytes.load(std::memory_order_relaxed); }
+
+private:
+    MemoryBudget() = default;
+    ~MemoryBudget() = default;
+
+    std::atomic_int64_t mUsedBytes = 0;
+    // non-positive value means unlimited
+    std::atomic_int64_t mLimitBytes = 0;
+
+    mutable std::mutex mPipelineMux;
+    std::unordered_map<QueueKey, int64_t> mPipelineBytes;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class MemoryBudgetUnittest;
+#endif
+};
+
+} // namespace logtail
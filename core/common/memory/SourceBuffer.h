@@ -18,8 +18,11 @@
 
 #include <list>
 #include <memory>
+#include <utility>
 
 #include "common/StringView.h"
+#include "common/memory/ChunkPool.h"
+#include "common/memory/MemoryBudget.h"
 
 namespace logtail {
 
@@ -47,33 +50,39 @@ private:
 public:
     explicit BufferAllocator(uint32_t firstChunkSize = 4096, uint32_t chunkSizeLimit = 1024 * 128)
         : mFirstChunkSize(firstChunkSize), mChunkSizeLimit(chunkSizeLimit), mChunkSize(firstChunkSize) {
-        mAllocPtr = new uint8_t[mChunkSize];
-        mAllocatedChunks.push_back(mAllocPtr);
-        mFreeBytesInChunk = mChunkSize;
-        mAllocated = mChunkSize;
+        size_t size = mChunkSize;
+        mAllocPtr = NewChunk(size);
+        mFreeBytesInChunk = size;
     }
 
     BufferAllocator(const BufferAllocator&) = delete;
     BufferAllocator& operator=(const BufferAllocator&) = delete;
 
-    BufferAllocator(BufferAllocator&&) = default;
-    BufferAllocator& operator=(BufferAllocator&&) = default;
+    // the moved-from allocator owns nothing, so that chunks are released from memory budget only once
+    BufferAllocator(BufferAllocator&& rhs) noexcept { Swap(rhs); }
+    BufferAllocator& operator=(BufferAllocator&& rhs) noexcept {
+        if (this != &rhs) {
+            BufferAllocator tmp(std::move(rhs));
+            Swap(tmp);
+        }
+        return *this;
+    }
 
     ~BufferAllocator() {
         for (size_t i = 0; i < mAllocatedChunks.size(); i++) {
-            delete[] mAllocatedChunks[i];
+            DeleteChunk(mAllocatedChunks[i]);
         }
     }
 
     void Reset(void) {
         for (size_t i = 1; i < mAllocatedChunks.size(); i++) {
-            delete[] mAllocatedChunks[i];
+            DeleteChunk(mAllocatedChunks[i]);
         }
         mAllocatedChunks.resize(1);
-        mAllocPtr = mAllocatedChunks[0];
+        mAllocPtr = mAllocatedChunks[0].first;
         mChunkSize = mFirstChunkSize;
-        mFreeBytesInChunk = mChunkSize;
-        mAllocated = mChunkSize;
+        mFreeBytesInChunk = mAllocatedChunks[0].second;
+        mAllocated = mAllocatedChunks[0].second;
         mUsed = 0;
     }
 
@@ -106,9 +115,8 @@ private:
              * will not be so large. Thus, it is wise to allocate it directly
              * from heap in order to avoid polluting chunk size.
              */
-            mem = new uint8_t[bytes];
-            mAllocatedChunks.push_back(mem);
-            mAllocated += bytes;
+            size_t size = bytes;
+            mem = NewChunk(size);
         } else {
             /*
              * Here we intentionally waste some space in the current chunk.
@@ -116,23 +124,47 @@ private:
             if (mChunkSize < mChunkSizeLimit) {
                 mChunkSize *= 2;
             }
-            mem = new uint8_t[mChunkSize];
-            mAllocatedChunks.push_back(mem);
+            size_t size = mChunkSize;
+            mem = NewChunk(size);
             mAllocPtr = mem + bytes;
-            mFreeBytesInChunk = mChunkSize - bytes;
-            mAllocated += mChunkSize;
+            mFreeBytesInChunk = size - bytes;
         }
 
         mUsed += bytes;
         return mem;
     }
 
+    // chunks are recycled by ChunkPool, size is set to the actual capacity of the chunk
+    uint8_t* NewChunk(size_t& size) {
+        uint8_t* chunk = ChunkPool::GetInstance()->Acquire(size);
+        mAllocatedChunks.emplace_back(chunk, size);
+        mAllocated += size;
+        MemoryBudget::GetInstance()->Allocate(size);
+        return chunk;
+    }
+
+    void DeleteChunk(const std::pair<uint8_t*, size_t>& chunk) {
+        ChunkPool::GetInstance()->Release(chunk.first, chunk.second);
+        MemoryBudget::GetInstance()->Release(chunk.second);
+    }
+
+    void Swap(BufferAllocator& rhs) noexcept {
+        std::swap(mFirstChunkSize, rhs.mFirstChunkSize);
+        std::swap(mChunkSizeLimit, rhs.mChunkSizeLimit);
+        mAllocatedChunks.swap(rhs.mAllocatedChunks);
+        std::swap(mAllocated, rhs.mAllocated);
+        std::swap(mUsed, rhs.mUsed);
+        std::swap(mAllocPtr, rhs.mAllocPtr);
+        std::swap(mFreeBytesInChunk, rhs.mFreeBytesInChunk);
+        std::swap(mChunkSize, rhs.mChunkSize);
+    }
+
 private:
     uint32_t mFirstChunkSize = 4096;
     uint32_t mChunkSizeLimit = 1024 * 128;
 
-    // The allocated memory chunks
-    std::vector<uint8_t*> mAllocatedChunks;
+    // The allocated memory chunks and their capacities
+    std::vector<std::pair<uint8_t*, size_t>> mAllocatedChunks;
     // Statistics data
     uint64_t mAllocated = 0;
     uint64_t mUsed = 0;
@@ -152,6 +184,9 @@ private:
 // only movable
 class SourceBuffer {
 public:
+    // firstChunkSize should be close to the typical size of the event group held by the buffer
+    explicit SourceBuffer(uint32_t firstChunkSize = 4096) : mAllocator(firstChunkSize) {}
+
     StringBuffer AllocateStringBuffer(size_t size) {
         char* data = static_cast<char*>(mAllocator.Allocate(size + 1));
         data[size] = '\0';
@@ -167,6 +202,8 @@ public:
     StringBuffer CopyString(const std::string& s) { return CopyString(s.data(), s.length()); }
     StringBuffer CopyString(StringView s) { return CopyString(s.data(), s.length()); }
 
+    int64_t GetAllocatedSize() const { return mAllocator.GetAllocatedSize(); }
+
 private:
     BufferAllocator mAllocator;
 
@@ -35,38 +35,171 @@ ProcessCacheValue* ProcessCacheValue::CloneContents() {
     return newValue;
 }
 
-ProcessCache::ProcessCache(size_t initCacheSize) {
-    mCache.reserve(initCacheSize);
+ProcessCache::Table::Table(size_t bucketCount)
+    : mMask(bucketCount - 1), mBuckets(new std::atomic<Node*>[bucketCount]) {
+    for (size_t i = 0; i < bucketCount; ++i) {
+        mBuckets[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+ProcessCache::Table::~Table() {
+    for (size_t i = 0; i <= mMask; ++i) {
+        Node* node = mBuckets[i].load(std::memory_order_relaxed);
+        while (node != nullptr) {
+            Node* next = node->mNext.load(std::memory_order_relaxed);
+            delete node;
+            node = next;
+        }
+    }
+}
+
+ProcessCache::ProcessCache(size_t initCacheSize) : mInitBucketCount(kMinBucketCount) {
+    while (mInitBucketCount * kShardCount < initCacheSize) {
+        mInitBucketCount <<= 1;
+    }
+    for (auto& shard : mShards) {
+        shard.mTable.store(new Table(mInitBucketCount), std::memory_order_release);
+    }
+}
+
+ProcessCache::~ProcessCache() {
+    // no reader can be left at this point
+    for (auto& shard : mShards) {
+        delete shard.mTable.load(std::memory_order_relaxed);
+        for (auto& [epoch, node] : shard.mRetiredNodes) {
+            delete node;
+        }
+        for (auto& [epoch, table] : shard.mRetiredTables) {
+            delete table;
+        }
+    }
+}
+
+uint64_t ProcessCache::hashKey(const data_event_id& key) {
+    // splitmix64 finalizer, both the shard (high bits) and the bucket (low bits) need well mixed bits
+    uint64_t x = (uint64_t(key.pid) << 32) ^ key.time;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+const ProcessCache::Node* ProcessCache::findNode(const Table* table, const data_event_id& key, uint64_t hash) {
+    const Node* node = table->mBuckets[hash & table->mMask].load(std::memory_order_acquire);
+    while (node != nullptr) {
+        if (DataEventIdEqual()(node->mKey, key)) {
+            return node;
+        }
+        node = node->mNext.load(std::memory_order_acquire);
+    }
+    return nullptr;
 }
 
 bool ProcessCache::Contains(const data_event_id& key) const {
-    std::lock_guard<std::mutex> lock(mCacheMutex);
-    return mCache.find(key) != mCache.end();
+    auto hash = hashKey(key);
+    auto& shard = getShard(hash);
+    ebpf::EpochManager::Guard guard(mEpoch);
+    return findNode(shard.mTable.load(std::memory_order_acquire), key, hash) != nullptr;
 }
 
-std::shared_ptr<ProcessCacheValue> ProcessCache::Lookup(const data_event_id& key) {
-    std::lock_guard<std::mutex> lock(mCacheMutex);
-    auto it = mCache.find(key);
-    if (it != mCache.end()) {
-        return it->second;
+std::shared_ptr<ProcessCacheValue> ProcessCache::Lookup(const data_event_id& key) const {
+    auto hash = hashKey(key);
+    auto& shard = getShard(hash);
+    ebpf::EpochManager::Guard guard(mEpoch);
+    const Node* node = findNode(shard.mTable.load(std::memory_order_acquire), key, hash);
+    if (node != nullptr) {
+        return node->mValue;
     }
     return nullptr;
 }
 
 size_t ProcessCache::Size() const {
-    std::lock_guard<std::mutex> lock(mCacheMutex);
-    return mCache.size();
+    size_t size = 0;
+    for (const auto& shard : mShards) {
+        size += shard.mSize.load(std::memory_order_relaxed);
+    }
+    return size;
 }
 
 void ProcessCache::removeCache(const data_event_id& key) {
-    std::lock_guard<std::mutex> lock(mCacheMutex);
-    mCache.erase(key);
+    auto hash = hashKey(key);
+    auto& shard = getShard(hash);
+    std::lock_guard<std::mutex> lock(shard.mWriteMutex);
+    Table* table = shard.mTable.load(std::memory_order_relaxed);
+    std::atomic<Node*>* prev = &table->mBuckets[hash & table->mMask];
+    Node* node = prev->load(std::memory_order_relaxed);
+    while (node != nullptr) {
+        if (DataEventIdEqual()(node->mKey, key)) {
+            prev->store(node->mNext.load(std::memory_order_relaxed), std::memory_order_release);
+            shard.mSize.fetch_sub(1, std::memory_order_relaxed);
+            retireNode(shard, node);
+            return;
+        }
+        prev = &node->mNext;
+        node = prev->load(std::memory_order_relaxed);
+    }
 }
 
 void ProcessCache::AddCache(const data_event_id& key, std::shared_ptr<ProcessCacheValue>&& value) {
     value->IncRef();
-    std::lock_guard<std::mutex> lock(mCacheMutex);
-    mCache.emplace(key, std::move(value));
+    auto hash = hashKey(key);
+    auto& shard = getShard(hash);
+    std::lock_guard<std::mutex> lock(shard.mWriteMutex);
+    Table* table = shard.mTable.load(std::memory_order_relaxed);
+    if (findNode(table, key, hash) != nullptr) {
+        return;
+    }
+    // fully built before being published to readers
+    auto* node = new Node(key, std::move(value));
+    auto& bucket = table->mBuckets[hash & table->mMask];
+    node->mNext.store(bucket.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    bucket.store(node, std::memory_order_release);
+    if (shard.mSize.fetch_add(1, std::memory_order_relaxed) + 1 > (table->mMask + 1) * kMaxLoadFactor) {
+        grow(shard);
+    }
+}
+
+void ProcessCache::grow(Shard& shard) {
+    Table* oldTable = shard.mTable.load(std::memory_order_relaxed);
+    // readers may be walking the old chains, so the new table gets its own copies of the nodes
+    auto* newTable = new Table((oldTable->mMask + 1) * 2);
+    for (size_t i = 0; i <= oldTable->mMask; ++i) {
+        for (Node* node = oldTable->mBuckets[i].load(std::memory_order_relaxed); node != nullptr;
+             node = node->mNext.load(std::memory_order_relaxed)) {
+            auto* copy = new Node(node->mKey, node->mValue);
+            auto& bucket = newTable->mBuckets[hashKey(node->mKey) & newTable->mMask];
+            copy->mNext.store(bucket.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            bucket.store(copy, std::memory_order_relaxed);
+        }
+    }
+    shard.mTable.store(newTable, std::memory_order_release);
+    retireTable(shard, oldTable);
+}
+
+void ProcessCache::retireNode(Shard& shard, Node* node) {
+    shard.mRetiredNodes.emplace_back(mEpoch.Retire(), node);
+    if (shard.mRetiredNodes.size() >= kReclaimBatch) {
+        reclaim(shard);
+    }
+}
+
+void ProcessCache::retireTable(Shard& shard, Table* table) {
+    shard.mRetiredTables.emplace_back(mEpoch.Retire(), table);
+    reclaim(shard);
+}
+
+void ProcessCache::reclaim(Shard& shard) {
+    uint64_t minActive = mEpoch.MinActiveEpoch();
+    // retired in epoch order, so everything before the first one still visible can go
+    size_t n = 0;
+    while (n < shard.mRetiredNodes.size() && shard.mRetiredNodes[n].first <= minActive) {
+        delete shard.mRetiredNodes[n++].second;
+    }
+    shard.mRetiredNodes.erase(shard.mRetiredNodes.begin(), shard.mRetiredNodes.begin() + n);
+    n = 0;
+    while (n < shard.mRetiredTables.size() && shard.mRetiredTables[n].first <= minActive) {
+        delete shard.mRetiredTables[n++].second;
+    }
+    shard.mRetiredTables.erase(shard.mRetiredTables.begin(), shard.mRetiredTables.begin() + n);
 }
 
 void ProcessCache::IncRef(const data_event_id& key) {
@@ -90,8 +223,13 @@ void ProcessCache::enqueueExpiredEntry(const data_event_id& key, time_t curktime
 }
 
 void ProcessCache::ClearCache() {
-    std::lock_guard<std::mutex> lock(mCacheMutex);
-    mCache.clear();
+    for (auto& shard : mShards) {
+        std::lock_guard<std::mutex> lock(shard.mWriteMutex);
+        Table* oldTable = shard.mTable.load(std::memory_order_relaxed);
+        shard.mTable.store(new Table(mInitBucketCount), std::memory_order_release);
+        shard.mSize.store(0, std::memory_order_relaxed);
+        retireTable(shard, oldTable);
+    }
 }
 
 
@@ -109,8 +247,15 @@ void ProcessCache::ClearExpiredCache(time_t ktime) {
 }
 
 void ProcessCache::PrintDebugInfo() {
-    for (const auto& [key, value] : mCache) {
-        LOG_ERROR(sLogger, ("[DUMP CACHE] pid", key.pid)("ktime", key.time));
+    for (auto& shard : mShards) {
+        std::lock_guard<std::mutex> lock(shard.mWriteMutex);
+        const Table* table = shard.mTable.load(std::memory_order_relaxed);
+        for (size_t i = 0; i <= table->mMask; ++i) {
+            for (const Node* node = table->mBuckets[i].load(std::memory_order_relaxed); node != nullptr;
+                 node = node->mNext.load(std::memory_order_relaxed)) {
+                LOG_ERROR(sLogger, ("[DUMP CACHE] pid", node->mKey.pid)("ktime", node->mKey.time));
+            }
+        }
     }
     for (const auto& entry : mCacheExpireQueue) {
         LOG_ERROR(sLogger,
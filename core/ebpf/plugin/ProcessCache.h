@@ -13,16 +13,24 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#pragma once
+
 #include <coolbpf/security/data_msg.h>
 #include <cstdint>
 
+#include <array>
+#include <atomic>
 #include <deque>
+#include <memory>
 #include <mutex>
+#include <utility>
+#include <vector>
 
 #include "common/StringView.h"
 #include "common/memory/SourceBuffer.h"
 #include "ebpf/type/table/ProcessTable.h"
 #include "ebpf/type/table/StaticDataRow.h"
+#include "ebpf/util/EpochManager.h"
 
 namespace logtail {
 
@@ -106,19 +114,27 @@ struct DataEventIdEqual {
     }
 };
 
+// ProcessCache is written by the process event thread and read by every plugin attaching process tags.
+// Entries are spread over shards of lock-free hash tables: readers never take a lock, writers only lock the shard
+// they modify, and unlinked entries are freed through epoch reclamation once no reader can still see them.
 class ProcessCache {
 public:
     explicit ProcessCache(size_t initCacheSize = kInitCacheSize);
+    ~ProcessCache();
 
-    // thread-safe
+    ProcessCache(const ProcessCache&) = delete;
+    ProcessCache& operator=(const ProcessCache&) = delete;
+
+    // thread-safe, lock-free
     bool Contains(const data_event_id& key) const;
 
-    // thread-safe
-    std::shared_ptr<ProcessCacheValue> Lookup(const data_event_id& key);
+    // thread-safe, lock-free
+    std::shared_ptr<ProcessCacheValue> Lookup(const data_event_id& key) const;
 
+    // thread-safe
     size_t Size() const;
 
-    // thread-safe, only single write call, but contention with read
+    // thread-safe, does not block readers
     // will init ref count to 1
     void AddCache(const data_event_id& key, std::shared_ptr<ProcessCacheValue>&& value);
     // NOT thread-safe, only single write call, no contention with read
@@ -127,7 +143,7 @@ public:
     // NOT thread-safe, only single write call, no contention with read
     // will dec ref count by 1, and if ref count is 0, will enqueueExpiredEntry
     void DecRef(const data_event_id& key, time_t curktime);
-    // thread-safe, only single write call, but contention with read
+    // thread-safe, does not block readers
     void ClearCache();
     // NOT thread-safe, only single write call, no contention with read
     void ClearExpiredCache(time_t ktime);
@@ -135,15 +151,55 @@ public:
     void PrintDebugInfo();
 
 private:
-    // thread-safe, only single write call, but contention with read
+    static constexpr size_t kShardCount = 16;
+    static constexpr size_t kMinBucketCount = 16;
+    static constexpr size_t kMaxLoadFactor = 2;
+    static constexpr size_t kReclaimBatch = 64;
+
+    struct Node {
+        Node(const data_event_id& key, std::shared_ptr<ProcessCacheValue> value)
+            : mKey(key), mValue(std::move(value)) {}
+        data_event_id mKey;
+        std::shared_ptr<ProcessCacheValue> mValue; // never changed while the node is linked
+        std::atomic<Node*> mNext{nullptr};
+    };
+
+    // a bucket array; replaced as a whole on growth or clear, deleting it deletes the nodes still chained in it
+    struct Table {
+        explicit Table(size_t bucketCount);
+        ~Table();
+        size_t mMask;
+        std::unique_ptr<std::atomic<Node*>[]> mBuckets;
+    };
+
+    struct alignas(64) Shard {
+        std::atomic<Table*> mTable{nullptr};
+        std::atomic<size_t> mSize{0};
+        std::mutex mWriteMutex; // serializes writers of this shard, never taken by readers
+        std::vector<std::pair<uint64_t, Node*>> mRetiredNodes;
+        std::vector<std::pair<uint64_t, Table*>> mRetiredTables;
+    };
+
+    static uint64_t hashKey(const data_event_id& key);
+    Shard& getShard(uint64_t hash) const { return mShards[hash >> 60]; }
+    // caller must hold an epoch guard
+    static const Node* findNode(const Table* table, const data_event_id& key, uint64_t hash);
+
+    // thread-safe, does not block readers
     void removeCache(const data_event_id& key);
     // NOT thread-safe, only single write call, no contention with read
     void enqueueExpiredEntry(const data_event_id& key, time_t curktime);
+    // caller must hold shard.mWriteMutex
+    void grow(Shard& shard);
+    void retireNode(Shard& shard, Node* node);
+    void retireTable(Shard& shard, Table* table);
+    void reclaim(Shard& shard);
+
+    static_assert((kShardCount & (kShardCount - 1)) == 0 && kShardCount == 16, "shard index takes 4 hash bits");
+    size_t mInitBucketCount;
+    mutable ebpf::EpochManager mEpoch;
+    mutable std::array<Shard, kShardCount> mShards;
 
-    using ExecveEventMap
-        = std::unordered_map<data_event_id, std::shared_ptr<ProcessCacheValue>, DataEventIdHash, DataEventIdEqual>;
-    mutable std::mutex mCacheMutex;
-    ExecveEventMap mCache;
     struct ExitedEntry {
         time_t time;
         data_event_id key;
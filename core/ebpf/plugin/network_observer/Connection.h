@@ -155,6 +155,9 @@ public:
 
     void MarkConnDeleted() { mMetaFlags.fetch_or(kSFlagConnDeleted, std::memory_order_release); }
 
+    // only accessed by the poller thread, which consumes both data and ctrl events
+    HttpStreamState& GetHttpStreamState() { return mHttpStreamState; }
+
 private:
     void updateL4Meta(struct conn_stats_event_t* event);
     // peer pod meta
@@ -189,6 +192,8 @@ private:
     void MarkClose() {
         this->mIsClose = true;
         this->mMarkCloseTime = std::chrono::steady_clock::now();
+        // headers cut off before close will never be completed
+        mHttpStreamState.Reset();
     }
 
     void RecordLastUpdateTs(uint64_t ts) { mLastUpdateTs = ts; }
@@ -212,6 +217,8 @@ private:
 
     ConnStatsData mCurrStats;
 
+    HttpStreamState mHttpStreamState;
+
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class ConnectionUnittest;
     friend class ConnectionManagerUnittest;
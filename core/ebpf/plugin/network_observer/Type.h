@@ -21,9 +21,11 @@ extern "C" {
 
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "common/HashUtil.h"
+#include "common/StringView.h"
 
 
 namespace logtail::ebpf {
@@ -43,6 +45,51 @@ struct CaseInsensitiveLess {
 
 using HeadersMap = std::multimap<std::string, std::string, CaseInsensitiveLess>;
 
+// Header name/value pairs in the order they appear on the wire. The views point into the owning record's buffer.
+using HeaderViews = std::vector<std::pair<StringView, StringView>>;
+
+inline const StringView* FindHeader(const HeaderViews& headers, StringView name) {
+    for (const auto& header : headers) {
+        if (header.first.size() == name.size()
+            && std::equal(header.first.begin(), header.first.end(), name.begin(), [](char c1, char c2) {
+                   return std::tolower(static_cast<unsigned char>(c1)) == std::tolower(static_cast<unsigned char>(c2));
+               })) {
+            return &header.second;
+        }
+    }
+    return nullptr;
+}
+
+// Upper bound of bytes buffered per direction for an HTTP exchange spanning several data events.
+inline constexpr size_t kMaxHttpPendingBytes = 64 * 1024;
+
+// Unfinished HTTP exchange of a connection. When a data event ends in the middle of the headers, its payload is kept
+// here and the next data event of the same connection is appended to it, so the exchange is resumed instead of being
+// dropped. mReqScanned/mRespScanned record how many bytes have already been scanned for the end of headers,
+// picohttpparser then only rescans the newly arrived bytes. mReqHeaderPending/mRespHeaderPending tell which
+// direction is cut off in its headers.
+struct HttpStreamState {
+    void Reset() {
+        mReq.clear();
+        mResp.clear();
+        mReqScanned = 0;
+        mRespScanned = 0;
+        mReqHeaderPending = false;
+        mRespHeaderPending = false;
+        mStartTs = 0;
+    }
+
+    [[nodiscard]] bool HasPending() const { return !mReq.empty() || !mResp.empty(); }
+
+    std::string mReq;
+    std::string mResp;
+    size_t mReqScanned = 0;
+    size_t mRespScanned = 0;
+    bool mReqHeaderPending = false;
+    bool mRespHeaderPending = false;
+    uint64_t mStartTs = 0;
+};
+
 inline enum support_proto_e& operator++(enum support_proto_e& pt) {
     pt = static_cast<enum support_proto_e>(static_cast<int>(pt) + 1);
     return pt;
@@ -14,6 +14,7 @@
 
 #include "HttpParser.h"
 
+#include <charconv>
 #include <map>
 
 #include "common/StringTools.h"
@@ -27,35 +28,111 @@ inline constexpr char kContentLength[] = "Content-Length";
 inline constexpr char kTransferEncoding[] = "Transfer-Encoding";
 inline constexpr char kUpgrade[] = "Upgrade";
 
+// A data event continues the pending exchange only if it carries the rest of the cut off headers, rather than a new
+// message in either direction. Each data event is otherwise a complete request/response pair on its own.
+static bool ContinuesPendingExchange(const HttpStreamState& stream,
+                                     std::string_view reqBuf,
+                                     std::string_view respBuf,
+                                     uint64_t startTs) {
+    if (startTs < stream.mStartTs) {
+        return false;
+    }
+    if (stream.mReqHeaderPending) {
+        return !reqBuf.empty() && !http::StartsWithHttpMethod(reqBuf);
+    }
+    if (!reqBuf.empty()) {
+        return false;
+    }
+    return stream.mRespHeaderPending && !respBuf.empty() && !http::StartsWithHttp(respBuf);
+}
+
 std::vector<std::shared_ptr<AbstractRecord>> HTTPProtocolParser::Parse(struct conn_data_event_t* dataEvent,
                                                                        const std::shared_ptr<Connection>& conn,
                                                                        const std::shared_ptr<Sampler>& sampler) {
+    std::string_view reqBuf(dataEvent->msg, dataEvent->request_len);
+    std::string_view respBuf(dataEvent->msg + dataEvent->request_len, dataEvent->response_len);
+    uint64_t startTs = dataEvent->start_ts;
+    HttpStreamState* stream = conn ? &conn->GetHttpStreamState() : nullptr;
+    bool resumed = false;
+    if (stream && stream->HasPending()) {
+        if (ContinuesPendingExchange(*stream, reqBuf, respBuf, startTs)) {
+            stream->mReq.append(reqBuf);
+            stream->mResp.append(respBuf);
+            reqBuf = stream->mReq;
+            respBuf = stream->mResp;
+            startTs = stream->mStartTs;
+            resumed = true;
+        } else {
+            LOG_DEBUG(sLogger,
+                      ("[HTTPProtocolParser]: HTTP exchange not continued by next data event, drop it, request bytes",
+                       stream->mReq.size())("response bytes", stream->mResp.size()));
+            stream->Reset();
+        }
+    }
+
     auto record = std::make_shared<HttpRecord>(conn);
     record->SetEndTsNs(dataEvent->end_ts);
-    record->SetStartTsNs(dataEvent->start_ts);
+    record->SetStartTsNs(startTs);
     auto spanId = GenerateSpanID();
     // slow request
-    if (record->GetLatencyMs() > 500 || sampler->ShouldSample(spanId)) {
+    if (record->GetLatencyMs() > 500 || (sampler && sampler->ShouldSample(spanId))) {
         record->MarkSample();
     }
 
+    size_t reqScanned = stream ? stream->mReqScanned : 0;
+    size_t respScanned = stream ? stream->mRespScanned : 0;
+    ParseState respState = ParseState::kSuccess;
+    ParseState reqState = ParseState::kSuccess;
     // ParseResponse may set SAMPLE flag, depending on HTTP status code ...
-    if (dataEvent->response_len > 0) {
-        std::string_view buf(dataEvent->msg + dataEvent->request_len, dataEvent->response_len);
-        ParseState state = http::ParseResponse(buf, record, true, false);
-        if (state != ParseState::kSuccess) {
-            LOG_DEBUG(sLogger, ("[HTTPProtocolParser]: Parse HTTP response failed", int(state)));
-            return {};
-        }
+    if (!respBuf.empty()) {
+        std::string_view buf(respBuf);
+        respState = http::ParseResponse(buf, record, true, false, &respScanned);
+    }
+    if ((respState == ParseState::kSuccess || respState == ParseState::kNeedsMoreData) && !reqBuf.empty()) {
+        std::string_view buf(reqBuf);
+        reqState = http::ParseRequest(buf, record, false, &reqScanned);
+    }
+
+    // The scanned length is only left non zero when the end of headers is not found. A body shorter than its length is
+    // normal since eBPF truncates payloads, so such an exchange is reported with the headers parsed.
+    bool reqHeaderPending = reqState == ParseState::kNeedsMoreData && reqScanned != 0;
+    bool respHeaderPending = respState == ParseState::kNeedsMoreData && respScanned != 0;
+    if (reqState == ParseState::kNeedsMoreData && !reqHeaderPending) {
+        reqState = ParseState::kSuccess;
+    }
+    if (respState == ParseState::kNeedsMoreData && !respHeaderPending) {
+        respState = ParseState::kSuccess;
     }
 
-    if (dataEvent->request_len > 0) {
-        std::string_view buf(dataEvent->msg, dataEvent->request_len);
-        ParseState state = http::ParseRequest(buf, record, false);
-        if (state != ParseState::kSuccess) {
-            LOG_DEBUG(sLogger, ("[HTTPProtocolParser]: Parse HTTP request failed", int(state)));
+    if (reqHeaderPending || respHeaderPending) {
+        if (stream && !conn->IsClose() && reqBuf.size() <= kMaxHttpPendingBytes
+            && respBuf.size() <= kMaxHttpPendingBytes) {
+            if (!resumed) {
+                stream->mReq.assign(reqBuf);
+                stream->mResp.assign(respBuf);
+                stream->mStartTs = startTs;
+            }
+            stream->mReqScanned = reqScanned;
+            stream->mRespScanned = respScanned;
+            stream->mReqHeaderPending = reqHeaderPending;
+            stream->mRespHeaderPending = respHeaderPending;
             return {};
         }
+        LOG_DEBUG(sLogger,
+                  ("[HTTPProtocolParser]: HTTP exchange incomplete, drop it, request bytes",
+                   reqBuf.size())("response bytes", respBuf.size()));
+    }
+    // the record keeps its own copy of everything it refers to, so the pending bytes can be released now
+    if (resumed) {
+        stream->Reset();
+    }
+    if (respState != ParseState::kSuccess) {
+        LOG_DEBUG(sLogger, ("[HTTPProtocolParser]: Parse HTTP response failed", int(respState)));
+        return {};
+    }
+    if (reqState != ParseState::kSuccess) {
+        LOG_DEBUG(sLogger, ("[HTTPProtocolParser]: Parse HTTP request failed", int(reqState)));
+        return {};
     }
 
     if (record->ShouldSample()) {
@@ -67,6 +144,26 @@ std::vector<std::shared_ptr<AbstractRecord>> HTTPProtocolParser::Parse(struct co
 }
 
 namespace http {
+HeaderViews CopyHTTPHeaders(const phr_header* headers, size_t numHeaders, HttpRecord& record) {
+    HeaderViews result;
+    if (numHeaders == 0) {
+        return result;
+    }
+    // pico returns headers in wire order, so all of them lie in one contiguous block which is copied at once
+    const char* begin = headers[0].name != nullptr ? headers[0].name : headers[0].value;
+    const char* end = headers[numHeaders - 1].value + headers[numHeaders - 1].value_len;
+    StringView block = record.CopyToBuffer(begin, end - begin);
+    result.reserve(numHeaders);
+    for (size_t i = 0; i < numHeaders; i++) {
+        StringView name;
+        if (headers[i].name != nullptr) {
+            name = StringView(block.data() + (headers[i].name - begin), headers[i].name_len);
+        }
+        result.emplace_back(name, StringView(block.data() + (headers[i].value - begin), headers[i].value_len));
+    }
+    return result;
+}
+
 HeadersMap GetHTTPHeadersMap(const phr_header* headers, size_t numHeaders) {
     HeadersMap result;
     for (size_t i = 0; i < numHeaders; i++) {
@@ -77,7 +174,7 @@ HeadersMap GetHTTPHeadersMap(const phr_header* headers, size_t numHeaders) {
     return result;
 }
 
-int ParseHttpRequest(std::string_view& buf, HTTPRequest& result) {
+int ParseHttpRequest(std::string_view& buf, HTTPRequest& result, size_t lastLen) {
     return phr_parse_request(buf.data(),
                              buf.size(),
                              &result.mMethod,
@@ -87,18 +184,22 @@ int ParseHttpRequest(std::string_view& buf, HTTPRequest& result) {
                              &result.mMinorVersion,
                              result.mHeaders,
                              &result.mNumHeaders,
-                             /*last_len*/ 0);
+                             lastLen);
 }
 
 const std::string kRootPath = "/";
 const char kQuestionMark = '?';
 const std::string kHttP1Prefix = "http1.";
 
-ParseState ParseRequest(std::string_view& buf, std::shared_ptr<HttpRecord>& result, bool forceSample) {
+ParseState
+ParseRequest(std::string_view& buf, std::shared_ptr<HttpRecord>& result, bool forceSample, size_t* scannedLen) {
     HTTPRequest req;
-    int retval = http::ParseHttpRequest(buf, req);
+    int retval = http::ParseHttpRequest(buf, req, scannedLen ? *scannedLen : 0);
     if (retval >= 0) {
         buf.remove_prefix(retval);
+        if (scannedLen) {
+            *scannedLen = 0;
+        }
 
         auto orginPath = std::string(req.mPath, req.mPathLen);
         auto trimPath = TrimString(orginPath);
@@ -117,12 +218,15 @@ ParseState ParseRequest(std::string_view& buf, std::shared_ptr<HttpRecord>& resu
         if (result->ShouldSample() || forceSample) {
             result->SetProtocolVersion(kHttP1Prefix + std::to_string(req.mMinorVersion));
             result->SetMethod(std::string(req.mMethod, req.mMethodLen));
-            result->SetReqHeaderMap(http::GetHTTPHeadersMap(req.mHeaders, req.mNumHeaders));
+            result->SetReqHeaders(http::CopyHTTPHeaders(req.mHeaders, req.mNumHeaders, *result));
             return ParseRequestBody(buf, result);
         }
         return ParseState::kSuccess;
     }
     if (retval == -2) {
+        if (scannedLen) {
+            *scannedLen = buf.size();
+        }
         return ParseState::kNeedsMoreData;
     }
 
@@ -175,16 +279,16 @@ ParseState ParseChunked(std::string_view& data, size_t bodySizeLimitBytes, std::
 
 ParseState ParseRequestBody(std::string_view& buf, std::shared_ptr<HttpRecord>& result) {
     // Case 1: Content-Length
-    const auto contentLengthIter = result->GetReqHeaderMap().find(kContentLength);
-    if (contentLengthIter != result->GetReqHeaderMap().end()) {
-        std::string_view contentLenStr = contentLengthIter->second;
+    const StringView* contentLength = FindHeader(result->GetReqHeaders(), kContentLength);
+    if (contentLength != nullptr) {
+        std::string_view contentLenStr(contentLength->data(), contentLength->size());
         auto r = ParseContent(contentLenStr, buf, 256, result->mReqBody, result->mReqBodySize);
         return r;
     }
 
     // Case 2: Chunked transfer.
-    const auto transferEncodingIter = result->GetReqHeaderMap().find(kTransferEncoding);
-    if (transferEncodingIter != result->GetReqHeaderMap().end() && transferEncodingIter->second == "chunked") {
+    const StringView* transferEncoding = FindHeader(result->GetReqHeaders(), kTransferEncoding);
+    if (transferEncoding != nullptr && *transferEncoding == "chunked") {
         auto s = ParseChunked(buf, 256, result->mReqBody, result->mReqBodySize);
 
         return s;
@@ -202,7 +306,7 @@ ParseState ParseRequestBody(std::string_view& buf, std::shared_ptr<HttpRecord>&
 }
 
 
-int ParseHttpResponse(std::string_view buf, HTTPResponse* result) {
+int ParseHttpResponse(std::string_view buf, HTTPResponse* result, size_t lastLen = 0) {
     return phr_parse_response(buf.data(),
                               buf.size(),
                               &result->mMinorVersion,
@@ -211,26 +315,17 @@ int ParseHttpResponse(std::string_view buf, HTTPResponse* result) {
                               &result->mMsgLen,
                               result->mHeaders,
                               &result->mNumHeaders,
-                              /*last_len*/ 0);
+                              lastLen);
 }
 
 bool ParseContentLength(const std::string_view& contentLenStr, size_t* len) {
-    if (len == nullptr) {
+    if (len == nullptr || contentLenStr.empty()) {
         return false;
     }
 
-    try {
-        size_t pos;
-        std::stoull(contentLenStr.data());
-        *len = std::stoull(std::string(contentLenStr), &pos);
-        if (pos != contentLenStr.size()) {
-            return false;
-        }
-    } catch (const std::exception& e) {
-        return false;
-    }
-
-    return true;
+    const char* end = contentLenStr.data() + contentLenStr.size();
+    auto [ptr, ec] = std::from_chars(contentLenStr.data(), end, *len);
+    return ec == std::errc() && ptr == end;
 }
 
 ParseState ParseContent(std::string_view& contentLenStr,
@@ -243,6 +338,9 @@ ParseState ParseContent(std::string_view& contentLenStr,
         return ParseState::kInvalid;
     }
     if (data.size() < len) {
+        // keep what is captured, the caller may report a truncated body as is
+        result = data.substr(0, std::min(data.size(), bodySizeLimitBytes));
+        bodySize = len;
         return ParseState::kNeedsMoreData;
     }
 
@@ -262,6 +360,17 @@ bool StartsWithHttp(const std::string_view& buf) {
     return buf.size() >= kPrefix.size() && buf.substr(0, kPrefix.size()) == kPrefix;
 }
 
+bool StartsWithHttpMethod(const std::string_view& buf) {
+    static const std::string_view kMethods[]
+        = {"GET ", "POST ", "PUT ", "DELETE ", "HEAD ", "OPTIONS ", "PATCH ", "CONNECT ", "TRACE "};
+    for (const auto& method : kMethods) {
+        if (buf.size() >= method.size() && buf.substr(0, method.size()) == method) {
+            return true;
+        }
+    }
+    return false;
+}
+
 ParseState ParseResponseBody(std::string_view& buf, std::shared_ptr<HttpRecord>& result, bool closed) {
     HTTPResponse r;
     bool adjacentResp = StartsWithHttp(buf) && (ParseHttpResponse(buf, &r) > 0);
@@ -271,17 +380,17 @@ ParseState ParseResponseBody(std::string_view& buf, std::shared_ptr<HttpRecord>&
     }
 
     // Case 1: Content-Length
-    const auto contentLengthIter = result->GetRespHeaderMap().find(kContentLength);
-    if (contentLengthIter != result->GetRespHeaderMap().end()) {
-        std::string_view contentLenStr = contentLengthIter->second;
+    const StringView* contentLength = FindHeader(result->GetRespHeaders(), kContentLength);
+    if (contentLength != nullptr) {
+        std::string_view contentLenStr(contentLength->data(), contentLength->size());
         auto s = ParseContent(contentLenStr, buf, 256, result->mRespBody, result->mRespBodySize);
         // CTX_DCHECK_LE(result->body.size(), FLAGS_http_body_limit_bytes);
         return s;
     }
 
     // Case 2: Chunked transfer.
-    const auto transferEncodingIter = result->GetRespHeaderMap().find(kTransferEncoding);
-    if (transferEncodingIter != result->GetRespHeaderMap().end() && transferEncodingIter->second == "chunked") {
+    const StringView* transferEncoding = FindHeader(result->GetRespHeaders(), kTransferEncoding);
+    if (transferEncoding != nullptr && *transferEncoding == "chunked") {
         auto s = ParseChunked(buf, 256, result->mRespBody, result->mRespBodySize);
         // CTX_DCHECK_LE(result->body.size(), FLAGS_http_body_limit_bytes);
         return s;
@@ -295,8 +404,7 @@ ParseState ParseResponseBody(std::string_view& buf, std::shared_ptr<HttpRecord>&
 
         // Status 101 is an even more special case.
         if (result->mCode == 101) {
-            const auto upgradeIter = result->GetRespHeaderMap().find(kUpgrade);
-            if (upgradeIter == result->GetRespHeaderMap().end()) {
+            if (FindHeader(result->GetRespHeaders(), kUpgrade) == nullptr) {
             }
 
             return ParseState::kEOS;
@@ -318,12 +426,19 @@ ParseState ParseResponseBody(std::string_view& buf, std::shared_ptr<HttpRecord>&
     return ParseState::kSuccess;
 }
 
-ParseState ParseResponse(std::string_view& buf, std::shared_ptr<HttpRecord>& result, bool closed, bool forceSample) {
+ParseState ParseResponse(std::string_view& buf,
+                         std::shared_ptr<HttpRecord>& result,
+                         bool closed,
+                         bool forceSample,
+                         size_t* scannedLen) {
     HTTPResponse resp;
-    int retval = ParseHttpResponse(buf, &resp);
+    int retval = ParseHttpResponse(buf, &resp, scannedLen ? *scannedLen : 0);
 
     if (retval >= 0) {
         buf.remove_prefix(retval);
+        if (scannedLen) {
+            *scannedLen = 0;
+        }
         result->SetStatusCode(resp.mStatus);
         // for 4xx 5xx
         if (result->GetStatusCode() >= 400) {
@@ -331,13 +446,16 @@ ParseState ParseResponse(std::string_view& buf, std::shared_ptr<HttpRecord>& res
         }
 
         if (result->ShouldSample() || forceSample) {
-            result->SetRespHeaderMap(http::GetHTTPHeadersMap(resp.mHeaders, resp.mNumHeaders));
+            result->SetRespHeaders(http::CopyHTTPHeaders(resp.mHeaders, resp.mNumHeaders, *result));
             result->SetRespMsg(std::string(resp.mMsg, resp.mMsgLen));
             return ParseResponseBody(buf, result, closed);
         }
         return ParseState::kSuccess;
     }
     if (retval == -2) {
+        if (scannedLen) {
+            *scannedLen = buf.size();
+        }
         return ParseState::kNeedsMoreData;
     }
     return ParseState::kInvalid;
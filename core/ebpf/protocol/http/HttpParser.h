@@ -70,22 +70,37 @@ enum class ParseState {
 
 namespace http {
 
-ParseState ParseRequest(std::string_view& buf, std::shared_ptr<HttpRecord>& result, bool forceSample = false);
+// scannedLen, when given, carries the number of bytes of buf already scanned without finding the end of headers in a
+// previous call. It is updated on return so that a caller appending more data only has the new bytes rescanned.
+ParseState ParseRequest(std::string_view& buf,
+                        std::shared_ptr<HttpRecord>& result,
+                        bool forceSample = false,
+                        size_t* scannedLen = nullptr);
 
 ParseState ParseRequestBody(std::string_view& buf, std::shared_ptr<HttpRecord>& result);
 
 HeadersMap GetHTTPHeadersMap(const phr_header* headers, size_t numHeaders);
 
+// copies the header block into the record's buffer once and returns views into it
+HeaderViews CopyHTTPHeaders(const phr_header* headers, size_t numHeaders, HttpRecord& record);
+
 ParseState ParseContent(std::string_view& contentLenStr,
                         std::string_view& data,
                         size_t bodySizeLimitBytes,
                         std::string& result,
                         size_t& bodySize);
 
-ParseState
-ParseResponse(std::string_view& buf, std::shared_ptr<HttpRecord>& result, bool closed, bool forceSample = false);
+ParseState ParseResponse(std::string_view& buf,
+                         std::shared_ptr<HttpRecord>& result,
+                         bool closed,
+                         bool forceSample = false,
+                         size_t* scannedLen = nullptr);
+
+int ParseHttpRequest(std::string_view& buf, HTTPRequest& result, size_t lastLen = 0);
+
+bool StartsWithHttp(const std::string_view& buf);
 
-int ParseHttpRequest(std::string_view& buf, HTTPRequest& result);
+bool StartsWithHttpMethod(const std::string_view& buf);
 } // namespace http
 
 
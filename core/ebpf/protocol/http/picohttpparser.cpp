@@ -26,8 +26,19 @@
 
 #include <assert.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <string.h>
-#ifdef __SSE4_2__
+/*
+ * On x86 builds with GCC/Clang the SIMD scanners are compiled with per-function target attributes and selected at
+ * runtime, so the agent binary does not need to be built with -msse4.2/-mavx2 to use them.
+ */
+#if !defined(_MSC_VER) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PHR_SIMD_DISPATCH 1
+#endif
+#if defined(__SSE4_2__) || defined(PHR_SIMD_DISPATCH)
+#define PHR_SIMD 1
+#endif
+#ifdef PHR_SIMD
 #ifdef _MSC_VER
 #include <nmmintrin.h>
 #else
@@ -102,10 +113,18 @@ static const char* token_char_map = "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\
                                     "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0"
                                     "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0";
 
+#ifdef PHR_SIMD_DISPATCH
+#define PHR_TARGET(isa) __attribute__((target(isa)))
+#else
+#define PHR_TARGET(isa)
+#endif
+
+#ifdef PHR_SIMD
+/* scans 16 bytes per step with pcmpestri, ranges_size is at most 16 (8 ranges) */
+PHR_TARGET("sse4.2")
 static const char*
-findchar_fast(const char* buf, const char* buf_end, const char* ranges, size_t ranges_size, int* found) {
+findchar_sse42(const char* buf, const char* buf_end, const char* ranges, size_t ranges_size, int* found) {
     *found = 0;
-#if __SSE4_2__
     if (likely(buf_end - buf >= 16)) {
         __m128i ranges16 = _mm_loadu_si128((const __m128i*)ranges);
 
@@ -123,20 +142,109 @@ findchar_fast(const char* buf, const char* buf_end, const char* ranges, size_t r
             left -= 16;
         } while (likely(left != 0));
     }
+    return buf;
+}
+#endif
+
+#ifdef PHR_SIMD_DISPATCH
+/*
+ * AVX2 has no range-compare instruction, so every [lo, hi] pair is checked as (unsigned)(c - lo) <= (hi - lo) using
+ * min_epu8. The tail that does not fill a 32-byte lane is handed to the SSE4.2 scanner.
+ */
+PHR_TARGET("avx2,sse4.2")
+static const char*
+findchar_avx2(const char* buf, const char* buf_end, const char* ranges, size_t ranges_size, int* found) {
+    *found = 0;
+    if (likely(buf_end - buf >= 32)) {
+        __m256i lows[8];
+        __m256i spans[8];
+        size_t num_ranges = ranges_size / 2;
+        for (size_t i = 0; i < num_ranges; ++i) {
+            unsigned char lo = (unsigned char)ranges[2 * i];
+            unsigned char hi = (unsigned char)ranges[2 * i + 1];
+            lows[i] = _mm256_set1_epi8((char)lo);
+            spans[i] = _mm256_set1_epi8((char)(unsigned char)(hi - lo));
+        }
+        do {
+            __m256i b32 = _mm256_loadu_si256((const __m256i*)buf);
+            __m256i hit = _mm256_setzero_si256();
+            for (size_t i = 0; i < num_ranges; ++i) {
+                __m256i off = _mm256_sub_epi8(b32, lows[i]);
+                hit = _mm256_or_si256(hit, _mm256_cmpeq_epi8(_mm256_min_epu8(off, spans[i]), off));
+            }
+            uint32_t mask = (uint32_t)_mm256_movemask_epi8(hit);
+            if (unlikely(mask != 0)) {
+                *found = 1;
+                return buf + __builtin_ctz(mask);
+            }
+            buf += 32;
+        } while (likely(buf_end - buf >= 32));
+    }
+    return findchar_sse42(buf, buf_end, ranges, ranges_size, found);
+}
+
+static const char*
+findchar_scalar(const char* buf, const char* buf_end, const char* ranges, size_t ranges_size, int* found) {
+    *found = 0;
+    (void)buf_end;
+    (void)ranges;
+    (void)ranges_size;
+    return buf;
+}
+
+typedef const char* (*findchar_func)(const char*, const char*, const char*, size_t, int*);
+
+static findchar_func resolve_findchar(void) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return findchar_avx2;
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+        return findchar_sse42;
+    }
+    return findchar_scalar;
+}
+
+static const findchar_func findchar_impl = resolve_findchar();
+
+int phr_simd_level(void) {
+    if (findchar_impl == findchar_avx2) {
+        return PHR_SIMD_AVX2;
+    }
+    return findchar_impl == findchar_sse42 ? PHR_SIMD_SSE42 : PHR_SIMD_NONE;
+}
 #else
+int phr_simd_level(void) {
+#ifdef PHR_SIMD
+    return PHR_SIMD_SSE42;
+#else
+    return PHR_SIMD_NONE;
+#endif
+}
+#endif
+
+/* returns the first char within any of the ranges, *found is 0 if the scanned prefix has none of them */
+static inline const char*
+findchar_fast(const char* buf, const char* buf_end, const char* ranges, size_t ranges_size, int* found) {
+#if defined(PHR_SIMD_DISPATCH)
+    return findchar_impl(buf, buf_end, ranges, ranges_size, found);
+#elif defined(PHR_SIMD)
+    return findchar_sse42(buf, buf_end, ranges, ranges_size, found);
+#else
+    *found = 0;
     /* suppress unused parameter warning */
     (void)buf_end;
     (void)ranges;
     (void)ranges_size;
-#endif
     return buf;
+#endif
 }
 
 static const char*
 get_token_to_eol(const char* buf, const char* buf_end, const char** token, size_t* token_len, int* ret) {
     const char* token_start = buf;
 
-#ifdef __SSE4_2__
+#ifdef PHR_SIMD
     static const char ALIGNED(16) ranges1[16] = "\0\010" /* allow HT */
                                                 "\012\037" /* allow SP and up to but not including DEL */
                                                 "\177\177"; /* allow chars w. MSB set */
@@ -144,7 +252,7 @@ get_token_to_eol(const char* buf, const char* buf_end, const char** token, size_
     buf = findchar_fast(buf, buf_end, ranges1, 6, &found);
     if (found)
         goto FOUND_CTL;
-#else
+#endif
     /* find non-printable char within the next 8 bytes, this is the hottest code; manually inlined */
     while (likely(buf_end - buf >= 8)) {
 #define DOIT() \
@@ -169,7 +277,6 @@ get_token_to_eol(const char* buf, const char* buf_end, const char** token, size_
         }
         ++buf;
     }
-#endif
     for (;; ++buf) {
         CHECK_EOF();
         if (unlikely(!IS_PRINTABLE_ASCII(*buf))) {
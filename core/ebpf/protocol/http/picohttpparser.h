@@ -99,6 +99,13 @@ ssize_t phr_decode_chunked(struct phr_chunked_decoder* decoder, char* buf, size_
 /* returns if the chunked decoder is in middle of chunked data */
 int phr_decode_chunked_is_in_data(struct phr_chunked_decoder* decoder);
 
+#define PHR_SIMD_NONE 0
+#define PHR_SIMD_SSE42 1
+#define PHR_SIMD_AVX2 2
+
+/* returns the instruction set selected for header scanning, one of PHR_SIMD_* */
+int phr_simd_level(void);
+
 #ifdef __cplusplus
 }
 #endif
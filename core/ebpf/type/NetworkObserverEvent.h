@@ -18,6 +18,7 @@
 #include <string>
 #include <vector>
 
+#include "common/memory/SourceBuffer.h"
 #include "ebpf/plugin/network_observer/Connection.h"
 #include "ebpf/plugin/network_observer/Type.h"
 #include "ebpf/type/table/AppTable.h"
@@ -151,6 +152,25 @@ public:
 
     void SetRespHeaderMap(HeadersMap&& headerMap) { mRespHeaderMap = std::move(headerMap); }
 
+    void SetReqHeaders(HeaderViews&& headers) {
+        mReqHeaders = std::move(headers);
+        mReqHeaderMap.clear();
+    }
+
+    void SetRespHeaders(HeaderViews&& headers) {
+        mRespHeaders = std::move(headers);
+        mRespHeaderMap.clear();
+    }
+
+    // copies data into the record's own buffer, which lives as long as the record
+    StringView CopyToBuffer(const char* data, size_t len) {
+        if (!mSourceBuffer) {
+            mSourceBuffer = std::make_shared<SourceBuffer>();
+        }
+        auto sb = mSourceBuffer->CopyString(data, len);
+        return StringView(sb.data, sb.size);
+    }
+
     void SetRespMsg(std::string&& msg) { mRespMsg = std::move(msg); }
 
     bool IsError() const override { return mCode >= 400; }
@@ -163,8 +183,10 @@ public:
     size_t GetReqBodySize() const override { return mReqBodySize; }
     size_t GetRespBodySize() const override { return mRespBodySize; }
     const std::string& GetMethod() const override { return mHttpMethod; }
-    const HeadersMap& GetReqHeaderMap() const override { return mReqHeaderMap; }
-    const HeadersMap& GetRespHeaderMap() const override { return mRespHeaderMap; }
+    const HeadersMap& GetReqHeaderMap() const override { return BuildHeaderMap(mReqHeaders, mReqHeaderMap); }
+    const HeadersMap& GetRespHeaderMap() const override { return BuildHeaderMap(mRespHeaders, mRespHeaderMap); }
+    const HeaderViews& GetReqHeaders() const { return mReqHeaders; }
+    const HeaderViews& GetRespHeaders() const { return mRespHeaders; }
     const std::string& GetProtocolVersion() const override { return mProtocolVersion; }
     const std::string& GetPath() const override { return mPath; }
     const std::string& GetRealPath() const { return mRealPath; }
@@ -181,8 +203,23 @@ public:
     std::string mHttpMethod;
     std::string mProtocolVersion;
     std::string mRespMsg;
-    HeadersMap mReqHeaderMap;
-    HeadersMap mRespHeaderMap;
+    HeaderViews mReqHeaders;
+    HeaderViews mRespHeaders;
+
+private:
+    // the map form is only built when someone asks for it, parsing itself only produces views
+    static const HeadersMap& BuildHeaderMap(const HeaderViews& views, HeadersMap& map) {
+        if (map.empty() && !views.empty()) {
+            for (const auto& header : views) {
+                map.emplace(header.first.to_string(), header.second.to_string());
+            }
+        }
+        return map;
+    }
+
+    mutable HeadersMap mReqHeaderMap;
+    mutable HeadersMap mRespHeaderMap;
+    std::shared_ptr<SourceBuffer> mSourceBuffer;
 };
 
 class MetricData {
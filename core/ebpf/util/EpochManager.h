@@ -0,0 +1,88 @@
+// Copyright 2025 LoongCollector Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <thread>
+
+namespace logtail::ebpf {
+
+/**
+ * Epoch based reclamation for structures read without locks.
+ *
+ * A reader pins the current epoch for the duration of a Guard. A writer unlinks a node first and then calls Retire,
+ * which advances the epoch and returns it. The node may be freed once MinActiveEpoch() is not below that epoch: every
+ * reader still pinned entered after the unlink and cannot reach the node.
+ */
+class EpochManager {
+public:
+    static constexpr size_t kMaxReaders = 128;
+    static constexpr uint64_t kNoReader = std::numeric_limits<uint64_t>::max();
+
+    class Guard {
+    public:
+        explicit Guard(EpochManager& mgr) : mSlot(mgr.enter()) {}
+        ~Guard() { mSlot->store(0, std::memory_order_release); }
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+    private:
+        std::atomic<uint64_t>* mSlot;
+    };
+
+    uint64_t Retire() { return mGlobalEpoch.fetch_add(1) + 1; }
+
+    uint64_t MinActiveEpoch() const {
+        uint64_t min = kNoReader;
+        for (const auto& slot : mSlots) {
+            uint64_t epoch = slot.mEpoch.load();
+            if (epoch != 0 && epoch < min) {
+                min = epoch;
+            }
+        }
+        return min;
+    }
+
+private:
+    std::atomic<uint64_t>* enter() {
+        static thread_local size_t sHint = std::hash<std::thread::id>()(std::this_thread::get_id()) % kMaxReaders;
+        while (true) {
+            for (size_t i = 0; i < kMaxReaders; ++i) {
+                auto& slot = mSlots[(sHint + i) % kMaxReaders].mEpoch;
+                uint64_t expected = 0;
+                if (slot.load(std::memory_order_relaxed) == 0
+                    && slot.compare_exchange_strong(expected, mGlobalEpoch.load())) {
+                    sHint = (sHint + i) % kMaxReaders;
+                    return &slot;
+                }
+            }
+            // more than kMaxReaders readers at the same time, rare enough to just wait
+            std::this_thread::yield();
+        }
+    }
+
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> mEpoch{0}; // 0 means idle
+    };
+
+    std::atomic<uint64_t> mGlobalEpoch{1};
+    std::array<Slot, kMaxReaders> mSlots;
+};
+
+} // namespace logtail::ebpf
@@ -608,42 +608,37 @@ FileDiscoveryConfig ConfigManager::FindBestMatch(const string& path, const strin
             }
         }
     }
-    const auto& nameConfigMap = FileServer::GetInstance()->GetAllFileDiscoveryConfigs();
-    auto itr = nameConfigMap.begin();
+    vector<FileDiscoveryConfig> candidates;
+    GetCandidateConfigs(path, candidates);
     FileDiscoveryConfig prevMatch(nullptr, nullptr);
     size_t prevLen = 0;
     size_t curLen = 0;
     uint32_t nameRepeat = 0;
     string logNameList;
     vector<FileDiscoveryConfig> multiConfigs;
-    for (; itr != nameConfigMap.end(); ++itr) {
-        const FileDiscoveryOptions* config = itr->second.first;
-        // // exclude __FUSE_CONFIG__
-        // if (itr->first == STRING_FLAG(fuse_customized_config_name)) {
-        //     continue;
-        // }
-
+    for (const auto& candidate : candidates) {
+        const FileDiscoveryOptions* config = candidate.first;
         bool match = config->IsMatch(path, name);
         if (match) {
             // if force multi config, do not send alarm
             if (!name.empty() && !config->mAllowingIncludedByMultiConfigs) {
                 nameRepeat++;
                 logNameList.append("logstore:");
-                logNameList.append(itr->second.second->GetLogstoreName());
+                logNameList.append(candidate.second->GetLogstoreName());
                 logNameList.append(",config:");
-                logNameList.append(itr->second.second->GetConfigName());
+                logNameList.append(candidate.second->GetConfigName());
                 logNameList.append(" ");
-                multiConfigs.push_back(itr->second);
+                multiConfigs.push_back(candidate);
             }
 
             // note: best config is the one which length is longest and create time is nearest
             curLen = config->GetBasePath().size();
             if (prevLen < curLen) {
-                prevMatch = itr->second;
+                prevMatch = candidate;
                 prevLen = curLen;
             } else if (prevLen == curLen && prevMatch.first) {
-                if (prevMatch.second->GetCreateTime() > itr->second.second->GetCreateTime()) {
-                    prevMatch = itr->second;
+                if (prevMatch.second->GetCreateTime() > candidate.second->GetCreateTime()) {
+                    prevMatch = candidate;
                     prevLen = curLen;
                 }
             }
@@ -698,18 +693,11 @@ int32_t ConfigManager::FindAllMatch(vector<FileDiscoveryConfig>& allConfig,
         }
     }
     bool alarmFlag = false;
-    auto nameConfigMap = FileServer::GetInstance()->GetAllFileDiscoveryConfigs();
-    auto itr = nameConfigMap.begin();
-    for (; itr != nameConfigMap.end(); ++itr) {
-        const FileDiscoveryOptions* config = itr->second.first;
-        // // exclude __FUSE_CONFIG__
-        // if (itr->first == STRING_FLAG(fuse_customized_config_name)) {
-        //     continue;
-        // }
-
-        bool match = config->IsMatch(path, name);
-        if (match) {
-            allConfig.push_back(itr->second);
+    vector<FileDiscoveryConfig> candidates;
+    GetCandidateConfigs(path, candidates);
+    for (const auto& candidate : candidates) {
+        if (candidate.first->IsMatch(path, name)) {
+            allConfig.push_back(candidate);
         }
     }
 
@@ -746,21 +734,15 @@ int32_t ConfigManager::FindMatchWithForceFlag(std::vector<FileDiscoveryConfig>&
             }
         }
     }
-    auto nameConfigMap = FileServer::GetInstance()->GetAllFileDiscoveryConfigs();
-    auto itr = nameConfigMap.begin();
+    vector<FileDiscoveryConfig> candidates;
+    GetCandidateConfigs(path, candidates);
     FileDiscoveryConfig prevMatch = make_pair(nullptr, nullptr);
     size_t prevLen = 0;
     size_t curLen = 0;
     uint32_t nameRepeat = 0;
     string logNameList;
     vector<FileDiscoveryConfig> multiConfigs;
-    for (; itr != nameConfigMap.end(); ++itr) {
-        FileDiscoveryConfig config = itr->second;
-        // // exclude __FUSE_CONFIG__
-        // if (itr->first == STRING_FLAG(fuse_customized_config_name)) {
-        //     continue;
-        // }
-
+    for (const auto& config : candidates) {
         bool match = config.first->IsMatch(path, name);
         if (match) {
             // if force multi config, do not send alarm
@@ -869,14 +851,37 @@ void ConfigManager::DeleteHandlers() {
 // 1. No wildcard path: the base path of Config is the prefix of @path and within depth.
 // 2. Wildcard path: @path matches and within depth.
 void ConfigManager::GetRelatedConfigs(const std::string& path, std::vector<FileDiscoveryConfig>& configs) {
-    const auto& nameConfigMap = FileServer::GetInstance()->GetAllFileDiscoveryConfigs();
-    for (auto iter = nameConfigMap.begin(); iter != nameConfigMap.end(); ++iter) {
-        if (iter->second.first->IsMatch(path, "")) {
-            configs.push_back(iter->second);
+    vector<FileDiscoveryConfig> candidates;
+    GetCandidateConfigs(path, candidates);
+    for (const auto& candidate : candidates) {
+        if (candidate.first->IsMatch(path, "")) {
+            configs.push_back(candidate);
         }
     }
 }
 
+void ConfigManager::GetCandidateConfigs(const std::string& path, std::vector<FileDiscoveryConfig>& candidates) {
+    // versions are read before building, so that a change during the build leads to another rebuild next time
+    uint64_t configVersion = FileServer::GetInstance()->GetFileDiscoveryConfigVersion();
+    uint64_t containerInfoVersion = FileDiscoveryOptions::GetContainerInfoVersion();
+    shared_ptr<const FileDiscoveryConfigIndex> index;
+    {
+        ScopedSpinLock lock(mFileDiscoveryConfigIndexLock);
+        if (mFileDiscoveryConfigIndex && mIndexedFileDiscoveryConfigVersion == configVersion
+            && mIndexedContainerInfoVersion == containerInfoVersion) {
+            index = mFileDiscoveryConfigIndex;
+        }
+    }
+    if (!index) {
+        index = make_shared<const FileDiscoveryConfigIndex>(FileServer::GetInstance()->GetAllFileDiscoveryConfigs());
+        ScopedSpinLock lock(mFileDiscoveryConfigIndexLock);
+        mFileDiscoveryConfigIndex = index;
+        mIndexedFileDiscoveryConfigVersion = configVersion;
+        mIndexedContainerInfoVersion = containerInfoVersion;
+    }
+    index->GetCandidates(path, candidates);
+}
+
 bool ConfigManager::UpdateContainerPath(ConfigContainerInfoUpdateCmd* cmd) {
     mContainerInfoCmdLock.lock();
     mContainerInfoCmdVec.push_back(cmd);
@@ -18,6 +18,7 @@
 
 #include <cstdint>
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -25,6 +26,7 @@
 
 #include "common/Lock.h"
 #include "container_manager/ConfigContainerInfoUpdateCmd.h"
+#include "file_server/FileDiscoveryConfigIndex.h"
 #include "file_server/FileDiscoveryOptions.h"
 #include "file_server/event/Event.h"
 
@@ -157,6 +159,11 @@ protected:
     SpinLock mCacheFileAllConfigMapLock;
     std::unordered_map<std::string, std::pair<std::vector<FileDiscoveryConfig>, int32_t>> mCacheFileAllConfigMap;
 
+    SpinLock mFileDiscoveryConfigIndexLock;
+    std::shared_ptr<const FileDiscoveryConfigIndex> mFileDiscoveryConfigIndex;
+    uint64_t mIndexedFileDiscoveryConfigVersion = 0;
+    uint64_t mIndexedContainerInfoVersion = 0;
+
     PTMutex mContainerInfoCmdLock;
     std::vector<ConfigContainerInfoUpdateCmd*> mContainerInfoCmdVec;
 
@@ -436,6 +443,10 @@ public:
 
     void GetRelatedConfigs(const std::string& path, std::vector<FileDiscoveryConfig>& configs);
 
+    // candidates that may match the path, in the iteration order of FileServer::GetAllFileDiscoveryConfigs(), the index
+    // is rebuilt once configs or their container info change
+    void GetCandidateConfigs(const std::string& path, std::vector<FileDiscoveryConfig>& candidates);
+
     EventHandler* GetSharedHandler() { return mSharedHandler; }
 
     bool RegisterDirectory(const std::string& source, const std::string& object);
@@ -84,6 +84,7 @@ DEFINE_FLAG_INT32(existed_file_active_timeout,
 DEFINE_FLAG_INT32(checkpoint_find_max_cache_size, "", 100000);
 DEFINE_FLAG_INT32(max_watch_dir_count, "", 100 * 1000);
 DEFINE_FLAG_INT32(default_max_inotify_watch_num, "the max allowed inotify watch dir number", 3000);
+DEFINE_FLAG_INT32(inotify_wd_table_max_size, "max wd of inotify watches looked up by a flat table", 65536);
 
 namespace logtail {
 
@@ -720,6 +721,17 @@ bool EventDispatcher::AddTimeoutWatch(const string& path) {
 void EventDispatcher::AddOneToOneMapEntry(DirInfo* dirInfo, int wd) {
     mPathWdMap[dirInfo->mPath] = wd;
     mWdDirInfoMap[wd] = dirInfo;
+    // wds are allocated cyclically by the kernel, so the table is bounded instead of being sized by watch count
+    if (wd < 0) {
+        return;
+    }
+    if (static_cast<size_t>(wd) >= mWdDirInfoTable.size()) {
+        if (wd >= INT32_FLAG(inotify_wd_table_max_size)) {
+            return;
+        }
+        mWdDirInfoTable.resize(wd + 1, nullptr);
+    }
+    mWdDirInfoTable[wd] = dirInfo;
 }
 
 void EventDispatcher::RemoveOneToOneMapEntry(int wd) {
@@ -729,6 +741,9 @@ void EventDispatcher::RemoveOneToOneMapEntry(int wd) {
     mPathWdMap.erase((itr->second)->mPath);
     delete itr->second;
     mWdDirInfoMap.erase(itr);
+    if (wd >= 0 && static_cast<size_t>(wd) < mWdDirInfoTable.size()) {
+        mWdDirInfoTable[wd] = nullptr;
+    }
 }
 
 void EventDispatcher::DumpInotifyWatcherDirs() {
@@ -892,13 +907,20 @@ bool EventDispatcher::IsRegistered(const std::string& path) {
 }
 
 bool EventDispatcher::IsRegistered(int wd, string& path) {
-    MapType<int, DirInfo*>::Type::iterator itr = mWdDirInfoMap.find(wd);
-    if (itr == mWdDirInfoMap.end())
+    const DirInfo* dirInfo = GetInotifyDirInfo(wd);
+    if (dirInfo == nullptr) {
         return false;
-    else {
-        path = (itr->second)->mPath;
-        return true;
     }
+    path = dirInfo->mPath;
+    return true;
+}
+
+const DirInfo* EventDispatcher::GetInotifyDirInfo(int wd) const {
+    if (wd >= 0 && static_cast<size_t>(wd) < mWdDirInfoTable.size()) {
+        return mWdDirInfoTable[wd];
+    }
+    auto itr = mWdDirInfoMap.find(wd);
+    return itr == mWdDirInfoMap.end() ? nullptr : itr->second;
 }
 
 void EventDispatcher::HandleTimeout() {
@@ -1036,6 +1058,7 @@ void EventDispatcher::CleanEnviroments() {
     for (MapType<int, DirInfo*>::Type::iterator iter = mWdDirInfoMap.begin(); iter != mWdDirInfoMap.end(); ++iter)
         delete iter->second;
     mWdDirInfoMap.clear();
+    mWdDirInfoTable.clear();
     mBrokenLinkSet.clear();
     mWdUpdateTimeMap.clear();
     // for (unordered_map<int64_t, SingleDSPacket*>::iterator iter = mPacketBuffer.begin();
@@ -201,6 +201,8 @@ public:
     std::vector<std::pair<std::string, EventHandler*> > FindAllSubDirAndHandler(const std::string& baseDir);
     void UnregisterAllDir(const std::string& basePath);
     bool IsRegistered(int wd, std::string& path);
+    // GetInotifyDirInfo returns the DirInfo registered with @wd, or nullptr if not registered.
+    const DirInfo* GetInotifyDirInfo(int wd) const;
     void CheckSymbolicLink();
 
     void DumpCheckPointPeriod(int32_t curTime);
@@ -268,6 +270,9 @@ protected:
 
     MapType<std::string, int>::Type mPathWdMap;
     MapType<int, DirInfo*>::Type mWdDirInfoMap;
+    // mirror of mWdDirInfoMap indexed by wd, so that inotify events are resolved without hashing,
+    // wds larger than inotify_wd_table_max_size are only kept in mWdDirInfoMap
+    std::vector<DirInfo*> mWdDirInfoTable;
     std::set<std::string> mBrokenLinkSet;
     // for timeout issue
     MapType<int, time_t>::Type mWdUpdateTimeMap;
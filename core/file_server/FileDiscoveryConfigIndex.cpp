@@ -0,0 +1,117 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "file_server/FileDiscoveryConfigIndex.h"
+
+#include <algorithm>
+
+#include "common/FileSystemUtil.h"
+
+using namespace std;
+
+namespace logtail {
+
+// wildcard base paths are matched by fnmatch, which also treats [ and \ specially
+static string GetLiteralPrefix(const string& wildcardPath) {
+#if defined(__linux__)
+    size_t pos = wildcardPath.find_first_of("[\\");
+    if (pos != string::npos) {
+        pos = wildcardPath.rfind(PATH_SEPARATOR[0], pos);
+        return pos == string::npos ? string() : wildcardPath.substr(0, pos);
+    }
+#endif
+    return wildcardPath;
+}
+
+FileDiscoveryConfigIndex::FileDiscoveryConfigIndex(const unordered_map<string, FileDiscoveryConfig>& configs) {
+    mConfigs.reserve(configs.size());
+    for (const auto& item : configs) {
+        const FileDiscoveryOptions* opts = item.second.first;
+        uint32_t idx = mConfigs.size();
+        mConfigs.push_back(item.second);
+        if (opts->IsContainerDiscoveryEnabled()) {
+            // config paths are converted to paths in containers before matching, and nothing matches without a
+            // container
+            if (!opts->GetContainerInfo()) {
+                continue;
+            }
+            for (const auto& info : *opts->GetContainerInfo()) {
+                Insert(info.mRealBaseDir, idx);
+            }
+        } else if (opts->GetWildcardPaths().empty()) {
+            Insert(opts->GetBasePath(), idx);
+        } else {
+            Insert(GetLiteralPrefix(opts->GetWildcardPaths()[0]), idx);
+        }
+    }
+}
+
+void FileDiscoveryConfigIndex::Insert(const string& prefix, uint32_t idx) {
+    Node* node = &mRoot;
+    size_t begin = 0;
+    while (begin < prefix.size()) {
+        size_t end = prefix.find(PATH_SEPARATOR[0], begin);
+        if (end == string::npos) {
+            end = prefix.size();
+        }
+        // empty segments are skipped on both insertion and lookup, which only ever adds candidates
+        if (end > begin) {
+            auto& child = node->mChildren[prefix.substr(begin, end - begin)];
+            if (!child) {
+                child = make_unique<Node>();
+            }
+            node = child.get();
+        }
+        begin = end + 1;
+    }
+    if (node->mConfigs.empty() || node->mConfigs.back() != idx) {
+        node->mConfigs.push_back(idx);
+    }
+}
+
+void FileDiscoveryConfigIndex::GetCandidates(const string& path, vector<FileDiscoveryConfig>& candidates) const {
+    static thread_local vector<uint32_t> sMatched;
+    static thread_local string sSegment;
+    sMatched.clear();
+
+    const Node* node = &mRoot;
+    sMatched.insert(sMatched.end(), node->mConfigs.begin(), node->mConfigs.end());
+    size_t begin = 0;
+    while (begin < path.size() && !node->mChildren.empty()) {
+        size_t end = path.find(PATH_SEPARATOR[0], begin);
+        if (end == string::npos) {
+            end = path.size();
+        }
+        if (end > begin) {
+            sSegment.assign(path, begin, end - begin);
+            auto iter = node->mChildren.find(sSegment);
+            if (iter == node->mChildren.end()) {
+                break;
+            }
+            node = iter->second.get();
+            sMatched.insert(sMatched.end(), node->mConfigs.begin(), node->mConfigs.end());
+        }
+        begin = end + 1;
+    }
+
+    // a container config may be registered on several nodes along the path
+    sort(sMatched.begin(), sMatched.end());
+    sMatched.erase(unique(sMatched.begin(), sMatched.end()), sMatched.end());
+    candidates.reserve(candidates.size() + sMatched.size());
+    for (uint32_t idx : sMatched) {
+        candidates.push_back(mConfigs[idx]);
+    }
+}
+
+} // namespace logtail
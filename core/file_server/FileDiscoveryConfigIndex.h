@@ -0,0 +1,64 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "file_server/FileDiscoveryOptions.h"
+
+namespace logtail {
+
+// FileDiscoveryConfigIndex narrows down the file discovery configs that may match a path, so that
+// FileDiscoveryOptions::IsMatch is only called on those instead of on every config.
+//
+// Every config is inserted into a trie of path segments under the literal part of its base path: the base path itself,
+// the directory before the first wildcard segment, or the real base dir of each container. Any config which could match
+// a path is registered on a node along that path, so walking the segments of the path from the root gives a superset of
+// the matched configs. File name patterns, wildcard segments, max depth and blacklists are left to IsMatch.
+class FileDiscoveryConfigIndex {
+public:
+    explicit FileDiscoveryConfigIndex(const std::unordered_map<std::string, FileDiscoveryConfig>& configs);
+    FileDiscoveryConfigIndex(const FileDiscoveryConfigIndex&) = delete;
+    FileDiscoveryConfigIndex& operator=(const FileDiscoveryConfigIndex&) = delete;
+
+    // candidates are appended in the iteration order of the map the index is built from, the same order in which a
+    // full scan would visit them
+    void GetCandidates(const std::string& path, std::vector<FileDiscoveryConfig>& candidates) const;
+    size_t Size() const { return mConfigs.size(); }
+
+private:
+    struct Node {
+        std::unordered_map<std::string, std::unique_ptr<Node>> mChildren;
+        std::vector<uint32_t> mConfigs;
+    };
+
+    void Insert(const std::string& prefix, uint32_t idx);
+
+    std::vector<FileDiscoveryConfig> mConfigs;
+    Node mRoot;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class FileDiscoveryConfigIndexUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -29,6 +29,8 @@ using namespace std;
 
 namespace logtail {
 
+atomic_uint64_t FileDiscoveryOptions::sContainerInfoVersion{0};
+
 // basePath must not stop with '/'
 inline bool _IsSubPath(const string& basePath, const string& subPath) {
     size_t pathSize = subPath.size();
@@ -730,11 +732,13 @@ bool FileDiscoveryOptions::UpdateContainerInfo(const Json::Value& paramsJSON, co
             if ((*mContainerInfos)[i].mID == containerInfo.mID) {
                 // update
                 (*mContainerInfos)[i] = containerInfo;
+                ++sContainerInfoVersion;
                 return true;
             }
         }
         // add
         mContainerInfos->push_back(containerInfo);
+        ++sContainerInfoVersion;
         return true;
     }
 
@@ -756,6 +760,7 @@ bool FileDiscoveryOptions::UpdateContainerInfo(const Json::Value& paramsJSON, co
         }
         mContainerInfos->push_back(iter.second);
     }
+    ++sContainerInfoVersion;
     return success;
 }
 
@@ -772,6 +777,7 @@ bool FileDiscoveryOptions::DeleteContainerInfo(const Json::Value& paramsJSON) {
     for (vector<ContainerInfo>::iterator iter = mContainerInfos->begin(); iter != mContainerInfos->end(); ++iter) {
         if (iter->mID == containerInfo.mID) {
             mContainerInfos->erase(iter);
+            ++sContainerInfoVersion;
             break;
         }
     }
@@ -18,6 +18,7 @@
 
 #include <cstdint>
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <utility>
@@ -46,7 +47,12 @@ public:
     bool IsContainerDiscoveryEnabled() const { return mEnableContainerDiscovery; }
     void SetEnableContainerDiscoveryFlag(bool flag) { mEnableContainerDiscovery = true; }
     const std::shared_ptr<std::vector<ContainerInfo>>& GetContainerInfo() const { return mContainerInfos; }
-    void SetContainerInfo(const std::shared_ptr<std::vector<ContainerInfo>>& info) { mContainerInfos = info; }
+    void SetContainerInfo(const std::shared_ptr<std::vector<ContainerInfo>>& info) {
+        mContainerInfos = info;
+        ++sContainerInfoVersion;
+    }
+    // bumped whenever container info of any config changes, so that FileDiscoveryConfigIndex can be rebuilt
+    static uint64_t GetContainerInfoVersion() { return sContainerInfoVersion.load(); }
     void SetDeduceAndSetContainerBaseDirFunc(bool (*f)(ContainerInfo&,
                                                        const CollectionPipelineContext*,
                                                        const FileDiscoveryOptions*)) {
@@ -109,6 +115,8 @@ private:
     // mFilePattern, but works in reversed way.
     std::vector<std::string> mFileNameBlacklist;
 
+    static std::atomic_uint64_t sContainerInfoVersion;
+
     bool mEnableContainerDiscovery = false;
     std::shared_ptr<std::vector<ContainerInfo>> mContainerInfos; // must not be null if container discovery is enabled
     bool (*mDeduceAndSetContainerBaseDirFunc)(ContainerInfo& containerInfo,
@@ -140,12 +140,14 @@ void FileServer::AddFileDiscoveryConfig(const string& name,
                                         const CollectionPipelineContext* ctx) {
     WriteLock lock(mReadWriteLock);
     mPipelineNameFileDiscoveryConfigsMap[name] = make_pair(opts, ctx);
+    ++mFileDiscoveryConfigVersion;
 }
 
 // 移除给定名称的文件发现配置
 void FileServer::RemoveFileDiscoveryConfig(const string& name) {
     WriteLock lock(mReadWriteLock);
     mPipelineNameFileDiscoveryConfigsMap.erase(name);
+    ++mFileDiscoveryConfigVersion;
 }
 
 // 获取给定名称的文件读取器配置
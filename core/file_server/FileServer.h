@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -53,6 +54,8 @@ public:
     void
     AddFileDiscoveryConfig(const std::string& name, FileDiscoveryOptions* opts, const CollectionPipelineContext* ctx);
     void RemoveFileDiscoveryConfig(const std::string& name);
+    // bumped on every add or remove of file discovery configs
+    uint64_t GetFileDiscoveryConfigVersion() const { return mFileDiscoveryConfigVersion.load(); }
 
     FileReaderConfig GetFileReaderConfig(const std::string& name) const;
     const std::unordered_map<std::string, FileReaderConfig>& GetAllFileReaderConfigs() const {
@@ -110,6 +113,7 @@ private:
     mutable ReadWriteLock mReadWriteLock;
 
     std::unordered_map<std::string, FileDiscoveryConfig> mPipelineNameFileDiscoveryConfigsMap;
+    std::atomic_uint64_t mFileDiscoveryConfigVersion{0};
     std::unordered_map<std::string, FileReaderConfig> mPipelineNameFileReaderConfigsMap;
     std::unordered_map<std::string, MultilineConfig> mPipelineNameMultilineConfigsMap;
     std::unordered_map<std::string, FileTagConfig> mPipelineNameFileTagConfigsMap;
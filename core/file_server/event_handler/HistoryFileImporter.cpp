@@ -14,21 +14,42 @@
 
 #include "HistoryFileImporter.h"
 
+#include <fcntl.h>
+
+#include <cstring>
+#include <limits>
+
 #include "app_config/AppConfig.h"
+#include "checkpoint/AdhocCheckpointManager.h"
 #include "collection_pipeline/queue/ProcessQueueManager.h"
 #include "common/FileSystemUtil.h"
+#include "common/Flags.h"
+#include "common/HashUtil.h"
 #include "common/RuntimeUtil.h"
 #include "common/Thread.h"
 #include "common/TimeUtil.h"
 #include "file_server/ConfigManager.h"
+#include "file_server/FileServer.h"
 #include "file_server/reader/LogFileReader.h"
 #include "logger/Logger.h"
+#include "monitor/metric_constants/MetricConstants.h"
 #include "runner/ProcessorRunner.h"
 
+DEFINE_FLAG_INT32(history_file_import_thread_count,
+                  "threads reading history files of one import, files are read one by one if not more than 1",
+                  1);
+DEFINE_FLAG_INT64(history_file_import_chunk_size,
+                  "history files larger than this are split into chunks read in parallel, bytes",
+                  256 * 1024 * 1024);
+
 namespace logtail {
 
 HistoryFileImporter::HistoryFileImporter() {
     LOG_INFO(sLogger, ("HistoryFileImporter", "init"));
+    mImportSizeBytes
+        = FileServer::GetInstance()->GetMetricsRecordRef().CreateCounter(METRIC_RUNNER_FILE_HISTORY_IMPORT_SIZE_BYTES);
+    mImportThroughput = FileServer::GetInstance()->GetMetricsRecordRef().CreateDoubleGauge(
+        METRIC_RUNNER_FILE_HISTORY_IMPORT_THROUGHPUT_GB_PER_SEC);
     mThread = CreateThread([this]() { Run(); });
 }
 
@@ -46,7 +67,11 @@ void HistoryFileImporter::Run() {
             LOG_WARNING(sLogger, ("get all files", "failed"));
             continue;
         }
-        ProcessEvent(event, objList);
+        if (INT32_FLAG(history_file_import_thread_count) > 1) {
+            ProcessEventInParallel(event, objList);
+        } else {
+            ProcessEvent(event, objList);
+        }
     }
 }
 
@@ -109,7 +134,9 @@ void HistoryFileImporter::ProcessEvent(const HistoryFileEvent& event, const std:
                 usleep(1000 * 10);
             }
             std::unique_ptr<LogBuffer> logBuffer(new LogBuffer);
+            int64_t lastFilePos = readerSharePtr->GetLastFilePos();
             readerSharePtr->ReadLog(*logBuffer, nullptr);
+            ADD_COUNTER(mImportSizeBytes, readerSharePtr->GetLastFilePos() - lastFilePos);
             if (!logBuffer->rawBuffer.empty()) {
                 logBuffer->logFileReader = readerSharePtr;
 
@@ -133,4 +160,224 @@ void HistoryFileImporter::ProcessEvent(const HistoryFileEvent& event, const std:
                      "file", filePath)("offset", readerSharePtr->GetLastFilePos())("time(ms)", doneTime - startTime));
     }
 }
+
+void HistoryFileImporter::ProcessEventInParallel(const HistoryFileEvent& event,
+                                                 const std::vector<std::string>& fileNames) {
+    auto* checkpointManager = AdhocCheckpointManager::GetInstance();
+    const std::string jobName
+        = "history_" + ToString(HashString(event.mConfigName + "*" + event.mDirName + "*" + event.mFileName));
+    const std::string checkpointPath = checkpointManager->GetJobCheckpointPath(jobName);
+
+    // resume from the checkpoint of an interrupted import, chunks of files changed since then are dropped
+    AdhocJobCheckpoint jobCheckpoint(jobName);
+    if (jobCheckpoint.Load(checkpointPath)) {
+        for (const auto& chunk : jobCheckpoint.GetFileCheckpointList()) {
+            if (chunk->mStatus != STATUS_WAITING && chunk->mStatus != STATUS_LOADING) {
+                continue;
+            }
+            auto current = checkpointManager->CreateAdhocFileCheckpoint(jobName, chunk->mFileName);
+            if (!current || current->mDevInode != chunk->mDevInode || current->mSignatureHash != chunk->mSignatureHash
+                || current->mSignatureSize != chunk->mSignatureSize || current->mSize < chunk->mSize) {
+                LOG_WARNING(sLogger, ("history file changed since last import, skip", chunk->mFileName));
+                chunk->mStatus = STATUS_LOST;
+            }
+        }
+        LOG_INFO(sLogger,
+                 ("resume history file import, job", jobName)("chunk count",
+                                                              jobCheckpoint.GetFileCheckpointList().size()));
+    } else {
+        for (auto& chunk : SplitFiles(event, jobName, fileNames)) {
+            jobCheckpoint.AddFileCheckpoint(chunk);
+        }
+    }
+    const auto& chunks = jobCheckpoint.GetFileCheckpointList();
+    jobCheckpoint.Dump(checkpointPath, false);
+
+    auto startTime = GetCurrentTimeInMilliSeconds();
+    int64_t startBytes = mImportedBytes.load();
+    std::mutex chunkMux;
+    std::atomic_size_t nextChunk{0};
+    std::atomic_int runningWorkers{0};
+    std::vector<ThreadPtr> workers;
+    size_t workerCount = std::min(chunks.size(), static_cast<size_t>(INT32_FLAG(history_file_import_thread_count)));
+    LOG_INFO(sLogger,
+             ("begin load history files in parallel, file count", fileNames.size())("chunk count", chunks.size())(
+                 "thread count", workerCount)("job", jobName));
+    runningWorkers = workerCount;
+    for (size_t i = 0; i < workerCount; ++i) {
+        workers.push_back(CreateThread([&]() {
+            for (size_t idx = nextChunk++; idx < chunks.size(); idx = nextChunk++) {
+                ImportChunk(event, *chunks[idx], chunkMux);
+            }
+            --runningWorkers;
+        }));
+    }
+
+    auto lastTime = startTime;
+    int64_t lastBytes = startBytes;
+    while (runningWorkers > 0) {
+        usleep(1000 * 1000);
+        auto now = GetCurrentTimeInMilliSeconds();
+        int64_t bytes = mImportedBytes.load();
+        SET_GAUGE(mImportThroughput, (bytes - lastBytes) / 1e9 / std::max<double>((now - lastTime) / 1000.0, 0.001));
+        lastTime = now;
+        lastBytes = bytes;
+        std::lock_guard<std::mutex> lock(chunkMux);
+        jobCheckpoint.Dump(checkpointPath, true);
+    }
+    for (auto& worker : workers) {
+        worker->Wait(0);
+    }
+    SET_GAUGE(mImportThroughput, 0);
+
+    // every chunk is either finished or lost by now, so the import is never resumed
+    jobCheckpoint.Dump(checkpointPath, false);
+    remove(checkpointPath.c_str());
+    double seconds = std::max<double>((GetCurrentTimeInMilliSeconds() - startTime) / 1000.0, 0.001);
+    double gigaBytes = (mImportedBytes.load() - startBytes) / 1e9;
+    LOG_INFO(sLogger,
+             ("load history files in parallel", "done")("job", jobName)("GB", gigaBytes)("time(s)", seconds)(
+                 "GB/s", gigaBytes / seconds));
+}
+
+std::vector<AdhocFileCheckpointPtr> HistoryFileImporter::SplitFiles(const HistoryFileEvent& event,
+                                                                    const std::string& jobName,
+                                                                    const std::vector<std::string>& fileNames) {
+    // a multiline event may span chunk boundaries
+    int64_t chunkSize = event.mMultilineConfig.first && event.mMultilineConfig.first->IsMultiline()
+        ? std::numeric_limits<int64_t>::max()
+        : std::max<int64_t>(INT64_FLAG(history_file_import_chunk_size), 1);
+    std::vector<AdhocFileCheckpointPtr> chunks;
+    std::vector<char> buf(64 * 1024);
+    for (const auto& fileName : fileNames) {
+        const std::string filePath = PathJoin(event.mDirName, fileName);
+        auto file = AdhocCheckpointManager::GetInstance()->CreateAdhocFileCheckpoint(jobName, filePath);
+        if (!file || !file->mDevInode.IsValid()) {
+            LOG_WARNING(sLogger, ("history file can not be loaded, skip", filePath));
+            continue;
+        }
+        int fd = open(filePath.c_str(), O_RDONLY);
+        if (fd < 0) {
+            LOG_WARNING(sLogger, ("fail to open history file, skip", filePath)("errno", errno));
+            continue;
+        }
+        int64_t fileSize = file->mSize;
+        int64_t begin = std::min(event.mStartPos, fileSize);
+        do {
+            // each chunk ends right after a line feed, or at the end of the file
+            int64_t end = fileSize - begin > chunkSize ? begin + chunkSize : fileSize;
+            while (end < fileSize) {
+                ssize_t nbytes = pread(fd, buf.data(), buf.size(), end - 1);
+                if (nbytes <= 0) {
+                    end = fileSize;
+                    break;
+                }
+                auto* lineFeed = static_cast<char*>(memchr(buf.data(), '\n', nbytes));
+                if (lineFeed != nullptr) {
+                    end += lineFeed - buf.data();
+                    break;
+                }
+                end += nbytes;
+            }
+            end = std::min(end, fileSize);
+            auto chunk = std::make_shared<AdhocFileCheckpoint>(*file);
+            chunk->mOffset = begin;
+            chunk->mSize = end;
+            chunks.push_back(chunk);
+            begin = end;
+        } while (begin < fileSize);
+        close(fd);
+    }
+    return chunks;
+}
+
+void HistoryFileImporter::ImportChunk(const HistoryFileEvent& event, AdhocFileCheckpoint& chunk, std::mutex& chunkMux) {
+    static ProcessorRunner* logProcess = ProcessorRunner::GetInstance();
+    {
+        std::lock_guard<std::mutex> lock(chunkMux);
+        if (chunk.mStatus != STATUS_WAITING && chunk.mStatus != STATUS_LOADING) {
+            return;
+        }
+        if (chunk.mStatus == STATUS_WAITING) {
+            chunk.mStatus = STATUS_LOADING;
+            chunk.mStartTime = time(NULL);
+        }
+    }
+    auto markChunk = [&](FileReadStatus status, int64_t offset) {
+        std::lock_guard<std::mutex> lock(chunkMux);
+        chunk.mStatus = status;
+        chunk.mOffset = offset;
+        chunk.mLastUpdateTime = time(NULL);
+    };
+
+    size_t lastSeparator = chunk.mFileName.find_last_of(PATH_SEPARATOR[0]);
+    std::string dirName = chunk.mFileName.substr(0, lastSeparator);
+    std::string fileName = chunk.mFileName.substr(lastSeparator + 1);
+    LogFileReaderPtr readerSharePtr(LogFileReader::CreateLogFileReader(dirName,
+                                                                       fileName,
+                                                                       chunk.mDevInode,
+                                                                       event.mReaderConfig,
+                                                                       event.mMultilineConfig,
+                                                                       event.mDiscoveryconfig,
+                                                                       event.mTagConfig,
+                                                                       event.mEOConcurrency,
+                                                                       true));
+    if (readerSharePtr == NULL || !readerSharePtr->UpdateFilePtr()) {
+        LOG_WARNING(sLogger,
+                    ("process history file chunk", "failed")("file", chunk.mFileName)("offset", chunk.mOffset)(
+                        "reason", "open file failed"));
+        markChunk(STATUS_LOST, chunk.mOffset);
+        return;
+    }
+    readerSharePtr->SetLastFilePos(chunk.mOffset);
+    readerSharePtr->CheckFileSignatureAndOffset(false);
+    readerSharePtr->SetLastFileSize(chunk.mSize);
+
+    // @return true if anything is read
+    auto readAndPush = [&](const Event* flushEvent) {
+        while (!ProcessQueueManager::GetInstance()->IsValidToPush(readerSharePtr->GetQueueKey())) {
+            usleep(1000 * 10);
+        }
+        std::unique_ptr<LogBuffer> logBuffer(new LogBuffer);
+        int64_t lastFilePos = readerSharePtr->GetLastFilePos();
+        readerSharePtr->ReadLog(*logBuffer, flushEvent);
+        int64_t readBytes = readerSharePtr->GetLastFilePos() - lastFilePos;
+        mImportedBytes += readBytes;
+        ADD_COUNTER(mImportSizeBytes, readBytes);
+        if (logBuffer->rawBuffer.empty()) {
+            return false;
+        }
+        logBuffer->logFileReader = readerSharePtr;
+        PipelineEventGroup group = LogFileReader::GenerateEventGroup(readerSharePtr, logBuffer.get());
+        logProcess->PushQueue(readerSharePtr->GetQueueKey(), 0, std::move(group), 100000000);
+        markChunk(STATUS_LOADING, readerSharePtr->GetLastFilePos());
+        return true;
+    };
+
+    bool doneFlag = false;
+    while (true) {
+        if (!readAndPush(nullptr)) {
+            if (doneFlag) {
+                break;
+            }
+            doneFlag = true;
+        }
+    }
+    if (!readerSharePtr->IsReadToEnd()) {
+        LOG_WARNING(sLogger,
+                    ("process history file chunk", "failed")("file", chunk.mFileName)("offset",
+                                                                                     readerSharePtr->GetLastFilePos())(
+                        "end offset", chunk.mSize)("reason", "file is truncated"));
+        markChunk(STATUS_LOST, readerSharePtr->GetLastFilePos());
+        return;
+    }
+    // the last line of a file without a line feed stays in the cache of the reader, and is complete at the end of
+    // the file, so it is read at once instead of waiting for the flush timeout
+    if (readerSharePtr->HasDataInCache()) {
+        auto timeoutEvent = readerSharePtr->CreateFlushTimeoutEvent();
+        readAndPush(timeoutEvent.get());
+    }
+    markChunk(STATUS_FINISHED, chunk.mSize);
+}
+
 } // namespace logtail
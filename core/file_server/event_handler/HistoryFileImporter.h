@@ -15,12 +15,17 @@
  */
 
 #pragma once
+#include <atomic>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
+#include "checkpoint/AdhocFileCheckpoint.h"
 #include "common/CircularBuffer.h"
 #include "common/StringTools.h"
 #include "common/Thread.h"
+#include "monitor/metric_models/MetricTypes.h"
 #include "plugin/input/InputFile.h"
 
 namespace logtail {
@@ -64,11 +69,28 @@ private:
     // @todo multi line, flush last buffer
     void ProcessEvent(const HistoryFileEvent& event, const std::vector<std::string>& fileNames);
 
+    // With history_file_import_thread_count above 1, files are split into newline aligned chunks of at most
+    // history_file_import_chunk_size bytes and read by that many threads. Each chunk has its own range in the adhoc
+    // checkpoint of the import, so an import interrupted by a restart resumes from where every chunk stopped.
+    void ProcessEventInParallel(const HistoryFileEvent& event, const std::vector<std::string>& fileNames);
+    std::vector<AdhocFileCheckpointPtr> SplitFiles(const HistoryFileEvent& event,
+                                                   const std::string& jobName,
+                                                   const std::vector<std::string>& fileNames);
+    void ImportChunk(const HistoryFileEvent& event, AdhocFileCheckpoint& chunk, std::mutex& chunkMux);
+
     static const int32_t HISTORY_EVENT_MAX = 10000;
     CircularBufferSem<HistoryFileEvent, HISTORY_EVENT_MAX> mEventQueue;
     std::unordered_map<std::string, int64_t> mCheckPoints;
     FILE* mCheckPointPtr;
     ThreadPtr mThread;
+
+    std::atomic_int64_t mImportedBytes{0};
+    CounterPtr mImportSizeBytes;
+    DoubleGaugePtr mImportThroughput;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class HistoryFileImporterUnittest;
+#endif
 };
 
 } // namespace logtail
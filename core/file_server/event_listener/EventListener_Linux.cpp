@@ -18,8 +18,13 @@
 #include <sys/ioctl.h>
 #include <unistd.h>
 
+#include <string_view>
+#include <unordered_set>
+
 #include "common/ErrorUtil.h"
 #include "common/Flags.h"
+#include "common/HashUtil.h"
+#include "common/StringView.h"
 #include "file_server/EventDispatcher.h"
 #include "file_server/event_handler/LogInput.h"
 #include "logger/Logger.h"
@@ -29,6 +34,18 @@ DEFINE_FLAG_BOOL(fs_events_inotify_enable, "", true);
 
 namespace logtail {
 
+namespace {
+
+struct WdNameHash {
+    size_t operator()(const std::pair<int, StringView>& key) const {
+        size_t seed = std::hash<int>()(key.first);
+        HashCombine(seed, std::hash<std::string_view>()(std::string_view(key.second.data(), key.second.size())));
+        return seed;
+    }
+};
+
+} // namespace
+
 const uint32_t EventListener::mWatchEventMask
     = IN_CREATE | IN_MODIFY | IN_MASK_ADD | IN_DELETE_SELF | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE;
 
@@ -61,14 +78,17 @@ int32_t logtail::EventListener::ReadEvents(std::vector<logtail::Event*>& eventVe
     static char* s_lastHalfEventBuf = new char[65536];
     static int32_t s_lastHalfEventSize = 0;
 
-    char* buffer = new char[len + s_lastHalfEventSize];
+    // the buffer is reused across reads to avoid an allocation per read during event storms
+    if (mReadBuffer.size() < static_cast<size_t>(len + s_lastHalfEventSize)) {
+        mReadBuffer.resize(len + s_lastHalfEventSize);
+    }
+    char* buffer = mReadBuffer.data();
     if (s_lastHalfEventSize > 0) {
         memcpy(buffer, s_lastHalfEventBuf, s_lastHalfEventSize);
     }
     size_t readLen = read(mInotifyFd, buffer + s_lastHalfEventSize, len);
     if (readLen == 0) {
         LOG_ERROR(sLogger, ("read inotify fd error", ErrnoToString(GetErrno()))("read len", len));
-        delete[] buffer;
         return 0;
     }
     // update len
@@ -77,6 +97,8 @@ int32_t logtail::EventListener::ReadEvents(std::vector<logtail::Event*>& eventVe
     s_lastHalfEventSize = 0;
     if (BOOL_FLAG(fs_events_inotify_enable)) {
         static EventDispatcher* dispatcher = EventDispatcher::GetInstance();
+        // modify events of the same file in one read are coalesced, since the reader reads to the end of file anyway
+        std::unordered_set<std::pair<int, StringView>, WdNameHash> modifiedFiles;
         int n = 0;
         struct inotify_event* event;
         while (n < len) {
@@ -111,15 +133,26 @@ int32_t logtail::EventListener::ReadEvents(std::vector<logtail::Event*>& eventVe
                 etype |= event->mask & IN_MOVED_FROM ? EVENT_MOVE_FROM : 0;
                 etype |= event->mask & IN_MOVED_TO ? EVENT_MOVE_TO : 0;
                 etype |= event->mask & IN_DELETE ? EVENT_DELETE : 0;
-                std::string path;
-                if (etype != 0 && dispatcher->IsRegistered(event->wd, path))
-                    eventVec.push_back(
-                        new Event(path, event->len > 0 ? event->name : "", etype, event->wd, event->cookie));
+                const DirInfo* dirInfo = etype != 0 ? dispatcher->GetInotifyDirInfo(event->wd) : nullptr;
+                if (dirInfo != nullptr) {
+                    // event->name is padded with '\0'
+                    StringView name(event->len > 0 ? event->name : "");
+                    bool duplicated = false;
+                    if (etype == EVENT_MODIFY) {
+                        duplicated = !modifiedFiles.emplace(event->wd, name).second;
+                    } else {
+                        // keep the order between modify and other events of the file
+                        modifiedFiles.erase(std::make_pair(event->wd, name));
+                    }
+                    if (!duplicated) {
+                        eventVec.push_back(new Event(
+                            dirInfo->mPath, std::string(name.data(), name.size()), etype, event->wd, event->cookie));
+                    }
+                }
             }
             n += sizeof(struct inotify_event) + event->len;
         }
     }
-    delete[] buffer;
     return (int32_t)eventVec.size();
 }
 
@@ -49,6 +49,8 @@ public:
 private:
     EventListener() = default;
     int32_t mInotifyFd = -1;
+    // reused by ReadEvents, which is only called by the polling thread of LogInput
+    std::vector<char> mReadBuffer;
 };
 
 } // namespace logtail
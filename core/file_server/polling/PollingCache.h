@@ -63,7 +63,18 @@ private:
     int64_t mLastModifyTime = 0;
 };
 
-typedef std::unordered_map<std::string, DirFileCache> DirCheckCacheMap;
+// DirCheckCache is the cache of a directory. Besides DirFileCache, it remembers the subdirectories and regular files
+// found when the directory was listed last time, so that the directory needn't be listed again until it changes.
+struct DirCheckCache : public DirFileCache {
+    uint64_t mInode = 0;
+    // Time in nanoseconds when the directory was listed completely, 0 means it has to be listed.
+    int64_t mListTime = 0;
+    std::vector<std::string> mSubDirs;
+    // Files are still stated every round, because appending to a file does not change LMD of its directory.
+    std::vector<std::string> mFiles;
+};
+
+typedef std::unordered_map<std::string, DirCheckCache> DirCheckCacheMap;
 typedef std::unordered_map<std::string, DirFileCache> FileCheckCacheMap;
 
 struct ModifyCheckCache {
@@ -32,6 +32,7 @@
 #include "file_server/event/Event.h"
 #include "file_server/polling/PollingEventQueue.h"
 #include "file_server/polling/PollingModify.h"
+#include "file_server/polling/PollingScanner.h"
 #include "logger/Logger.h"
 #include "monitor/AlarmManager.h"
 #include "monitor/metric_constants/MetricConstants.h"
@@ -59,6 +60,10 @@ DEFINE_FLAG_INT32(polling_max_stat_count, "max stat count in each round", 100000
 DEFINE_FLAG_INT32(polling_max_stat_count_per_dir, "max stat count per dir in each round", 100000);
 DEFINE_FLAG_INT32(polling_max_stat_count_per_config, "max stat count per config in each round", 100000);
 DEFINE_FLAG_INT32(polling_modify_repush_interval, "polling modify event repush interval, seconds", 10);
+DEFINE_FLAG_INT32(polling_full_scan_round,
+                  "list all directories every such rounds, directories unchanged since last listing are skipped in "
+                  "other rounds, 1 means always listing",
+                  10);
 DECLARE_FLAG_INT32(wildcard_max_sub_dir_count);
 
 using namespace std;
@@ -260,20 +265,31 @@ void PollingDirFile::PollingIteration() {
 // removed or renamed. However, modifying the content of a file within it will not update
 // LMD, and add/remove/rename file/directory in its subdirectory will also not update LMD.
 // NOTE: So, we can not find changes in subdirectories of the directory according to LMD.
+// However, LMD is enough to know that entries of the directory itself are unchanged, so a directory
+// is listed again only if its LMD or inode changes, while the files found by the last listing are still
+// stated every round to catch appended content. Since the LMD of a directory is only accurate to a
+// tick of filesystem, it should be a while before the last listing, otherwise entries added within the
+// same tick after the listing would be missed.
 bool PollingDirFile::CheckAndUpdateDirMatchCache(const string& dirPath,
                                                  const fsutil::PathStat& statBuf,
                                                  bool exceedPreservedDirDepth,
-                                                 bool& newFlag) {
+                                                 bool& newFlag,
+                                                 bool& unchanged,
+                                                 vector<string>& subDirs,
+                                                 vector<string>& files) {
     int64_t sec, nsec;
     statBuf.GetLastWriteTime(sec, nsec);
     int64_t modifyTime = NANO_CONVERTING * sec + nsec;
+    uint64_t inode = statBuf.GetDevInode().inode;
+    unchanged = false;
 
     ScopedSpinLock lock(mCacheLock);
     auto iter = mDirCacheMap.find(dirPath);
 
     // New directory, add a new cache item for it.
     if (iter == mDirCacheMap.end()) {
-        DirFileCache& dirCache = mDirCacheMap[dirPath];
+        DirCheckCache& dirCache = mDirCacheMap[dirPath];
+        dirCache.mInode = inode;
         dirCache.SetConfigMatched(true);
         dirCache.SetExceedPreservedDirDepth(exceedPreservedDirDepth);
         dirCache.SetCheckRound(mCurrentRound);
@@ -292,11 +308,36 @@ bool PollingDirFile::CheckAndUpdateDirMatchCache(const string& dirPath,
 
     // Already cached, update last round and modified time.
     newFlag = false;
-    iter->second.SetCheckRound(mCurrentRound);
-    iter->second.SetLastModifyTime(modifyTime);
+    auto& dirCache = iter->second;
+    // Directories exceeding preserved depth are listed every round to keep LMD of files in them up to date.
+    if (dirCache.mListTime > 0 && dirCache.mInode == inode && dirCache.GetLastModifyTime() == modifyTime
+        && modifyTime + NANO_CONVERTING < dirCache.mListTime && !exceedPreservedDirDepth
+        && INT32_FLAG(polling_full_scan_round) > 1 && mCurrentRound % INT32_FLAG(polling_full_scan_round) != 0) {
+        unchanged = true;
+        subDirs = dirCache.mSubDirs;
+        files = dirCache.mFiles;
+    } else {
+        dirCache.mListTime = 0;
+    }
+    dirCache.mInode = inode;
+    dirCache.SetCheckRound(mCurrentRound);
+    dirCache.SetLastModifyTime(modifyTime);
     return true; // iter->second.HasMatchedConfig().
 }
 
+void PollingDirFile::UpdateDirListCache(const string& dirPath,
+                                        int64_t listTime,
+                                        vector<string>&& subDirs,
+                                        vector<string>&& files) {
+    ScopedSpinLock lock(mCacheLock);
+    auto iter = mDirCacheMap.find(dirPath);
+    if (iter != mDirCacheMap.end()) {
+        iter->second.mListTime = listTime;
+        iter->second.mSubDirs = std::move(subDirs);
+        iter->second.mFiles = std::move(files);
+    }
+}
+
 bool PollingDirFile::CheckAndUpdateFileMatchCache(const string& fileDir,
                                                   const string& fileName,
                                                   const fsutil::PathStat& statBuf,
@@ -380,15 +421,33 @@ bool PollingDirFile::PollingNormalConfigPath(const FileDiscoveryConfig& pConfig,
         return false;
     }
     bool isNewDirectory = false;
-    if (!CheckAndUpdateDirMatchCache(dirPath, statBuf, exceedPreservedDirDepth, isNewDirectory))
+    bool unchanged = false;
+    vector<string> cachedSubDirs;
+    vector<string> cachedFiles;
+    if (!CheckAndUpdateDirMatchCache(
+            dirPath, statBuf, exceedPreservedDirDepth, isNewDirectory, unchanged, cachedSubDirs, cachedFiles))
         return true;
     if (isNewDirectory) {
         PollingEventQueue::GetInstance()->PushEvent(new Event(srcPath, obj, EVENT_CREATE | EVENT_ISDIR, -1, 0));
     }
 
     // Iterate directories and files in dirPath.
-    fsutil::Dir dir(dirPath);
-    if (!dir.Open()) {
+    // If dirPath is unchanged since last listing, the subdirectories and files found at that time are
+    // iterated without listing it again.
+    int64_t listTime = static_cast<int64_t>(GetCurrentTimeInNanoSeconds());
+    vector<PollingEntry> entries;
+    if (unchanged) {
+        entries.resize(cachedSubDirs.size() + cachedFiles.size());
+        for (size_t i = 0; i < cachedSubDirs.size(); ++i) {
+            entries[i].mName = std::move(cachedSubDirs[i]);
+            entries[i].mType = fsutil::Entry::Type::DIR;
+        }
+        for (size_t i = 0; i < cachedFiles.size(); ++i) {
+            auto& ent = entries[cachedSubDirs.size() + i];
+            ent.mName = std::move(cachedFiles[i]);
+            ent.mType = fsutil::Entry::Type::REG_FILE;
+        }
+    } else if (!PollingScanner::GetInstance()->ReadDir(dirPath, entries)) {
         auto err = GetErrno();
         if (fsutil::Dir::IsENOENT(err)) {
             LOG_DEBUG(sLogger, ("Open dir error, ENOENT, dir", dirPath.c_str()));
@@ -405,11 +464,14 @@ bool PollingDirFile::PollingNormalConfigPath(const FileDiscoveryConfig& pConfig,
         }
         return true;
     }
+    // Whether all entries are iterated, only then the listing can be reused in later rounds.
+    bool completed = true;
     int32_t nowStatCount = 0;
-    fsutil::Entry ent;
-    while ((ent = dir.ReadNext(false))) {
-        if (!mRuningFlag || mHoldOnFlag)
+    for (auto& ent : entries) {
+        if (!mRuningFlag || mHoldOnFlag) {
+            completed = false;
             break;
+        }
 
         if (++mStatCount % INT32_FLAG(dirfile_stat_count) == 0) {
             usleep(INT32_FLAG(dirfile_stat_sleep) * 1000);
@@ -428,6 +490,7 @@ bool PollingDirFile::PollingNormalConfigPath(const FileDiscoveryConfig& pConfig,
                 pConfig.second->GetProjectName(),
                 pConfig.second->GetConfigName(),
                 pConfig.second->GetLogstoreName());
+            completed = false;
             break;
         }
 
@@ -444,64 +507,78 @@ bool PollingDirFile::PollingNormalConfigPath(const FileDiscoveryConfig& pConfig,
                 pConfig.second->GetProjectName(),
                 pConfig.second->GetConfigName(),
                 pConfig.second->GetLogstoreName());
+            completed = false;
             break;
         }
 
         // If the type of item is raw directory or file, use MatchDirPattern or FindBestMatch
         // to check if there are configs that match it.
-        auto entName = ent.Name();
-        string item = PathJoin(dirPath, entName);
-        bool needCheckDirMatch = true;
-        bool needFindBestMatch = true;
-        if (ent.IsDir()) {
+        const auto& entName = ent.mName;
+        if (ent.mType == fsutil::Entry::Type::DIR) {
             // Have to call MatchDirPattern, because we have no idea which config matches
             // the directory according to cache.
             // TODO: Refactor directory cache, maintain all configs that match the directory.
-            needCheckDirMatch = false;
-            if (pConfig.first->IsDirectoryInBlacklist(item)) {
+            if (pConfig.first->IsDirectoryInBlacklist(PathJoin(dirPath, entName))) {
                 continue;
             }
-        } else if (ent.IsRegFile()) {
+        } else if (ent.mType == fsutil::Entry::Type::REG_FILE) {
             // TODO: Add file cache looking up here: we can skip the file if it is in cache
             // and the match flag is false (no config matches it).
             // There is a cache in FindBestMatch, so the overhead is acceptable now.
-            needFindBestMatch = false;
             if (!ConfigManager::GetInstance()->FindBestMatch(dirPath, entName).first) {
                 continue;
             }
         } else {
             // Symbolic link should be passed, while other types file should ignore.
-            if (!ent.IsSymbolic()) {
-                LOG_DEBUG(sLogger, ("should ignore, other type file", item.c_str()));
+            if (!ent.mIsSymbolic) {
+                LOG_DEBUG(sLogger, ("should ignore, other type file", PathJoin(dirPath, entName)));
                 continue;
             }
         }
-
         // Mainly for symbolic (Linux), we need to use stat to dig out the real type.
-        fsutil::PathStat buf;
-        if (!fsutil::PathStat::stat(item, buf)) {
-            LOG_DEBUG(sLogger, ("get file info error", item.c_str())("errno", errno));
+        ent.mNeedStat = true;
+    }
+    PollingScanner::GetInstance()->StatEntries(dirPath, entries);
+
+    vector<string> subDirs;
+    vector<string> files;
+    for (auto& ent : entries) {
+        if (!ent.mNeedStat) {
+            continue;
+        }
+        const auto& entName = ent.mName;
+        if (!ent.mStat.mSucceeded) {
+            LOG_DEBUG(sLogger, ("get file info error", PathJoin(dirPath, entName))("errno", ent.mStat.mErrno));
             continue;
         }
 
         // For directory, poll recursively; for file, update cache and add to mNewFileVec so that
         // it can be pushed to PollingModify at the end of polling.
-        // If needCheckDirMatch or needFindBestMatch is true, that means the item is a symbolic link.
+        // If the entry type is not DIR or REG, that means the item is a symbolic link.
         // We should check file type again to make sure that the original file which linked by
         // a symbolic file is DIR or REG.
-        if (buf.IsDir() && (!needCheckDirMatch || !pConfig.first->IsDirectoryInBlacklist(item))) {
+        const auto& buf = ent.mStat.mStat;
+        bool needCheckDirMatch = ent.mType != fsutil::Entry::Type::DIR;
+        bool needFindBestMatch = ent.mType != fsutil::Entry::Type::REG_FILE;
+        if (buf.IsDir() && (!needCheckDirMatch || !pConfig.first->IsDirectoryInBlacklist(PathJoin(dirPath, entName)))) {
+            subDirs.push_back(entName);
             PollingNormalConfigPath(pConfig, dirPath, entName, buf, depth + 1);
         } else if (buf.IsRegFile()) {
+            files.push_back(entName);
             if (CheckAndUpdateFileMatchCache(dirPath, entName, buf, needFindBestMatch, exceedPreservedDirDepth)) {
                 LOG_DEBUG(sLogger, ("add to modify event", entName)("round", mCurrentRound));
                 mNewFileVec.push_back(SplitedFilePath(dirPath, entName));
             }
         } else {
             // Ignore other file type.
-            LOG_DEBUG(sLogger, ("other type file is linked by a symbolic link, should ignore", item.c_str()));
+            LOG_DEBUG(sLogger,
+                      ("other type file is linked by a symbolic link, should ignore", PathJoin(dirPath, entName)));
             continue;
         }
     }
+    if (!unchanged && completed) {
+        UpdateDirListCache(dirPath, listTime, std::move(subDirs), std::move(files));
+    }
 
     return true;
 }
@@ -561,8 +638,8 @@ bool PollingDirFile::PollingWildcardConfigPath(const FileDiscoveryConfig& pConfi
 
     // Current part is not constant (normal) path, so we have to iterate and match one by one.
     bool hasMatchFlag = false;
-    fsutil::Dir dir(dirPath);
-    if (!dir.Open()) {
+    vector<PollingEntry> entries;
+    if (!PollingScanner::GetInstance()->ReadDir(dirPath, entries)) {
         auto err = GetErrno();
         if (fsutil::Dir::IsENOENT(err)) {
             LOG_DEBUG(sLogger, ("Open dir fail, ENOENT, dir", dirPath.c_str()));
@@ -579,27 +656,11 @@ bool PollingDirFile::PollingWildcardConfigPath(const FileDiscoveryConfig& pConfi
         }
         return true;
     }
-    fsutil::Entry ent;
-    int32_t dirCount = 0;
-    while ((ent = dir.ReadNext(false))) {
+    size_t entryCount = 0;
+    for (; entryCount < entries.size(); ++entryCount) {
         if (!mRuningFlag || mHoldOnFlag)
             break;
 
-        if (dirCount >= INT32_FLAG(wildcard_max_sub_dir_count)) {
-            LOG_WARNING(sLogger,
-                        ("too many sub directoried for path",
-                         dirPath)("dirCount", dirCount)("basePath", pConfig.first->GetBasePath()));
-            AlarmManager::GetInstance()->SendAlarm(STAT_LIMIT_ALARM,
-                                                   string("too many sub directoried for path:" + dirPath
-                                                          + " dirCount: " + ToString(dirCount) + " basePath"
-                                                          + pConfig.first->GetBasePath()),
-                                                   pConfig.second->GetRegion(),
-                                                   pConfig.second->GetProjectName(),
-                                                   pConfig.second->GetConfigName(),
-                                                   pConfig.second->GetLogstoreName());
-            break;
-        }
-
         if (++mStatCount % INT32_FLAG(dirfile_stat_count) == 0)
             usleep(INT32_FLAG(dirfile_stat_sleep) * 1000);
 
@@ -619,13 +680,40 @@ bool PollingDirFile::PollingWildcardConfigPath(const FileDiscoveryConfig& pConfi
             break;
         }
 
-        auto entName = ent.Name();
+        // Regular files can not match the directory part.
+        auto& ent = entries[entryCount];
+        ent.mNeedStat = ent.mType != fsutil::Entry::Type::REG_FILE;
+    }
+    entries.resize(entryCount);
+    PollingScanner::GetInstance()->StatEntries(dirPath, entries);
+
+    int32_t dirCount = 0;
+    for (auto& ent : entries) {
+        if (!ent.mNeedStat) {
+            continue;
+        }
+        if (dirCount >= INT32_FLAG(wildcard_max_sub_dir_count)) {
+            LOG_WARNING(sLogger,
+                        ("too many sub directoried for path",
+                         dirPath)("dirCount", dirCount)("basePath", pConfig.first->GetBasePath()));
+            AlarmManager::GetInstance()->SendAlarm(STAT_LIMIT_ALARM,
+                                                   string("too many sub directoried for path:" + dirPath
+                                                          + " dirCount: " + ToString(dirCount) + " basePath"
+                                                          + pConfig.first->GetBasePath()),
+                                                   pConfig.second->GetRegion(),
+                                                   pConfig.second->GetProjectName(),
+                                                   pConfig.second->GetConfigName(),
+                                                   pConfig.second->GetLogstoreName());
+            break;
+        }
+
+        const auto& entName = ent.mName;
         string item = PathJoin(dirPath, entName);
-        fsutil::PathStat buf;
-        if (!fsutil::PathStat::stat(item, buf)) {
-            LOG_WARNING(sLogger, ("get file info fail", item.c_str())("errno", GetErrno()));
+        if (!ent.mStat.mSucceeded) {
+            LOG_WARNING(sLogger, ("get file info fail", item.c_str())("errno", ent.mStat.mErrno));
             continue;
         }
+        const auto& buf = ent.mStat.mStat;
         if (buf.IsDir()) {
             ++dirCount;
 
@@ -84,12 +84,22 @@ private:
     // @dirPath: absolute path of the directory.
     // @statBuf: stat of the directory.
     // @newFlag: a boolean to indicate caller that it is a new directory, generate event for it.
+    // @unchanged: a boolean to indicate caller that the directory is unchanged since it was listed last time,
+    //   so only @subDirs and @files found at that time have to be polled instead of listing it again.
     // @return a boolean to indicate should the directory be continued to poll.
     //   It will returns true always now (might change in future).
     bool CheckAndUpdateDirMatchCache(const std::string& dirPath,
                                      const fsutil::PathStat& statBuf,
                                      bool exceedPreservedDirDepth,
-                                     bool& newFlag);
+                                     bool& newFlag,
+                                     bool& unchanged,
+                                     std::vector<std::string>& subDirs,
+                                     std::vector<std::string>& files);
+    // UpdateDirListCache records @subDirs and @files of the directory which is listed completely at @listTime.
+    void UpdateDirListCache(const std::string& dirPath,
+                            int64_t listTime,
+                            std::vector<std::string>&& subDirs,
+                            std::vector<std::string>&& files);
     // CheckAndUpdateFileMatchCache updates file cache (add if not existing).
     // @fileDir+@fileName: absolute path of the file.
     // @needFindBestMatch: false indicates that the file has already found the
@@ -145,6 +155,7 @@ private:
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class PollingUnittest;
+    friend class PollingDirFileUnittest;
 #endif
 };
 
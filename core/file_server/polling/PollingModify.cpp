@@ -15,6 +15,7 @@
 #include "file_server/polling/PollingModify.h"
 
 #include "file_server/polling/PollingEventQueue.h"
+#include "file_server/polling/PollingScanner.h"
 #if defined(__linux__)
 #include <sys/file.h>
 #endif
@@ -36,6 +37,7 @@ DEFINE_FLAG_INT32(modify_check_interval, "modify check interval ms", 1000);
 DEFINE_FLAG_INT32(ignore_file_modify_timeout, "if file modify time is up to XXX seconds, ignore it", 180);
 DEFINE_FLAG_INT32(modify_stat_count, "sleep when dir file stat count up to", 100);
 DEFINE_FLAG_INT32(modify_stat_sleepMs, "sleep time when dir file stat up to 1000, ms", 10);
+DEFINE_FLAG_INT32(modify_stat_batch_size, "count of files stated in a batch by polling modify", 4096);
 DEFINE_FLAG_INT32(modify_cache_max, "max modify cache size, if exceed, delete 0.2 oldest", 100000);
 DEFINE_FLAG_INT32(modify_cache_make_space_interval, "second", 600);
 
@@ -263,34 +265,59 @@ void PollingModify::PollingIteration() {
     vector<Event*> pollingEventVec;
     int32_t statCount = 0;
     SET_GAUGE(mPollingModifySize, mModifyCacheMap.size());
-    for (auto iter = mModifyCacheMap.begin(); iter != mModifyCacheMap.end(); ++iter) {
+    // Files are stated in batches, so that files in the same directory share the directory fd and large batches
+    // can be split across worker threads. The cache is ordered by directory, which keeps them adjacent.
+    vector<const SplitedFilePath*> batchFiles;
+    vector<ModifyCheckCache*> batchCaches;
+    vector<PollingStat> batchStats;
+    auto iter = mModifyCacheMap.begin();
+    while (iter != mModifyCacheMap.end()) {
         if (!mRuningFlag || mHoldOnFlag)
             break;
 
-        const SplitedFilePath& filePath = iter->first;
-        ModifyCheckCache& modifyCache = iter->second;
-        fsutil::PathStat logFileStat;
-        if (!fsutil::PathStat::stat(PathJoin(filePath.mFileDir, filePath.mFileName), logFileStat)) {
-            if (errno == ENOENT) {
-                LOG_DEBUG(sLogger, ("file deleted", PathJoin(filePath.mFileDir, filePath.mFileName)));
-                if (UpdateDeletedFile(filePath, modifyCache, pollingEventVec)) {
-                    deletedFileVec.push_back(filePath);
+        batchFiles.clear();
+        batchCaches.clear();
+        for (; iter != mModifyCacheMap.end() && batchFiles.size() < (size_t)INT32_FLAG(modify_stat_batch_size);
+             ++iter) {
+            batchFiles.push_back(&iter->first);
+            batchCaches.push_back(&iter->second);
+        }
+        PollingScanner::GetInstance()->StatFiles(batchFiles, batchStats);
+
+        for (size_t i = 0; i < batchFiles.size(); ++i) {
+            const SplitedFilePath& filePath = *batchFiles[i];
+            ModifyCheckCache& modifyCache = *batchCaches[i];
+            const PollingStat& stat = batchStats[i];
+            if (!stat.mSucceeded) {
+                if (stat.mErrno == ENOENT) {
+                    LOG_DEBUG(sLogger, ("file deleted", PathJoin(filePath.mFileDir, filePath.mFileName)));
+                    if (UpdateDeletedFile(filePath, modifyCache, pollingEventVec)) {
+                        deletedFileVec.push_back(filePath);
+                    }
+                } else {
+                    LOG_DEBUG(sLogger, ("get file info error", PathJoin(filePath.mFileDir, filePath.mFileName)));
                 }
             } else {
-                LOG_DEBUG(sLogger, ("get file info error", PathJoin(filePath.mFileDir, filePath.mFileName)));
+                int64_t sec, nsec;
+                stat.mStat.GetLastWriteTime(sec, nsec);
+                timespec mtim{sec, nsec};
+                auto devInode = stat.mStat.GetDevInode();
+                UpdateFile(filePath,
+                           modifyCache,
+                           devInode.dev,
+                           devInode.inode,
+                           stat.mStat.GetFileSize(),
+                           mtim,
+                           pollingEventVec);
             }
-        } else {
-            int64_t sec, nsec;
-            logFileStat.GetLastWriteTime(sec, nsec);
-            timespec mtim{sec, nsec};
-            auto devInode = logFileStat.GetDevInode();
-            UpdateFile(
-                filePath, modifyCache, devInode.dev, devInode.inode, logFileStat.GetFileSize(), mtim, pollingEventVec);
         }
 
-        ++statCount;
-        if (statCount % INT32_FLAG(modify_stat_count) == 0) {
-            usleep(1000 * INT32_FLAG(modify_stat_sleepMs));
+        // Sleep as long as stating the files one by one.
+        int32_t lastStatCount = statCount;
+        statCount += static_cast<int32_t>(batchFiles.size());
+        int32_t sleepCount = statCount / INT32_FLAG(modify_stat_count) - lastStatCount / INT32_FLAG(modify_stat_count);
+        if (sleepCount > 0) {
+            usleep(1000 * INT32_FLAG(modify_stat_sleepMs) * sleepCount);
         }
     }
 
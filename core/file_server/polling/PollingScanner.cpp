@@ -0,0 +1,240 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "file_server/polling/PollingScanner.h"
+
+#if defined(__linux__)
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+
+#include "common/Flags.h"
+#include "logger/Logger.h"
+
+DEFINE_FLAG_INT32(polling_getdents_buffer_size_kb, "buffer size to read directory entries in polling, kb", 128);
+DEFINE_FLAG_INT32(polling_stat_thread_num, "worker threads to stat files in polling, 0 means stat in place", 2);
+DEFINE_FLAG_INT32(polling_parallel_stat_min_count, "min count of files in a batch to stat by worker threads", 1024);
+
+using namespace std;
+
+namespace logtail {
+
+#if defined(__linux__)
+namespace {
+
+// The layout of entries returned by getdents64, which is not exported by glibc.
+struct LinuxDirent64 {
+    uint64_t d_ino;
+    int64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[];
+};
+
+// Entries with less files are stated by path, since opening the directory costs as much as a stat.
+const size_t kMinFileCountToOpenDir = 2;
+
+int OpenDir(const string& dirPath) {
+    return open(dirPath.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+}
+
+} // namespace
+#endif
+
+bool PollingScanner::ReadDir(const string& dirPath, vector<PollingEntry>& entries) {
+#if defined(__linux__)
+    int fd = OpenDir(dirPath);
+    if (fd < 0) {
+        return false;
+    }
+    static thread_local vector<char> sBuffer;
+    sBuffer.resize(max(INT32_FLAG(polling_getdents_buffer_size_kb), 4) * 1024);
+    while (true) {
+        long size = syscall(SYS_getdents64, fd, sBuffer.data(), sBuffer.size());
+        if (size <= 0) {
+            if (size < 0) {
+                LOG_WARNING(sLogger, ("read dir failed", dirPath)("errno", errno));
+            }
+            break;
+        }
+        for (long pos = 0; pos < size;) {
+            auto ent = reinterpret_cast<const LinuxDirent64*>(sBuffer.data() + pos);
+            pos += ent->d_reclen;
+            if (ent->d_name[0] == '.') {
+                continue;
+            }
+            entries.emplace_back();
+            auto& entry = entries.back();
+            entry.mName = ent->d_name;
+            // Same as fsutil::Dir::ReadNext without stat.
+            switch (ent->d_type) {
+                case DT_DIR:
+                    entry.mType = fsutil::Entry::Type::DIR;
+                    break;
+                case DT_REG:
+                    entry.mType = fsutil::Entry::Type::REG_FILE;
+                    break;
+                case DT_LNK:
+                    entry.mIsSymbolic = true;
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+    close(fd);
+    return true;
+#else
+    fsutil::Dir dir(dirPath);
+    if (!dir.Open()) {
+        return false;
+    }
+    fsutil::Entry ent;
+    while ((ent = dir.ReadNext(false))) {
+        entries.emplace_back();
+        auto& entry = entries.back();
+        entry.mName = ent.Name();
+        if (ent.IsDir()) {
+            entry.mType = fsutil::Entry::Type::DIR;
+        } else if (ent.IsRegFile()) {
+            entry.mType = fsutil::Entry::Type::REG_FILE;
+        }
+        entry.mIsSymbolic = ent.IsSymbolic();
+    }
+    return true;
+#endif
+}
+
+void PollingScanner::StatEntries(const string& dirPath, vector<PollingEntry>& entries) {
+    vector<PollingEntry*> targets;
+    for (auto& entry : entries) {
+        if (entry.mNeedStat) {
+            targets.push_back(&entry);
+        }
+    }
+    if (targets.empty()) {
+        return;
+    }
+#if defined(__linux__)
+    int dirFd = targets.size() >= kMinFileCountToOpenDir ? OpenDir(dirPath) : -1;
+#endif
+    ParallelFor(targets.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            auto& entry = *targets[i];
+#if defined(__linux__)
+            entry.mStat.mSucceeded = dirFd >= 0
+                ? fsutil::PathStat::statat(dirFd, entry.mName.c_str(), entry.mStat.mStat)
+                : fsutil::PathStat::statat(AT_FDCWD, PathJoin(dirPath, entry.mName).c_str(), entry.mStat.mStat);
+#else
+            entry.mStat.mSucceeded = fsutil::PathStat::stat(PathJoin(dirPath, entry.mName), entry.mStat.mStat);
+#endif
+            if (!entry.mStat.mSucceeded) {
+                entry.mStat.mErrno = errno;
+            }
+        }
+    });
+#if defined(__linux__)
+    if (dirFd >= 0) {
+        close(dirFd);
+    }
+#endif
+}
+
+void PollingScanner::StatFiles(const vector<const SplitedFilePath*>& files, vector<PollingStat>& stats) {
+    stats.clear();
+    stats.resize(files.size());
+    ParallelFor(files.size(), [&](size_t begin, size_t end) {
+#if defined(__linux__)
+        int dirFd = -1;
+        // files in [begin, dirEnd) are in the same directory
+        size_t dirEnd = begin;
+#endif
+        for (size_t i = begin; i < end; ++i) {
+            const auto& file = *files[i];
+            auto& stat = stats[i];
+#if defined(__linux__)
+            if (i == dirEnd) {
+                if (dirFd >= 0) {
+                    close(dirFd);
+                }
+                while (dirEnd < end && files[dirEnd]->mFileDir == file.mFileDir) {
+                    ++dirEnd;
+                }
+                dirFd = dirEnd - i >= kMinFileCountToOpenDir ? OpenDir(file.mFileDir) : -1;
+            }
+            stat.mSucceeded = dirFd >= 0
+                ? fsutil::PathStat::statat(dirFd, file.mFileName.c_str(), stat.mStat)
+                : fsutil::PathStat::statat(AT_FDCWD, PathJoin(file.mFileDir, file.mFileName).c_str(), stat.mStat);
+#else
+            stat.mSucceeded = fsutil::PathStat::stat(PathJoin(file.mFileDir, file.mFileName), stat.mStat);
+#endif
+            if (!stat.mSucceeded) {
+                stat.mErrno = errno;
+            }
+        }
+#if defined(__linux__)
+        if (dirFd >= 0) {
+            close(dirFd);
+        }
+#endif
+    });
+}
+
+void PollingScanner::ParallelFor(size_t count, const function<void(size_t, size_t)>& func) {
+    if (count < static_cast<size_t>(INT32_FLAG(polling_parallel_stat_min_count))
+        || INT32_FLAG(polling_stat_thread_num) <= 0) {
+        func(0, count);
+        return;
+    }
+    call_once(mThreadPoolOnce, [this]() {
+        mThreadNum = INT32_FLAG(polling_stat_thread_num);
+        mThreadPool = make_unique<ThreadPool>(mThreadNum);
+        mThreadPool->Start();
+        LOG_INFO(sLogger, ("polling stat worker threads", "started")("thread num", mThreadNum));
+    });
+
+    struct Latch {
+        mutex mMux;
+        condition_variable mCond;
+        size_t mPending = 0;
+    };
+    auto latch = make_shared<Latch>();
+    // The caller runs the first range, while worker threads run the others.
+    size_t rangeSize = (count + mThreadNum) / (mThreadNum + 1);
+    for (size_t begin = rangeSize; begin < count; begin += rangeSize) {
+        size_t end = min(begin + rangeSize, count);
+        {
+            lock_guard<mutex> lock(latch->mMux);
+            ++latch->mPending;
+        }
+        mThreadPool->Add([latch, &func, begin, end]() {
+            func(begin, end);
+            lock_guard<mutex> lock(latch->mMux);
+            if (--latch->mPending == 0) {
+                latch->mCond.notify_all();
+            }
+        });
+    }
+    func(0, min(rangeSize, count));
+    unique_lock<mutex> lock(latch->mMux);
+    latch->mCond.wait(lock, [&latch]() { return latch->mPending == 0; });
+}
+
+} // namespace logtail
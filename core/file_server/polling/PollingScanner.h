@@ -0,0 +1,89 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common/FileSystemUtil.h"
+#include "common/SplitedFilePath.h"
+#include "common/ThreadPool.h"
+
+namespace logtail {
+
+struct PollingStat {
+    bool mSucceeded = false;
+    // errno of the failed stat
+    int mErrno = 0;
+    fsutil::PathStat mStat;
+};
+
+struct PollingEntry {
+    std::string mName;
+    // type reported by directory iteration, UNKNOWN for symbolic links and special files
+    fsutil::Entry::Type mType = fsutil::Entry::Type::UNKNOWN;
+    bool mIsSymbolic = false;
+    // set by caller to stat the entry in StatEntries
+    bool mNeedStat = false;
+    PollingStat mStat;
+};
+
+// PollingScanner is the scanning engine shared by PollingDirFile and PollingModify.
+// On Linux, directories are read by getdents64 with a large buffer, and entries are stated relative to the fd of
+// their directory with statx, so that neither a syscall per few entries nor a full path resolution per stat is
+// needed. Stats of a large batch are split across worker threads.
+class PollingScanner {
+public:
+    PollingScanner(const PollingScanner&) = delete;
+    PollingScanner& operator=(const PollingScanner&) = delete;
+
+    static PollingScanner* GetInstance() {
+        static PollingScanner* ptr = new PollingScanner();
+        return ptr;
+    }
+
+    // ReadDir reads entries of @dirPath except those starting with '.'.
+    // @return false if the directory can not be opened, errno is kept for the caller.
+    bool ReadDir(const std::string& dirPath, std::vector<PollingEntry>& entries);
+
+    // StatEntries stats entries of @dirPath whose mNeedStat is set, symbolic links are followed.
+    void StatEntries(const std::string& dirPath, std::vector<PollingEntry>& entries);
+
+    // StatFiles stats @files into @stats, files in the same directory should be adjacent to share the directory fd.
+    void StatFiles(const std::vector<const SplitedFilePath*>& files, std::vector<PollingStat>& stats);
+
+private:
+    PollingScanner() = default;
+    ~PollingScanner() = default;
+
+    // ParallelFor calls @func with disjoint ranges covering [0, @count), the ranges are run by worker threads and
+    // the caller if @count is large enough.
+    void ParallelFor(size_t count, const std::function<void(size_t, size_t)>& func);
+
+    std::once_flag mThreadPoolOnce;
+    std::unique_ptr<ThreadPool> mThreadPool;
+    size_t mThreadNum = 0;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class PollingScannerUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -1652,7 +1652,8 @@ void LogFileReader::ReadUTF8(LogBuffer& logBuffer, int64_t end, bool& moreData,
 }
 
 void LogFileReader::ReadGBK(LogBuffer& logBuffer, int64_t end, bool& moreData, bool tryRollback) {
-    std::unique_ptr<char[]> gbkMemory;
+    // GBK data is only needed until it is converted into the source buffer, so the memory is reused across reads
+    static thread_local std::vector<char> sGbkMemory;
     char* gbkBuffer = nullptr;
     size_t readCharCount = 0, originReadCount = 0;
     int64_t lastReadPos = 0;
@@ -1663,8 +1664,8 @@ void LogFileReader::ReadGBK(LogBuffer& logBuffer, int64_t end, bool& moreData, b
     if (!mLogFileOp.IsOpen()) {
         // read flush timeout
         readCharCount = mCache.size();
-        gbkMemory.reset(new char[readCharCount + 1]);
-        gbkBuffer = gbkMemory.get();
+        sGbkMemory.resize(readCharCount + 1);
+        gbkBuffer = sGbkMemory.data();
         memcpy(gbkBuffer, mCache.data(), readCharCount);
         // Ignore \n if last is force read
         if (gbkBuffer[0] == '\n' && mLastForceRead) {
@@ -1684,8 +1685,8 @@ void LogFileReader::ReadGBK(LogBuffer& logBuffer, int64_t end, bool& moreData, b
         if (READ_BYTE < lastCacheSize) {
             READ_BYTE = lastCacheSize; // this should not happen, just avoid READ_BYTE >= 0 theoratically
         }
-        gbkMemory.reset(new char[READ_BYTE + 1]);
-        gbkBuffer = gbkMemory.get();
+        sGbkMemory.resize(READ_BYTE + 1);
+        gbkBuffer = sGbkMemory.data();
         if (lastCacheSize) {
             READ_BYTE -= lastCacheSize; // reserve space to copy from cache if needed
         }
@@ -1739,9 +1740,11 @@ void LogFileReader::ReadGBK(LogBuffer& logBuffer, int64_t end, bool& moreData, b
     gbkBuffer[readCharCount] = '\0';
 
     vector<long> lineFeedPos = {-1}; // elements point to the last char of each line
-    for (long idx = 0; idx < long(readCharCount - 1); ++idx) {
-        if (gbkBuffer[idx] == '\n')
-            lineFeedPos.push_back(idx);
+    const char* lineSearchEnd = gbkBuffer + (readCharCount > 0 ? readCharCount - 1 : 0);
+    for (const char* pos = gbkBuffer;
+         (pos = static_cast<const char*>(memchr(pos, '\n', lineSearchEnd - pos))) != nullptr;
+         ++pos) {
+        lineFeedPos.push_back(pos - gbkBuffer);
     }
     lineFeedPos.push_back(readCharCount - 1);
 
@@ -277,6 +277,8 @@ public:
             mFirstWatched = false;
         mLastFilePos = pos;
     }
+    // reading stops at @size until the file size is checked again, which allows reading only a range of the file
+    void SetLastFileSize(int64_t size) { mLastFileSize = size; }
     void
     InitReader(bool tailExisted = false, FileReadPolicy policy = BACKWARD_TO_FIXED_POS, uint32_t eoConcurrency = 0);
 
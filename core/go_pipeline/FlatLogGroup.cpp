@@ -0,0 +1,129 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "go_pipeline/FlatLogGroup.h"
+
+#include <cstring>
+
+#include "common/Flags.h"
+#include "common/StringTools.h"
+#include "constants/TagConstants.h"
+
+DECLARE_FLAG_INT32(max_send_log_group_size);
+
+using namespace std;
+
+namespace logtail {
+
+namespace {
+
+class FlatWriter {
+public:
+    explicit FlatWriter(char* data) : mCur(data) {}
+
+    void AddUInt8(uint8_t value) { *mCur++ = static_cast<char>(value); }
+
+    void AddUInt32(uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            *mCur++ = static_cast<char>(value >> (i * 8));
+        }
+    }
+
+    void AddString(StringView value) {
+        AddUInt32(static_cast<uint32_t>(value.size()));
+        if (!value.empty()) {
+            memcpy(mCur, value.data(), value.size());
+            mCur += value.size();
+        }
+    }
+
+private:
+    char* mCur;
+};
+
+} // namespace
+
+bool SerializeFlatLogGroup(const PipelineEventGroup& group,
+                           bool enableNanosecond,
+                           const string& logstore,
+                           string& res,
+                           string& errorMsg) {
+    // the buffer is sized in a first pass, so that the second pass only copies bytes
+    size_t size = 16 + 4 + logstore.size() + 4;
+    size_t contentCnt = 0;
+    size_t tagCnt = 0;
+    StringView topic;
+    for (const auto& e : group.GetEvents()) {
+        if (!e.Is<LogEvent>()) {
+            errorMsg = "unsupported event type in event group";
+            return false;
+        }
+        const auto& logEvent = e.Cast<LogEvent>();
+        size += 9;
+        if (enableNanosecond && logEvent.GetTimestampNanosecond()) {
+            size += 4;
+        }
+        for (const auto& kv : logEvent) {
+            size += 8 + kv.first.size() + kv.second.size();
+            ++contentCnt;
+        }
+    }
+    for (const auto& tag : group.GetTags()) {
+        if (tag.first == LOG_RESERVED_KEY_TOPIC) {
+            topic = tag.second;
+            size += topic.size();
+        } else {
+            size += 8 + tag.first.size() + tag.second.size();
+            ++tagCnt;
+        }
+    }
+    if (size > static_cast<size_t>(INT32_FLAG(max_send_log_group_size))) {
+        errorMsg = "log group exceeds size limit\tgroup size: " + ToString(size)
+            + "\tsize limit: " + ToString(INT32_FLAG(max_send_log_group_size));
+        return false;
+    }
+
+    res.resize(size);
+    FlatWriter writer(&res[0]);
+    writer.AddUInt32(FLAT_LOG_GROUP_MAGIC);
+    writer.AddUInt32(static_cast<uint32_t>(group.GetEvents().size()));
+    writer.AddUInt32(static_cast<uint32_t>(contentCnt));
+    writer.AddUInt32(static_cast<uint32_t>(tagCnt));
+    writer.AddString(logstore);
+    writer.AddString(topic);
+    for (const auto& tag : group.GetTags()) {
+        if (tag.first != LOG_RESERVED_KEY_TOPIC) {
+            writer.AddString(tag.first);
+            writer.AddString(tag.second);
+        }
+    }
+    for (const auto& e : group.GetEvents()) {
+        const auto& logEvent = e.Cast<LogEvent>();
+        writer.AddUInt32(static_cast<uint32_t>(logEvent.GetTimestamp()));
+        writer.AddUInt32(static_cast<uint32_t>(logEvent.Size()));
+        if (enableNanosecond && logEvent.GetTimestampNanosecond()) {
+            writer.AddUInt8(1);
+            writer.AddUInt32(logEvent.GetTimestampNanosecond().value());
+        } else {
+            writer.AddUInt8(0);
+        }
+        for (const auto& kv : logEvent) {
+            writer.AddString(kv.first);
+            writer.AddString(kv.second);
+        }
+    }
+    return true;
+}
+
+} // namespace logtail
@@ -0,0 +1,45 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <string>
+
+#include "models/PipelineEventGroup.h"
+
+namespace logtail {
+
+// Flat layout of a log group handed over to Go pipelines through ProcessFlatLogGroup, read by
+// LogGroup.UnmarshalFlat in pkg/protocol/sls_logs_flat.go. Unlike protobuf, every field has a fixed position, so
+// neither side builds an intermediate message object: the encoder writes straight from the event group and the
+// decoder slices strings out of the buffer.
+//
+// All integers are little endian, and a string is a uint32 length followed by its bytes.
+//   header:  uint32 magic, uint32 log count, uint32 total content count of all logs, uint32 tag count
+//   group:   string category, string topic, tag count * (string key, string value)
+//   log:     uint32 time, uint32 content count, uint8 has nanosecond, [uint32 nanosecond],
+//            content count * (string key, string value)
+constexpr uint32_t FLAT_LOG_GROUP_MAGIC = 0x31474C46; // "FLG1"
+
+bool SerializeFlatLogGroup(const PipelineEventGroup& group,
+                           bool enableNanosecond,
+                           const std::string& logstore,
+                           std::string& res,
+                           std::string& errorMsg);
+
+} // namespace logtail
@@ -37,6 +37,9 @@
 #endif
 
 DEFINE_FLAG_BOOL(enable_sls_metrics_format, "if enable format metrics in SLS metricstore log pattern", true);
+DEFINE_FLAG_BOOL(enable_go_flat_log_group,
+                 "hand log groups over to Go pipelines in flat layout instead of protobuf if Go plugin supports it",
+                 true);
 DECLARE_FLAG_STRING(ALIYUN_LOG_FILE_TAGS);
 DECLARE_FLAG_INT32(file_tags_update_interval);
 DECLARE_FLAG_STRING(agent_host_id);
@@ -452,6 +455,12 @@ bool LogtailPlugin::LoadPluginBase() {
             LOG_ERROR(sLogger, ("load ProcessLogGroup error, Message", error));
             return mPluginValid;
         }
+        // C++以flat格式传递数据到golang插件，旧版本插件不支持时退回protobuf
+        mProcessFlatLogGroupFun = (ProcessFlatLogGroupFun)loader.LoadMethod("ProcessFlatLogGroup", error);
+        if (!error.empty()) {
+            LOG_INFO(sLogger, ("load ProcessFlatLogGroup error, use protobuf instead, Message", error));
+            mProcessFlatLogGroupFun = nullptr;
+        }
         // 获取golang部分指标信息
         mGetGoMetricsFun = (GetGoMetricsFun)loader.LoadMethod("GetGoMetrics", error);
         if (!error.empty()) {
@@ -549,6 +558,33 @@ void LogtailPlugin::ProcessLogGroup(const std::string& configName,
 #endif
 }
 
+bool LogtailPlugin::IsFlatLogGroupSupported() const {
+    return BOOL_FLAG(enable_go_flat_log_group) && mProcessFlatLogGroupFun != nullptr;
+}
+
+void LogtailPlugin::ProcessFlatLogGroup(const std::string& configName,
+                                        const std::string& flatLogGroup,
+                                        const std::string& packId) {
+    if (flatLogGroup.empty() || !(mPluginValid && mProcessFlatLogGroupFun != nullptr)) {
+        return;
+    }
+    std::string realConfigName = configName + "/2";
+    std::string packIdPrefix = ToHexString(HashString(packId));
+    GoString goConfigName;
+    GoSlice goLog;
+    GoString goPackId;
+    goConfigName.n = realConfigName.size();
+    goConfigName.p = realConfigName.c_str();
+    goPackId.n = packIdPrefix.size();
+    goPackId.p = packIdPrefix.c_str();
+    goLog.len = goLog.cap = flatLogGroup.length();
+    goLog.data = (void*)flatLogGroup.c_str();
+    GoInt rst = mProcessFlatLogGroupFun(goConfigName, goLog, goPackId);
+    if (rst != (GoInt)0) {
+        LOG_WARNING(sLogger, ("process flat loggroup error", configName)("result", rst));
+    }
+}
+
 void LogtailPlugin::GetGoMetrics(std::vector<std::map<std::string, std::string>>& metircsList,
                                  const string& metricType) {
     if (mGetGoMetricsFun != nullptr) {
@@ -143,6 +143,7 @@ typedef GoInt (*InitPluginBaseFun)();
 typedef GoInt (*InitPluginBaseV2Fun)(GoString cfg);
 typedef GoInt (*ProcessLogsFun)(GoString c, GoSlice l, GoString p, GoString t, GoSlice tags);
 typedef GoInt (*ProcessLogGroupFun)(GoString c, GoSlice l, GoString p);
+typedef GoInt (*ProcessFlatLogGroupFun)(GoString c, GoSlice l, GoString p);
 typedef struct innerContainerMeta* (*GetContainerMetaFun)(GoString containerID);
 typedef InnerPluginMetrics* (*GetGoMetricsFun)(GoString metricType);
 
@@ -230,6 +231,12 @@ public:
 
     void ProcessLogGroup(const std::string& configName, const std::string& logGroup, const std::string& packId);
 
+    // log groups in the layout of go_pipeline/FlatLogGroup.h, only available when the loaded Go plugin exports
+    // ProcessFlatLogGroup
+    bool IsFlatLogGroupSupported() const;
+    void
+    ProcessFlatLogGroup(const std::string& configName, const std::string& flatLogGroup, const std::string& packId);
+
     static int IsValidToSend(long long logstoreKey);
 
     static int SendPb(const char* configName,
@@ -274,6 +281,7 @@ private:
     logtail::FlusherSLS mPluginContainerConfig;
     ProcessLogsFun mProcessLogsFun;
     ProcessLogGroupFun mProcessLogGroupFun;
+    ProcessFlatLogGroupFun mProcessFlatLogGroupFun = nullptr;
     GetContainerMetaFun mGetContainerMetaFun;
     GetGoMetricsFun mGetGoMetricsFun;
 
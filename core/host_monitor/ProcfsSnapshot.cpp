@@ -0,0 +1,363 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "host_monitor/ProcfsSnapshot.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <thread>
+
+#include "common/Flags.h"
+#include "common/StringTools.h"
+#include "host_monitor/Constants.h"
+#include "logger/Logger.h"
+
+DEFINE_FLAG_INT32(procfs_snapshot_ttl_ms, "procfs read by one collector is reused by others within this period", 500);
+DEFINE_FLAG_INT32(procfs_snapshot_max_cached_fds, "max number of /proc/[pid]/stat kept open between scans", 4096);
+DEFINE_FLAG_INT32(process_collect_silent_count, "number of process scanned between a sleep", 1000);
+
+using namespace std::chrono;
+
+namespace logtail {
+
+namespace {
+
+bool PreadAll(int fd, std::string& content) {
+    content.resize(std::max<size_t>(content.capacity(), 4096));
+    size_t size = 0;
+    while (true) {
+        if (size == content.size()) {
+            content.resize(content.size() * 2);
+        }
+        ssize_t n = pread(fd, &content[size], content.size() - size, size);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        if (n == 0) {
+            break;
+        }
+        size += n;
+    }
+    content.resize(size);
+    return true;
+}
+
+template <typename T>
+bool TokenTo(StringView token, T& val) {
+    return StringTo(token.data(), token.data() + token.size(), val);
+}
+
+} // namespace
+
+ProcfsSnapshot::~ProcfsSnapshot() {
+    CloseAll();
+}
+
+bool ProcfsSnapshot::GetSystemStat(std::shared_ptr<const SystemStatSnapshot>& snapshot, std::string& errorMessage) {
+    std::lock_guard<std::mutex> lock(mMux);
+    CheckRoot();
+    auto* file = RefreshFile(PROCESS_STAT.string(), errorMessage);
+    if (file == nullptr) {
+        return false;
+    }
+    if (!mSystemStat || mSystemStatTime != file->mReadTime) {
+        auto stat = mSystemStat.use_count() == 1 ? std::move(mSystemStat) : std::make_shared<SystemStatSnapshot>();
+        ParseSystemStat(file->mContent->data(), file->mContent->size(), *stat);
+        mSystemStat = std::move(stat);
+        mSystemStatTime = file->mReadTime;
+    }
+    snapshot = mSystemStat;
+    return true;
+}
+
+std::shared_ptr<const ProcessStatSnapshot> ProcfsSnapshot::GetProcessStats() {
+    {
+        std::lock_guard<std::mutex> lock(mMux);
+        CheckRoot();
+        if (mProcessStats && !Expired(mProcessStatsTime, steady_clock::now())) {
+            return mProcessStats;
+        }
+    }
+
+    std::lock_guard<std::mutex> scanLock(mScanMux);
+    {
+        // another collector may have published a scan while this one was waiting
+        std::lock_guard<std::mutex> lock(mMux);
+        if (mProcessStats && !Expired(mProcessStatsTime, steady_clock::now())) {
+            return mProcessStats;
+        }
+    }
+    CheckScanRoot();
+    const auto now = steady_clock::now();
+    DIR* dir = opendir(mScanRoot.c_str());
+    if (dir == nullptr) {
+        LOG_DEBUG(sLogger, ("failed to open proc dir", mScanRoot)("errno", errno));
+        return nullptr;
+    }
+    // the spare buffer is reused unless a reader still holds it
+    auto snapshot = mSpareProcessStats.use_count() == 1 ? std::move(mSpareProcessStats)
+                                                        : std::make_shared<ProcessStatSnapshot>();
+    auto& processes = snapshot->mProcesses;
+    ++mRound;
+    size_t count = 0;
+    int readCount = 0;
+    const int silentCount = INT32_FLAG(process_collect_silent_count);
+    struct dirent* entry = nullptr;
+    while ((entry = readdir(dir)) != nullptr) {
+        const char* name = entry->d_name;
+        if (name[0] < '0' || name[0] > '9') {
+            continue;
+        }
+        pid_t pid{};
+        if (!StringTo(name, name + strlen(name), pid) || pid == 0) {
+            continue;
+        }
+        if (++readCount > silentCount) {
+            readCount = 0;
+            std::this_thread::sleep_for(milliseconds{100});
+        }
+        if (count == processes.size()) {
+            processes.emplace_back();
+        }
+        if (ReadProcessStat(pid, processes[count])) {
+            ++count;
+        }
+    }
+    closedir(dir);
+    processes.resize(count);
+
+    // close fds of processes that are gone
+    for (auto it = mProcessStatFds.begin(); it != mProcessStatFds.end();) {
+        if (it->second.mRound != mRound) {
+            close(it->second.mFd);
+            it = mProcessStatFds.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mMux);
+    mSpareProcessStats = std::move(mProcessStats);
+    mProcessStats = std::move(snapshot);
+    mProcessStatsTime = now;
+    return mProcessStats;
+}
+
+bool ProcfsSnapshot::GetFileContent(const std::string& relativePath,
+                                    std::shared_ptr<const std::string>& content,
+                                    std::string& errorMessage) {
+    std::lock_guard<std::mutex> lock(mMux);
+    CheckRoot();
+    auto* file = RefreshFile(relativePath, errorMessage);
+    if (file == nullptr) {
+        return false;
+    }
+    content = file->mContent;
+    return true;
+}
+
+bool ProcfsSnapshot::ParseSystemStat(const char* data, size_t size, SystemStatSnapshot& snapshot) {
+    // cpu  1195061569 1728645 418424132 203670447952 14723544 0 773400 0 0 0
+    // cpu0 14708487 14216 4613031 2108180843 57199 0 424744 0 0 0
+    // ...
+    // btime 1731142542
+    snapshot.mCPUs.clear();
+    snapshot.mBootTime = 0;
+    const char* cur = data;
+    const char* end = data + size;
+    while (cur < end) {
+        const auto* lineEnd = static_cast<const char*>(memchr(cur, '\n', end - cur));
+        if (lineEnd == nullptr) {
+            lineEnd = end;
+        }
+        ProcfsTokenizer tokenizer(cur, lineEnd);
+        cur = lineEnd + 1;
+
+        StringView key;
+        if (!tokenizer.Next(key)) {
+            continue;
+        }
+        if (key.substr(0, 3) == "cpu") {
+            CPUStat cpuStat{};
+            if (key.size() == 3) {
+                cpuStat.index = -1;
+            } else if (!TokenTo(key.substr(3), cpuStat.index)) {
+                LOG_ERROR(sLogger, ("failed to parse cpu index", "skip")("wrong cpu index", key));
+                continue;
+            }
+            double* values[] = {&cpuStat.user,
+                                &cpuStat.nice,
+                                &cpuStat.system,
+                                &cpuStat.idle,
+                                &cpuStat.iowait,
+                                &cpuStat.irq,
+                                &cpuStat.softirq,
+                                &cpuStat.steal,
+                                &cpuStat.guest,
+                                &cpuStat.guestNice};
+            // old kernels have fewer columns, the missing ones stay 0
+            StringView value;
+            for (auto key = static_cast<int>(EnumCpuKey::user);
+                 key <= static_cast<int>(EnumCpuKey::guest_nice) && tokenizer.Next(value);
+                 ++key) {
+                if (!TokenTo(value, *values[key - 1])) {
+                    LOG_WARNING(sLogger, ("failed to parse cpu metric", key)("value", value));
+                    *values[key - 1] = 0.0;
+                }
+            }
+            snapshot.mCPUs.push_back(cpuStat);
+        } else if (key == "btime") {
+            StringView value;
+            if (!tokenizer.Next(value) || !TokenTo(value, snapshot.mBootTime)) {
+                LOG_WARNING(sLogger, ("failed to parse btime", value));
+                snapshot.mBootTime = 0;
+            }
+        }
+    }
+    return true;
+}
+
+void ProcfsSnapshot::CheckRoot() {
+    std::string root = PROCESS_DIR.string();
+    if (root != mRoot) {
+        CloseFiles();
+        mRoot = std::move(root);
+    }
+}
+
+ProcfsSnapshot::CachedFile* ProcfsSnapshot::RefreshFile(const std::string& relativePath, std::string& errorMessage) {
+    errorMessage.clear();
+    const auto now = steady_clock::now();
+    auto& file = mFiles[relativePath];
+    if (file.mContent && !Expired(file.mReadTime, now)) {
+        return &file;
+    }
+    const std::string path = mRoot + "/" + relativePath;
+    // a file never disappears from procfs, but retry once with a new fd in case it was replaced
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        if (file.mFd < 0) {
+            file.mFd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (file.mFd < 0) {
+                errorMessage = (errno == ENOENT ? "file does not exist: " : "failed to open file: ") + path;
+                break;
+            }
+        }
+        // readers may still hold the previous content
+        auto content = file.mContent.use_count() == 1 ? std::move(file.mContent) : std::make_shared<std::string>();
+        if (PreadAll(file.mFd, *content)) {
+            file.mContent = std::move(content);
+            file.mReadTime = now;
+            return &file;
+        }
+        errorMessage = "failed to read file: " + path + ", errno: " + std::to_string(errno);
+        close(file.mFd);
+        file.mFd = -1;
+    }
+    mFiles.erase(relativePath);
+    return nullptr;
+}
+
+bool ProcfsSnapshot::Expired(steady_clock::time_point readTime, steady_clock::time_point now) const {
+    return now >= readTime + milliseconds{INT32_FLAG(procfs_snapshot_ttl_ms)};
+}
+
+void ProcfsSnapshot::CheckScanRoot() {
+    std::string root = PROCESS_DIR.string();
+    if (root != mScanRoot) {
+        CloseProcessStatFds();
+        mScanRoot = std::move(root);
+    }
+}
+
+bool ProcfsSnapshot::ReadProcessStat(pid_t pid, ProcessStat& stat) {
+    auto& buffer = mProcessStatBuffer;
+    ssize_t n = -1;
+    auto it = mProcessStatFds.find(pid);
+    if (it != mProcessStatFds.end()) {
+        n = pread(it->second.mFd, buffer.data(), buffer.size(), 0);
+        if (n > 0) {
+            it->second.mRound = mRound;
+        } else {
+            // the process behind the cached fd has exited, and the pid may have been reused since
+            close(it->second.mFd);
+            mProcessStatFds.erase(it);
+        }
+    }
+    if (n <= 0) {
+        int fd = OpenProcessStat(pid);
+        if (fd < 0) {
+            return false;
+        }
+        n = pread(fd, buffer.data(), buffer.size(), 0);
+        if (n > 0 && mProcessStatFds.size() < static_cast<size_t>(INT32_FLAG(procfs_snapshot_max_cached_fds))) {
+            mProcessStatFds.emplace(pid, ProcessStatFd{fd, mRound});
+        } else {
+            close(fd);
+        }
+        if (n <= 0) {
+            return false;
+        }
+    }
+    // the line keeps its capacity between processes
+    mProcessStatLine.assign(buffer.data(), n);
+    return mProcParser.ParseProcessStat(pid, mProcessStatLine, stat);
+}
+
+int ProcfsSnapshot::OpenProcessStat(pid_t pid) const {
+    char path[PATH_MAX];
+    int len = snprintf(path, sizeof(path), "%s/%d/%s", mScanRoot.c_str(), pid, PROCESS_STAT.c_str());
+    if (len <= 0 || static_cast<size_t>(len) >= sizeof(path)) {
+        return -1;
+    }
+    return open(path, O_RDONLY | O_CLOEXEC);
+}
+
+void ProcfsSnapshot::CloseProcessStatFds() {
+    for (auto& item : mProcessStatFds) {
+        close(item.second.mFd);
+    }
+    mProcessStatFds.clear();
+    mSpareProcessStats.reset();
+}
+
+void ProcfsSnapshot::CloseFiles() {
+    for (auto& item : mFiles) {
+        if (item.second.mFd >= 0) {
+            close(item.second.mFd);
+        }
+    }
+    mFiles.clear();
+    mSystemStat.reset();
+    mProcessStats.reset();
+}
+
+void ProcfsSnapshot::CloseAll() {
+    std::lock_guard<std::mutex> scanLock(mScanMux);
+    std::lock_guard<std::mutex> lock(mMux);
+    CloseProcessStatFds();
+    CloseFiles();
+    mRoot.clear();
+    mScanRoot.clear();
+}
+
+} // namespace logtail
@@ -0,0 +1,183 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <sys/types.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/ProcParser.h"
+#include "common/StringView.h"
+
+namespace logtail {
+
+// man proc: https://man7.org/linux/man-pages/man5/proc.5.html
+// search key: /proc/stat
+enum class EnumCpuKey : int {
+    user = 1,
+    nice,
+    system,
+    idle,
+    iowait, // since Linux 2.5.41
+    irq, // since Linux 2.6.0
+    softirq, // since Linux 2.6.0
+    steal, // since Linux 2.6.11
+    guest, // since Linux 2.6.24
+    guest_nice, // since Linux 2.6.33
+};
+
+struct CPUStat {
+    int32_t index; // -1 means total cpu
+    double user;
+    double nice;
+    double system;
+    double idle;
+    double iowait;
+    double irq;
+    double softirq;
+    double steal;
+    double guest;
+    double guestNice;
+};
+
+// parsed /proc/stat
+struct SystemStatSnapshot {
+    std::vector<CPUStat> mCPUs;
+    int64_t mBootTime = 0; // btime, 0 if not found
+};
+
+// parsed /proc/[pid]/stat of all processes
+struct ProcessStatSnapshot {
+    std::vector<ProcessStat> mProcesses;
+};
+
+// Splits a procfs buffer into space separated fields without copying.
+class ProcfsTokenizer {
+public:
+    ProcfsTokenizer(const char* begin, const char* end) : mCur(begin), mEnd(end) {}
+
+    bool Next(StringView& token) {
+        while (mCur < mEnd && *mCur == ' ') {
+            ++mCur;
+        }
+        if (mCur >= mEnd) {
+            return false;
+        }
+        const char* start = mCur;
+        while (mCur < mEnd && *mCur != ' ') {
+            ++mCur;
+        }
+        token = StringView(start, mCur - start);
+        return true;
+    }
+
+private:
+    const char* mCur;
+    const char* mEnd;
+};
+
+// ProcfsSnapshot reads procfs at most once per tick (procfs_snapshot_ttl_ms) and shares the parsed result between
+// all host monitor collectors. Files are kept open and re-read with pread, so a steady state tick costs one
+// directory walk plus one pread per process, with no allocation for processes already seen.
+// Snapshots are immutable once published; readers keep them alive through shared_ptr while the next tick is built
+// into a spare buffer. PROCESS_DIR is scanned under mScanMux only, so that readers of /proc/stat and other files are
+// not blocked by the sleeps between batches of processes.
+class ProcfsSnapshot {
+public:
+    ProcfsSnapshot(const ProcfsSnapshot&) = delete;
+    ProcfsSnapshot& operator=(const ProcfsSnapshot&) = delete;
+
+    static ProcfsSnapshot* GetInstance() {
+        static ProcfsSnapshot sInstance;
+        return &sInstance;
+    }
+
+    // /proc/stat of the current tick
+    bool GetSystemStat(std::shared_ptr<const SystemStatSnapshot>& snapshot, std::string& errorMessage);
+    // /proc/[pid]/stat of the current tick, nullptr if PROCESS_DIR cannot be listed
+    std::shared_ptr<const ProcessStatSnapshot> GetProcessStats();
+    // raw content of a system wide file under PROCESS_DIR of the current tick, e.g. meminfo, diskstats, net/dev
+    bool GetFileContent(const std::string& relativePath,
+                        std::shared_ptr<const std::string>& content,
+                        std::string& errorMessage);
+
+    static bool ParseSystemStat(const char* data, size_t size, SystemStatSnapshot& snapshot);
+
+private:
+    struct CachedFile {
+        int mFd = -1;
+        std::shared_ptr<std::string> mContent;
+        std::chrono::steady_clock::time_point mReadTime;
+    };
+
+    struct ProcessStatFd {
+        int mFd = -1;
+        uint64_t mRound = 0;
+    };
+
+    ProcfsSnapshot() : mProcParser("") {}
+    ~ProcfsSnapshot();
+
+    // called with mMux held
+    void CheckRoot();
+    CachedFile* RefreshFile(const std::string& relativePath, std::string& errorMessage);
+    bool Expired(std::chrono::steady_clock::time_point readTime, std::chrono::steady_clock::time_point now) const;
+    // called with mScanMux held
+    void CheckScanRoot();
+    bool ReadProcessStat(pid_t pid, ProcessStat& stat);
+    int OpenProcessStat(pid_t pid) const;
+    void CloseProcessStatFds();
+
+    void CloseFiles();
+    void CloseAll();
+
+    // guards the cached files and the published snapshots
+    std::mutex mMux;
+    std::string mRoot;
+
+    std::unordered_map<std::string, CachedFile> mFiles;
+
+    std::shared_ptr<SystemStatSnapshot> mSystemStat;
+    std::chrono::steady_clock::time_point mSystemStatTime;
+
+    std::shared_ptr<ProcessStatSnapshot> mProcessStats;
+    std::chrono::steady_clock::time_point mProcessStatsTime;
+
+    // guards the state of the process scan, taken before mMux when both are needed
+    std::mutex mScanMux;
+    std::string mScanRoot;
+    // the snapshot replaced by the last scan, reused by the next one
+    std::shared_ptr<ProcessStatSnapshot> mSpareProcessStats;
+    std::unordered_map<pid_t, ProcessStatFd> mProcessStatFds;
+    uint64_t mRound = 0;
+    std::array<char, 4096> mProcessStatBuffer{};
+    std::string mProcessStatLine;
+    ProcParser mProcParser;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class ProcfsSnapshotUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -18,13 +18,9 @@
 
 #include <string>
 
-#include "boost/algorithm/string.hpp"
-#include "boost/algorithm/string/split.hpp"
-
 #include "MetricValue.h"
-#include "common/StringTools.h"
 #include "host_monitor/Constants.h"
-#include "host_monitor/SystemInformationTools.h"
+#include "host_monitor/ProcfsSnapshot.h"
 #include "logger/Logger.h"
 
 namespace logtail {
@@ -78,9 +74,9 @@ bool CPUCollector::Collect(const HostMonitorTimerEvent::CollectConfig& collectCo
 }
 
 bool CPUCollector::GetHostSystemCPUStat(std::vector<CPUStat>& cpus) {
-    std::vector<std::string> cpuLines;
+    std::shared_ptr<const SystemStatSnapshot> systemStat;
     std::string errorMessage;
-    if (!GetHostSystemStat(cpuLines, errorMessage)) {
+    if (!ProcfsSnapshot::GetInstance()->GetSystemStat(systemStat, errorMessage)) {
         if (mValidState) {
             LOG_WARNING(sLogger, ("failed to get system cpu", "invalid CPU collector")("error msg", errorMessage));
             mValidState = false;
@@ -88,51 +84,8 @@ bool CPUCollector::GetHostSystemCPUStat(std::vector<CPUStat>& cpus) {
         return false;
     }
     mValidState = true;
-    // cpu  1195061569 1728645 418424132 203670447952 14723544 0 773400 0 0 0
-    // cpu0 14708487 14216 4613031 2108180843 57199 0 424744 0 0 0
-    // ...
-    cpus.clear();
-    cpus.reserve(cpuLines.size());
-    for (auto const& line : cpuLines) {
-        std::vector<std::string> cpuMetric;
-        boost::split(cpuMetric, line, boost::is_any_of(" "), boost::token_compress_on);
-        if (cpuMetric.size() > 0 && cpuMetric[0].substr(0, 3) == "cpu") {
-            CPUStat cpuStat{};
-            if (cpuMetric[0] == "cpu") {
-                cpuStat.index = -1;
-            } else {
-                if (!StringTo(cpuMetric[0].substr(3), cpuStat.index)) {
-                    LOG_ERROR(sLogger, ("failed to parse cpu index", "skip")("wrong cpu index", cpuMetric[0]));
-                    continue;
-                }
-            }
-            cpuStat.user = ParseMetric(cpuMetric, EnumCpuKey::user);
-            cpuStat.nice = ParseMetric(cpuMetric, EnumCpuKey::nice);
-            cpuStat.system = ParseMetric(cpuMetric, EnumCpuKey::system);
-            cpuStat.idle = ParseMetric(cpuMetric, EnumCpuKey::idle);
-            cpuStat.iowait = ParseMetric(cpuMetric, EnumCpuKey::iowait);
-            cpuStat.irq = ParseMetric(cpuMetric, EnumCpuKey::irq);
-            cpuStat.softirq = ParseMetric(cpuMetric, EnumCpuKey::softirq);
-            cpuStat.steal = ParseMetric(cpuMetric, EnumCpuKey::steal);
-            cpuStat.guest = ParseMetric(cpuMetric, EnumCpuKey::guest);
-            cpuStat.guestNice = ParseMetric(cpuMetric, EnumCpuKey::guest_nice);
-            cpus.push_back(cpuStat);
-        }
-    }
+    cpus = systemStat->mCPUs;
     return true;
 }
 
-double CPUCollector::ParseMetric(const std::vector<std::string>& cpuMetric, EnumCpuKey key) const {
-    if (cpuMetric.size() <= static_cast<size_t>(key)) {
-        return 0.0;
-    }
-    double value = 0.0;
-    if (!StringTo(cpuMetric[static_cast<size_t>(key)], value)) {
-        LOG_WARNING(
-            sLogger,
-            ("failed to parse cpu metric", static_cast<size_t>(key))("value", cpuMetric[static_cast<size_t>(key)]));
-    }
-    return value;
-}
-
 } // namespace logtail
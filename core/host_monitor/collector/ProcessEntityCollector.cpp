@@ -21,38 +21,27 @@
 #include <sched.h>
 #include <unistd.h>
 
-#include <functional>
 #include <memory>
 #include <queue>
 #include <string>
 #include <utility>
 #include <vector>
 
-#include "ProcParser.h"
-#include "common/FileSystemUtil.h"
-#include "common/Flags.h"
 #include "common/HashUtil.h"
 #include "common/MachineInfoUtil.h"
-#include "common/StringTools.h"
 #include "common/StringView.h"
 #include "constants/EntityConstants.h"
 #include "host_monitor/Constants.h"
-#include "host_monitor/SystemInformationTools.h"
+#include "host_monitor/ProcfsSnapshot.h"
 #include "logger/Logger.h"
 #include "models/PipelineEventGroup.h"
 
-DEFINE_FLAG_INT32(process_collect_silent_count, "number of process scanned between a sleep", 1000);
-
 namespace logtail {
 
 const size_t ProcessTopN = 20;
 
 const std::string ProcessEntityCollector::sName = "process_entity";
 
-ProcessEntityCollector::ProcessEntityCollector()
-    : mProcParser(""), mProcessSilentCount(INT32_FLAG(process_collect_silent_count)) {
-}
-
 system_clock::time_point ProcessEntityCollector::TicksToUnixTime(int64_t startTicks) {
     return system_clock::time_point{static_cast<milliseconds>(startTicks)
                                     + milliseconds{GetHostSystemBootTime() * 1000}};
@@ -131,29 +120,38 @@ void ProcessEntityCollector::GetSortedProcess(std::vector<ExtendedProcessStatPtr
                         decltype(compare)>
         queue(compare);
 
-    int readCount = 0;
-    std::unordered_map<pid_t, ExtendedProcessStatPtr> newProcessStat;
-    WalkAllProcess(PROCESS_DIR, [&](const std::string& dirName) {
-        if (++readCount > mProcessSilentCount) {
-            readCount = 0;
-            std::this_thread::sleep_for(milliseconds{100});
+    auto snapshot = ProcfsSnapshot::GetInstance()->GetProcessStats();
+    if (!snapshot) {
+        if (mValidState) {
+            LOG_ERROR(sLogger,
+                      ("root path is not a directory or not exist", "invalid ProcessEntity collector")("root",
+                                                                                                        PROCESS_DIR));
+            mValidState = false;
         }
-        pid_t pid{};
-        if (!StringTo(dirName, pid)) {
-            return;
+        processStats.clear();
+        return;
+    }
+    mValidState = true;
+
+    ++mCollectRound;
+    for (const auto& stat : snapshot->mProcesses) {
+        bool isFirstCollect = false;
+        auto ptr = GetProcessStat(stat, isFirstCollect);
+        if (!isFirstCollect) {
+            queue.emplace(ptr, ptr->cpuInfo.percent);
         }
-        if (pid != 0) {
-            bool isFirstCollect = false;
-            auto ptr = GetProcessStat(pid, isFirstCollect);
-            newProcessStat[pid] = ptr;
-            if (ptr && !isFirstCollect) {
-                queue.emplace(ptr, ptr->cpuInfo.percent);
-            }
-            if (queue.size() > topN) {
-                queue.pop();
-            }
+        if (queue.size() > topN) {
+            queue.pop();
         }
-    });
+    }
+    // forget processes that are gone
+    for (auto it = mPrevProcessStat.begin(); it != mPrevProcessStat.end();) {
+        if (it->second->collectRound != mCollectRound) {
+            it = mPrevProcessStat.erase(it);
+        } else {
+            ++it;
+        }
+    }
 
     processStats.clear();
     processStats.reserve(queue.size());
@@ -168,88 +166,48 @@ void ProcessEntityCollector::GetSortedProcess(std::vector<ExtendedProcessStatPtr
     }
     LOG_DEBUG(sLogger, ("collect Process Cpu info, top", processStats.size()));
 
-    mPrevProcessStat = std::move(newProcessStat);
     mProcessSortTime = now;
 }
 
-ExtendedProcessStatPtr ProcessEntityCollector::GetProcessStat(pid_t pid, bool& isFirstCollect) {
+ExtendedProcessStatPtr ProcessEntityCollector::GetProcessStat(const ProcessStat& stat, bool& isFirstCollect) {
     const auto now = steady_clock::now();
 
-    // TODO: more accurate cache
-    auto prev = mPrevProcessStat.find(pid);
-    if (prev == mPrevProcessStat.end() || prev->second == nullptr
-        || prev->second->lastStatTime.time_since_epoch().count() == 0) {
-        isFirstCollect = true;
-    } else {
-        isFirstCollect = false;
+    // entries are updated in place, so only processes never seen before cost an allocation
+    auto& ptr = mPrevProcessStat[stat.pid];
+    if (ptr == nullptr) {
+        ptr = std::make_shared<ExtendedProcessStat>();
     }
+    ptr->collectRound = mCollectRound;
+    // a different start time means the pid has been reused by another process
+    isFirstCollect = ptr->lastStatTime.time_since_epoch().count() == 0 || ptr->stat.startTicks != stat.startTicks;
     // proc/[pid]/stat的统计粒度通常为10ms，两次采样之间需要足够大才能平滑。
-    if (prev != mPrevProcessStat.end() && prev->second && now < prev->second->lastStatTime + seconds{1}) {
-        return prev->second;
-    }
-    auto ptr = ReadNewProcessStat(pid);
-    if (!ptr) {
-        return nullptr;
+    if (!isFirstCollect && now < ptr->lastStatTime + seconds{1}) {
+        return ptr;
     }
 
     // calculate CPU related fields
     {
-        ptr->lastStatTime = now;
         constexpr const uint64_t MILLISECOND = 1000;
-        ptr->cpuInfo.user = (ptr->stat.utimeTicks + ptr->stat.cutimeTicks) * MILLISECOND / SYSTEM_HERTZ;
-        ptr->cpuInfo.sys = (ptr->stat.stimeTicks + ptr->stat.cstimeTicks) * MILLISECOND / SYSTEM_HERTZ;
-        ptr->cpuInfo.total = ptr->cpuInfo.user + ptr->cpuInfo.sys;
-        if (isFirstCollect || ptr->cpuInfo.total <= prev->second->cpuInfo.total) {
+        ProcessCpuInfo cpuInfo;
+        cpuInfo.user = (stat.utimeTicks + stat.cutimeTicks) * MILLISECOND / SYSTEM_HERTZ;
+        cpuInfo.sys = (stat.stimeTicks + stat.cstimeTicks) * MILLISECOND / SYSTEM_HERTZ;
+        cpuInfo.total = cpuInfo.user + cpuInfo.sys;
+        if (isFirstCollect || cpuInfo.total <= ptr->cpuInfo.total) {
             // first time called
-            ptr->cpuInfo.percent = 0.0;
+            cpuInfo.percent = 0.0;
         } else {
-            auto totalDiff = static_cast<double>(ptr->cpuInfo.total - prev->second->cpuInfo.total);
+            auto totalDiff = static_cast<double>(cpuInfo.total - ptr->cpuInfo.total);
             auto timeDiff = static_cast<double>(
-                std::chrono::duration_cast<std::chrono::milliseconds>(ptr->lastStatTime.time_since_epoch()
-                                                                      - prev->second->lastStatTime.time_since_epoch())
-                    .count());
-            ptr->cpuInfo.percent = totalDiff / timeDiff;
+                std::chrono::duration_cast<std::chrono::milliseconds>(now - ptr->lastStatTime).count());
+            cpuInfo.percent = totalDiff / timeDiff;
         }
+        ptr->stat = stat;
+        ptr->cpuInfo = cpuInfo;
+        ptr->lastStatTime = now;
     }
     return ptr;
 }
 
-ExtendedProcessStatPtr ProcessEntityCollector::ReadNewProcessStat(pid_t pid) {
-    LOG_DEBUG(sLogger, ("read process stat", pid));
-    auto processStat = PROCESS_DIR / std::to_string(pid) / PROCESS_STAT;
-
-    std::string line;
-    if (FileReadResult::kOK != ReadFileContent(processStat.string(), line)) {
-        LOG_ERROR(sLogger, ("read process stat", "fail")("file", processStat));
-        return nullptr;
-    }
-    auto ptr = std::make_shared<ExtendedProcessStat>();
-    mProcParser.ParseProcessStat(pid, line, ptr->stat);
-    return ptr;
-}
-
-bool ProcessEntityCollector::WalkAllProcess(const std::filesystem::path& root,
-                                            const std::function<void(const std::string&)>& callback) {
-    if (!std::filesystem::exists(root) || !std::filesystem::is_directory(root)) {
-        if (mValidState) {
-            LOG_ERROR(sLogger,
-                      ("root path is not a directory or not exist", "invalid ProcessEntity collector")("root", root));
-            mValidState = false;
-        }
-        return false;
-    }
-    mValidState = true;
-
-    for (const auto& dirEntry :
-         std::filesystem::directory_iterator{root, std::filesystem::directory_options::skip_permission_denied}) {
-        std::string filename = dirEntry.path().filename().string();
-        if (IsInt(filename)) {
-            callback(filename);
-        }
-    }
-    return true;
-}
-
 std::string ProcessEntityCollector::GetProcessEntityID(StringView pid, StringView createTime, StringView hostEntityID) {
     std::ostringstream oss;
     oss << hostEntityID << pid << createTime;
@@ -283,29 +241,20 @@ int64_t ProcessEntityCollector::GetHostSystemBootTime() {
         return systemBootSeconds;
     }
     int64_t currentSeconds = duration_cast<seconds>(system_clock::now().time_since_epoch()).count();
-    std::vector<std::string> lines = {};
+    std::shared_ptr<const SystemStatSnapshot> systemStat;
     std::string errorMessage;
-    if (!GetHostSystemStat(lines, errorMessage)) {
+    if (!ProcfsSnapshot::GetInstance()->GetSystemStat(systemStat, errorMessage)) {
         LOG_WARNING(sLogger, ("failed to get system boot time", "use current time instead")("error msg", errorMessage));
         return currentSeconds;
     }
-    for (auto const& line : lines) {
-        auto cpuMetric = SplitString(line);
-        // example: btime 1719922762
-        if (cpuMetric.size() >= 2 && cpuMetric[0] == "btime") {
-            if (!StringTo(cpuMetric[1], systemBootSeconds)) {
-                LOG_WARNING(sLogger,
-                            ("failed to get system boot time",
-                             "use current time instead")("error msg", "parse btime erorr " + cpuMetric[1]));
-                return currentSeconds;
-            }
-            return systemBootSeconds;
-        }
+    if (systemStat->mBootTime == 0) {
+        LOG_WARNING(sLogger,
+                    ("failed to get system boot time", "use current time instead")("error msg",
+                                                                                   "btime not found in stat"));
+        return currentSeconds;
     }
-
-    LOG_WARNING(sLogger,
-                ("failed to get system boot time", "use current time instead")("error msg", "btime not found in stat"));
-    return currentSeconds;
+    systemBootSeconds = systemStat->mBootTime;
+    return systemBootSeconds;
 }
 
 } // namespace logtail
@@ -48,6 +48,7 @@ struct ExtendedProcessStat {
     ProcessStat stat;
     ProcessCpuInfo cpuInfo;
     steady_clock::time_point lastStatTime;
+    uint64_t collectRound = 0;
 };
 
 using ExtendedProcessStatPtr = std::shared_ptr<ExtendedProcessStat>;
@@ -55,7 +56,6 @@ using ExtendedProcessStatPtr = std::shared_ptr<ExtendedProcessStat>;
 
 class ProcessEntityCollector : public BaseCollector {
 public:
-    ProcessEntityCollector();
     ~ProcessEntityCollector() override = default;
 
     bool Collect(const HostMonitorTimerEvent::CollectConfig& collectConfig, PipelineEventGroup* group) override;
@@ -66,10 +66,7 @@ public:
 private:
     system_clock::time_point TicksToUnixTime(int64_t startTicks);
     void GetSortedProcess(std::vector<ExtendedProcessStatPtr>& processStats, size_t topN);
-    ExtendedProcessStatPtr GetProcessStat(pid_t pid, bool& isFirstCollect);
-    ExtendedProcessStatPtr ReadNewProcessStat(pid_t pid);
-    ExtendedProcessStatPtr ParseProcessStat(pid_t pid, std::string& line);
-    bool WalkAllProcess(const std::filesystem::path& root, const std::function<void(const std::string&)>& callback);
+    ExtendedProcessStatPtr GetProcessStat(const ProcessStat& stat, bool& isFirstCollect);
 
     std::string GetProcessEntityID(StringView pid, StringView createTime, StringView hostEntityID);
     void FetchDomainInfo(std::string& domain,
@@ -80,9 +77,7 @@ private:
 
     steady_clock::time_point mProcessSortTime;
     std::unordered_map<pid_t, ExtendedProcessStatPtr> mPrevProcessStat;
-    ProcParser mProcParser;
-
-    const int mProcessSilentCount;
+    uint64_t mCollectRound = 0;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class ProcessEntityCollectorUnittest;
@@ -0,0 +1,322 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "logger/BinaryLogger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+
+#include "spdlog/details/os.h"
+
+#include "common/Flags.h"
+
+DEFINE_FLAG_BOOL(enable_binary_logger, "format agent logs in a background thread instead of logging threads", false);
+DEFINE_FLAG_INT32(binary_logger_thread_buffer_size_kb, "size of the record ring of each logging thread, kb", 256);
+DEFINE_FLAG_INT32(binary_logger_flush_interval_ms, "interval for the background thread to format records, ms", 20);
+
+using namespace std;
+
+namespace logtail {
+
+namespace {
+
+// the records being encoded by the thread, indexed by the nesting depth of makers and reused to avoid allocation,
+// deque keeps references to existing records valid when a nested maker adds one
+thread_local deque<string> sRecords;
+thread_local size_t sRecordDepth = 0;
+// set when the ring of the thread is released, records logged by destructors of other thread locals afterwards are
+// formatted in place
+thread_local bool sThreadExited = false;
+
+struct ThreadRingHolder {
+    shared_ptr<BinaryLogRing> mRing;
+
+    ~ThreadRingHolder() {
+        sThreadExited = true;
+        if (mRing) {
+            mRing->Close();
+        }
+    }
+};
+
+thread_local ThreadRingHolder sThreadRing;
+
+template <typename T>
+T ReadPod(const string& record, size_t& pos) {
+    T value;
+    memcpy(&value, record.data() + pos, sizeof(T));
+    pos += sizeof(T);
+    return value;
+}
+
+void ReadString(const string& record, size_t& pos, string& out) {
+    uint32_t len = ReadPod<uint32_t>(record, pos);
+    out.append(record.data() + pos, len);
+    pos += len;
+}
+
+// LoggerAccessor exposes the protected sink_it_ of spdlog::logger, which is what logger::log calls after building the
+// message, and is overridden by async_logger to post the message to the async pool.
+struct LoggerAccessor : public spdlog::logger {
+    static void SinkIt(spdlog::logger& logger, const spdlog::details::log_msg& msg) {
+        (logger.*(&LoggerAccessor::sink_it_))(msg);
+    }
+};
+
+} // namespace
+
+BinaryLogRing::BinaryLogRing(size_t capacity) : mCapacity(capacity) {
+    mBuffer.reset(new char[mCapacity]);
+}
+
+bool BinaryLogRing::TryPush(const char* data, uint32_t size) {
+    uint64_t tail = mTail.load(memory_order_relaxed);
+    uint64_t head = mHead.load(memory_order_acquire);
+    if (mCapacity - (tail - head) < sizeof(size) + size) {
+        return false;
+    }
+    CopyIn(tail, reinterpret_cast<const char*>(&size), sizeof(size));
+    CopyIn(tail + sizeof(size), data, size);
+    mTail.store(tail + sizeof(size) + size, memory_order_release);
+    return true;
+}
+
+bool BinaryLogRing::TryPop(string& record) {
+    uint64_t head = mHead.load(memory_order_relaxed);
+    uint64_t tail = mTail.load(memory_order_acquire);
+    if (head == tail) {
+        return false;
+    }
+    uint32_t size = 0;
+    CopyOut(head, reinterpret_cast<char*>(&size), sizeof(size));
+    record.resize(size);
+    CopyOut(head + sizeof(size), &record[0], size);
+    mHead.store(head + sizeof(size) + size, memory_order_release);
+    return true;
+}
+
+void BinaryLogRing::CopyIn(uint64_t pos, const char* data, size_t size) {
+    size_t offset = pos % mCapacity;
+    size_t first = min(size, mCapacity - offset);
+    memcpy(mBuffer.get() + offset, data, first);
+    memcpy(mBuffer.get(), data + first, size - first);
+}
+
+void BinaryLogRing::CopyOut(uint64_t pos, char* data, size_t size) const {
+    size_t offset = pos % mCapacity;
+    size_t first = min(size, mCapacity - offset);
+    memcpy(data, mBuffer.get() + offset, first);
+    memcpy(data + first, mBuffer.get(), size - first);
+}
+
+atomic<bool> BinaryLogger::sEnabled{false};
+
+void BinaryLogger::Start() {
+    lock_guard<mutex> lock(mThreadRunningMux);
+    if (!BOOL_FLAG(enable_binary_logger) || mIsThreadRunning) {
+        return;
+    }
+    mIsThreadRunning = true;
+    mThreadRes = async(launch::async, &BinaryLogger::Run, this);
+    sEnabled.store(true, memory_order_release);
+    // exit paths other than Application::Exit
+    static once_flag sAtExitOnce;
+    call_once(sAtExitOnce, []() { atexit([]() { BinaryLogger::GetInstance()->Stop(); }); });
+}
+
+void BinaryLogger::Stop() {
+    {
+        lock_guard<mutex> lock(mThreadRunningMux);
+        if (!mIsThreadRunning) {
+            return;
+        }
+        sEnabled.store(false, memory_order_release);
+        mIsThreadRunning = false;
+    }
+    mStopCV.notify_all();
+    if (mThreadRes.valid()) {
+        mThreadRes.get();
+    }
+    // records committed after the thread exited
+    Drain();
+}
+
+void BinaryLogger::FlushOnCrash() {
+    Drain(true);
+}
+
+void BinaryLogger::Commit(string& record) {
+    if (IsEnabled() && !sThreadExited) {
+        BinaryLogRing* ring = GetThreadRing();
+        if (ring->TryPush(record.data(), static_cast<uint32_t>(record.size()))) {
+            return;
+        }
+    }
+    mInPlaceCnt.fetch_add(1, memory_order_relaxed);
+    Format(record);
+}
+
+void BinaryLogger::Run() {
+    unique_lock<mutex> lock(mThreadRunningMux);
+    while (mIsThreadRunning) {
+        lock.unlock();
+        Drain();
+        lock.lock();
+        mStopCV.wait_for(lock, chrono::milliseconds(INT32_FLAG(binary_logger_flush_interval_ms)), [this]() {
+            return !mIsThreadRunning;
+        });
+    }
+    lock.unlock();
+    Drain();
+}
+
+size_t BinaryLogger::Drain(bool crashing) {
+    // the crashed thread may hold the locks
+    unique_lock<mutex> drainLock(mDrainMux, defer_lock);
+    if (!crashing) {
+        drainLock.lock();
+    } else if (!drainLock.try_lock()) {
+        return 0;
+    }
+    vector<shared_ptr<BinaryLogRing>> rings;
+    {
+        unique_lock<mutex> lock(mRingsMux, defer_lock);
+        if (!crashing) {
+            lock.lock();
+        } else if (!lock.try_lock()) {
+            return 0;
+        }
+        rings = mRings;
+    }
+    static thread_local string sPopped;
+    size_t cnt = 0;
+    vector<BinaryLogRing*> closedRings;
+    for (auto& ring : rings) {
+        // read before draining, so that records pushed before the owner thread exits are never left behind
+        bool closed = ring->IsClosed();
+        while (ring->TryPop(sPopped)) {
+            Format(sPopped, crashing);
+            ++cnt;
+        }
+        if (closed && !crashing) {
+            closedRings.push_back(ring.get());
+        }
+    }
+    if (!closedRings.empty()) {
+        lock_guard<mutex> lock(mRingsMux);
+        mRings.erase(remove_if(mRings.begin(),
+                               mRings.end(),
+                               [&closedRings](const shared_ptr<BinaryLogRing>& ring) {
+                                   return find(closedRings.begin(), closedRings.end(), ring.get())
+                                       != closedRings.end();
+                               }),
+                     mRings.end());
+    }
+    return cnt;
+}
+
+BinaryLogRing* BinaryLogger::GetThreadRing() {
+    if (!sThreadRing.mRing) {
+        size_t capacity = static_cast<size_t>(max(INT32_FLAG(binary_logger_thread_buffer_size_kb), 4)) * 1024;
+        sThreadRing.mRing = make_shared<BinaryLogRing>(capacity);
+        lock_guard<mutex> lock(mRingsMux);
+        mRings.push_back(sThreadRing.mRing);
+    }
+    return sThreadRing.mRing.get();
+}
+
+void BinaryLogger::Format(const string& record, bool toSinks) {
+    size_t pos = 0;
+    auto header = ReadPod<RecordHeader>(record, pos);
+    static thread_local string sContent;
+    sContent.clear();
+    // same as LogMaker
+    while (pos < record.size()) {
+        sContent.push_back('\t');
+        ReadString(record, pos, sContent);
+        sContent.push_back(':');
+        switch (static_cast<ValueType>(record[pos++])) {
+            case ValueType::BOOL:
+                sContent.append(ReadPod<bool>(record, pos) ? "true" : "false");
+                break;
+            case ValueType::CHAR:
+                sContent.push_back(ReadPod<char>(record, pos));
+                break;
+            case ValueType::INT:
+                sContent.append(to_string(ReadPod<int64_t>(record, pos)));
+                break;
+            case ValueType::UINT:
+                sContent.append(to_string(ReadPod<uint64_t>(record, pos)));
+                break;
+            case ValueType::DOUBLE: {
+                ostringstream oss;
+                oss << ReadPod<double>(record, pos);
+                sContent.append(oss.str());
+                break;
+            }
+            case ValueType::STRING:
+                ReadString(record, pos, sContent);
+                break;
+        }
+    }
+
+    const LogSite* site = header.mSite;
+    auto& logger = *header.mLogger;
+    auto payload = fmt::format("{}:{}\t{}", site->mFile, site->mLine, sContent);
+    spdlog::details::log_msg msg(spdlog::log_clock::time_point(chrono::duration_cast<spdlog::log_clock::duration>(
+                                     chrono::nanoseconds(header.mTimeNs))),
+                                 spdlog::source_loc{},
+                                 logger.name(),
+                                 site->mLevel,
+                                 payload);
+    msg.thread_id = header.mThreadId;
+    if (!toSinks) {
+        try {
+            LoggerAccessor::SinkIt(logger, msg);
+            return;
+        } catch (const spdlog::spdlog_ex&) {
+            // the async pool is released on exit
+        }
+    }
+    for (auto& sink : logger.sinks()) {
+        try {
+            if (sink->should_log(msg.level)) {
+                sink->log(msg);
+            }
+            sink->flush();
+        } catch (const spdlog::spdlog_ex&) {
+        }
+    }
+}
+
+BinaryLogMaker::BinaryLogMaker(spdlog::logger* logger, const LogSite* site)
+    : mRecord(sRecordDepth < sRecords.size() ? sRecords[sRecordDepth] : sRecords.emplace_back()) {
+    ++sRecordDepth;
+    BinaryLogger::RecordHeader header{
+        site,
+        logger,
+        chrono::duration_cast<chrono::nanoseconds>(spdlog::log_clock::now().time_since_epoch()).count(),
+        spdlog::details::os::thread_id()};
+    mRecord.clear();
+    mRecord.append(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+BinaryLogMaker::~BinaryLogMaker() {
+    BinaryLogger::GetInstance()->Commit(mRecord);
+    --sRecordDepth;
+}
+
+} // namespace logtail
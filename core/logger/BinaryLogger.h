@@ -0,0 +1,201 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "spdlog/spdlog.h"
+
+namespace logtail {
+
+// LogSite is the static part of a log statement, its address is the format id of the records of the statement.
+struct LogSite {
+    const char* mFile;
+    int mLine;
+    spdlog::level::level_enum mLevel;
+};
+
+// BinaryLogRing is a single producer single consumer ring of encoded records, owned by one logging thread.
+class BinaryLogRing {
+public:
+    explicit BinaryLogRing(size_t capacity);
+
+    // TryPush is called by the owner thread only, @return false if the ring is full.
+    bool TryPush(const char* data, uint32_t size);
+    // TryPop is called by the consumer only, @return false if the ring is empty.
+    bool TryPop(std::string& record);
+
+    void Close() { mClosed.store(true, std::memory_order_release); }
+    bool IsClosed() const { return mClosed.load(std::memory_order_acquire); }
+
+private:
+    void CopyIn(uint64_t pos, const char* data, size_t size);
+    void CopyOut(uint64_t pos, char* data, size_t size) const;
+
+    std::unique_ptr<char[]> mBuffer;
+    const size_t mCapacity;
+    alignas(64) std::atomic<uint64_t> mHead{0};
+    alignas(64) std::atomic<uint64_t> mTail{0};
+    std::atomic<bool> mClosed{false};
+};
+
+// BinaryLogger moves the formatting of LOG_* statements off the calling threads. The calling thread only copies the
+// address of the static LogSite and the raw field values into its own ring, and a background thread formats the
+// records and passes them to the logger with the original time and thread id, so that they still go through the
+// async pool and the flush policy of the logger. Records are formatted in place if the ring is full, so no log is
+// lost. Pending records are drained on exit, and written to the sinks directly on crash.
+class BinaryLogger {
+public:
+    BinaryLogger(const BinaryLogger&) = delete;
+    BinaryLogger& operator=(const BinaryLogger&) = delete;
+
+    static BinaryLogger* GetInstance() {
+        static BinaryLogger* ptr = new BinaryLogger();
+        return ptr;
+    }
+
+    static bool IsEnabled() { return sEnabled.load(std::memory_order_relaxed); }
+
+    void Start();
+    // Stop formats all pending records, LOG_* statements are formatted in place afterwards.
+    void Stop();
+    // FlushOnCrash writes pending records to the sinks directly and flushes them, since the async pool of the logger
+    // does not run any more. It is called by the crash handler, and does nothing if another thread is draining.
+    void FlushOnCrash();
+
+    // Commit appends the record in @record to the ring of the calling thread.
+    void Commit(std::string& record);
+
+    enum class ValueType : uint8_t { BOOL, CHAR, INT, UINT, DOUBLE, STRING };
+
+    struct RecordHeader {
+        const LogSite* mSite;
+        spdlog::logger* mLogger;
+        int64_t mTimeNs;
+        size_t mThreadId;
+    };
+
+private:
+    BinaryLogger() = default;
+    ~BinaryLogger() = default;
+
+    void Run();
+    // Drain formats all pending records, @return the number of records formatted.
+    // It can be called by any thread, @crashing makes it write to the sinks directly and give up on lock contention.
+    size_t Drain(bool crashing = false);
+    BinaryLogRing* GetThreadRing();
+    static void Format(const std::string& record, bool toSinks = false);
+
+    static std::atomic<bool> sEnabled;
+
+    std::mutex mRingsMux;
+    std::vector<std::shared_ptr<BinaryLogRing>> mRings;
+    // rings are single consumer, so draining is serialized
+    std::mutex mDrainMux;
+
+    std::future<void> mThreadRes;
+    std::mutex mThreadRunningMux;
+    bool mIsThreadRunning = false;
+    std::condition_variable mStopCV;
+
+    std::atomic<uint64_t> mInPlaceCnt{0};
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class BinaryLoggerUnittest;
+#endif
+};
+
+// BinaryLogMaker has the same interface as LogMaker, and encodes fields into a thread local record instead of
+// formatting them. Makers created while evaluating fields of another maker on the same thread use their own records.
+class BinaryLogMaker {
+public:
+    BinaryLogMaker(spdlog::logger* logger, const LogSite* site);
+    ~BinaryLogMaker();
+
+    template <typename T>
+    BinaryLogMaker& operator()(const std::string& key, const T& value) {
+        return this->operator()(key.c_str(), value);
+    }
+
+    template <typename T>
+    BinaryLogMaker& operator()(const char* key, const T& value) {
+        AppendString(key, strlen(key));
+        AppendValue(value);
+        return *this;
+    }
+
+private:
+    template <typename T>
+    void AppendValue(const T& value) {
+        using ValueType = BinaryLogger::ValueType;
+        using U = std::decay_t<T>;
+        if constexpr (std::is_same_v<U, bool>) {
+            AppendPod(ValueType::BOOL, value);
+        } else if constexpr (std::is_same_v<U, char> || std::is_same_v<U, signed char>
+                             || std::is_same_v<U, unsigned char>) {
+            AppendPod(ValueType::CHAR, static_cast<char>(value));
+        } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+            AppendPod(ValueType::INT, static_cast<int64_t>(value));
+        } else if constexpr (std::is_integral_v<U>) {
+            AppendPod(ValueType::UINT, static_cast<uint64_t>(value));
+        } else if constexpr (std::is_same_v<U, double> || std::is_same_v<U, float>) {
+            AppendPod(ValueType::DOUBLE, static_cast<double>(value));
+        } else if constexpr (std::is_same_v<U, const char*> || std::is_same_v<U, char*>) {
+            AppendTag(ValueType::STRING);
+            AppendString(value, value == nullptr ? 0 : strlen(value));
+        } else if constexpr (std::is_same_v<U, std::string> || std::is_same_v<U, std::string_view>) {
+            AppendTag(ValueType::STRING);
+            AppendString(value.data(), value.size());
+        } else {
+            // other types are formatted in place by their operator<<
+            std::ostringstream oss;
+            oss << value;
+            std::string str = oss.str();
+            AppendTag(ValueType::STRING);
+            AppendString(str.data(), str.size());
+        }
+    }
+
+    void AppendTag(BinaryLogger::ValueType type) { mRecord.push_back(static_cast<char>(type)); }
+
+    template <typename T>
+    void AppendPod(BinaryLogger::ValueType type, const T& value) {
+        AppendTag(type);
+        mRecord.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void AppendString(const char* data, size_t size) {
+        uint32_t len = static_cast<uint32_t>(size);
+        mRecord.append(reinterpret_cast<const char*>(&len), sizeof(len));
+        mRecord.append(data, size);
+    }
+
+    std::string& mRecord;
+};
+
+} // namespace logtail
@@ -110,6 +110,7 @@ void Logger::InitGlobalLoggers() {
     if (!sLogger) {
         sLogger = GetLogger(GetAgentLoggersPrefix());
     }
+    BinaryLogger::GetInstance()->Start();
 }
 
 Logger::logger Logger::CreateLogger(const std::string& loggerName,
@@ -21,6 +21,8 @@
 
 #include "spdlog/spdlog.h"
 
+#include "logger/BinaryLogger.h"
+
 namespace logtail {
 
 class Logger {
@@ -110,12 +112,20 @@ public:
     const std::string GetContent() const { return mOStringStream.str(); }
 };
 
+// Fields are evaluated only if the level is enabled. In binary mode, they are copied without formatting and
+// formatted by the background thread of BinaryLogger.
 #define LOG_X_IF(logger, condition, fields, level) \
     do { \
         if (condition && logger->should_log(level)) { \
-            LogMaker maker; \
-            (void)maker fields; \
-            logger->log(level, "{}:{}\t{}", __FILE__, __LINE__, maker.GetContent()); \
+            if (logtail::BinaryLogger::IsEnabled()) { \
+                static const logtail::LogSite sLogSite{__FILE__, __LINE__, level}; \
+                logtail::BinaryLogMaker maker(&*(logger), &sLogSite); \
+                (void)maker fields; \
+            } else { \
+                LogMaker maker; \
+                (void)maker fields; \
+                logger->log(level, "{}:{}\t{}", __FILE__, __LINE__, maker.GetContent()); \
+            } \
         } \
     } while (0)
 
@@ -116,6 +116,7 @@ private:
     // We do not invalidate existing LogContent when the same key has arrived.
     friend class ProcessorParseApsaraNative;
     void AppendContentNoCopy(StringView key, StringView val);
+    void ReserveContents(size_t size) { mContents.reserve(size); }
 
     // since log reduce in SLS server requires the original order of log contents, we have to maintain this sequential
     // information for backward compatability.
@@ -34,6 +34,7 @@
 #include "common/RuntimeUtil.h"
 #include "common/StringTools.h"
 #include "common/TimeUtil.h"
+#include "common/memory/MemoryBudget.h"
 #include "common/version.h"
 #include "constants/Constants.h"
 #include "file_server/event_handler/LogInput.h"
@@ -103,6 +104,7 @@ bool LogtailMonitor::Init() {
     mRealtimeCpuStat.Reset();
     // Reset memory statistics.
     mMemStat.Reset();
+    MemoryBudget::GetInstance()->UpdateLimit(AppConfig::GetInstance()->GetMemUsageUpLimit());
 
 #if defined(__linux__)
     // Reset OS CPU statistics.
@@ -180,6 +182,10 @@ void LogtailMonitor::Monitor() {
 
                 GetMemStat();
                 LoongCollectorMonitor::GetInstance()->SetAgentMemory(mMemStat.mRss);
+                MemoryBudget::GetInstance()->UpdateLimit(AppConfig::GetInstance()->GetMemUsageUpLimit());
+                LoongCollectorMonitor::GetInstance()->SetAgentMemoryBudget(
+                    MemoryBudget::GetInstance()->GetLimit() / 1024 / 1024,
+                    max(MemoryBudget::GetInstance()->GetUsedBytes(), int64_t(0)) / 1024 / 1024);
                 CalCpuStat(curCpuStat, mCpuStat);
                 LoongCollectorMonitor::GetInstance()->SetAgentCpu(mCpuStat.mCpuUsage);
                 if (CheckHardMemLimit()) {
@@ -625,6 +631,8 @@ void LoongCollectorMonitor::Init() {
     mAgentCpu = mMetricsRecordRef.CreateDoubleGauge(METRIC_AGENT_CPU);
     mAgentMemory = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_MEMORY);
     mAgentGoMemory = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_MEMORY_GO);
+    mAgentMemoryBudgetLimit = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_MEMORY_BUDGET_LIMIT);
+    mAgentMemoryBudgetUsed = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_MEMORY_BUDGET_USED);
     mAgentGoRoutinesTotal = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_GO_ROUTINES_TOTAL);
     mAgentOpenFdTotal = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_OPEN_FD_TOTAL);
     mAgentConfigTotal = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_PIPELINE_CONFIG_TOTAL);
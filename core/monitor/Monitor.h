@@ -198,6 +198,10 @@ public:
     void SetAgentCpu(double cpu) { SET_GAUGE(mAgentCpu, cpu); }
     void SetAgentMemory(uint64_t mem) { SET_GAUGE(mAgentMemory, mem); }
     void SetAgentGoMemory(uint64_t mem) { SET_GAUGE(mAgentGoMemory, mem); }
+    void SetAgentMemoryBudget(uint64_t limit, uint64_t used) {
+        SET_GAUGE(mAgentMemoryBudgetLimit, limit);
+        SET_GAUGE(mAgentMemoryBudgetUsed, used);
+    }
     void SetAgentGoRoutinesTotal(uint64_t total) { SET_GAUGE(mAgentGoRoutinesTotal, total); }
     void SetAgentOpenFdTotal(uint64_t total) {
 #ifndef APSARA_UNIT_TEST_MAIN
@@ -237,6 +241,8 @@ private:
     DoubleGaugePtr mAgentCpu;
     IntGaugePtr mAgentMemory;
     IntGaugePtr mAgentGoMemory;
+    IntGaugePtr mAgentMemoryBudgetLimit;
+    IntGaugePtr mAgentMemoryBudgetUsed;
     IntGaugePtr mAgentGoRoutinesTotal;
     IntGaugePtr mAgentOpenFdTotal;
     IntGaugePtr mAgentConfigTotal;
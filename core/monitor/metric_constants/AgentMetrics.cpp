@@ -36,6 +36,8 @@ const string METRIC_AGENT_GO_ROUTINES_TOTAL = "go_routines_total";
 const string METRIC_AGENT_INSTANCE_CONFIG_TOTAL = "instance_config_total"; // Not Implemented
 const string METRIC_AGENT_MEMORY = "memory_used_mb";
 const string METRIC_AGENT_MEMORY_GO = "go_memory_used_mb";
+const string METRIC_AGENT_MEMORY_BUDGET_LIMIT = "memory_budget_limit_mb";
+const string METRIC_AGENT_MEMORY_BUDGET_USED = "memory_budget_used_mb";
 const string METRIC_AGENT_OPEN_FD_TOTAL = "open_fd_total";
 const string METRIC_AGENT_PIPELINE_CONFIG_TOTAL = "pipeline_config_total";
 
@@ -34,9 +34,15 @@ const string METRIC_LABEL_KEY_EXACTLY_ONCE_ENABLED = "exactly_once_enabled";
  **********************************************************/
 const string METRIC_LABEL_KEY_GROUP_BATCH_ENABLED = "group_batch_enabled";
 
+/**********************************************************
+ *   limiter
+ **********************************************************/
+const string METRIC_LABEL_KEY_LIMITER_DESCRIPTION = "limiter_description";
+
 // label values
 const string METRIC_LABEL_VALUE_COMPONENT_NAME_BATCHER = "batcher";
 const string METRIC_LABEL_VALUE_COMPONENT_NAME_COMPRESSOR = "compressor";
+const string METRIC_LABEL_VALUE_COMPONENT_NAME_CONCURRENCY_LIMITER = "concurrency_limiter";
 const string METRIC_LABEL_VALUE_COMPONENT_NAME_PROCESS_QUEUE = "process_queue";
 const string METRIC_LABEL_VALUE_COMPONENT_NAME_ROUTER = "router";
 const string METRIC_LABEL_VALUE_COMPONENT_NAME_SENDER_QUEUE = "sender_queue";
@@ -81,4 +87,11 @@ const string METRIC_COMPONENT_QUEUE_FETCH_REJECTED_BY_PROJECT_LIMITER_TIMES_TOTA
 const string METRIC_COMPONENT_QUEUE_FETCH_REJECTED_BY_LOGSTORE_LIMITER_TIMES_TOTAL = "logstore_reject_times_total";
 const string METRIC_COMPONENT_QUEUE_FETCH_REJECTED_BY_RATE_LIMITER_TIMES_TOTAL = "rate_reject_times_total";
 
+/**********************************************************
+ *   limiter
+ **********************************************************/
+const string METRIC_COMPONENT_LIMITER_CONCURRENCY_LIMIT = "concurrency_limit";
+const string METRIC_COMPONENT_LIMITER_MIN_RESPONSE_TIME_MS = "min_response_time_ms";
+const string METRIC_COMPONENT_LIMITER_RECENT_RESPONSE_TIME_MS = "recent_response_time_ms";
+
 } // namespace logtail
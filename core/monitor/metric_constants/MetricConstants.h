@@ -40,6 +40,8 @@ extern const std::string METRIC_AGENT_GO_ROUTINES_TOTAL;
 extern const std::string METRIC_AGENT_INSTANCE_CONFIG_TOTAL;
 extern const std::string METRIC_AGENT_MEMORY;
 extern const std::string METRIC_AGENT_MEMORY_GO;
+extern const std::string METRIC_AGENT_MEMORY_BUDGET_LIMIT;
+extern const std::string METRIC_AGENT_MEMORY_BUDGET_USED;
 extern const std::string METRIC_AGENT_OPEN_FD_TOTAL;
 extern const std::string METRIC_AGENT_PIPELINE_CONFIG_TOTAL;
 
@@ -188,6 +190,13 @@ extern const std::string METRIC_PLUGIN_FLUSHER_OTHER_ERROR_TOTAL;
  **********************************************************/
 extern const std::string METRIC_PLUGIN_HISTORY_FAILURE_TOTAL;
 
+/**********************************************************
+ *   processor_parse_regex_native
+ **********************************************************/
+extern const std::string METRIC_PLUGIN_PARSE_LATENCY_P50_US;
+extern const std::string METRIC_PLUGIN_PARSE_LATENCY_P90_US;
+extern const std::string METRIC_PLUGIN_PARSE_LATENCY_P99_US;
+
 /**********************************************************
  *   processor_split_multiline_log_string_native
  **********************************************************/
@@ -225,10 +234,12 @@ extern const std::string METRIC_LABEL_KEY_FLUSHER_PLUGIN_ID;
 extern const std::string METRIC_LABEL_KEY_EXACTLY_ONCE_ENABLED;
 extern const std::string METRIC_LABEL_KEY_QUEUE_TYPE;
 extern const std::string METRIC_LABEL_KEY_GROUP_BATCH_ENABLED;
+extern const std::string METRIC_LABEL_KEY_LIMITER_DESCRIPTION;
 
 // label values
 extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_BATCHER;
 extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_COMPRESSOR;
+extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_CONCURRENCY_LIMITER;
 extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_PROCESS_QUEUE;
 extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_ROUTER;
 extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_SENDER_QUEUE;
@@ -273,6 +284,13 @@ extern const std::string METRIC_COMPONENT_QUEUE_FETCH_REJECTED_BY_PROJECT_LIMITE
 extern const std::string METRIC_COMPONENT_QUEUE_FETCH_REJECTED_BY_LOGSTORE_LIMITER_TIMES_TOTAL;
 extern const std::string METRIC_COMPONENT_QUEUE_FETCH_REJECTED_BY_RATE_LIMITER_TIMES_TOTAL;
 
+/**********************************************************
+ *   limiter
+ **********************************************************/
+extern const std::string METRIC_COMPONENT_LIMITER_CONCURRENCY_LIMIT;
+extern const std::string METRIC_COMPONENT_LIMITER_MIN_RESPONSE_TIME_MS;
+extern const std::string METRIC_COMPONENT_LIMITER_RECENT_RESPONSE_TIME_MS;
+
 //////////////////////////////////////////////////////////////////////////
 // runner
 //////////////////////////////////////////////////////////////////////////
@@ -285,6 +303,7 @@ extern const std::string METRIC_LABEL_KEY_THREAD_NO;
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_FILE_SERVER;
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_FLUSHER;
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_HTTP_SINK;
+extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_FILE_SINK;
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_PROCESSOR;
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_PROMETHEUS;
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_EBPF_SERVER;
@@ -327,6 +346,8 @@ extern const std::string METRIC_RUNNER_FILE_ENABLE_FILE_INCLUDED_BY_MULTI_CONFIG
 extern const std::string METRIC_RUNNER_FILE_POLLING_MODIFY_CACHE_SIZE;
 extern const std::string METRIC_RUNNER_FILE_POLLING_DIR_CACHE_SIZE;
 extern const std::string METRIC_RUNNER_FILE_POLLING_FILE_CACHE_SIZE;
+extern const std::string METRIC_RUNNER_FILE_HISTORY_IMPORT_SIZE_BYTES;
+extern const std::string METRIC_RUNNER_FILE_HISTORY_IMPORT_THROUGHPUT_GB_PER_SEC;
 
 /**********************************************************
  *   ebpf server
@@ -126,6 +126,13 @@ const string METRIC_PLUGIN_OUT_SUCCESSFUL_EVENTS_TOTAL = "out_successful_events_
  **********************************************************/
 const string METRIC_PLUGIN_HISTORY_FAILURE_TOTAL = "history_failure_total";
 
+/**********************************************************
+ *   processor_parse_regex_native
+ **********************************************************/
+const string METRIC_PLUGIN_PARSE_LATENCY_P50_US = "parse_latency_p50_us";
+const string METRIC_PLUGIN_PARSE_LATENCY_P90_US = "parse_latency_p90_us";
+const string METRIC_PLUGIN_PARSE_LATENCY_P99_US = "parse_latency_p99_us";
+
 /**********************************************************
  *   processor_split_multiline_log_string_native
  **********************************************************/
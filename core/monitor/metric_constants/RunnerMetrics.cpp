@@ -27,6 +27,7 @@ const string METRIC_LABEL_KEY_THREAD_NO = "thread_no";
 const string METRIC_LABEL_VALUE_RUNNER_NAME_FILE_SERVER = "file_server";
 const string METRIC_LABEL_VALUE_RUNNER_NAME_FLUSHER = "flusher_runner";
 const string METRIC_LABEL_VALUE_RUNNER_NAME_HTTP_SINK = "http_sink";
+const string METRIC_LABEL_VALUE_RUNNER_NAME_FILE_SINK = "file_sink";
 const string METRIC_LABEL_VALUE_RUNNER_NAME_PROCESSOR = "processor_runner";
 const string METRIC_LABEL_VALUE_RUNNER_NAME_PROMETHEUS = "prometheus_runner";
 const string METRIC_LABEL_VALUE_RUNNER_NAME_EBPF_SERVER = "ebpf_runner";
@@ -69,6 +70,8 @@ const string METRIC_RUNNER_FILE_ENABLE_FILE_INCLUDED_BY_MULTI_CONFIGS_FLAG = "en
 const string METRIC_RUNNER_FILE_POLLING_MODIFY_CACHE_SIZE = "polling_modify_cache_size";
 const string METRIC_RUNNER_FILE_POLLING_DIR_CACHE_SIZE = "polling_dir_cache_size";
 const string METRIC_RUNNER_FILE_POLLING_FILE_CACHE_SIZE = "polling_file_cache_size";
+const string METRIC_RUNNER_FILE_HISTORY_IMPORT_SIZE_BYTES = "history_import_size_bytes";
+const string METRIC_RUNNER_FILE_HISTORY_IMPORT_THROUGHPUT_GB_PER_SEC = "history_import_throughput_gb_per_sec";
 
 /**********************************************************
  *   ebpf server
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <initializer_list>
+#include <vector>
+
+namespace logtail {
+
+// LatencyHistogram counts latencies in power-of-two microsecond buckets, so that percentiles can be estimated without
+// keeping the samples. Bucket 0 holds latencies below 1us, and bucket i holds [2^(i-1), 2^i) us.
+// It is lock free and can be shared by threads.
+class LatencyHistogram {
+public:
+    static const size_t kBucketNum = 32;
+
+    void Add(std::chrono::nanoseconds latency) {
+        uint64_t us = static_cast<uint64_t>(latency.count()) / 1000;
+        size_t idx = 0;
+        while (us != 0 && idx + 1 < kBucketNum) {
+            us >>= 1;
+            ++idx;
+        }
+        mBuckets[idx].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Collect estimates @percentiles, each in (0, 100], of the latencies added since the last call in microseconds,
+    // interpolating linearly inside the bucket. The histogram is reset afterwards.
+    // @return false if no latency is added since the last call.
+    bool Collect(std::initializer_list<double> percentiles, std::vector<uint64_t>& res) {
+        std::array<uint64_t, kBucketNum> counts;
+        uint64_t total = 0;
+        for (size_t i = 0; i < kBucketNum; ++i) {
+            counts[i] = mBuckets[i].exchange(0, std::memory_order_relaxed);
+            total += counts[i];
+        }
+        res.clear();
+        if (total == 0) {
+            return false;
+        }
+        for (double p : percentiles) {
+            double rank = total * p / 100;
+            uint64_t seen = 0;
+            size_t idx = 0;
+            while (idx + 1 < kBucketNum && seen + counts[idx] < rank) {
+                seen += counts[idx++];
+            }
+            double lower = idx == 0 ? 0 : static_cast<double>(1ULL << (idx - 1));
+            double upper = static_cast<double>(1ULL << idx);
+            double ratio = counts[idx] == 0 ? 1 : (rank - seen) / counts[idx];
+            res.push_back(static_cast<uint64_t>(lower + (upper - lower) * ratio));
+        }
+        return true;
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, kBucketNum> mBuckets{};
+};
+
+} // namespace logtail
@@ -16,7 +16,8 @@
 
 namespace logtail {
 
-DelimiterModeFsmParser::DelimiterModeFsmParser(char quote, char separator) : quote(quote), separator(separator) {
+DelimiterModeFsmParser::DelimiterModeFsmParser(char quote, char separator)
+    : quote(quote), separator(separator), specialCharMatcher({separator, quote}) {
 }
 
 DelimiterModeFsmParser::~DelimiterModeFsmParser() {
@@ -270,20 +271,35 @@ bool DelimiterModeFsmParser::ParseDelimiterLine(
     const char* ch = buffer.data();
     int fieldStart = begin;
     int fieldEnd = begin;
-    for (int i = begin; i < end; ++i) {
-        if (ch[i] == separator) {
-            result = HandleSeparator(ch, quote, fieldStart, fieldEnd, fsm, columnValues, doubleQuoteNum, event);
-        } else if (ch[i] == quote) {
-            result = HandleQuote(fieldStart, fieldEnd, fsm, doubleQuoteNum);
-        } else // data
-        {
-            result = HandleData(fieldEnd, fsm);
+    // data chars never change the state except the first one after a separator or a quote, so only separators and
+    // quotes are located by the matcher and the data chars between them are handled as a whole
+    int dataBegin = begin;
+    auto handleData = [&](int dataEnd) {
+        if (dataEnd == dataBegin) {
+            return true;
         }
-
-        if (!result) {
-            columnValues.clear();
+        if (!HandleData(fieldEnd, fsm)) {
             return false;
         }
+        fieldEnd += dataEnd - dataBegin - 1;
+        return true;
+    };
+    specialCharMatcher.ForEach(ch + begin, ch + end, [&](const char* p) {
+        int i = p - ch;
+        result = handleData(i);
+        if (result) {
+            if (*p == separator) {
+                result = HandleSeparator(ch, quote, fieldStart, fieldEnd, fsm, columnValues, doubleQuoteNum, event);
+            } else {
+                result = HandleQuote(fieldStart, fieldEnd, fsm, doubleQuoteNum);
+            }
+        }
+        dataBegin = i + 1;
+        return result;
+    });
+    if (!result || !handleData(end)) {
+        columnValues.clear();
+        return false;
     }
     result = HandleEOF(ch, quote, fieldStart, fieldEnd, fsm, columnValues, doubleQuoteNum, event);
     // clear all columns if failed to parse
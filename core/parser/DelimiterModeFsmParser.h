@@ -20,6 +20,7 @@
 #include <string>
 #include <vector>
 
+#include "common/CharSetMatcher.h"
 #include "common/StringView.h"
 #include "models/LogEvent.h"
 
@@ -97,6 +98,7 @@ public:
 private:
     const char quote;
     const char separator;
+    const CharSetMatcher specialCharMatcher;
 };
 
 } // namespace logtail
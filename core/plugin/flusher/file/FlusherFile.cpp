@@ -14,10 +14,18 @@
 
 #include "plugin/flusher/file/FlusherFile.h"
 
-#include "spdlog/async.h"
-#include "spdlog/sinks/rotating_file_sink.h"
+#include <cstring>
 
+#include "app_config/AppConfig.h"
 #include "collection_pipeline/queue/SenderQueueManager.h"
+#include "common/Flags.h"
+#include "common/compression/CompressorFactory.h"
+#include "runner/ProcessorRunner.h"
+
+DEFINE_FLAG_INT32(flusher_file_batch_max_size_bytes, "", 1024 * 1024);
+DEFINE_FLAG_INT32(flusher_file_batch_min_size_bytes, "", 256 * 1024);
+DEFINE_FLAG_INT32(flusher_file_batch_min_cnt, "", 4000);
+DEFINE_FLAG_INT32(flusher_file_batch_timeout_secs, "", 1);
 
 using namespace std;
 
@@ -43,53 +51,155 @@ bool FlusherFile::Init(const Json::Value& config, Json::Value& optionalGoPipelin
                            mContext->GetRegion());
     }
     // MaxFileSize
-    GetMandatoryUIntParam(config, "MaxFileSize", mMaxFileSize, errorMsg);
+    if (!GetOptionalUIntParam(config, "MaxFileSize", mMaxFileSize, errorMsg)) {
+        PARAM_WARNING_DEFAULT(mContext->GetLogger(),
+                              mContext->GetAlarm(),
+                              errorMsg,
+                              mMaxFileSize,
+                              sName,
+                              mContext->GetConfigName(),
+                              mContext->GetProjectName(),
+                              mContext->GetLogstoreName(),
+                              mContext->GetRegion());
+    }
     // MaxFiles
-    GetMandatoryUIntParam(config, "MaxFiles", mMaxFiles, errorMsg);
+    if (!GetOptionalUIntParam(config, "MaxFiles", mMaxFiles, errorMsg)) {
+        PARAM_WARNING_DEFAULT(mContext->GetLogger(),
+                              mContext->GetAlarm(),
+                              errorMsg,
+                              mMaxFiles,
+                              sName,
+                              mContext->GetConfigName(),
+                              mContext->GetProjectName(),
+                              mContext->GetLogstoreName(),
+                              mContext->GetRegion());
+    }
+    // RotateInterval
+    if (!GetOptionalUIntParam(config, "RotateInterval", mRotateInterval, errorMsg)) {
+        PARAM_WARNING_DEFAULT(mContext->GetLogger(),
+                              mContext->GetAlarm(),
+                              errorMsg,
+                              mRotateInterval,
+                              sName,
+                              mContext->GetConfigName(),
+                              mContext->GetProjectName(),
+                              mContext->GetLogstoreName(),
+                              mContext->GetRegion());
+    }
+
+    // CompressType
+    // only zstd is supported, because concatenated zstd frames are still a valid zstd file, while lz4 blocks are not
+    string compressType;
+    if (!GetOptionalStringParam(config, "CompressType", compressType, errorMsg)) {
+        PARAM_WARNING_IGNORE(mContext->GetLogger(),
+                             mContext->GetAlarm(),
+                             errorMsg,
+                             sName,
+                             mContext->GetConfigName(),
+                             mContext->GetProjectName(),
+                             mContext->GetLogstoreName(),
+                             mContext->GetRegion());
+    } else if (compressType == "zstd") {
+        mCompressor = CompressorFactory::GetInstance()->Create(config, *mContext, sName, mPluginID, CompressType::ZSTD);
+    } else if (!compressType.empty() && compressType != "none") {
+        PARAM_WARNING_IGNORE(mContext->GetLogger(),
+                             mContext->GetAlarm(),
+                             "string param CompressType is not valid",
+                             sName,
+                             mContext->GetConfigName(),
+                             mContext->GetProjectName(),
+                             mContext->GetLogstoreName(),
+                             mContext->GetRegion());
+    }
 
-    // create file writer
-    auto threadPool = std::make_shared<spdlog::details::thread_pool>(10, 1);
-    auto fileSink = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(mFilePath, mMaxFileSize, mMaxFiles, true);
-    mFileWriter
-        = std::make_shared<spdlog::async_logger>(sName, fileSink, threadPool, spdlog::async_overflow_policy::block);
-    mFileWriter->set_pattern("%v");
+    // Batch
+    const char* key = "Batch";
+    const Json::Value* itr = config.find(key, key + strlen(key));
+    if (itr && !itr->isObject()) {
+        PARAM_WARNING_IGNORE(mContext->GetLogger(),
+                             mContext->GetAlarm(),
+                             "param Batch is not of type object",
+                             sName,
+                             mContext->GetConfigName(),
+                             mContext->GetProjectName(),
+                             mContext->GetLogstoreName(),
+                             mContext->GetRegion());
+        itr = nullptr;
+    }
+    DefaultFlushStrategyOptions strategy{static_cast<uint32_t>(INT32_FLAG(flusher_file_batch_max_size_bytes)),
+                                         static_cast<uint32_t>(INT32_FLAG(flusher_file_batch_min_size_bytes)),
+                                         static_cast<uint32_t>(INT32_FLAG(flusher_file_batch_min_cnt)),
+                                         static_cast<uint32_t>(INT32_FLAG(flusher_file_batch_timeout_secs))};
+    if (!mBatcher.Init(
+            itr ? *itr : Json::Value(), this, strategy, true, AppConfig::GetInstance()->GetProcessThreadCount())) {
+        return false;
+    }
 
+    mFileWriter = make_shared<RotatingFileWriter>(mFilePath, mMaxFileSize, mMaxFiles, mRotateInterval);
     mGroupSerializer = make_unique<JsonEventGroupSerializer>(this);
     mSendCnt = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_FLUSHER_OUT_EVENT_GROUPS_TOTAL);
     return true;
 }
 
 bool FlusherFile::Send(PipelineEventGroup&& g) {
-    return SerializeAndPush(std::move(g));
+    vector<BatchedEventsList> res;
+    mBatcher.Add(std::move(g), res, ProcessorRunner::GetThreadNo());
+    return SerializeAndPush(std::move(res));
 }
 
 bool FlusherFile::Flush(size_t key) {
-    return true;
+    BatchedEventsList res;
+    mBatcher.FlushQueue(key, res);
+    return SerializeAndPush(std::move(res));
 }
 
 bool FlusherFile::FlushAll() {
-    return true;
+    vector<BatchedEventsList> res;
+    mBatcher.FlushAll(res);
+    return SerializeAndPush(std::move(res));
 }
 
-bool FlusherFile::SerializeAndPush(PipelineEventGroup&& group) {
-    string serializedData;
-    string errorMsg;
-    BatchedEvents g(std::move(group.MutableEvents()),
-                    std::move(group.GetSizedTags()),
-                    std::move(group.GetSourceBuffer()),
-                    group.GetMetadata(EventGroupMetaKey::SOURCE_ID),
-                    std::move(group.GetExactlyOnceCheckpoint()));
-    mGroupSerializer->DoSerialize(std::move(g), serializedData, errorMsg);
-    if (errorMsg.empty()) {
-        if (!serializedData.empty() && serializedData.back() == '\n') {
-            serializedData.pop_back();
+bool FlusherFile::SerializeAndPush(vector<BatchedEventsList>&& groupLists) {
+    bool allSucceeded = true;
+    for (auto& groupList : groupLists) {
+        allSucceeded = SerializeAndPush(std::move(groupList)) && allSucceeded;
+    }
+    return allSucceeded;
+}
+
+bool FlusherFile::SerializeAndPush(BatchedEventsList&& groupList) {
+    if (groupList.empty()) {
+        return true;
+    }
+    // all groups in the list are written as one item, so that the file sink appends them with a single write
+    string data, serializedData, errorMsg;
+    for (auto& group : groupList) {
+        serializedData.clear();
+        errorMsg.clear();
+        if (!mGroupSerializer->DoSerialize(std::move(group), serializedData, errorMsg)) {
+            if (!errorMsg.empty()) {
+                LOG_ERROR(sLogger, ("serialize pipeline event group error", errorMsg));
+            }
+            continue;
         }
-        mFileWriter->info(std::move(serializedData));
-        mFileWriter->flush();
-    } else {
-        LOG_ERROR(sLogger, ("serialize pipeline event group error", errorMsg));
+        ADD_COUNTER(mSendCnt, 1);
+        data.append(serializedData);
     }
-    return true;
+    if (data.empty()) {
+        return true;
+    }
+    size_t rawSize = data.size();
+    if (mCompressor) {
+        string compressedData;
+        if (!mCompressor->DoCompress(data, compressedData, errorMsg)) {
+            LOG_WARNING(mContext->GetLogger(),
+                        ("failed to compress event group",
+                         errorMsg)("action", "discard data")("plugin", sName)("config", mContext->GetConfigName()));
+            return false;
+        }
+        data = std::move(compressedData);
+    }
+    return PushToQueue(make_unique<SenderQueueItem>(std::move(data), rawSize, this, mQueueKey));
 }
 
 } // namespace logtail
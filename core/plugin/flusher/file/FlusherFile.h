@@ -16,13 +16,14 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
-#include "spdlog/spdlog.h"
-
 #include "collection_pipeline/batch/Batcher.h"
 #include "collection_pipeline/plugin/interface/Flusher.h"
 #include "collection_pipeline/serializer/JsonSerializer.h"
+#include "common/compression/Compressor.h"
+#include "runner/sink/file/RotatingFileWriter.h"
 
 namespace logtail {
 
@@ -35,17 +36,28 @@ public:
     bool Send(PipelineEventGroup&& g) override;
     bool Flush(size_t key) override;
     bool FlushAll() override;
+    SinkType GetSinkType() override { return SinkType::FILE; }
+
+    const std::shared_ptr<RotatingFileWriter>& GetFileWriter() const { return mFileWriter; }
 
 private:
-    bool SerializeAndPush(PipelineEventGroup&& group);
+    bool SerializeAndPush(std::vector<BatchedEventsList>&& groupLists);
+    bool SerializeAndPush(BatchedEventsList&& groupList);
 
-    std::shared_ptr<spdlog::logger> mFileWriter;
+    std::shared_ptr<RotatingFileWriter> mFileWriter;
     std::string mFilePath;
     uint32_t mMaxFileSize = 1024 * 1024 * 10;
     uint32_t mMaxFiles = 10;
+    uint32_t mRotateInterval = 0;
+    Batcher<> mBatcher;
     std::unique_ptr<EventGroupSerializer> mGroupSerializer;
+    std::unique_ptr<Compressor> mCompressor;
 
     CounterPtr mSendCnt;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class FlusherFileUnittest;
+#endif
 };
 
 } // namespace logtail
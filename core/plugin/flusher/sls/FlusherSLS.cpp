@@ -38,6 +38,7 @@
 #include "plugin/flusher/sls/SendResult.h"
 #include "provider/Provider.h"
 #include "runner/FlusherRunner.h"
+#include "runner/ProcessorRunner.h"
 #include "sls_logs.pb.h"
 #ifdef __ENTERPRISE__
 #include "config/provider/EnterpriseConfigProvider.h"
@@ -505,7 +506,8 @@ bool FlusherSLS::Init(const Json::Value& config, Json::Value& optionalGoPipeline
                        this,
                        strategy,
                        !mContext->IsExactlyOnceEnabled() && mShardHashKeys.empty()
-                           && mTelemetryType != sls_logs::SLS_TELEMETRY_TYPE_METRICS)) {
+                           && mTelemetryType != sls_logs::SLS_TELEMETRY_TYPE_METRICS,
+                       AppConfig::GetInstance()->GetProcessThreadCount())) {
         // when either exactly once is enabled or ShardHashKeys is not empty or telemetry type is metrics, we don't
         // enable group batch
         return false;
@@ -587,7 +589,7 @@ bool FlusherSLS::Send(PipelineEventGroup&& g) {
         return SerializeAndPush(std::move(g));
     } else {
         vector<BatchedEventsList> res;
-        mBatcher.Add(std::move(g), res);
+        mBatcher.Add(std::move(g), res, ProcessorRunner::GetThreadNo());
         return SerializeAndPush(std::move(res));
     }
 }
@@ -714,9 +716,12 @@ void FlusherSLS::OnSendDone(const HttpResponse& response, SenderQueueItem* item)
                 ToString(chrono::duration_cast<chrono::milliseconds>(curSystemTime - item->mFirstEnqueTime).count())
                     + "ms")("try cnt", data->mTryCnt)("endpoint", data->mCurrentHost)("is profile data",
                                                                                       isProfileData));
-        GetRegionConcurrencyLimiter(mRegion)->OnSuccess(curSystemTime);
-        GetProjectConcurrencyLimiter(mProject)->OnSuccess(curSystemTime);
-        GetLogstoreConcurrencyLimiter(mProject, mLogstore)->OnSuccess(curSystemTime);
+        // measured by http sink from the request being sent, not including the time waiting in the sink
+        auto responseTime = response.GetResponseTime() == chrono::milliseconds::max() ? chrono::milliseconds::zero()
+                                                                                      : response.GetResponseTime();
+        GetRegionConcurrencyLimiter(mRegion)->OnSuccess(curSystemTime, responseTime);
+        GetProjectConcurrencyLimiter(mProject)->OnSuccess(curSystemTime, responseTime);
+        GetLogstoreConcurrencyLimiter(mProject, mLogstore)->OnSuccess(curSystemTime, responseTime);
         SenderQueueManager::GetInstance()->DecreaseConcurrencyLimiterInSendingCnt(item->mQueueKey);
         ADD_COUNTER(mSuccessCnt, 1);
         DealSenderQueueItemAfterSend(item, false);
@@ -1193,6 +1198,7 @@ unique_ptr<HttpSinkRequest> FlusherSLS::CreatePostLogStoreLogsRequest(const stri
                                    CompressTypeToString(mCompressor->GetCompressType()),
                                    item->mType,
                                    item->mData,
+                                   item->GetContentMd5(),
                                    item->mRawSize,
                                    item->mShardHashKey,
                                    seqId,
@@ -1229,6 +1235,7 @@ unique_ptr<HttpSinkRequest> FlusherSLS::CreatePostMetricStoreLogsRequest(const s
                                       item->mLogstore,
                                       CompressTypeToString(mCompressor->GetCompressType()),
                                       item->mData,
+                                      item->GetContentMd5(),
                                       item->mRawSize,
                                       path,
                                       header);
@@ -1264,6 +1271,7 @@ unique_ptr<HttpSinkRequest> FlusherSLS::CreatePostAPMBackendRequest(const string
                                  CompressTypeToString(mCompressor->GetCompressType()),
                                  item->mType,
                                  item->mData,
+                                 item->GetContentMd5(),
                                  item->mRawSize,
                                  mSubpath,
                                  query,
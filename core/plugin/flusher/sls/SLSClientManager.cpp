@@ -144,6 +144,7 @@ void PreparePostLogStoreLogsRequest(const string& accessKeyId,
                                     const string& compressType,
                                     RawDataType dataType,
                                     const string& body,
+                                    const string& contentMd5,
                                     size_t rawSize,
                                     const string& shardHashKey,
                                     optional<uint64_t> seqId,
@@ -167,7 +168,7 @@ void PreparePostLogStoreLogsRequest(const string& accessKeyId,
     header[DATE] = GetDateString();
     header[CONTENT_TYPE] = TYPE_LOG_PROTOBUF;
     header[CONTENT_LENGTH] = to_string(body.size());
-    header[CONTENT_MD5] = CalcMD5(body);
+    header[CONTENT_MD5] = contentMd5;
     header[X_LOG_APIVERSION] = LOG_API_VERSION;
     header[X_LOG_SIGNATUREMETHOD] = HMAC_SHA1;
     if (!compressType.empty()) {
@@ -205,6 +206,7 @@ void PreparePostMetricStoreLogsRequest(const string& accessKeyId,
                                        const string& logstore,
                                        const string& compressType,
                                        const string& body,
+                                       const string& contentMd5,
                                        size_t rawSize,
                                        string& path,
                                        map<string, string>& header) {
@@ -220,7 +222,7 @@ void PreparePostMetricStoreLogsRequest(const string& accessKeyId,
     header[DATE] = GetDateString();
     header[CONTENT_TYPE] = TYPE_LOG_PROTOBUF;
     header[CONTENT_LENGTH] = to_string(body.size());
-    header[CONTENT_MD5] = CalcMD5(body);
+    header[CONTENT_MD5] = contentMd5;
     header[X_LOG_APIVERSION] = LOG_API_VERSION;
     header[X_LOG_SIGNATUREMETHOD] = HMAC_SHA1;
     if (!compressType.empty()) {
@@ -246,6 +248,7 @@ void PreparePostAPMBackendRequest(const string& accessKeyId,
                                   const string& compressType,
                                   RawDataType dataType,
                                   const string& body,
+                                  const string& contentMd5,
                                   size_t rawSize,
                                   const string& path,
                                   string& query,
@@ -259,7 +262,7 @@ void PreparePostAPMBackendRequest(const string& accessKeyId,
     header[DATE] = GetDateString();
     header[CONTENT_TYPE] = TYPE_LOG_PROTOBUF;
     header[CONTENT_LENGTH] = to_string(body.size());
-    header[CONTENT_MD5] = CalcMD5(body);
+    header[CONTENT_MD5] = contentMd5;
     header[X_LOG_APIVERSION] = LOG_API_VERSION;
     header[X_LOG_SIGNATUREMETHOD] = HMAC_SHA1;
     if (!compressType.empty()) {
@@ -304,6 +307,7 @@ SLSResponse PostLogStoreLogs(const string& accessKeyId,
                                    compressType,
                                    dataType,
                                    body,
+                                   CalcMD5(body),
                                    rawSize,
                                    shardHashKey,
                                    nullopt, // sync request does not support exactly-once
@@ -338,6 +342,7 @@ SLSResponse PostMetricStoreLogs(const string& accessKeyId,
                                       logstore,
                                       compressType,
                                       body,
+                                      CalcMD5(body),
                                       rawSize,
                                       path,
                                       header);
@@ -371,6 +376,7 @@ SLSResponse PostAPMBackendLogs(const string& accessKeyId,
                                  compressType,
                                  dataType,
                                  body,
+                                 CalcMD5(body),
                                  rawSize,
                                  subpath,
                                  query,
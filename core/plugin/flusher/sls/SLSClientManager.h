@@ -63,6 +63,7 @@ private:
 #endif
 };
 
+// @contentMd5: md5 of @body, which is calculated once and reused by retries of the same data.
 void PreparePostLogStoreLogsRequest(const std::string& accessKeyId,
                                     const std::string& accessKeySecret,
                                     SLSClientManager::AuthType type,
@@ -73,6 +74,7 @@ void PreparePostLogStoreLogsRequest(const std::string& accessKeyId,
                                     const std::string& compressType,
                                     RawDataType dataType,
                                     const std::string& body,
+                                    const std::string& contentMd5,
                                     size_t rawSize,
                                     const std::string& shardHashKey,
                                     std::optional<uint64_t> seqId,
@@ -88,6 +90,7 @@ void PreparePostMetricStoreLogsRequest(const std::string& accessKeyId,
                                        const std::string& logstore,
                                        const std::string& compressType,
                                        const std::string& body,
+                                       const std::string& contentMd5,
                                        size_t rawSize,
                                        std::string& path,
                                        std::map<std::string, std::string>& header);
@@ -101,6 +104,7 @@ void PreparePostAPMBackendRequest(const std::string& accessKeyId,
                                   const std::string& compressType,
                                   RawDataType dataType,
                                   const std::string& body,
+                                  const std::string& contentMd5,
                                   size_t rawSize,
                                   const std::string& path,
                                   std::string& query,
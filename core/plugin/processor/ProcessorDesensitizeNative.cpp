@@ -15,13 +15,22 @@
  */
 #include "plugin/processor/ProcessorDesensitizeNative.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "collection_pipeline/plugin/instance/ProcessorInstance.h"
+#include "common/Flags.h"
 #include "common/HashUtil.h"
 #include "common/ParamExtractor.h"
 #include "constants/Constants.h"
 #include "models/LogEvent.h"
 #include "monitor/metric_constants/MetricConstants.h"
 
+DEFINE_FLAG_INT64(desensitize_rule_set_max_mem,
+                  "max memory of the regex set finding matched desensitize rules, rules are searched one by one if "
+                  "it is exceeded, bytes",
+                  8 * 1024 * 1024);
+
 namespace logtail {
 
 const std::string ProcessorDesensitizeNative::sName = "processor_desensitize_native";
@@ -41,36 +50,40 @@ bool ProcessorDesensitizeNative::Init(const Json::Value& config) {
                            mContext->GetRegion());
     }
 
-    // Method
-    std::string method;
-    if (!GetMandatoryStringParam(config, "Method", method, errorMsg)) {
-        PARAM_ERROR_RETURN(mContext->GetLogger(),
-                           mContext->GetAlarm(),
-                           errorMsg,
-                           sName,
-                           mContext->GetConfigName(),
-                           mContext->GetProjectName(),
-                           mContext->GetLogstoreName(),
-                           mContext->GetRegion());
-    }
-    if (method == "const") {
-        mMethod = DesensitizeMethod::CONST_OPTION;
-    } else if (method == "md5") {
-        mMethod = DesensitizeMethod::MD5_OPTION;
+    // Rules
+    const char* key = "Rules";
+    const Json::Value* itr = config.find(key, key + strlen(key));
+    if (itr != nullptr) {
+        if (!itr->isArray() || itr->empty()) {
+            PARAM_ERROR_RETURN(mContext->GetLogger(),
+                               mContext->GetAlarm(),
+                               "param Rules is not a non-empty array",
+                               sName,
+                               mContext->GetConfigName(),
+                               mContext->GetProjectName(),
+                               mContext->GetLogstoreName(),
+                               mContext->GetRegion());
+        }
+        for (Json::Value::ArrayIndex i = 0; i < itr->size(); ++i) {
+            DesensitizeRule rule;
+            if (!(*itr)[i].isObject()) {
+                errorMsg = "rule is not an object";
+            } else if (ParseRule((*itr)[i], rule, errorMsg)) {
+                mRules.emplace_back(std::move(rule));
+                continue;
+            }
+            PARAM_ERROR_RETURN(mContext->GetLogger(),
+                               mContext->GetAlarm(),
+                               "param Rules[" + ToString(i) + "] is not valid: " + errorMsg,
+                               sName,
+                               mContext->GetConfigName(),
+                               mContext->GetProjectName(),
+                               mContext->GetLogstoreName(),
+                               mContext->GetRegion());
+        }
     } else {
-        PARAM_ERROR_RETURN(mContext->GetLogger(),
-                           mContext->GetAlarm(),
-                           "string param Method is not valid",
-                           sName,
-                           mContext->GetConfigName(),
-                           mContext->GetProjectName(),
-                           mContext->GetLogstoreName(),
-                           mContext->GetRegion());
-    }
-
-    // ReplacingString
-    if (mMethod == DesensitizeMethod::CONST_OPTION) {
-        if (!GetMandatoryStringParam(config, "ReplacingString", mReplacingString, errorMsg)) {
+        DesensitizeRule rule;
+        if (!ParseRule(config, rule, errorMsg)) {
             PARAM_ERROR_RETURN(mContext->GetLogger(),
                                mContext->GetAlarm(),
                                errorMsg,
@@ -80,47 +93,37 @@ bool ProcessorDesensitizeNative::Init(const Json::Value& config) {
                                mContext->GetLogstoreName(),
                                mContext->GetRegion());
         }
-    }
-    mReplacingString = std::string("\\1") + mReplacingString;
-
-    // ContentPatternBeforeReplacedString
-    if (!GetMandatoryStringParam(
-            config, "ContentPatternBeforeReplacedString", mContentPatternBeforeReplacedString, errorMsg)) {
-        PARAM_ERROR_RETURN(mContext->GetLogger(),
-                           mContext->GetAlarm(),
-                           errorMsg,
-                           sName,
-                           mContext->GetConfigName(),
-                           mContext->GetProjectName(),
-                           mContext->GetLogstoreName(),
-                           mContext->GetRegion());
-    }
-
-    // ReplacedContentPattern
-    if (!GetMandatoryStringParam(config, "ReplacedContentPattern", mReplacedContentPattern, errorMsg)) {
-        PARAM_ERROR_RETURN(mContext->GetLogger(),
-                           mContext->GetAlarm(),
-                           errorMsg,
-                           sName,
-                           mContext->GetConfigName(),
-                           mContext->GetProjectName(),
-                           mContext->GetLogstoreName(),
-                           mContext->GetRegion());
+        mMethod = rule.mMethod;
+        mReplacingString = rule.mRewrite;
+        mContentPatternBeforeReplacedString = config["ContentPatternBeforeReplacedString"].asString();
+        mReplacedContentPattern = config["ReplacedContentPattern"].asString();
+        mRules.emplace_back(std::move(rule));
     }
 
-    std::string regexStr = std::string("(") + mContentPatternBeforeReplacedString + ")" + mReplacedContentPattern;
-    mRegex.reset(new re2::RE2(regexStr));
-    if (!mRegex->ok()) {
-        errorMsg = mRegex->error();
-        PARAM_ERROR_RETURN(mContext->GetLogger(),
-                           mContext->GetAlarm(),
-                           "param ContentPatternBeforeReplacedString or ReplacedContentPattern is not a valid regex: "
-                               + errorMsg,
-                           sName,
-                           mContext->GetConfigName(),
-                           mContext->GetProjectName(),
-                           mContext->GetLogstoreName(),
-                           mContext->GetRegion());
+    if (mRules.size() > 1) {
+        re2::RE2::Options options;
+        options.set_max_mem(INT64_FLAG(desensitize_rule_set_max_mem));
+        options.set_log_errors(false);
+        mRuleSet.reset(new re2::RE2::Set(options, re2::RE2::UNANCHORED));
+        for (const auto& rule : mRules) {
+            if (mRuleSet->Add(rule.mRegex->pattern(), &errorMsg) < 0) {
+                PARAM_ERROR_RETURN(mContext->GetLogger(),
+                                   mContext->GetAlarm(),
+                                   "failed to add rule to regex set: " + errorMsg,
+                                   sName,
+                                   mContext->GetConfigName(),
+                                   mContext->GetProjectName(),
+                                   mContext->GetLogstoreName(),
+                                   mContext->GetRegion());
+            }
+        }
+        // each rule is valid, so the set can only fail for lack of memory
+        if (!mRuleSet->Compile()) {
+            LOG_WARNING(mContext->GetLogger(),
+                        ("failed to compile regex set of rules", "search rules one by one")("rule count", mRules.size())(
+                            "max mem", INT64_FLAG(desensitize_rule_set_max_mem))("config", mContext->GetConfigName()));
+            mRuleSet.reset();
+        }
     }
 
     // ReplacingAll
@@ -144,6 +147,59 @@ bool ProcessorDesensitizeNative::Init(const Json::Value& config) {
     return true;
 }
 
+bool ProcessorDesensitizeNative::ParseRule(const Json::Value& config, DesensitizeRule& rule, std::string& errorMsg) {
+    // Method
+    std::string method;
+    if (!GetMandatoryStringParam(config, "Method", method, errorMsg)) {
+        return false;
+    }
+    if (method == "const") {
+        rule.mMethod = DesensitizeMethod::CONST_OPTION;
+    } else if (method == "md5") {
+        rule.mMethod = DesensitizeMethod::MD5_OPTION;
+    } else {
+        errorMsg = "string param Method is not valid";
+        return false;
+    }
+
+    // ReplacingString
+    std::string replacingString;
+    if (rule.mMethod == DesensitizeMethod::CONST_OPTION) {
+        if (!GetMandatoryStringParam(config, "ReplacingString", replacingString, errorMsg)) {
+            return false;
+        }
+    }
+    rule.mRewrite = std::string("\\1") + replacingString;
+
+    // ContentPatternBeforeReplacedString
+    std::string contentPatternBeforeReplacedString;
+    if (!GetMandatoryStringParam(
+            config, "ContentPatternBeforeReplacedString", contentPatternBeforeReplacedString, errorMsg)) {
+        return false;
+    }
+
+    // ReplacedContentPattern
+    std::string replacedContentPattern;
+    if (!GetMandatoryStringParam(config, "ReplacedContentPattern", replacedContentPattern, errorMsg)) {
+        return false;
+    }
+
+    std::string regexStr = std::string("(") + contentPatternBeforeReplacedString + ")" + replacedContentPattern;
+    rule.mRegex.reset(new re2::RE2(regexStr));
+    if (!rule.mRegex->ok()) {
+        errorMsg = "param ContentPatternBeforeReplacedString or ReplacedContentPattern is not a valid regex: "
+            + rule.mRegex->error();
+        return false;
+    }
+    std::string rewriteError;
+    if (rule.mMethod == DesensitizeMethod::CONST_OPTION
+        && !rule.mRegex->CheckRewriteString(rule.mRewrite, &rewriteError)) {
+        errorMsg = "param ReplacingString is not valid: " + rewriteError;
+        return false;
+    }
+    return true;
+}
+
 void ProcessorDesensitizeNative::Process(PipelineEventGroup& logGroup) {
     if (logGroup.GetEvents().empty()) {
         return;
@@ -179,10 +235,10 @@ void ProcessorDesensitizeNative::ProcessEvent(PipelineEventPtr& e) {
         if (item.second.empty()) {
             continue;
         }
-        std::string value = item.second.to_string();
-        CastOneSensitiveWord(&value);
-        StringBuffer valueBuffer = sourceEvent.GetSourceBuffer()->CopyString(value);
-        sourceEvent.SetContentNoCopy(item.first, StringView(valueBuffer.data, valueBuffer.size));
+        StringView result;
+        if (CastSensitiveWords(item.second, *sourceEvent.GetSourceBuffer(), result)) {
+            sourceEvent.SetContentNoCopy(item.first, result);
+        }
         processed = true;
     }
     if (processed) {
@@ -196,56 +252,103 @@ void ProcessorDesensitizeNative::ProcessEvent(PipelineEventPtr& e) {
     }
 }
 
-void ProcessorDesensitizeNative::CastOneSensitiveWord(std::string* value) {
-    std::string* pVal = value;
-    bool rst = false;
-
-    if (mMethod == DesensitizeMethod::CONST_OPTION) {
-        if (mReplacingAll) {
-            rst = RE2::GlobalReplace(pVal, *mRegex, mReplacingString);
-        } else {
-            rst = RE2::Replace(pVal, *mRegex, mReplacingString);
+bool ProcessorDesensitizeNative::CastSensitiveWords(StringView value,
+                                                    SourceBuffer& sourceBuffer,
+                                                    StringView& result) const {
+    static thread_local std::vector<int> matchedRules;
+    static thread_local std::vector<MatchSpan> spans;
+    static thread_local std::string replacements;
+    matchedRules.clear();
+    spans.clear();
+    replacements.clear();
+    bool searchAll = true;
+    if (mRuleSet) {
+        re2::RE2::Set::ErrorInfo errorInfo{re2::RE2::Set::kNoError};
+        if (mRuleSet->Match(re2::StringPiece(value.data(), value.size()), &matchedRules, &errorInfo)) {
+            std::sort(matchedRules.begin(), matchedRules.end());
+            searchAll = false;
+        } else if (errorInfo.kind == re2::RE2::Set::kNoError) {
+            return false;
         }
-    } else {
-        re2::StringPiece srcStr(*pVal);
-        size_t maxSize = pVal->size();
-        size_t beginPos = 0;
-        rst = true;
-        std::string destStr;
-        do {
-            re2::StringPiece findRst;
-            if (!re2::RE2::FindAndConsume(&srcStr, *mRegex, &findRst)) {
-                if (beginPos == (size_t)0) {
-                    rst = false;
-                }
-                break;
-            }
-            // like  xxxx, psw=123abc,xx
-            size_t beginOffset = findRst.data() + findRst.size() - pVal->data();
-            size_t endOffset = srcStr.empty() ? maxSize : srcStr.data() - pVal->data();
-            if (beginOffset < beginPos || endOffset <= beginPos || endOffset > maxSize) {
-                rst = false;
-                break;
-            }
-            // add : xxxx, psw
-            destStr.append(pVal->substr(beginPos, beginOffset - beginPos));
-            // md5: 123abc
-            destStr.append(CalcMD5(pVal->substr(beginOffset, endOffset - beginOffset)));
-            beginPos = endOffset;
-            // refine for  : xxxx. psw=123abc
-            if (endOffset >= maxSize) {
-                break;
+        // otherwise, the set failed (e.g. the DFA is out of memory) and tells nothing about the value
+    }
+    if (searchAll) {
+        matchedRules.resize(mRules.size());
+        for (size_t i = 0; i < mRules.size(); ++i) {
+            matchedRules[i] = static_cast<int>(i);
+        }
+    }
+    for (int idx : matchedRules) {
+        FindRuleMatches(value, idx, spans, replacements);
+    }
+    if (spans.empty()) {
+        return false;
+    }
+    if (matchedRules.size() > 1) {
+        std::sort(spans.begin(), spans.end(), [](const MatchSpan& lhs, const MatchSpan& rhs) {
+            return lhs.mBegin < rhs.mBegin || (lhs.mBegin == rhs.mBegin && lhs.mRuleIdx < rhs.mRuleIdx);
+        });
+        size_t kept = 1;
+        for (size_t i = 1; i < spans.size(); ++i) {
+            if (spans[i].mBegin >= spans[kept - 1].mEnd) {
+                spans[kept++] = spans[i];
             }
-        } while (mReplacingAll);
+        }
+        spans.resize(kept);
+    }
 
-        if (rst && beginPos < pVal->size()) {
-            // add ,xx
-            destStr.append(pVal->substr(beginPos));
+    size_t size = value.size();
+    for (const auto& span : spans) {
+        size = size - (span.mEnd - span.mBegin) + span.mReplacementSize;
+    }
+    StringBuffer sb = sourceBuffer.AllocateStringBuffer(size);
+    char* dest = sb.data;
+    size_t pos = 0;
+    for (const auto& span : spans) {
+        memcpy(dest, value.data() + pos, span.mBegin - pos);
+        dest += span.mBegin - pos;
+        memcpy(dest, replacements.data() + span.mReplacementOffset, span.mReplacementSize);
+        dest += span.mReplacementSize;
+        pos = span.mEnd;
+    }
+    memcpy(dest, value.data() + pos, value.size() - pos);
+    result = StringView(sb.data, size);
+    return true;
+}
+
+void ProcessorDesensitizeNative::FindRuleMatches(StringView value,
+                                                 size_t ruleIdx,
+                                                 std::vector<MatchSpan>& spans,
+                                                 std::string& replacements) const {
+    static thread_local std::vector<re2::StringPiece> submatches;
+    const DesensitizeRule& rule = mRules[ruleIdx];
+    int groupNum = rule.mRegex->NumberOfCapturingGroups() + 1;
+    submatches.resize(groupNum);
+    re2::StringPiece text(value.data(), value.size());
+    size_t pos = 0;
+    while (pos <= value.size()
+           && rule.mRegex->Match(text, pos, value.size(), re2::RE2::UNANCHORED, submatches.data(), groupNum)) {
+        size_t begin = submatches[0].data() - value.data();
+        size_t end = begin + submatches[0].size();
+        // empty matches have nothing to desensitize
+        if (begin == end) {
+            pos = end + 1;
+            continue;
+        }
+        size_t offset = replacements.size();
+        if (rule.mMethod == DesensitizeMethod::CONST_OPTION) {
+            rule.mRegex->Rewrite(&replacements, rule.mRewrite, submatches.data(), groupNum);
+        } else {
+            // like xxxx, psw=123abc,xx, keep psw= and replace 123abc with its md5
+            size_t prefixEnd = submatches[1].data() - value.data() + submatches[1].size();
+            replacements.append(submatches[1].data(), submatches[1].size());
+            replacements.append(CalcMD5(std::string(value.data() + prefixEnd, end - prefixEnd)));
         }
-        if (rst) {
-            *value = destStr;
-            pVal = value;
+        spans.push_back({begin, end, ruleIdx, offset, replacements.size() - offset});
+        if (!mReplacingAll) {
+            break;
         }
+        pos = end;
     }
 }
 
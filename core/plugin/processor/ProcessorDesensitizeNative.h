@@ -16,7 +16,11 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "re2/re2.h"
+#include "re2/set.h"
 
 #include "collection_pipeline/plugin/interface/Processor.h"
 
@@ -47,14 +51,44 @@ public:
     // Whether to replace all matching sensitive content.
     bool mReplacingAll = true;
 
+    // A rule describes one kind of sensitive content. Either Rules or the params above are used to define rules.
+    struct DesensitizeRule {
+        DesensitizeMethod mMethod = DesensitizeMethod::CONST_OPTION;
+        // rewrite string for const method, with the prefix kept by \1
+        std::string mRewrite;
+        std::shared_ptr<re2::RE2> mRegex;
+    };
+    // List of rules, each with Method, ReplacingString, ContentPatternBeforeReplacedString and
+    // ReplacedContentPattern. Values are scanned once for all rules, and matches of different rules are found on the
+    // original value. If matches overlap, the one starting first is used, then the one with the smaller index.
+    std::vector<DesensitizeRule> mRules;
+
 protected:
     bool IsSupportedEvent(const PipelineEventPtr& e) const override;
 
 private:
+    struct MatchSpan {
+        size_t mBegin;
+        size_t mEnd;
+        size_t mRuleIdx;
+        // offset and size of the replacement in the replacement buffer
+        size_t mReplacementOffset;
+        size_t mReplacementSize;
+    };
+
+    bool ParseRule(const Json::Value& config, DesensitizeRule& rule, std::string& errorMsg);
     void ProcessEvent(PipelineEventPtr& e);
-    void CastOneSensitiveWord(std::string* value);
+    // CastSensitiveWords returns false if @value contains no sensitive content, otherwise the desensitized value is
+    // written to @result, allocated once from @sourceBuffer.
+    bool CastSensitiveWords(StringView value, SourceBuffer& sourceBuffer, StringView& result) const;
+    void FindRuleMatches(StringView value,
+                         size_t ruleIdx,
+                         std::vector<MatchSpan>& spans,
+                         std::string& replacements) const;
 
-    std::shared_ptr<re2::RE2> mRegex;
+    // mRuleSet finds the rules matched by a value in one pass, so that only these rules are searched for matches.
+    // It is null if there is only one rule or it can not be compiled within the memory limit.
+    std::unique_ptr<re2::RE2::Set> mRuleSet;
 
     CounterPtr mDiscardedEventsTotal;
     CounterPtr mOutFailedEventsTotal;
@@ -18,6 +18,7 @@
 
 #include "app_config/AppConfig.h"
 #include "collection_pipeline/plugin/instance/ProcessorInstance.h"
+#include "common/CharSetMatcher.h"
 #include "common/LogtailCommonFlags.h"
 #include "common/ParamExtractor.h"
 #include "common/TimeUtil.h"
@@ -199,28 +200,9 @@ bool ProcessorParseApsaraNative::ProcessEvent(const StringView& logPath,
     }
 
     sourceEvent.SetTimestamp(logTime, logTime_in_micro * 1000 % 1000000000);
-    int32_t beg_index = 0;
-    int32_t colon_index = -1;
-    int32_t index = -1;
-    index = ParseApsaraBaseFields(buffer, sourceEvent);
-    int32_t length = buffer.size();
-    if (index < length) {
-        for (index = index + 1; index <= length; ++index) {
-            if (index == length || buffer.data()[index] == '\t') {
-                if (colon_index >= 0) {
-                    StringView key(buffer.data() + beg_index, colon_index - beg_index);
-                    StringView data(buffer.data() + colon_index + 1, index - colon_index - 1);
-                    AddLog(key, data, sourceEvent);
-                    if (key == mSourceKey) {
-                        sourceKeyOverwritten = true;
-                    }
-                    colon_index = -1;
-                }
-                beg_index = index + 1;
-            } else if (buffer.data()[index] == ':' && colon_index == -1) {
-                colon_index = index;
-            }
-        }
+    int32_t index = ParseApsaraBaseFields(buffer, sourceEvent);
+    if (static_cast<size_t>(index) < buffer.size()) {
+        sourceKeyOverwritten = ParseApsaraFields(buffer, index + 1, sourceEvent);
     }
     // logTime_in_micro = (int64_t)logTime_in_micro - (int64_t)mLogTimeZoneOffsetSecond * (int64_t)1000000;
     StringBuffer sb = sourceEvent.GetSourceBuffer()->AllocateStringBuffer(20);
@@ -281,13 +263,17 @@ time_t ProcessorParseApsaraNative::ApsaraEasyReadLogTimeParser(StringView& buffe
             LOG_WARNING(sLogger, ("parse apsara log time", "fail")("string", buffer));
             return 0;
         }
-        // strTime is the content between '[' and ']' and ends with '\0'
-        std::string strTime = buffer.substr(1, pos).to_string();
+        // timeView is the content between '[' and ']' and ends with ']'
+        StringView timeView = buffer.substr(1, pos);
         int nanosecondLength = 0;
-        if (IsPrefixString(strTime, cachedTimeStr) == true) {
-            if (strTime.size() > cachedTimeStr.size()) {
-                auto strptimeResult
-                    = Strptime(strTime.c_str() + cachedTimeStr.size() + 1, "%f", &logTime, nanosecondLength);
+        if (IsPrefixString(timeView, cachedTimeStr) == true) {
+            if (timeView.size() > cachedTimeStr.size()) {
+                // 毫秒部分以']'结尾，可以直接在原始数据上解析，无需拷贝时间字符串
+                const char* strptimeResult = nullptr;
+                if (cachedTimeStr.size() + 1 < timeView.size()) {
+                    strptimeResult
+                        = Strptime(timeView.data() + cachedTimeStr.size() + 1, "%f", &logTime, nanosecondLength);
+                }
                 if (NULL == strptimeResult) {
                     LOG_WARNING(sLogger,
                                 ("parse apsara log time microsecond",
@@ -297,6 +283,8 @@ time_t ProcessorParseApsaraNative::ApsaraEasyReadLogTimeParser(StringView& buffe
             microTime = (int64_t)cachedLogTime.tv_sec * 1000000 + logTime.tv_nsec / 1000;
             return cachedLogTime.tv_sec;
         }
+        // strTime is the content between '[' and ']' and ends with '\0'
+        std::string strTime = timeView.to_string();
         // parse second part
         auto strptimeResult = Strptime(strTime.c_str(), "%Y-%m-%d %H:%M:%S", &logTime, nanosecondLength);
         if (NULL == strptimeResult) {
@@ -328,8 +316,8 @@ time_t ProcessorParseApsaraNative::ApsaraEasyReadLogTimeParser(StringView& buffe
  * @param prefix - 要检查的前缀。
  * @return 如果字符串以指定前缀开头，则返回true；否则返回false。
  */
-bool ProcessorParseApsaraNative::IsPrefixString(const std::string& all, const StringView& prefix) {
-    return !prefix.empty() && std::equal(prefix.begin(), prefix.end(), all.begin());
+bool ProcessorParseApsaraNative::IsPrefixString(const StringView& all, const StringView& prefix) {
+    return !prefix.empty() && all.size() >= prefix.size() && std::equal(prefix.begin(), prefix.end(), all.begin());
 }
 
 /*
@@ -462,6 +450,51 @@ int32_t ProcessorParseApsaraNative::ParseApsaraBaseFields(const StringView& buff
     return endIndexArray[baseFieldNum - 1]; // return ']' position
 }
 
+/*
+ * 解析Apsara日志基础字段之后以制表符分隔的key:value字段，并批量添加到日志事件中。
+ * @param buffer - 包含日志数据的字符串视图。
+ * @param beginIndex - 开始扫描的索引。
+ * @param sourceEvent - 引用到日志事件对象，用于添加解析出的字段。
+ * @return 如果有字段的key与mSourceKey相同，则返回true；否则返回false。
+ */
+bool ProcessorParseApsaraNative::ParseApsaraFields(const StringView& buffer,
+                                                   int32_t beginIndex,
+                                                   LogEvent& sourceEvent) {
+    static const CharSetMatcher sMatcher({'\t', ':'});
+    static thread_local std::vector<std::pair<StringView, StringView>> sFields;
+    sFields.clear();
+    const char* begin = buffer.data();
+    const char* end = buffer.data() + buffer.size();
+    const char* keyBegin = begin;
+    const char* colon = nullptr;
+    sMatcher.ForEach(begin + beginIndex, end, [&](const char* p) {
+        if (*p == '\t') {
+            if (colon != nullptr) {
+                sFields.emplace_back(StringView(keyBegin, colon - keyBegin), StringView(colon + 1, p - colon - 1));
+                colon = nullptr;
+            }
+            keyBegin = p + 1;
+        } else if (colon == nullptr) {
+            colon = p;
+        }
+        return true;
+    });
+    if (colon != nullptr) {
+        sFields.emplace_back(StringView(keyBegin, colon - keyBegin), StringView(colon + 1, end - colon - 1));
+    }
+
+    bool sourceKeyOverwritten = false;
+    // microtime and source content may be added later
+    sourceEvent.ReserveContents(sourceEvent.Size() + sFields.size() + 2);
+    for (const auto& field : sFields) {
+        sourceEvent.AppendContentNoCopy(field.first, field.second);
+        if (field.first == mSourceKey) {
+            sourceKeyOverwritten = true;
+        }
+    }
+    return sourceKeyOverwritten;
+}
+
 void ProcessorParseApsaraNative::AddLog(const StringView& key,
                                         const StringView& value,
                                         LogEvent& targetEvent,
@@ -16,6 +16,8 @@
 
 #include "plugin/processor/ProcessorParseDelimiterNative.h"
 
+#include <cstring>
+
 #include "collection_pipeline/plugin/instance/ProcessorInstance.h"
 #include "common/ParamExtractor.h"
 #include "models/LogEvent.h"
@@ -243,9 +245,13 @@ bool ProcessorParseDelimiterNative::ProcessEvent(const StringView& logPath,
 
     size_t reserveSize
         = mOverflowedFieldsTreatment == OverflowedFieldsTreatment::EXTEND ? (mKeys.size() + 10) : (mKeys.size() + 1);
-    std::vector<StringView> columnValues;
-    std::vector<size_t> colBegIdxs;
-    std::vector<size_t> colLens;
+    // column spans are only used within one event, reuse them to avoid allocation per event
+    static thread_local std::vector<StringView> columnValues;
+    static thread_local std::vector<size_t> colBegIdxs;
+    static thread_local std::vector<size_t> colLens;
+    columnValues.clear();
+    colBegIdxs.clear();
+    colLens.clear();
     bool parseSuccess = false;
     size_t parsedColCount = 0;
     bool useQuote = (mSeparator.size() == 1) && (mQuote != mSeparatorChar);
@@ -377,7 +383,7 @@ bool ProcessorParseDelimiterNative::SplitString(
     size_t pos = begIdx;
     size_t top = endIdx - d_size;
     while (pos <= top) {
-        const char* pch = std::search(buffer + pos, buffer + endIdx, mSeparator.begin(), mSeparator.end());
+        const char* pch = FindSeparator(buffer + pos, buffer + endIdx);
         size_t pos2;
         // if not found, pos2 = endIdx
         if (pch == buffer + endIdx) {
@@ -408,6 +414,26 @@ bool ProcessorParseDelimiterNative::SplitString(
     return true;
 }
 
+const char* ProcessorParseDelimiterNative::FindSeparator(const char* begin, const char* end) const {
+    size_t sepSize = mSeparator.size();
+    if (static_cast<size_t>(end - begin) < sepSize) {
+        return end;
+    }
+    // memchr is vectorized by libc, so the first char of the separator is located with it and the rest of the
+    // separator is compared only at the candidates
+    const char* last = end - sepSize;
+    for (const char* p = begin; p <= last; ++p) {
+        p = static_cast<const char*>(memchr(p, mSeparatorChar, last - p + 1));
+        if (p == nullptr) {
+            break;
+        }
+        if (memcmp(p + 1, mSeparator.data() + 1, sepSize - 1) == 0) {
+            return p;
+        }
+    }
+    return end;
+}
+
 void ProcessorParseDelimiterNative::AddLog(const StringView& key,
                                            const StringView& value,
                                            LogEvent& targetEvent,
@@ -68,6 +68,8 @@ private:
                      int32_t endIdx,
                      std::vector<size_t>& colBegIdxs,
                      std::vector<size_t>& colLens);
+    // FindSeparator returns the first occurrence of mSeparator in [@begin, @end), or @end if not found.
+    const char* FindSeparator(const char* begin, const char* end) const;
     void AddLog(const StringView& key, const StringView& value, LogEvent& targetEvent, bool overwritten = true);
 
     char mSeparatorChar;
@@ -16,10 +16,16 @@
 
 #include "plugin/processor/ProcessorParseRegexNative.h"
 
+#include <chrono>
+
 #include "app_config/AppConfig.h"
+#include "common/Flags.h"
 #include "common/ParamExtractor.h"
 #include "monitor/metric_constants/MetricConstants.h"
 
+DEFINE_FLAG_BOOL(enable_re2_regex_parser, "use RE2 for regex parsing if the regex is supported by RE2", true);
+DEFINE_FLAG_INT32(regex_parse_latency_update_interval_sec, "interval to update parse latency percentiles, seconds", 10);
+
 namespace logtail {
 
 const std::string ProcessorParseRegexNative::sName = "processor_parse_regex_native";
@@ -61,6 +67,9 @@ bool ProcessorParseRegexNative::Init(const Json::Value& config) {
     }
     mReg = boost::regex(mRegex);
     mIsWholeLineMode = mRegex == "(.*)";
+    if (!mIsWholeLineMode && BOOL_FLAG(enable_re2_regex_parser)) {
+        InitRE2();
+    }
 
     // Keys
     if (!GetMandatoryListParam(config, "Keys", mKeys, errorMsg)) {
@@ -96,10 +105,31 @@ bool ProcessorParseRegexNative::Init(const Json::Value& config) {
     mOutFailedEventsTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_OUT_FAILED_EVENTS_TOTAL);
     mOutKeyNotFoundEventsTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_OUT_KEY_NOT_FOUND_EVENTS_TOTAL);
     mOutSuccessfulEventsTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_OUT_SUCCESSFUL_EVENTS_TOTAL);
+    mParseLatencyP50Us = GetMetricsRecordRef().CreateIntGauge(METRIC_PLUGIN_PARSE_LATENCY_P50_US);
+    mParseLatencyP90Us = GetMetricsRecordRef().CreateIntGauge(METRIC_PLUGIN_PARSE_LATENCY_P90_US);
+    mParseLatencyP99Us = GetMetricsRecordRef().CreateIntGauge(METRIC_PLUGIN_PARSE_LATENCY_P99_US);
 
     return true;
 }
 
+void ProcessorParseRegexNative::InitRE2() {
+    re2::RE2::Options options;
+    // boost works on bytes, and its '.' matches '\n'
+    options.set_encoding(re2::RE2::Options::EncodingLatin1);
+    options.set_dot_nl(true);
+    options.set_log_errors(false);
+    // '^' and '$' match at line boundaries in boost by default
+    std::unique_ptr<re2::RE2> re2(new re2::RE2("(?m)" + mRegex, options));
+    // constructs not supported by RE2, e.g. backreferences and lookarounds, fail to compile and boost is used
+    if (!re2->ok() || static_cast<size_t>(re2->NumberOfCapturingGroups()) != mReg.mark_count()) {
+        LOG_INFO(mContext->GetLogger(),
+                 ("regex is not supported by RE2, use boost instead", mRegex)("error", re2->error())(
+                     "config", mContext->GetConfigName()));
+        return;
+    }
+    mRE2 = std::move(re2);
+}
+
 void ProcessorParseRegexNative::Process(PipelineEventGroup& logGroup) {
     if (logGroup.GetEvents().empty()) {
         return;
@@ -117,6 +147,7 @@ void ProcessorParseRegexNative::Process(PipelineEventGroup& logGroup) {
         }
     }
     events.resize(wIdx);
+    UpdateParseLatency();
     return;
 }
 
@@ -139,11 +170,13 @@ bool ProcessorParseRegexNative::ProcessEvent(const StringView& logPath,
     auto rawContent = sourceEvent.GetContent(mSourceKey);
     bool parseSuccess = true;
 
+    auto startTime = std::chrono::steady_clock::now();
     if (mIsWholeLineMode) {
         parseSuccess = WholeLineModeParser(sourceEvent, mKeys.empty() ? DEFAULT_CONTENT_KEY : mKeys[0]);
     } else {
         parseSuccess = RegexLogLineParser(sourceEvent, mReg, mKeys, logPath);
     }
+    mParseLatency.Add(std::chrono::steady_clock::now() - startTime);
 
     if (!parseSuccess || !mSourceKeyOverwritten) {
         sourceEvent.DelContent(mSourceKey);
@@ -182,11 +215,28 @@ bool ProcessorParseRegexNative::RegexLogLineParser(LogEvent& sourceEvent,
                                                    const boost::regex& reg,
                                                    const std::vector<std::string>& keys,
                                                    const StringView& logPath) {
-    boost::match_results<const char*> what;
+    // match states are reused to avoid allocation per event
+    static thread_local boost::match_results<const char*> what;
+    static thread_local std::vector<re2::StringPiece> submatches;
     std::string exception;
     StringView buffer = sourceEvent.GetContent(mSourceKey);
     bool parseSuccess = true;
-    if (!BoostRegexMatch(buffer.data(), buffer.size(), reg, exception, what, boost::match_default)) {
+    bool matched = false;
+    size_t groupNum = 0;
+    if (mRE2) {
+        groupNum = mRE2->NumberOfCapturingGroups() + 1;
+        submatches.resize(groupNum);
+        matched = mRE2->Match(re2::StringPiece(buffer.data(), buffer.size()),
+                              0,
+                              buffer.size(),
+                              re2::RE2::ANCHOR_BOTH,
+                              submatches.data(),
+                              groupNum);
+    } else {
+        matched = BoostRegexMatch(buffer.data(), buffer.size(), reg, exception, what, boost::match_default);
+        groupNum = what.size();
+    }
+    if (!matched) {
         if (!exception.empty()) {
             if (AppConfig::GetInstance()->IsLogParseAlarmValid()) {
                 if (GetContext().GetAlarm().IsLowLevelAlarmValid()) {
@@ -219,16 +269,16 @@ bool ProcessorParseRegexNative::RegexLogLineParser(LogEvent& sourceEvent,
         }
         ADD_COUNTER(mOutFailedEventsTotal, 1);
         parseSuccess = false;
-    } else if (what.size() <= keys.size()) {
+    } else if (groupNum <= keys.size()) {
         if (AppConfig::GetInstance()->IsLogParseAlarmValid()) {
             if (GetContext().GetAlarm().IsLowLevelAlarmValid()) {
                 LOG_WARNING(GetContext().GetLogger(),
                             ("parse key count not match",
-                             what.size())("parse regex log fail", buffer)("project", GetContext().GetProjectName())(
+                             groupNum)("parse regex log fail", buffer)("project", GetContext().GetProjectName())(
                                 "logstore", GetContext().GetLogstoreName())("file", logPath));
             }
             GetContext().GetAlarm().SendAlarm(REGEX_MATCH_ALARM,
-                                              "parse key count not match" + ToString(what.size())
+                                              "parse key count not match" + ToString(groupNum)
                                                   + "errorlog:" + buffer.to_string(),
                                               GetContext().GetRegion(),
                                               GetContext().GetProjectName(),
@@ -242,9 +292,29 @@ bool ProcessorParseRegexNative::RegexLogLineParser(LogEvent& sourceEvent,
     }
 
     for (uint32_t i = 0; i < keys.size(); i++) {
-        AddLog(keys[i], StringView(what[i + 1].begin(), what[i + 1].length()), sourceEvent);
+        if (mRE2) {
+            AddLog(keys[i], StringView(submatches[i + 1].data(), submatches[i + 1].size()), sourceEvent);
+        } else {
+            AddLog(keys[i], StringView(what[i + 1].begin(), what[i + 1].length()), sourceEvent);
+        }
     }
     return true;
 }
 
+void ProcessorParseRegexNative::UpdateParseLatency() {
+    time_t now = time(nullptr);
+    time_t last = mLastParseLatencyUpdateTime.load();
+    if (now - last < INT32_FLAG(regex_parse_latency_update_interval_sec)
+        || !mLastParseLatencyUpdateTime.compare_exchange_strong(last, now)) {
+        return;
+    }
+    static thread_local std::vector<uint64_t> percentiles;
+    if (!mParseLatency.Collect({50, 90, 99}, percentiles)) {
+        percentiles.assign(3, 0);
+    }
+    SET_GAUGE(mParseLatencyP50Us, percentiles[0]);
+    SET_GAUGE(mParseLatencyP90Us, percentiles[1]);
+    SET_GAUGE(mParseLatencyP99Us, percentiles[2]);
+}
+
 } // namespace logtail
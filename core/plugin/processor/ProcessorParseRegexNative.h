@@ -16,12 +16,17 @@
 
 #pragma once
 
+#include <atomic>
+#include <ctime>
+#include <memory>
 #include <vector>
 
 #include "boost/regex.hpp"
+#include "re2/re2.h"
 
 #include "collection_pipeline/plugin/interface/Processor.h"
 #include "models/LogEvent.h"
+#include "monitor/metric_models/LatencyHistogram.h"
 #include "plugin/processor/CommonParserOptions.h"
 
 namespace logtail {
@@ -54,15 +59,26 @@ private:
                             const std::vector<std::string>& keys,
                             const StringView& logPath);
     void AddLog(const StringView& key, const StringView& value, LogEvent& targetEvent, bool overwritten = true);
+    // InitRE2 compiles mRegex with RE2 if RE2 supports it with the same semantics as boost.
+    void InitRE2();
+    void UpdateParseLatency();
 
     bool mSourceKeyOverwritten = false;
     bool mIsWholeLineMode = false;
     boost::regex mReg;
+    // mRE2 is used instead of mReg if not null, RE2 runs in linear time and needs no allocation for matching
+    std::unique_ptr<re2::RE2> mRE2;
+
+    LatencyHistogram mParseLatency;
+    std::atomic<time_t> mLastParseLatencyUpdateTime{0};
 
     CounterPtr mDiscardedEventsTotal;
     CounterPtr mOutFailedEventsTotal;
     CounterPtr mOutKeyNotFoundEventsTotal;
     CounterPtr mOutSuccessfulEventsTotal;
+    IntGaugePtr mParseLatencyP50Us;
+    IntGaugePtr mParseLatencyP90Us;
+    IntGaugePtr mParseLatencyP99Us;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class ProcessorParseRegexNativeUnittest;
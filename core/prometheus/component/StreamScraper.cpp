@@ -1,5 +1,6 @@
 #include "prometheus/component/StreamScraper.h"
 
+#include <algorithm>
 #include <cstddef>
 
 #include <memory>
@@ -12,6 +13,7 @@
 #include "collection_pipeline/queue/ProcessQueueItem.h"
 #include "collection_pipeline/queue/ProcessQueueManager.h"
 #include "common/StringTools.h"
+#include "common/memory/MemoryBudget.h"
 #include "models/PipelineEventGroup.h"
 #include "prometheus/Utils.h"
 #include "runner/ProcessorRunner.h"
@@ -30,8 +32,12 @@ StreamScraper::StreamScraper(Labels labels,
                              size_t inputIndex,
                              std::string hash,
                              EventPool* eventPool,
-                             std::chrono::system_clock::time_point scrapeTime)
-    : mEventGroup(PipelineEventGroup(std::make_shared<SourceBuffer>())),
+                             std::chrono::system_clock::time_point scrapeTime,
+                             size_t lastScrapeSize)
+    : mFirstChunkSize(lastScrapeSize == 0 ? 4096
+                                          : std::min(lastScrapeSize, (size_t)INT64_FLAG(prom_stream_bytes_size))
+                              + mMaxSampleLength),
+      mEventGroup(NewSourceBuffer()),
       mHash(std::move(hash)),
       mEventPool(eventPool),
       mQueueKey(queueKey),
@@ -96,6 +102,10 @@ void StreamScraper::AddEvent(const char* line, size_t len) {
     }
 }
 
+std::shared_ptr<SourceBuffer> StreamScraper::NewSourceBuffer() const {
+    return std::make_shared<SourceBuffer>(mFirstChunkSize);
+}
+
 void StreamScraper::FlushCache() {
     if (!mCache.empty()) {
         AddEvent(mCache.data(), mCache.size());
@@ -114,13 +124,16 @@ void StreamScraper::PushEventGroup(PipelineEventGroup&& eGroup) const {
     return;
 #endif
     while (true) {
-        auto res = ProcessQueueManager::GetInstance()->PushQueue(mQueueKey, std::move(item));
-        if (res == QueueStatus::OK) {
-            break;
-        }
-        if (res == QueueStatus::QUEUE_NOT_EXIST) {
-            LOG_DEBUG(sLogger, ("prometheus stream scraper", "queue not exist"));
-            break;
+        // blocking here slows down reading of the response when memory budget is used up
+        if (MemoryBudget::GetInstance()->IsValidToPush(mQueueKey)) {
+            auto res = ProcessQueueManager::GetInstance()->PushQueue(mQueueKey, std::move(item));
+            if (res == QueueStatus::OK) {
+                break;
+            }
+            if (res == QueueStatus::QUEUE_NOT_EXIST) {
+                LOG_DEBUG(sLogger, ("prometheus stream scraper", "queue not exist"));
+                break;
+            }
         }
         usleep(10 * 1000);
     }
@@ -133,12 +146,12 @@ void StreamScraper::SendMetrics() {
 
     SetTargetLabels(mEventGroup);
     PushEventGroup(std::move(mEventGroup));
-    mEventGroup = PipelineEventGroup(std::make_shared<SourceBuffer>());
+    mEventGroup = PipelineEventGroup(NewSourceBuffer());
     mCurrStreamSize = 0;
 }
 
 void StreamScraper::Reset() {
-    mEventGroup = PipelineEventGroup(std::make_shared<SourceBuffer>());
+    mEventGroup = PipelineEventGroup(NewSourceBuffer());
     mRawSize = 0;
     mCurrStreamSize = 0;
     mCache.clear();
@@ -22,7 +22,8 @@ public:
                   size_t inputIndex,
                   std::string hash,
                   EventPool* eventPool,
-                  std::chrono::system_clock::time_point scrapeTime);
+                  std::chrono::system_clock::time_point scrapeTime,
+                  size_t lastScrapeSize = 0);
     static size_t MetricWriteCallback(char* buffer, size_t size, size_t nmemb, void* data);
     void FlushCache();
     void SendMetrics();
@@ -35,12 +36,16 @@ public:
 
 private:
     void AddEvent(const char* line, size_t len);
+    std::shared_ptr<SourceBuffer> NewSourceBuffer() const;
     void PushEventGroup(PipelineEventGroup&&) const;
     void SetTargetLabels(PipelineEventGroup& eGroup) const;
     std::string GetId();
 
     size_t mCurrStreamSize = 0;
     std::string mCache;
+    // event groups of a target are of similar sizes across scrapes, so the first chunk of source buffers is sized
+    // from the response size of the last scrape to save chunks allocated while the buffer grows
+    uint32_t mFirstChunkSize = 4096;
     PipelineEventGroup mEventGroup;
 
     std::string mHash;
@@ -16,6 +16,7 @@
 
 #include "prometheus/schedulers/ScrapeScheduler.h"
 
+#include <algorithm>
 #include <cstddef>
 
 #include <chrono>
@@ -195,8 +196,13 @@ std::unique_ptr<TimerEvent> ScrapeScheduler::BuildScrapeTimerEvent(std::chrono::
         mScrapeConfigPtr->mRequestHeaders,
         "",
         HttpResponse(
-            new prom::StreamScraper(
-                mTargetInfo.mLabels, mQueueKey, mInputIndex, mTargetInfo.mHash, mEventPool, mLatestScrapeTime),
+            new prom::StreamScraper(mTargetInfo.mLabels,
+                                    mQueueKey,
+                                    mInputIndex,
+                                    mTargetInfo.mHash,
+                                    mEventPool,
+                                    mLatestScrapeTime,
+                                    std::max(mScrapeResponseSizeBytes.load(), 0)),
             [](void* p) { delete static_cast<prom::StreamScraper*>(p); },
             prom::StreamScraper::MetricWriteCallback),
         mScrapeTimeoutSeconds,
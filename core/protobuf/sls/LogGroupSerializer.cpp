@@ -217,11 +217,17 @@ void LogGroupSerializer::AddLogContentMetricTimeNano(const MetricEvent& e) {
     // Value
     mRes.push_back(0x12);
     uint32_pack(valueSZ, mRes);
-    // TODO: avoid copy
-    mRes.append(to_string(e.GetTimestamp()));
+    // digits are written in place, the timestamp is ensured to have 10 digits by the caller
+    uint64_t value = e.GetTimestamp();
     if (e.GetTimestampNanosecond()) {
-        mRes.append(NumberToDigitString(e.GetTimestampNanosecond().value(), 9));
+        value = value * 1000000000 + e.GetTimestampNanosecond().value();
     }
+    char buffer[19];
+    for (size_t i = valueSZ; i > 0; --i) {
+        buffer[i - 1] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    mRes.append(buffer, valueSZ);
 }
 
 size_t GetLogContentSize(size_t keySZ, size_t valueSZ) {
@@ -25,7 +25,9 @@
 #include "common/http/HttpRequest.h"
 #include "logger/Logger.h"
 #include "monitor/AlarmManager.h"
+#include "plugin/flusher/file/FlusherFile.h"
 #include "plugin/flusher/sls/DiskBufferWriter.h"
+#include "runner/sink/file/FileSink.h"
 #include "runner/sink/http/HttpSink.h"
 
 DEFINE_FLAG_INT32(flusher_runner_exit_timeout_sec, "", 60);
@@ -147,6 +149,15 @@ void FlusherRunner::PushToHttpSink(SenderQueueItem* item, bool withLimit) {
     ++mHttpSendingCnt;
 }
 
+void FlusherRunner::PushToFileSink(SenderQueueItem* item) {
+    auto req = make_unique<FileSinkRequest>(item, static_cast<FlusherFile*>(item->mFlusher)->GetFileWriter());
+    req->mEnqueTime = item->mLastSendTime = chrono::system_clock::now();
+    LOG_TRACE(sLogger,
+              ("send item to file sink, item address", item)("config-flusher-dst",
+                                                             QueueKeyManager::GetInstance()->GetName(item->mQueueKey)));
+    FileSink::GetInstance()->AddRequest(std::move(req));
+}
+
 void FlusherRunner::Run() {
     LOG_INFO(sLogger, ("flusher runner", "started"));
     while (true) {
@@ -208,6 +219,9 @@ void FlusherRunner::Dispatch(SenderQueueItem* item) {
                 PushToHttpSink(item);
             }
             break;
+        case SinkType::FILE:
+            PushToFileSink(item);
+            break;
         default:
             SenderQueueManager::GetInstance()->RemoveItem(item->mQueueKey, item);
             break;
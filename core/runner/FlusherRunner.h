@@ -45,6 +45,7 @@ public:
 
     // TODO: should be private
     void PushToHttpSink(SenderQueueItem* item, bool withLimit = true);
+    void PushToFileSink(SenderQueueItem* item);
 
     int32_t GetSendingBufferCount() { return mHttpSendingCnt.load(); }
 
@@ -18,6 +18,8 @@
 #include "batch/TimeoutFlushManager.h"
 #include "collection_pipeline/CollectionPipelineManager.h"
 #include "common/Flags.h"
+#include "common/memory/MemoryBudget.h"
+#include "go_pipeline/FlatLogGroup.h"
 #include "go_pipeline/LogtailPlugin.h"
 #include "models/EventPool.h"
 #include "monitor/AlarmManager.h"
@@ -27,6 +29,12 @@
 
 DEFINE_FLAG_INT32(default_flush_merged_buffer_interval, "default flush merged buffer, seconds", 1);
 DEFINE_FLAG_INT32(processor_runner_exit_timeout_sec, "", 60);
+DEFINE_FLAG_INT32(processor_runner_batch_max_items,
+                  "max items drained from the same process queue per round, 1 means no batching",
+                  1);
+DEFINE_FLAG_INT32(processor_runner_batch_max_bytes,
+                  "stop draining the process queue once the items drained reach this size, bytes",
+                  512 * 1024);
 
 DECLARE_FLAG_INT32(max_send_log_group_size);
 
@@ -71,14 +79,18 @@ void ProcessorRunner::Stop() {
 bool ProcessorRunner::PushQueue(QueueKey key, size_t inputIndex, PipelineEventGroup&& group, uint32_t retryTimes) {
     unique_ptr<ProcessQueueItem> item = make_unique<ProcessQueueItem>(std::move(group), inputIndex);
     for (size_t i = 0; i < retryTimes; ++i) {
-        if (ProcessQueueManager::GetInstance()->PushQueue(key, std::move(item)) == QueueStatus::OK) {
+        // Data is held back by inputs that retry when memory budget is used up, so that the process is not oom
+        // killed. A one shot push, e.g. self monitor metrics and alarms, has nowhere else to keep its data, and is
+        // not dropped for the budget.
+        bool overBudget = retryTimes > 1 && !MemoryBudget::GetInstance()->IsValidToPush(key);
+        if (!overBudget && ProcessQueueManager::GetInstance()->PushQueue(key, std::move(item)) == QueueStatus::OK) {
             return true;
         }
         if (i % 100 == 0) {
             LOG_WARNING(sLogger,
                         ("push attempts to process queue continuously failed for the past second",
-                         "retry again")("config", QueueKeyManager::GetInstance()->GetName(key))("input index",
-                                                                                                ToString(inputIndex)));
+                         "retry again")("config", QueueKeyManager::GetInstance()->GetName(key))(
+                            "input index", ToString(inputIndex))("memory budget used up", ToString(overBudget)));
         }
         this_thread::sleep_for(chrono::milliseconds(10));
     }
@@ -102,6 +114,7 @@ void ProcessorRunner::Run(uint32_t threadNo) {
     sLastRunTime = sMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_LAST_RUN_TIME);
 
     static int32_t lastFlushBatchTime = 0;
+    vector<unique_ptr<ProcessQueueItem>> items;
     while (true) {
         int32_t curTime = time(nullptr);
         if (threadNo == 0 && curTime - lastFlushBatchTime >= INT32_FLAG(default_flush_merged_buffer_interval)) {
@@ -110,9 +123,13 @@ void ProcessorRunner::Run(uint32_t threadNo) {
         }
 
         SET_GAUGE(sLastRunTime, curTime);
-        unique_ptr<ProcessQueueItem> item;
         string configName;
-        if (!ProcessQueueManager::GetInstance()->PopItem(threadNo, item, configName)) {
+        items.clear();
+        if (!ProcessQueueManager::GetInstance()->PopItems(threadNo,
+                                                          max(INT32_FLAG(processor_runner_batch_max_items), 1),
+                                                          INT32_FLAG(processor_runner_batch_max_bytes),
+                                                          items,
+                                                          configName)) {
             if (mIsFlush && ProcessQueueManager::GetInstance()->IsAllQueueEmpty()) {
                 break;
             }
@@ -120,75 +137,108 @@ void ProcessorRunner::Run(uint32_t threadNo) {
             continue;
         }
 
-        ADD_COUNTER(sInEventsCnt, item->mEventGroup.GetEvents().size());
-        ADD_COUNTER(sInGroupsCnt, 1);
-        ADD_COUNTER(sInGroupDataSizeBytes, item->mEventGroup.DataSize());
+        for (const auto& item : items) {
+            ADD_COUNTER(sInEventsCnt, item->mEventGroup.GetEvents().size());
+            ADD_COUNTER(sInGroupsCnt, 1);
+            ADD_COUNTER(sInGroupDataSizeBytes, item->mEventGroup.DataSize());
+        }
+
+        ProcessItems(items, configName);
+        gThreadedEventPool.CheckGC();
+    }
+}
 
-        shared_ptr<CollectionPipeline>& pipeline = item->mPipeline;
-        bool hasOldPipeline = pipeline != nullptr;
-        if (!hasOldPipeline) {
-            pipeline = CollectionPipelineManager::GetInstance()->FindConfigByName(configName);
+void ProcessorRunner::ProcessItems(vector<unique_ptr<ProcessQueueItem>>& items, const string& configName) {
+    // all items come from the same queue, consecutive ones bound to the same pipeline and input go through the
+    // processors and Send together
+    for (size_t begin = 0, end = 1; begin < items.size(); begin = end++) {
+        while (end < items.size() && items[end]->mPipeline == items[begin]->mPipeline
+               && items[end]->mInputIndex == items[begin]->mInputIndex) {
+            ++end;
         }
+        ProcessBatch(items, begin, end, configName);
+    }
+}
+
+void ProcessorRunner::ProcessBatch(vector<unique_ptr<ProcessQueueItem>>& items,
+                                   size_t begin,
+                                   size_t end,
+                                   const string& configName) {
+    shared_ptr<CollectionPipeline> pipeline = items[begin]->mPipeline;
+    bool hasOldPipeline = pipeline != nullptr;
+    if (!hasOldPipeline) {
+        pipeline = CollectionPipelineManager::GetInstance()->FindConfigByName(configName);
+    }
+    if (!pipeline) {
+        LOG_INFO(sLogger,
+                 ("pipeline not found during processing, perhaps due to config deletion",
+                  "discard data")("config", configName));
+        return;
+    }
+
+    vector<PipelineEventGroup> eventGroupList;
+    eventGroupList.reserve(end - begin);
+    for (size_t i = begin; i < end; ++i) {
+        eventGroupList.emplace_back(std::move(items[i]->mEventGroup));
+    }
+    pipeline->Process(eventGroupList, items[begin]->mInputIndex);
+    // if the pipeline is updated, the pointer will be released, so we need to update it to the new pipeline
+    if (hasOldPipeline) {
+        pipeline = CollectionPipelineManager::GetInstance()->FindConfigByName(configName); // update to new pipeline
         if (!pipeline) {
             LOG_INFO(sLogger,
                      ("pipeline not found during processing, perhaps due to config deletion",
                       "discard data")("config", configName));
-            continue;
+            return;
         }
+    }
 
-        bool isLog = !item->mEventGroup.GetEvents().empty() && item->mEventGroup.GetEvents()[0].Is<LogEvent>();
-
-        vector<PipelineEventGroup> eventGroupList;
-        eventGroupList.emplace_back(std::move(item->mEventGroup));
-        pipeline->Process(eventGroupList, item->mInputIndex);
-        // if the pipeline is updated, the pointer will be released, so we need to update it to the new pipeline
-        if (hasOldPipeline) {
-            pipeline = CollectionPipelineManager::GetInstance()->FindConfigByName(configName); // update to new pipeline
-            if (!pipeline) {
-                LOG_INFO(sLogger,
-                         ("pipeline not found during processing, perhaps due to config deletion",
-                          "discard data")("config", configName));
+    if (pipeline->IsFlushingThroughGoPipeline()) {
+        // TODO:
+        // 1. allow all event types to be sent to Go pipelines
+        // 2. use event group protobuf instead
+        // the flat layout skips building and parsing a protobuf message on both sides of cgo
+        bool flat = LogtailPlugin::GetInstance()->IsFlatLogGroupSupported();
+        bool enableNanosecond = pipeline->GetContext().GetGlobalConfig().mEnableTimestampNanosecond;
+        const string& logstore = pipeline->GetContext().GetLogstoreName();
+        string res, errorMsg;
+        for (auto& group : eventGroupList) {
+            // groups in one batch come from different items, so each is checked on its own
+            if (group.GetEvents().empty() || !group.GetEvents()[0].Is<LogEvent>()) {
                 continue;
             }
-        }
-
-        if (pipeline->IsFlushingThroughGoPipeline()) {
-            // TODO:
-            // 1. allow all event types to be sent to Go pipelines
-            // 2. use event group protobuf instead
-            if (isLog) {
-                for (auto& group : eventGroupList) {
-                    string res, errorMsg;
-                    if (!Serialize(group,
-                                   pipeline->GetContext().GetGlobalConfig().mEnableTimestampNanosecond,
-                                   pipeline->GetContext().GetLogstoreName(),
-                                   res,
-                                   errorMsg)) {
-                        LOG_WARNING(pipeline->GetContext().GetLogger(),
-                                    ("failed to serialize event group",
-                                     errorMsg)("action", "discard data")("config", configName));
-                        pipeline->GetContext().GetAlarm().SendAlarm(SERIALIZE_FAIL_ALARM,
-                                                                    "failed to serialize event group: " + errorMsg
-                                                                        + "\taction: discard data\tconfig: "
-                                                                        + configName,
-                                                                    pipeline->GetContext().GetRegion(),
-                                                                    pipeline->GetContext().GetProjectName(),
-                                                                    configName,
-                                                                    pipeline->GetContext().GetLogstoreName());
-                        continue;
-                    }
-                    LogtailPlugin::GetInstance()->ProcessLogGroup(
-                        pipeline->GetContext().GetConfigName(),
-                        res,
-                        group.GetMetadata(EventGroupMetaKey::SOURCE_ID).to_string());
-                }
+            if (!(flat ? SerializeFlatLogGroup(group, enableNanosecond, logstore, res, errorMsg)
+                       : Serialize(group, enableNanosecond, logstore, res, errorMsg))) {
+                LOG_WARNING(pipeline->GetContext().GetLogger(),
+                            ("failed to serialize event group",
+                             errorMsg)("action", "discard data")("config", configName));
+                pipeline->GetContext().GetAlarm().SendAlarm(SERIALIZE_FAIL_ALARM,
+                                                            "failed to serialize event group: " + errorMsg
+                                                                + "\taction: discard data\tconfig: " + configName,
+                                                            pipeline->GetContext().GetRegion(),
+                                                            pipeline->GetContext().GetProjectName(),
+                                                            configName,
+                                                            pipeline->GetContext().GetLogstoreName());
+                continue;
+            }
+            if (flat) {
+                LogtailPlugin::GetInstance()->ProcessFlatLogGroup(
+                    pipeline->GetContext().GetConfigName(),
+                    res,
+                    group.GetMetadata(EventGroupMetaKey::SOURCE_ID).to_string());
+            } else {
+                LogtailPlugin::GetInstance()->ProcessLogGroup(
+                    pipeline->GetContext().GetConfigName(),
+                    res,
+                    group.GetMetadata(EventGroupMetaKey::SOURCE_ID).to_string());
             }
-        } else {
-            pipeline->Send(std::move(eventGroupList));
         }
+    } else {
+        pipeline->Send(std::move(eventGroupList));
+    }
+    // each item popped holds one in process count
+    for (size_t i = begin; i < end; ++i) {
         pipeline->SubInProcessCnt();
-
-        gThreadedEventPool.CheckGC();
     }
 }
 
@@ -20,9 +20,11 @@
 
 #include <atomic>
 #include <future>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "collection_pipeline/queue/ProcessQueueItem.h"
 #include "collection_pipeline/queue/QueueKey.h"
 #include "models/PipelineEventGroup.h"
 #include "monitor/MetricManager.h"
@@ -50,6 +52,12 @@ private:
     ~ProcessorRunner() = default;
 
     void Run(uint32_t threadNo);
+    void ProcessItems(std::vector<std::unique_ptr<ProcessQueueItem>>& items, const std::string& configName);
+    // runs items [begin, end), which share the same pipeline and input, through the processors and Send at once
+    void ProcessBatch(std::vector<std::unique_ptr<ProcessQueueItem>>& items,
+                      size_t begin,
+                      size_t end,
+                      const std::string& configName);
 
     bool Serialize(const PipelineEventGroup& group,
                    bool enableNanosecond,
@@ -68,6 +76,11 @@ private:
     thread_local static CounterPtr sInEventsCnt;
     thread_local static CounterPtr sInGroupDataSizeBytes;
     thread_local static IntGaugePtr sLastRunTime;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class ProcessorRunnerBenchmark;
+    friend class BatcherUnittest;
+#endif
 };
 
 } // namespace logtail
@@ -0,0 +1,123 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "runner/sink/file/FileSink.h"
+
+#include "collection_pipeline/queue/QueueKeyManager.h"
+#include "collection_pipeline/queue/SenderQueueManager.h"
+#include "common/Flags.h"
+#include "common/StringTools.h"
+#include "logger/Logger.h"
+#include "monitor/metric_constants/MetricConstants.h"
+
+DEFINE_FLAG_INT32(file_sink_flush_interval_ms, "max interval for buffered data of file sink to be flushed", 1000);
+DEFINE_FLAG_INT32(file_sink_exit_timeout_sec, "", 5);
+
+DECLARE_FLAG_INT32(discard_send_fail_interval);
+
+using namespace std;
+
+namespace logtail {
+
+bool FileSink::Init() {
+    WriteMetrics::GetInstance()->PrepareMetricsRecordRef(
+        mMetricsRecordRef,
+        MetricCategory::METRIC_CATEGORY_RUNNER,
+        {{METRIC_LABEL_KEY_RUNNER_NAME, METRIC_LABEL_VALUE_RUNNER_NAME_FILE_SINK}});
+    mInItemsTotal = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_IN_ITEMS_TOTAL);
+    mLastRunTime = mMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_LAST_RUN_TIME);
+    mOutSuccessfulItemsTotal = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_SINK_OUT_SUCCESSFUL_ITEMS_TOTAL);
+    mOutFailedItemsTotal = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_SINK_OUT_FAILED_ITEMS_TOTAL);
+
+    mIsFlush = false;
+    mThreadRes = async(launch::async, &FileSink::Run, this);
+    return true;
+}
+
+void FileSink::Stop() {
+    mIsFlush = true;
+    if (!mThreadRes.valid()) {
+        return;
+    }
+    future_status s = mThreadRes.wait_for(chrono::seconds(INT32_FLAG(file_sink_exit_timeout_sec)));
+    if (s == future_status::ready) {
+        LOG_INFO(sLogger, ("file sink", "stopped successfully"));
+    } else {
+        LOG_WARNING(sLogger, ("file sink", "forced to stopped"));
+    }
+}
+
+void FileSink::Run() {
+    LOG_INFO(sLogger, ("file sink", "started"));
+    auto lastFlushTime = chrono::steady_clock::now();
+    while (true) {
+        SET_GAUGE(mLastRunTime,
+                  chrono::duration_cast<chrono::seconds>(chrono::system_clock::now().time_since_epoch()).count());
+        unique_ptr<FileSinkRequest> request;
+        if (mQueue.WaitAndPop(request, 100)) {
+            ADD_COUNTER(mInItemsTotal, 1);
+            Write(std::move(request));
+            if (chrono::steady_clock::now() - lastFlushTime
+                < chrono::milliseconds(INT32_FLAG(file_sink_flush_interval_ms))) {
+                continue;
+            }
+        } else if (mIsFlush && mQueue.Empty()) {
+            break;
+        }
+        FlushWriters();
+        lastFlushTime = chrono::steady_clock::now();
+    }
+    FlushWriters();
+}
+
+void FileSink::Write(unique_ptr<FileSinkRequest>&& request) {
+    auto item = request->mItem;
+    LOG_TRACE(sLogger,
+              ("got item from flusher runner, item address", item)(
+                  "config-flusher-dst", QueueKeyManager::GetInstance()->GetName(item->mQueueKey))(
+                  "wait time",
+                  ToString(
+                      chrono::duration_cast<chrono::milliseconds>(chrono::system_clock::now() - request->mEnqueTime)
+                          .count())));
+    if (request->mWriter->Write(item->mData)) {
+        ADD_COUNTER(mOutSuccessfulItemsTotal, 1);
+        mDirtyWriters.insert(std::move(request->mWriter));
+        SenderQueueManager::GetInstance()->RemoveItem(item->mQueueKey, item);
+        return;
+    }
+    ADD_COUNTER(mOutFailedItemsTotal, 1);
+    if (chrono::duration_cast<chrono::seconds>(chrono::system_clock::now() - item->mFirstEnqueTime).count()
+        < INT32_FLAG(discard_send_fail_interval)) {
+        item->mStatus = SendingStatus::IDLE;
+        ++item->mTryCnt;
+        LOG_TRACE(sLogger,
+                  ("failed to write file", "retry later")("item address", item)(
+                      "config-flusher-dst", QueueKeyManager::GetInstance()->GetName(item->mQueueKey)));
+    } else {
+        LOG_WARNING(sLogger,
+                    ("failed to write file", "discard item")("file", request->mWriter->GetFilePath())(
+                        "config-flusher-dst", QueueKeyManager::GetInstance()->GetName(item->mQueueKey)));
+        SenderQueueManager::GetInstance()->RemoveItem(item->mQueueKey, item);
+    }
+}
+
+void FileSink::FlushWriters() {
+    for (auto& writer : mDirtyWriters) {
+        writer->Flush();
+    }
+    // writers of removed flushers are released here
+    mDirtyWriters.clear();
+}
+
+} // namespace logtail
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <set>
+
+#include "monitor/MetricManager.h"
+#include "runner/sink/Sink.h"
+#include "runner/sink/file/FileSinkRequest.h"
+
+namespace logtail {
+
+// FileSink writes items of file flushers on its own thread. Items are appended to the buffers of their writers, and
+// the buffers are flushed to disk only when the sink is idle or once every file_sink_flush_interval_ms, so that
+// writing an item costs no syscall on the hot path.
+class FileSink : public Sink<FileSinkRequest> {
+public:
+    FileSink(const FileSink&) = delete;
+    FileSink& operator=(const FileSink&) = delete;
+
+    static FileSink* GetInstance() {
+        static FileSink instance;
+        return &instance;
+    }
+
+    bool Init() override;
+    void Stop() override;
+
+private:
+    FileSink() = default;
+    ~FileSink() = default;
+
+    void Run();
+    void Write(std::unique_ptr<FileSinkRequest>&& request);
+    void FlushWriters();
+
+    std::future<void> mThreadRes;
+    std::atomic_bool mIsFlush = false;
+
+    // writers with data in buffer
+    std::set<std::shared_ptr<RotatingFileWriter>> mDirtyWriters;
+
+    mutable MetricsRecordRef mMetricsRecordRef;
+    CounterPtr mInItemsTotal;
+    CounterPtr mOutSuccessfulItemsTotal;
+    CounterPtr mOutFailedItemsTotal;
+    IntGaugePtr mLastRunTime;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class FlusherFileUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -0,0 +1,37 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+
+#include "collection_pipeline/queue/SenderQueueItem.h"
+#include "runner/sink/file/RotatingFileWriter.h"
+
+namespace logtail {
+
+struct FileSinkRequest {
+    SenderQueueItem* mItem = nullptr;
+    // shared with the flusher, so that the writer outlives the flusher until its buffered data is flushed
+    std::shared_ptr<RotatingFileWriter> mWriter;
+    std::chrono::system_clock::time_point mEnqueTime;
+
+    FileSinkRequest(SenderQueueItem* item, const std::shared_ptr<RotatingFileWriter>& writer)
+        : mItem(item), mWriter(writer) {}
+};
+
+} // namespace logtail
@@ -0,0 +1,139 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "runner/sink/file/RotatingFileWriter.h"
+
+#include "common/ErrorUtil.h"
+#include "common/FileSystemUtil.h"
+#include "logger/Logger.h"
+
+using namespace std;
+
+namespace logtail {
+
+RotatingFileWriter::RotatingFileWriter(
+    const string& filePath, uint64_t maxFileSize, uint32_t maxFiles, uint32_t rotateIntervalSec, size_t bufferSize)
+    : mFilePath(filePath),
+      mMaxFileSize(maxFileSize),
+      mMaxFiles(maxFiles),
+      mRotateIntervalSec(rotateIntervalSec),
+      mBufferSize(bufferSize) {
+    mBuffer.reserve(mBufferSize);
+}
+
+RotatingFileWriter::~RotatingFileWriter() {
+    Flush();
+    if (mFile != nullptr) {
+        fclose(mFile);
+    }
+}
+
+bool RotatingFileWriter::Write(const string& data) {
+    if (mFile == nullptr && !Open()) {
+        return false;
+    }
+    uint64_t fileSize = mFileSize + mBuffer.size();
+    if (fileSize > 0
+        && ((mMaxFileSize > 0 && fileSize + data.size() > mMaxFileSize)
+            || (mRotateIntervalSec > 0 && time(nullptr) - mOpenTime >= mRotateIntervalSec))) {
+        if (!Rotate()) {
+            return false;
+        }
+    }
+    if (mBuffer.size() + data.size() > mBufferSize && !Flush()) {
+        return false;
+    }
+    if (data.size() >= mBufferSize) {
+        return WriteToFile(data.data(), data.size());
+    }
+    mBuffer.append(data);
+    return true;
+}
+
+bool RotatingFileWriter::Flush() {
+    if (mBuffer.empty()) {
+        return true;
+    }
+    // data in buffer is dropped on failure, since the items it comes from have already been removed from queue
+    bool res = WriteToFile(mBuffer.data(), mBuffer.size());
+    mBuffer.clear();
+    return res;
+}
+
+bool RotatingFileWriter::Open() {
+    const string dir = ParentPath(mFilePath);
+    if (!dir.empty() && !Mkdirs(dir)) {
+        LOG_ERROR(sLogger, ("failed to create dir for file", mFilePath)("error", ErrnoToString(GetErrno())));
+        return false;
+    }
+    mFile = fopen(mFilePath.c_str(), "ab");
+    if (mFile == nullptr) {
+        LOG_ERROR(sLogger, ("failed to open file", mFilePath)("error", ErrnoToString(GetErrno())));
+        return false;
+    }
+    // data is already buffered by us
+    setvbuf(mFile, nullptr, _IONBF, 0);
+    fseek(mFile, 0, SEEK_END);
+    long size = ftell(mFile);
+    mFileSize = size > 0 ? static_cast<uint64_t>(size) : 0;
+    mOpenTime = time(nullptr);
+    return true;
+}
+
+bool RotatingFileWriter::Rotate() {
+    Flush();
+    fclose(mFile);
+    mFile = nullptr;
+    mFileSize = 0;
+    if (mMaxFiles == 0) {
+        remove(mFilePath.c_str());
+    }
+    for (uint32_t i = mMaxFiles; i > 0; --i) {
+        const string src = i == 1 ? mFilePath : GetRotatedFilePath(i - 1);
+        if (!CheckExistance(src)) {
+            continue;
+        }
+        const string dst = GetRotatedFilePath(i);
+        remove(dst.c_str());
+        if (rename(src.c_str(), dst.c_str()) != 0) {
+            LOG_WARNING(sLogger,
+                        ("failed to rename file during rotation", src)("target", dst)("error",
+                                                                                       ErrnoToString(GetErrno())));
+        }
+    }
+    return Open();
+}
+
+bool RotatingFileWriter::WriteToFile(const char* data, size_t size) {
+    if (fwrite(data, 1, size, mFile) != size) {
+        LOG_ERROR(sLogger,
+                  ("failed to write file", mFilePath)("size", size)("error", ErrnoToString(GetErrno())));
+        return false;
+    }
+    mFileSize += size;
+    return true;
+}
+
+string RotatingFileWriter::GetRotatedFilePath(uint32_t index) const {
+    // same as spdlog, a.log -> a.1.log, a -> a.1, .a -> .a.1
+    auto extPos = mFilePath.rfind('.');
+    auto sepPos = mFilePath.find_last_of("/\\");
+    if (extPos == string::npos || extPos == 0 || extPos == mFilePath.size() - 1
+        || (sepPos != string::npos && extPos <= sepPos + 1)) {
+        return mFilePath + "." + to_string(index);
+    }
+    return mFilePath.substr(0, extPos) + "." + to_string(index) + mFilePath.substr(extPos);
+}
+
+} // namespace logtail
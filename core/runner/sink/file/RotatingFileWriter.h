@@ -0,0 +1,73 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+
+#include <string>
+
+namespace logtail {
+
+// RotatingFileWriter appends data to a file through a user space buffer, so that many small items are written to
+// disk with one syscall. The file is rotated the same way as spdlog's rotating file sink, i.e., a.log is renamed to
+// a.1.log, a.1.log to a.2.log, and so on, with at most maxFiles rotated files kept. An item is never split across two
+// files: rotation happens before an item that would make the file exceed maxFileSize, or when the file has been
+// written for more than rotateIntervalSec seconds.
+//
+// It is not thread safe, and is only expected to be used by FileSink.
+class RotatingFileWriter {
+public:
+    RotatingFileWriter(const std::string& filePath,
+                       uint64_t maxFileSize,
+                       uint32_t maxFiles,
+                       uint32_t rotateIntervalSec = 0,
+                       size_t bufferSize = 1024 * 1024);
+    ~RotatingFileWriter();
+    RotatingFileWriter(const RotatingFileWriter&) = delete;
+    RotatingFileWriter& operator=(const RotatingFileWriter&) = delete;
+
+    bool Write(const std::string& data);
+    bool Flush();
+
+    const std::string& GetFilePath() const { return mFilePath; }
+
+private:
+    bool Open();
+    bool Rotate();
+    bool WriteToFile(const char* data, size_t size);
+    std::string GetRotatedFilePath(uint32_t index) const;
+
+    const std::string mFilePath;
+    const uint64_t mMaxFileSize;
+    const uint32_t mMaxFiles;
+    const uint32_t mRotateIntervalSec;
+    const size_t mBufferSize;
+
+    FILE* mFile = nullptr;
+    // size of the current file, data in buffer is not included until it is written successfully
+    uint64_t mFileSize = 0;
+    time_t mOpenTime = 0;
+    std::string mBuffer;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class FlusherFileUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <thread>
+
 #include "collection_pipeline/batch/Batcher.h"
 #include "common/JsonUtil.h"
 #include "unittest/Unittest.h"
@@ -35,6 +37,7 @@ public:
     void TestFlushAllWithoutGroupBatch();
     void TestFlushAllWithGroupBatch();
     void TestMetric();
+    void TestAddFromMultipleThreads();
 
 protected:
     static void SetUpTestCase() { sFlusher = make_unique<FlusherMock>(); }
@@ -157,8 +160,8 @@ void BatcherUnittest::TestAddWithoutGroupBatch() {
     SourceBuffer* buffer1 = group1.GetSourceBuffer().get();
     RangeCheckpoint* eoo1 = group1.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group1), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(2U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap.size());
+    APSARA_TEST_EQUAL(2U, batch.mShards[0].mEventQueueMap[key].mBatch.mEvents.size());
     APSARA_TEST_EQUAL(0U, res.size());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords.size());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].size());
@@ -174,8 +177,8 @@ void BatcherUnittest::TestAddWithoutGroupBatch() {
     SourceBuffer* buffer2 = group2.GetSourceBuffer().get();
     RangeCheckpoint* eoo2 = group2.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group2), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap[key].mBatch.mEvents.size());
     APSARA_TEST_EQUAL(1U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(3U, res[0][0].mEvents.size());
@@ -197,8 +200,8 @@ void BatcherUnittest::TestAddWithoutGroupBatch() {
     SourceBuffer* buffer3 = group3.GetSourceBuffer().get();
     RangeCheckpoint* eoo3 = group3.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group3), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(0U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap.size());
+    APSARA_TEST_EQUAL(0U, batch.mShards[0].mEventQueueMap[key].mBatch.mEvents.size());
     APSARA_TEST_EQUAL(2U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(1U, res[0][0].mEvents.size());
@@ -238,8 +241,8 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     SourceBuffer* buffer1 = group1.GetSourceBuffer().get();
     RangeCheckpoint* eoo1 = group1.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group1), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(2U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap.size());
+    APSARA_TEST_EQUAL(2U, batch.mShards[0].mEventQueueMap[key].mBatch.mEvents.size());
     APSARA_TEST_EQUAL(0U, res.size());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords.size());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].size());
@@ -255,8 +258,8 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     SourceBuffer* buffer2 = group2.GetSourceBuffer().get();
     RangeCheckpoint* eoo2 = group2.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group2), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap[key].mBatch.mEvents.size());
     APSARA_TEST_EQUAL(1U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(3U, res[0][0].mEvents.size());
@@ -278,8 +281,8 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     RangeCheckpoint* eoo3 = group3.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group3), res);
     APSARA_TEST_EQUAL(0U, res.size());
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap[key].mBatch.mEvents.size());
 
     // flush by time to group batch, and then group flush by time
     batch.mGroupFlushStrategy->SetTimeoutSecs(0);
@@ -287,8 +290,8 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     SourceBuffer* buffer4 = group4.GetSourceBuffer().get();
     RangeCheckpoint* eoo4 = group4.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group4), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap[key].mBatch.mEvents.size());
     APSARA_TEST_EQUAL(1U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(1U, res[0][0].mEvents.size());
@@ -309,8 +312,8 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     SourceBuffer* buffer5 = group5.GetSourceBuffer().get();
     RangeCheckpoint* eoo5 = group5.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group5), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap[key].mBatch.mEvents.size());
     APSARA_TEST_EQUAL(1U, res.size());
     APSARA_TEST_EQUAL(2U, res[0].size());
     APSARA_TEST_EQUAL(1U, res[0][0].mEvents.size());
@@ -342,8 +345,8 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     PipelineEventGroup group7 = CreateEventGroup(2);
     SourceBuffer* buffer7 = group7.GetSourceBuffer().get();
     batch.Add(std::move(group7), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap[key].mBatch.mEvents.size());
     APSARA_TEST_EQUAL(1U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(3U, res[0][0].mEvents.size());
@@ -376,8 +379,8 @@ void BatcherUnittest::TestAddWithOversizedGroup() {
 
     PipelineEventGroup group2 = CreateEventGroup(20);
     batch.Add(std::move(group2), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(0U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap.size());
+    APSARA_TEST_EQUAL(0U, batch.mShards[0].mEventQueueMap[key].mBatch.mEvents.size());
     APSARA_TEST_EQUAL(3U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(2U, res[0][0].mEvents.size());
@@ -410,7 +413,7 @@ void BatcherUnittest::TestFlushEventQueueWithoutGroupBatch() {
 
     // key existed
     batch.FlushQueue(key, res);
-    APSARA_TEST_EQUAL(0U, batch.mEventQueueMap.size());
+    APSARA_TEST_EQUAL(0U, batch.mShards[0].mEventQueueMap.size());
     APSARA_TEST_EQUAL(1U, res.size());
     APSARA_TEST_EQUAL(2U, res[0].mEvents.size());
     APSARA_TEST_EQUAL(1U, res[0].mTags.mInner.size());
@@ -439,7 +442,7 @@ void BatcherUnittest::TestFlushEventQueueWithGroupBatch() {
     RangeCheckpoint* eoo1 = group1.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group1), tmp);
     batch.FlushQueue(key, res);
-    APSARA_TEST_EQUAL(0U, batch.mEventQueueMap.size());
+    APSARA_TEST_EQUAL(0U, batch.mShards[0].mEventQueueMap.size());
     APSARA_TEST_EQUAL(0U, res.size());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords.size());
     APSARA_TEST_EQUAL(2U, TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].size());
@@ -459,7 +462,7 @@ void BatcherUnittest::TestFlushEventQueueWithGroupBatch() {
     RangeCheckpoint* eoo2 = group2.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group2), tmp);
     batch.FlushQueue(key, res);
-    APSARA_TEST_EQUAL(0U, batch.mEventQueueMap.size());
+    APSARA_TEST_EQUAL(0U, batch.mShards[0].mEventQueueMap.size());
     APSARA_TEST_EQUAL(2U, res.size());
     APSARA_TEST_EQUAL(2U, res[0].mEvents.size());
     APSARA_TEST_EQUAL(1U, res[0].mTags.mInner.size());
@@ -533,7 +536,7 @@ void BatcherUnittest::TestFlushAllWithoutGroupBatch() {
 
     vector<BatchedEventsList> res;
     batch.FlushAll(res);
-    APSARA_TEST_EQUAL(0U, batch.mEventQueueMap.size());
+    APSARA_TEST_EQUAL(0U, batch.mShards[0].mEventQueueMap.size());
     APSARA_TEST_EQUAL(1U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(2U, res[0][0].mEvents.size());
@@ -578,7 +581,7 @@ void BatcherUnittest::TestFlushAllWithGroupBatch() {
     batch.mGroupFlushStrategy->SetMinSizeBytes(10);
     vector<BatchedEventsList> res;
     batch.FlushAll(res);
-    APSARA_TEST_EQUAL(0U, batch.mEventQueueMap.size());
+    APSARA_TEST_EQUAL(0U, batch.mShards[0].mEventQueueMap.size());
     APSARA_TEST_EQUAL(2U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(2U, res[0][0].mEvents.size());
@@ -656,6 +659,81 @@ void BatcherUnittest::TestMetric() {
     }
 }
 
+void BatcherUnittest::TestAddFromMultipleThreads() {
+    DefaultFlushStrategyOptions strategy;
+    strategy.mMinCnt = 3;
+    strategy.mMinSizeBytes = 1000;
+    strategy.mTimeoutSecs = 3;
+
+    Batcher<> batch;
+    batch.Init(Json::Value(), sFlusher.get(), strategy, false, 3);
+    APSARA_TEST_EQUAL(3U, batch.mShards.size());
+
+    // each processor thread batches into its own shard, even with the same tags
+    size_t key = CreateEventGroup(1).GetTagsHash();
+    vector<BatchedEventsList> res[3];
+    vector<thread> threads;
+    for (uint32_t threadNo = 0; threadNo < 3; ++threadNo) {
+        threads.emplace_back(
+            [&, threadNo]() { batch.Add(CreateEventGroup(threadNo + 1), res[threadNo], threadNo); });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    for (uint32_t threadNo = 0; threadNo < 3; ++threadNo) {
+        APSARA_TEST_EQUAL(1U, batch.mShards[threadNo].mEventQueueMap.size());
+        APSARA_TEST_EQUAL(threadNo == 2 ? 0U : threadNo + 1,
+                          batch.mShards[threadNo].mEventQueueMap[key].mBatch.mEvents.size());
+    }
+    // reaching min cnt is flushed by the thread itself
+    APSARA_TEST_TRUE(res[0].empty());
+    APSARA_TEST_TRUE(res[1].empty());
+    APSARA_TEST_EQUAL(1U, res[2].size());
+    APSARA_TEST_EQUAL(3U, res[2][0][0].mEvents.size());
+
+    // another batch in the same shard
+    PipelineEventGroup other = CreateEventGroup(1);
+    other.SetTag(string("key"), string("other"));
+    size_t otherKey = other.GetTagsHash();
+    vector<BatchedEventsList> otherRes;
+    batch.Add(std::move(other), otherRes, 4);
+    APSARA_TEST_EQUAL(2U, batch.mShards[1].mEventQueueMap.size());
+
+    // each batch has its own timeout record, flushing one does not touch the others
+    auto& records = TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"];
+    APSARA_TEST_EQUAL(4U, records.size());
+    APSARA_TEST_EQUAL(key, batch.mShards[0].mTimeoutKeys[key]);
+    size_t timeoutKey = batch.mShards[1].mTimeoutKeys[key];
+    size_t otherTimeoutKey = batch.mShards[1].mTimeoutKeys[otherKey];
+    APSARA_TEST_NOT_EQUAL(key, timeoutKey);
+    APSARA_TEST_NOT_EQUAL(timeoutKey, otherTimeoutKey);
+    APSARA_TEST_NOT_EQUAL(0U, timeoutKey);
+    APSARA_TEST_NOT_EQUAL(0U, otherTimeoutKey);
+    APSARA_TEST_TRUE(records.find(make_pair(0, timeoutKey)) != records.end());
+    APSARA_TEST_TRUE(records.find(make_pair(0, otherTimeoutKey)) != records.end());
+
+    BatchedEventsList flushed;
+    batch.FlushQueue(timeoutKey, flushed);
+    APSARA_TEST_EQUAL(1U, flushed.size());
+    APSARA_TEST_EQUAL(2U, flushed[0].mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[1].mEventQueueMap.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[1].mEventQueueMap[otherKey].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(3U, batch.mTimeoutKeys.size());
+
+    // stale key after the batch is gone
+    flushed.clear();
+    batch.FlushQueue(timeoutKey, flushed);
+    APSARA_TEST_TRUE(flushed.empty());
+
+    vector<BatchedEventsList> all;
+    batch.FlushAll(all);
+    APSARA_TEST_EQUAL(2U, all.size());
+    APSARA_TEST_TRUE(batch.mTimeoutKeys.empty());
+    APSARA_TEST_TRUE(batch.mShards[0].mTimeoutKeys.empty());
+    APSARA_TEST_TRUE(batch.mShards[1].mTimeoutKeys.empty());
+}
+
 PipelineEventGroup BatcherUnittest::CreateEventGroup(size_t cnt) {
     PipelineEventGroup group(make_shared<SourceBuffer>());
     group.SetTag(string("key"), string("val"));
@@ -680,6 +758,7 @@ UNIT_TEST_CASE(BatcherUnittest, TestFlushGroupQueue)
 UNIT_TEST_CASE(BatcherUnittest, TestFlushAllWithoutGroupBatch)
 UNIT_TEST_CASE(BatcherUnittest, TestFlushAllWithGroupBatch)
 UNIT_TEST_CASE(BatcherUnittest, TestMetric)
+UNIT_TEST_CASE(BatcherUnittest, TestAddFromMultipleThreads)
 
 } // namespace logtail
 
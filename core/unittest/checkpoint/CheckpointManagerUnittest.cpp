@@ -18,6 +18,9 @@
 #include "unittest/Unittest.h"
 
 DECLARE_FLAG_INT32(checkpoint_find_max_file_count);
+DECLARE_FLAG_BOOL(enable_binary_check_point);
+DECLARE_FLAG_INT32(check_point_binary_log_compact_min_size);
+DECLARE_FLAG_INT32(check_point_binary_log_compact_ratio);
 
 namespace logtail {
 
@@ -35,9 +38,57 @@ public:
     static void TearDownTestCase() { bfs::remove_all(kTestRootDir); }
 
     void TestSearchFilePathByDevInodeInDirectory();
+    void TestBinaryCheckPointDumpAndLoad();
+    void TestBinaryCheckPointIncrementalDump();
+    void TestBinaryCheckPointCompact();
+    void TestBinaryCheckPointMigration();
+
+protected:
+    void TearDown() override {
+        auto* manager = CheckPointManager::Instance();
+        manager->RemoveAllCheckPoint();
+        manager->RemoveLocalCheckPoint();
+        BOOL_FLAG(enable_binary_check_point) = false;
+    }
+
+    static CheckPoint* NewCheckPoint(uint64_t inode, const std::string& configName, int64_t offset) {
+        auto* ptr = new CheckPoint("/var/log/test" + std::to_string(inode) + ".log",
+                                   offset,
+                                   1024,
+                                   inode * 31,
+                                   DevInode(1, inode),
+                                   configName,
+                                   "/host/var/log/test" + std::to_string(inode) + ".log",
+                                   inode % 2 == 0,
+                                   inode % 3 == 0,
+                                   "container" + std::to_string(inode),
+                                   inode % 5 == 0);
+        ptr->mLastUpdateTime = 1700000000 + inode;
+        ptr->mIdxInReaderArray = inode % 4;
+        return ptr;
+    }
+
+    static void AddCheckPoints(uint64_t count, int64_t offset) {
+        for (uint64_t inode = 1; inode <= count; ++inode) {
+            CheckPointManager::Instance()->AddCheckPoint(NewCheckPoint(inode, "config", offset));
+        }
+    }
+
+    static void ReloadCheckPoints() {
+        CheckPointManager::Instance()->RemoveAllCheckPoint();
+        CheckPointManager::Instance()->LoadCheckPoint();
+    }
+
+    static uint64_t GetBinaryCheckPointFileSize() {
+        return bfs::file_size(AppConfig::GetInstance()->GetCheckPointFilePath() + ".bin");
+    }
 };
 
 UNIT_TEST_CASE(CheckpointManagerUnittest, TestSearchFilePathByDevInodeInDirectory);
+UNIT_TEST_CASE(CheckpointManagerUnittest, TestBinaryCheckPointDumpAndLoad);
+UNIT_TEST_CASE(CheckpointManagerUnittest, TestBinaryCheckPointIncrementalDump);
+UNIT_TEST_CASE(CheckpointManagerUnittest, TestBinaryCheckPointCompact);
+UNIT_TEST_CASE(CheckpointManagerUnittest, TestBinaryCheckPointMigration);
 
 void CheckpointManagerUnittest::TestSearchFilePathByDevInodeInDirectory() {
     const std::string kRotateFileName = "test.log.5";
@@ -96,6 +147,151 @@ void CheckpointManagerUnittest::TestSearchFilePathByDevInodeInDirectory() {
     }
 }
 
+void CheckpointManagerUnittest::TestBinaryCheckPointDumpAndLoad() {
+    BOOL_FLAG(enable_binary_check_point) = true;
+    auto* manager = CheckPointManager::Instance();
+    for (uint64_t inode = 1; inode <= 10; ++inode) {
+        manager->AddCheckPoint(NewCheckPoint(inode, "config", inode * 100));
+        manager->AddCheckPoint(NewCheckPoint(inode, "another_config", inode * 200));
+    }
+    manager->AddDirCheckPoint("/var/log/a");
+    manager->AddDirCheckPoint("/var/log/b");
+    manager->AddDirCheckPoint("/var/log/a/c");
+    APSARA_TEST_TRUE(manager->DumpCheckPointToLocal());
+    APSARA_TEST_FALSE(bfs::exists(AppConfig::GetInstance()->GetCheckPointFilePath()));
+
+    ReloadCheckPoints();
+    APSARA_TEST_EQUAL(20U, manager->GetAllFileCheckPoint().size());
+    APSARA_TEST_EQUAL(20, manager->GetReaderCount());
+    for (uint64_t inode = 1; inode <= 10; ++inode) {
+        std::unique_ptr<CheckPoint> expected(NewCheckPoint(inode, "config", inode * 100));
+        CheckPointPtr cpt;
+        APSARA_TEST_TRUE_FATAL(manager->GetCheckPoint(DevInode(1, inode), "config", cpt));
+        APSARA_TEST_EQUAL(expected->mFileName, cpt->mFileName);
+        APSARA_TEST_EQUAL(expected->mRealFileName, cpt->mRealFileName);
+        APSARA_TEST_EQUAL(expected->mOffset, cpt->mOffset);
+        APSARA_TEST_EQUAL(expected->mSignatureHash, cpt->mSignatureHash);
+        APSARA_TEST_EQUAL(expected->mSignatureSize, cpt->mSignatureSize);
+        APSARA_TEST_EQUAL(expected->mFileOpenFlag, cpt->mFileOpenFlag);
+        APSARA_TEST_EQUAL(expected->mContainerStopped, cpt->mContainerStopped);
+        APSARA_TEST_EQUAL(expected->mContainerID, cpt->mContainerID);
+        APSARA_TEST_EQUAL(expected->mLastForceRead, cpt->mLastForceRead);
+        APSARA_TEST_EQUAL(expected->mIdxInReaderArray, cpt->mIdxInReaderArray);
+        APSARA_TEST_TRUE_FATAL(manager->GetCheckPoint(DevInode(1, inode), "another_config", cpt));
+        APSARA_TEST_EQUAL(static_cast<int64_t>(inode * 200), cpt->mOffset);
+    }
+    DirCheckPointPtr dir;
+    APSARA_TEST_TRUE_FATAL(manager->GetDirCheckPoint("/var/log", dir));
+    APSARA_TEST_TRUE(dir->mSubDir == std::set<std::string>({"/var/log/a", "/var/log/b"}));
+    APSARA_TEST_TRUE_FATAL(manager->GetDirCheckPoint("/var/log/a", dir));
+    APSARA_TEST_TRUE(dir->mSubDir == std::set<std::string>({"/var/log/a/c"}));
+}
+
+void CheckpointManagerUnittest::TestBinaryCheckPointIncrementalDump() {
+    BOOL_FLAG(enable_binary_check_point) = true;
+    auto* manager = CheckPointManager::Instance();
+    AddCheckPoints(100, 0);
+    APSARA_TEST_TRUE(manager->DumpCheckPointToLocal());
+    uint64_t snapshotSize = GetBinaryCheckPointFileSize();
+
+    // nothing changed, nothing appended
+    manager->RemoveAllCheckPoint();
+    AddCheckPoints(100, 0);
+    APSARA_TEST_TRUE(manager->DumpCheckPointToLocal());
+    APSARA_TEST_EQUAL(snapshotSize, GetBinaryCheckPointFileSize());
+
+    // one updated, one deleted and one added
+    manager->AddCheckPoint(NewCheckPoint(1, "config", 4096));
+    manager->DeleteCheckPoint(DevInode(1, 2), "config");
+    manager->AddCheckPoint(NewCheckPoint(101, "config", 0));
+    APSARA_TEST_TRUE(manager->DumpCheckPointToLocal());
+    uint64_t size = GetBinaryCheckPointFileSize();
+    APSARA_TEST_TRUE(size > snapshotSize);
+    APSARA_TEST_TRUE(size - snapshotSize < snapshotSize / 10);
+
+    ReloadCheckPoints();
+    APSARA_TEST_EQUAL(100U, manager->GetAllFileCheckPoint().size());
+    CheckPointPtr cpt;
+    APSARA_TEST_TRUE_FATAL(manager->GetCheckPoint(DevInode(1, 1), "config", cpt));
+    APSARA_TEST_EQUAL(4096, cpt->mOffset);
+    APSARA_TEST_FALSE(manager->GetCheckPoint(DevInode(1, 2), "config", cpt));
+    APSARA_TEST_TRUE(manager->GetCheckPoint(DevInode(1, 101), "config", cpt));
+    APSARA_TEST_FALSE(manager->mBinaryCheckPointNeedCompact);
+
+    // records of an interrupted dump are ignored
+    manager->AddCheckPoint(NewCheckPoint(1, "config", 8192));
+    APSARA_TEST_TRUE(manager->DumpCheckPointToLocal());
+    const std::string binaryFile = AppConfig::GetInstance()->GetCheckPointFilePath() + ".bin";
+    bfs::resize_file(binaryFile, GetBinaryCheckPointFileSize() - 1);
+    ReloadCheckPoints();
+    APSARA_TEST_TRUE_FATAL(manager->GetCheckPoint(DevInode(1, 1), "config", cpt));
+    APSARA_TEST_EQUAL(4096, cpt->mOffset);
+    APSARA_TEST_TRUE(manager->mBinaryCheckPointNeedCompact);
+}
+
+void CheckpointManagerUnittest::TestBinaryCheckPointCompact() {
+    BOOL_FLAG(enable_binary_check_point) = true;
+    auto bakMinSize = INT32_FLAG(check_point_binary_log_compact_min_size);
+    auto bakRatio = INT32_FLAG(check_point_binary_log_compact_ratio);
+    INT32_FLAG(check_point_binary_log_compact_min_size) = 0;
+    INT32_FLAG(check_point_binary_log_compact_ratio) = 2;
+
+    auto* manager = CheckPointManager::Instance();
+    AddCheckPoints(10, 0);
+    APSARA_TEST_TRUE(manager->DumpCheckPointToLocal());
+    uint64_t snapshotSize = GetBinaryCheckPointFileSize();
+    uint64_t lastSize = snapshotSize;
+    bool compacted = false;
+    for (int64_t offset = 1; offset <= 5; ++offset) {
+        AddCheckPoints(10, offset);
+        APSARA_TEST_TRUE(manager->DumpCheckPointToLocal());
+        uint64_t size = GetBinaryCheckPointFileSize();
+        APSARA_TEST_TRUE(size <= snapshotSize * 3);
+        compacted |= size < lastSize;
+        lastSize = size;
+    }
+    APSARA_TEST_TRUE(compacted);
+
+    ReloadCheckPoints();
+    CheckPointPtr cpt;
+    APSARA_TEST_TRUE_FATAL(manager->GetCheckPoint(DevInode(1, 10), "config", cpt));
+    APSARA_TEST_EQUAL(5, cpt->mOffset);
+
+    INT32_FLAG(check_point_binary_log_compact_min_size) = bakMinSize;
+    INT32_FLAG(check_point_binary_log_compact_ratio) = bakRatio;
+}
+
+void CheckpointManagerUnittest::TestBinaryCheckPointMigration() {
+    auto* manager = CheckPointManager::Instance();
+    const std::string binaryFile = AppConfig::GetInstance()->GetCheckPointFilePath() + ".bin";
+    AddCheckPoints(10, 100);
+    APSARA_TEST_TRUE(manager->DumpCheckPointToLocal());
+    APSARA_TEST_TRUE(bfs::exists(AppConfig::GetInstance()->GetCheckPointFilePath()));
+    APSARA_TEST_FALSE(bfs::exists(binaryFile));
+
+    // json file is loaded when there is no binary log, and migrated on the next dump
+    BOOL_FLAG(enable_binary_check_point) = true;
+    ReloadCheckPoints();
+    APSARA_TEST_EQUAL(10U, manager->GetAllFileCheckPoint().size());
+    manager->AddCheckPoint(NewCheckPoint(1, "config", 200));
+    APSARA_TEST_TRUE(manager->DumpCheckPointToLocal());
+    APSARA_TEST_TRUE(bfs::exists(binaryFile));
+
+    // binary log is newer than the json file left behind
+    ReloadCheckPoints();
+    CheckPointPtr cpt;
+    APSARA_TEST_TRUE_FATAL(manager->GetCheckPoint(DevInode(1, 1), "config", cpt));
+    APSARA_TEST_EQUAL(200, cpt->mOffset);
+
+    // turning the binary log off removes it
+    BOOL_FLAG(enable_binary_check_point) = false;
+    APSARA_TEST_TRUE(manager->DumpCheckPointToLocal());
+    APSARA_TEST_FALSE(bfs::exists(binaryFile));
+    ReloadCheckPoints();
+    APSARA_TEST_TRUE_FATAL(manager->GetCheckPoint(DevInode(1, 1), "config", cpt));
+    APSARA_TEST_EQUAL(200, cpt->mOffset);
+}
+
 } // namespace logtail
 
 UNIT_TEST_MAIN
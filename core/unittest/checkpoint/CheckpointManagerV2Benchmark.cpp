@@ -0,0 +1,112 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "app_config/AppConfig.h"
+#include "checkpoint/CheckpointManagerV2.h"
+#include "common/Flags.h"
+#include "common/RuntimeUtil.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_BOOL(enable_checkpoint_v2_group_commit);
+DECLARE_FLAG_INT32(logtail_checkpoint_check_gc_interval_sec);
+
+using namespace std;
+
+namespace logtail {
+
+class CheckpointManagerV2Benchmark : public ::testing::Test {
+public:
+    static void SetUpTestCase() {
+        sRootDir = (bfs::path(GetProcessExecutionDir()) / "CheckpointManagerV2Benchmark").string();
+        bfs::remove_all(sRootDir);
+        bfs::create_directories(sRootDir);
+        AppConfig::GetInstance()->SetLoongcollectorConfDir(sRootDir);
+        INT32_FLAG(logtail_checkpoint_check_gc_interval_sec) = 1;
+    }
+
+    static void TearDownTestCase() {
+        BOOL_FLAG(enable_checkpoint_v2_group_commit) = true;
+        bfs::remove_all(sRootDir);
+    }
+
+    void TestCommitThroughput();
+
+private:
+    static constexpr int kWritesPerThread = 500;
+    static constexpr uint32_t kConcurrency = 8;
+
+    // each thread plays a flusher committing range checkpoints of its own file, with sync writes as when
+    // EnableCheckpointSyncWrite is set, returns commits per second
+    double Run(bool groupCommit, bool async, int threadCount) {
+        BOOL_FLAG(enable_checkpoint_v2_group_commit) = groupCommit;
+        CheckpointManagerV2 m;
+        m.rebuild();
+        m.mDefaultWriteOption.sync = true;
+
+        auto start = chrono::high_resolution_clock::now();
+        vector<thread> threads;
+        for (int t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&m, t, async]() {
+                const string primaryKey = "config-/var/log/test" + to_string(t) + ".log-100-" + to_string(t);
+                RangeCheckpointPB cpt;
+                cpt.set_hash_key(primaryKey);
+                cpt.set_committed(true);
+                for (int idx = 0; idx < kWritesPerThread; ++idx) {
+                    cpt.set_sequence_id(idx);
+                    cpt.set_read_offset(idx * 1024);
+                    cpt.set_read_length(1024);
+                    const string key = CheckpointManagerV2::MakeRangeKey(primaryKey, idx % kConcurrency);
+                    if (async) {
+                        m.AsyncSetPB(key, cpt);
+                    } else {
+                        APSARA_TEST_TRUE(m.SetPB(key, cpt));
+                    }
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        m.Flush();
+        chrono::duration<double> elapsed = chrono::high_resolution_clock::now() - start;
+        return kWritesPerThread * threadCount / elapsed.count();
+    }
+
+    static string sRootDir;
+};
+
+string CheckpointManagerV2Benchmark::sRootDir;
+
+void CheckpointManagerV2Benchmark::TestCommitThroughput() {
+    for (int threadCount : {1, 4}) {
+        double direct = Run(false, false, threadCount);
+        double groupSync = Run(true, false, threadCount);
+        double groupAsync = Run(true, true, threadCount);
+        cout << "threads: " << threadCount << ", commits/s one put per write: " << direct
+             << ", group commit waiting: " << groupSync << ", group commit async: " << groupAsync
+             << ", async speedup: " << groupAsync / direct << endl;
+    }
+}
+
+UNIT_TEST_CASE(CheckpointManagerV2Benchmark, TestCommitThroughput)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -12,6 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include "app_config/AppConfig.h"
 #include "checkpoint/CheckpointManagerV2.h"
 #include "common/Flags.h"
@@ -54,6 +58,8 @@ public:
     void TestExtractPrimaryKeyFromRangeKey();
 
     void TestMarkGC();
+
+    void TestGroupCommit();
 };
 
 UNIT_TEST_CASE(CheckpointManagerV2Unittest, TestBaseMethod);
@@ -61,6 +67,7 @@ UNIT_TEST_CASE(CheckpointManagerV2Unittest, TestProtobufMethod);
 UNIT_TEST_CASE(CheckpointManagerV2Unittest, TestScanCheckpoints);
 UNIT_TEST_CASE(CheckpointManagerV2Unittest, TestExtractPrimaryKeyFromRangeKey);
 UNIT_TEST_CASE(CheckpointManagerV2Unittest, TestMarkGC);
+UNIT_TEST_CASE(CheckpointManagerV2Unittest, TestGroupCommit);
 
 void CheckpointManagerV2Unittest::TestBaseMethod() {
     CheckpointManagerV2 m;
@@ -342,6 +349,98 @@ void CheckpointManagerV2Unittest::TestMarkGC() {
     }
 }
 
+void CheckpointManagerV2Unittest::TestGroupCommit() {
+    CheckpointManagerV2 m;
+    m.rebuild();
+    EXPECT_TRUE(m.mCommitThreadPtr != nullptr);
+
+    const std::string key = m.MakeRangeKey(kPrimaryKey, 0);
+    RangeCheckpointPB cpt;
+    cpt.set_hash_key(kPrimaryKey);
+    cpt.set_sequence_id(0);
+    cpt.set_read_length(0);
+    cpt.set_update_time(time(NULL));
+    cpt.set_committed(false);
+    RangeCheckpointPB rCpt;
+    std::string value;
+
+    // Queued writes are visible at once, committed in order and reported by callbacks.
+    std::atomic_int callbackCount{0};
+    std::atomic_bool allSucceeded{true};
+    for (int idx = 0; idx < 100; ++idx) {
+        cpt.set_read_offset(idx);
+        m.AsyncSetPB(key, cpt, [&](bool success) {
+            ++callbackCount;
+            allSucceeded = allSucceeded && success;
+        });
+    }
+    EXPECT_TRUE(m.GetPB(key, rCpt));
+    EXPECT_EQ(99U, rCpt.read_offset());
+    m.Flush();
+    EXPECT_EQ(100, callbackCount.load());
+    EXPECT_TRUE(allSucceeded.load());
+    EXPECT_TRUE(m.readDatabase(key, value));
+    EXPECT_TRUE(rCpt.ParseFromString(value));
+    EXPECT_EQ(99U, rCpt.read_offset());
+
+    // A sync write is durable when it returns, and is not overwritten by an earlier async one.
+    cpt.set_read_offset(200);
+    m.AsyncSetPB(key, cpt);
+    cpt.set_read_offset(300);
+    EXPECT_TRUE(m.SetPB(key, cpt));
+    EXPECT_TRUE(m.readDatabase(key, value));
+    EXPECT_TRUE(rCpt.ParseFromString(value));
+    EXPECT_EQ(300U, rCpt.read_offset());
+
+    // Deleted keys are not brought back by queued writes, while writes after the deletion are kept.
+    m.AsyncSetPB(key, cpt);
+    m.DeleteCheckpoints(std::vector<std::string>{key});
+    EXPECT_FALSE(m.read(key, value));
+    m.Flush();
+    EXPECT_FALSE(m.readDatabase(key, value));
+    cpt.set_read_offset(400);
+    m.AsyncSetPB(key, cpt);
+    m.Flush();
+    EXPECT_TRUE(m.readDatabase(key, value));
+    EXPECT_TRUE(rCpt.ParseFromString(value));
+    EXPECT_EQ(400U, rCpt.read_offset());
+    m.DeleteCheckpoints(std::vector<std::string>{key});
+
+    // Closing stops the commit thread after committing queued writes, writes after it fail.
+    cpt.set_read_offset(500);
+    m.AsyncSetPB(key, cpt);
+    EXPECT_TRUE(m.close());
+    EXPECT_TRUE(m.mCommitThreadPtr == nullptr);
+    EXPECT_FALSE(m.SetPB(key, cpt));
+    std::atomic_bool closedResult{true};
+    m.AsyncSetPB(key, cpt, [&](bool success) { closedResult = success; });
+    EXPECT_FALSE(closedResult.load());
+    EXPECT_TRUE(m.open());
+    EXPECT_TRUE(m.mCommitThreadPtr != nullptr);
+    EXPECT_TRUE(m.GetPB(key, rCpt));
+    EXPECT_EQ(500U, rCpt.read_offset());
+
+    // Sync writers from several threads share batches.
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t) {
+        writers.emplace_back([&m, &cpt, t]() {
+            RangeCheckpointPB threadCpt = cpt;
+            for (int idx = 0; idx < 50; ++idx) {
+                threadCpt.set_read_offset(idx);
+                EXPECT_TRUE(m.SetPB(m.MakeRangeKey(kPrimaryKey + std::to_string(t), idx), threadCpt));
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    for (int t = 0; t < 4; ++t) {
+        for (int idx = 0; idx < 50; ++idx) {
+            EXPECT_TRUE(m.readDatabase(m.MakeRangeKey(kPrimaryKey + std::to_string(t), idx), value));
+        }
+    }
+}
+
 } // namespace logtail
 
 UNIT_TEST_MAIN
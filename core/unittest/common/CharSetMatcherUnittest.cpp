@@ -0,0 +1,97 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <vector>
+
+#include "common/CharSetMatcher.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class CharSetMatcherUnittest : public ::testing::Test {
+public:
+    void TestForEach();
+    void TestForEachStop();
+    void TestFind();
+};
+
+void CharSetMatcherUnittest::TestForEach() {
+    CharSetMatcher matcher({'\t', ':'});
+    // cover both the 16-byte blocks and the tail
+    for (size_t len = 0; len < 70; ++len) {
+        string str;
+        vector<size_t> expected;
+        for (size_t i = 0; i < len; ++i) {
+            if (i % 7 == 3) {
+                str.push_back('\t');
+                expected.push_back(i);
+            } else if (i % 11 == 5) {
+                str.push_back(':');
+                expected.push_back(i);
+            } else {
+                str.push_back(static_cast<char>('a' + i % 26));
+            }
+        }
+        vector<size_t> res;
+        matcher.ForEach(str.data(), str.data() + str.size(), [&](const char* p) {
+            res.push_back(p - str.data());
+            return true;
+        });
+        APSARA_TEST_EQUAL(expected, res);
+    }
+    {
+        // non-ascii bytes are never matched
+        string str(40, '\xa1');
+        str[33] = ':';
+        vector<size_t> res;
+        matcher.ForEach(str.data(), str.data() + str.size(), [&](const char* p) {
+            res.push_back(p - str.data());
+            return true;
+        });
+        APSARA_TEST_EQUAL(vector<size_t>({33}), res);
+    }
+}
+
+void CharSetMatcherUnittest::TestForEachStop() {
+    CharSetMatcher matcher({','});
+    string str(50, ',');
+    size_t cnt = 0;
+    matcher.ForEach(str.data(), str.data() + str.size(), [&](const char*) { return ++cnt < 20; });
+    APSARA_TEST_EQUAL(20U, cnt);
+}
+
+void CharSetMatcherUnittest::TestFind() {
+    CharSetMatcher matcher({'a', 'b', 'c', 'd', 'e'});
+    string str(40, 'x');
+    APSARA_TEST_EQUAL(str.data() + str.size(), matcher.Find(str.data(), str.data() + str.size()));
+    str[25] = 'd';
+    APSARA_TEST_EQUAL(str.data() + 25, matcher.Find(str.data(), str.data() + str.size()));
+    // only the first kMaxChars chars are used
+    str[20] = 'e';
+    APSARA_TEST_EQUAL(str.data() + 25, matcher.Find(str.data(), str.data() + str.size()));
+
+    CharSetMatcher empty({});
+    APSARA_TEST_EQUAL(str.data() + str.size(), empty.Find(str.data(), str.data() + str.size()));
+}
+
+UNIT_TEST_CASE(CharSetMatcherUnittest, TestForEach)
+UNIT_TEST_CASE(CharSetMatcherUnittest, TestForEachStop)
+UNIT_TEST_CASE(CharSetMatcherUnittest, TestFind)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,167 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "common/Flags.h"
+#include "common/memory/ChunkPool.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_BOOL(enable_chunk_pool);
+DECLARE_FLAG_INT32(chunk_pool_thread_cache_size_kb);
+DECLARE_FLAG_INT32(chunk_pool_shared_cache_size_mb);
+
+using namespace std;
+
+namespace logtail {
+
+class ChunkPoolUnittest : public ::testing::Test {
+public:
+    void TestAcquire();
+    void TestThreadCache();
+    void TestCrossThreadRelease();
+    void TestSharedCacheLimit();
+    void TestThreadExit();
+
+protected:
+    void TearDown() override {
+        BOOL_FLAG(enable_chunk_pool) = true;
+        INT32_FLAG(chunk_pool_thread_cache_size_kb) = 2048;
+        INT32_FLAG(chunk_pool_shared_cache_size_mb) = 32;
+    }
+};
+
+void ChunkPoolUnittest::TestAcquire() {
+    auto pool = ChunkPool::GetInstance();
+    {
+        size_t size = 5000;
+        uint8_t* chunk = pool->Acquire(size);
+        APSARA_TEST_EQUAL(8192U, size);
+        pool->Release(chunk, size);
+    }
+    {
+        // too large to be pooled
+        size_t size = ChunkPool::kMaxPooledChunkSize + 1;
+        auto stat = pool->GetStat();
+        uint8_t* chunk = pool->Acquire(size);
+        APSARA_TEST_EQUAL(ChunkPool::kMaxPooledChunkSize + 1, size);
+        pool->Release(chunk, size);
+        APSARA_TEST_EQUAL(stat.mMissCnt + 1, pool->GetStat().mMissCnt);
+        APSARA_TEST_EQUAL(stat.mFreeCnt + 1, pool->GetStat().mFreeCnt);
+    }
+    {
+        // chunks not allocated by the pool
+        auto stat = pool->GetStat();
+        pool->Release(new uint8_t[100], 100);
+        APSARA_TEST_EQUAL(stat.mFreeCnt + 1, pool->GetStat().mFreeCnt);
+    }
+    {
+        // pool disabled
+        BOOL_FLAG(enable_chunk_pool) = false;
+        size_t size = 5000;
+        uint8_t* chunk = pool->Acquire(size);
+        APSARA_TEST_EQUAL(5000U, size);
+        pool->Release(chunk, size);
+    }
+}
+
+void ChunkPoolUnittest::TestThreadCache() {
+    auto pool = ChunkPool::GetInstance();
+    size_t size = 3 * ChunkPool::kPageSize;
+    uint8_t* chunk = pool->Acquire(size);
+    pool->Release(chunk, size);
+
+    auto stat = pool->GetStat();
+    uint8_t* reused = pool->Acquire(size);
+    APSARA_TEST_EQUAL(chunk, reused);
+    APSARA_TEST_EQUAL(stat.mThreadCacheHitCnt + 1, pool->GetStat().mThreadCacheHitCnt);
+    pool->Release(reused, size);
+}
+
+void ChunkPoolUnittest::TestCrossThreadRelease() {
+    auto pool = ChunkPool::GetInstance();
+    // chunks released by a thread with full cache are moved to the shared cache
+    INT32_FLAG(chunk_pool_thread_cache_size_kb) = 0;
+    size_t size = 5 * ChunkPool::kPageSize;
+    vector<uint8_t*> chunks;
+    thread([&]() {
+        for (size_t i = 0; i < 3; ++i) {
+            size_t s = size;
+            chunks.push_back(pool->Acquire(s));
+        }
+    }).join();
+    int64_t sharedBytes = pool->GetStat().mSharedCachedBytes;
+    for (auto chunk : chunks) {
+        pool->Release(chunk, size);
+    }
+    APSARA_TEST_EQUAL(sharedBytes + 3 * static_cast<int64_t>(size), pool->GetStat().mSharedCachedBytes);
+
+    // the thread with empty cache takes chunks from the shared cache in batch
+    INT32_FLAG(chunk_pool_thread_cache_size_kb) = 2048;
+    vector<uint8_t*> reused;
+    thread([&]() {
+        auto stat = pool->GetStat();
+        for (size_t i = 0; i < 3; ++i) {
+            size_t s = size;
+            reused.push_back(pool->Acquire(s));
+        }
+        APSARA_TEST_EQUAL(stat.mSharedCacheHitCnt + 1, pool->GetStat().mSharedCacheHitCnt);
+        APSARA_TEST_EQUAL(stat.mThreadCacheHitCnt + 2, pool->GetStat().mThreadCacheHitCnt);
+        APSARA_TEST_EQUAL(sharedBytes, pool->GetStat().mSharedCachedBytes);
+        for (auto chunk : reused) {
+            pool->Release(chunk, size);
+        }
+    }).join();
+    sort(chunks.begin(), chunks.end());
+    sort(reused.begin(), reused.end());
+    APSARA_TEST_EQUAL(chunks, reused);
+}
+
+void ChunkPoolUnittest::TestSharedCacheLimit() {
+    auto pool = ChunkPool::GetInstance();
+    INT32_FLAG(chunk_pool_thread_cache_size_kb) = 0;
+    INT32_FLAG(chunk_pool_shared_cache_size_mb) = 0;
+    size_t size = 7 * ChunkPool::kPageSize;
+    uint8_t* chunk = pool->Acquire(size);
+    auto stat = pool->GetStat();
+    pool->Release(chunk, size);
+    APSARA_TEST_EQUAL(stat.mFreeCnt + 1, pool->GetStat().mFreeCnt);
+    APSARA_TEST_EQUAL(stat.mSharedCachedBytes, pool->GetStat().mSharedCachedBytes);
+}
+
+void ChunkPoolUnittest::TestThreadExit() {
+    auto pool = ChunkPool::GetInstance();
+    size_t size = 9 * ChunkPool::kPageSize;
+    int64_t sharedBytes = pool->GetStat().mSharedCachedBytes;
+    thread([&]() {
+        size_t s = size;
+        uint8_t* chunk = pool->Acquire(s);
+        pool->Release(chunk, s);
+        APSARA_TEST_EQUAL(sharedBytes, pool->GetStat().mSharedCachedBytes);
+    }).join();
+    // chunks cached by the exited thread are returned to the shared cache
+    APSARA_TEST_EQUAL(sharedBytes + static_cast<int64_t>(size), pool->GetStat().mSharedCachedBytes);
+}
+
+UNIT_TEST_CASE(ChunkPoolUnittest, TestAcquire)
+UNIT_TEST_CASE(ChunkPoolUnittest, TestThreadCache)
+UNIT_TEST_CASE(ChunkPoolUnittest, TestCrossThreadRelease)
+UNIT_TEST_CASE(ChunkPoolUnittest, TestSharedCacheLimit)
+UNIT_TEST_CASE(ChunkPoolUnittest, TestThreadExit)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
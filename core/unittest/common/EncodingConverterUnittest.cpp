@@ -23,9 +23,15 @@ namespace logtail {
 class EncodingConverterUnittest : public ::testing::Test {
 public:
     void ConvertGbk2Utf8();
+#if defined(__linux__)
+    void ConvertGbk2Utf8WithInvalidLine();
+#endif
 };
 
 APSARA_UNIT_TEST_CASE(EncodingConverterUnittest, ConvertGbk2Utf8, 0);
+#if defined(__linux__)
+APSARA_UNIT_TEST_CASE(EncodingConverterUnittest, ConvertGbk2Utf8WithInvalidLine, 0);
+#endif
 
 void EncodingConverterUnittest::ConvertGbk2Utf8() {
     char gbkStr[] = "ilogtail\xbf\xc9\xb9\xdb\xb2\xe2\xd0\xd4\xb2\xc9\xbc\xaf\xc6\xf7";
@@ -41,6 +47,28 @@ void EncodingConverterUnittest::ConvertGbk2Utf8() {
     APSARA_TEST_STREQ("ilogtail可观测性采集器", destChar.get());
 }
 
+#if defined(__linux__)
+void EncodingConverterUnittest::ConvertGbk2Utf8WithInvalidLine() {
+    // the invalid line is copied without converting, while other lines are converted
+    std::string gbkStr = "a long ascii prefix for the fast path \xbf\xc9\xb9\xdb\xb2\xe2\n"
+                         "invalid \xbf\n"
+                         "\xd0\xd4 \x80\n"
+                         "tail \xb2";
+    std::string expected = "a long ascii prefix for the fast path 可观测\n"
+                           "invalid \xbf\n"
+                           "性 €\n"
+                           "tail \xb2";
+    size_t srcLen = gbkStr.size();
+    std::vector<long> linePosVec;
+    size_t requireSize
+        = EncodingConverter::GetInstance()->ConvertGbk2Utf8(gbkStr.data(), &srcLen, nullptr, 0, linePosVec) + 1;
+    std::unique_ptr<char[]> destChar(new char[requireSize]);
+    size_t actualSize = EncodingConverter::GetInstance()->ConvertGbk2Utf8(
+        gbkStr.data(), &srcLen, destChar.get(), requireSize, linePosVec);
+    APSARA_TEST_EQUAL(expected, std::string(destChar.get(), actualSize));
+}
+#endif
+
 } // namespace logtail
 
 int main(int argc, char** argv) {
@@ -0,0 +1,163 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+
+#include "collection_pipeline/CollectionPipelineContext.h"
+#include "collection_pipeline/queue/ProcessQueueItem.h"
+#include "collection_pipeline/queue/ProcessQueueManager.h"
+#include "collection_pipeline/queue/QueueKeyManager.h"
+#include "collection_pipeline/queue/SenderQueueItem.h"
+#include "common/Flags.h"
+#include "common/memory/MemoryBudget.h"
+#include "common/memory/SourceBuffer.h"
+#include "models/PipelineEventGroup.h"
+#include "runner/ProcessorRunner.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT64(memory_budget_mb);
+
+using namespace std;
+
+namespace logtail {
+
+class MemoryBudgetUnittest : public ::testing::Test {
+public:
+    void TestAccounting();
+    void TestIsValidToPush();
+    void TestUpdateLimit();
+    void TestPushQueue();
+
+protected:
+    void TearDown() override {
+        MemoryBudget::GetInstance()->SetLimit(0);
+        MemoryBudget::GetInstance()->mPipelineBytes.clear();
+        INT64_FLAG(memory_budget_mb) = 0;
+    }
+};
+
+void MemoryBudgetUnittest::TestAccounting() {
+    auto budget = MemoryBudget::GetInstance();
+    int64_t base = budget->GetUsedBytes();
+    {
+        // source buffer
+        auto sourceBuffer = make_shared<SourceBuffer>();
+        APSARA_TEST_EQUAL(base + 4096, budget->GetUsedBytes());
+        sourceBuffer->AllocateStringBuffer(10000);
+        // chunks are rounded up to pages
+        APSARA_TEST_EQUAL(base + 4096 + 12288, budget->GetUsedBytes());
+
+        BufferAllocator allocator;
+        allocator.Allocate(10000);
+        BufferAllocator movedAllocator(std::move(allocator));
+        allocator = std::move(movedAllocator);
+        APSARA_TEST_EQUAL(base + 2 * 4096 + 2 * 12288, budget->GetUsedBytes());
+        allocator.Reset();
+        APSARA_TEST_EQUAL(base + 2 * 4096 + 12288, budget->GetUsedBytes());
+    }
+    APSARA_TEST_EQUAL(base, budget->GetUsedBytes());
+    {
+        // sender queue item
+        auto item = make_unique<SenderQueueItem>(string(100, 'a'), 100, nullptr, 0);
+        APSARA_TEST_EQUAL(base + 100, budget->GetUsedBytes());
+        unique_ptr<SenderQueueItem> clone(item->Clone());
+        APSARA_TEST_EQUAL(base + 200, budget->GetUsedBytes());
+    }
+    APSARA_TEST_EQUAL(base, budget->GetUsedBytes());
+    {
+        // process queue item is charged to the pipeline only once
+        auto item = make_unique<ProcessQueueItem>(PipelineEventGroup(make_shared<SourceBuffer>()), 0);
+        item->ChargeMemoryBudget(1);
+        item->ChargeMemoryBudget(1);
+        APSARA_TEST_EQUAL(1U, budget->mPipelineBytes.size());
+        APSARA_TEST_EQUAL(4096 + static_cast<int64_t>(sizeof(void*)), budget->mPipelineBytes[1]);
+    }
+    APSARA_TEST_TRUE(budget->mPipelineBytes.empty());
+}
+
+void MemoryBudgetUnittest::TestIsValidToPush() {
+    auto budget = MemoryBudget::GetInstance();
+    int64_t base = budget->GetUsedBytes();
+    // unlimited
+    budget->Allocate(1000);
+    APSARA_TEST_TRUE(budget->IsValidToPush(1));
+
+    budget->SetLimit(base + 1000);
+    APSARA_TEST_FALSE(budget->IsValidToPush(1));
+    budget->Release(1000);
+    APSARA_TEST_TRUE(budget->IsValidToPush(1));
+
+    // above fair share threshold, only pipelines below their fair share are admitted
+    budget->SetLimit(1000);
+    budget->Allocate(900 - base);
+    budget->AllocateForPipeline(1, 600);
+    budget->AllocateForPipeline(2, 300);
+    APSARA_TEST_FALSE(budget->IsValidToPush(1));
+    APSARA_TEST_TRUE(budget->IsValidToPush(2));
+    APSARA_TEST_TRUE(budget->IsValidToPush(3));
+    budget->ReleaseForPipeline(1, 200);
+    APSARA_TEST_TRUE(budget->IsValidToPush(1));
+
+    // budget used up
+    budget->Allocate(100);
+    APSARA_TEST_FALSE(budget->IsValidToPush(2));
+    APSARA_TEST_FALSE(budget->IsValidToPush(3));
+    budget->Release(1000 - base);
+    budget->ReleaseForPipeline(1, 400);
+    budget->ReleaseForPipeline(2, 300);
+    APSARA_TEST_TRUE(budget->mPipelineBytes.empty());
+}
+
+void MemoryBudgetUnittest::TestUpdateLimit() {
+    auto budget = MemoryBudget::GetInstance();
+    budget->UpdateLimit(384);
+    APSARA_TEST_EQUAL(192 * 1024 * 1024, budget->GetLimit());
+
+    INT64_FLAG(memory_budget_mb) = 100;
+    budget->UpdateLimit(384);
+    APSARA_TEST_EQUAL(100 * 1024 * 1024, budget->GetLimit());
+
+    INT64_FLAG(memory_budget_mb) = -1;
+    budget->UpdateLimit(384);
+    APSARA_TEST_EQUAL(0, budget->GetLimit());
+}
+
+void MemoryBudgetUnittest::TestPushQueue() {
+    auto budget = MemoryBudget::GetInstance();
+    CollectionPipelineContext ctx;
+    ctx.SetConfigName("test_config");
+    QueueKey key = QueueKeyManager::GetInstance()->GetKey("test_config");
+    ProcessQueueManager::GetInstance()->CreateOrUpdateBoundedQueue(key, 0, ctx);
+    budget->SetLimit(1);
+
+    // inputs that retry are held back
+    PipelineEventGroup group(make_shared<SourceBuffer>());
+    group.AddLogEvent();
+    APSARA_TEST_FALSE(ProcessorRunner::GetInstance()->PushQueue(key, 0, std::move(group), 2));
+    APSARA_TEST_EQUAL(1U, group.GetEvents().size());
+
+    // one shot pushes, e.g. self monitor data, are not dropped
+    APSARA_TEST_TRUE(ProcessorRunner::GetInstance()->PushQueue(key, 0, std::move(group)));
+    ProcessQueueManager::GetInstance()->DeleteQueue(key);
+}
+
+UNIT_TEST_CASE(MemoryBudgetUnittest, TestAccounting)
+UNIT_TEST_CASE(MemoryBudgetUnittest, TestIsValidToPush)
+UNIT_TEST_CASE(MemoryBudgetUnittest, TestUpdateLimit)
+UNIT_TEST_CASE(MemoryBudgetUnittest, TestPushQueue)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
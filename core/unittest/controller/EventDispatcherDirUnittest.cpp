@@ -16,17 +16,25 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 
+#include <cstdio>
+#include <fstream>
 #include <memory>
 #include <string>
 
+#include "boost/filesystem.hpp"
+
+#include "common/FileSystemUtil.h"
 #include "common/Flags.h"
+#include "common/RuntimeUtil.h"
 #include "file_server/EventDispatcher.h"
 #include "file_server/event/Event.h"
 #include "file_server/event_handler/EventHandler.h"
+#include "file_server/event_listener/EventListener.h"
 #include "unittest/Unittest.h"
 using namespace std;
 
 DECLARE_FLAG_STRING(ilogtail_config);
+DECLARE_FLAG_INT32(inotify_wd_table_max_size);
 
 namespace logtail {
 class MockHandler : public EventHandler {
@@ -124,11 +132,105 @@ public:
             }
         }
     }
+
+    void TestGetInotifyDirInfo() {
+        LOG_INFO(sLogger, ("TestGetInotifyDirInfo() begin", time(NULL)));
+        EventDispatcher* dispatcher = EventDispatcher::GetInstance();
+        std::string path;
+        APSARA_TEST_TRUE_FATAL(dispatcher->IsRegistered(5, path));
+        APSARA_TEST_EQUAL_FATAL(path, "/basepath1/log/5");
+        APSARA_TEST_EQUAL_FATAL(dispatcher->GetInotifyDirInfo(5)->mHandler, &mHandlers[5]);
+        APSARA_TEST_TRUE_FATAL(dispatcher->GetInotifyDirInfo(10) == nullptr);
+
+        dispatcher->RemoveOneToOneMapEntry(5);
+        APSARA_TEST_TRUE_FATAL(dispatcher->GetInotifyDirInfo(5) == nullptr);
+        APSARA_TEST_FALSE_FATAL(dispatcher->IsRegistered(5, path));
+
+        // wds out of the flat table are looked up in the map
+        int largeWd = INT32_FLAG(inotify_wd_table_max_size);
+        dispatcher->AddOneToOneMapEntry(new DirInfo("/large", largeWd, false, &mHandlers[0]), largeWd);
+        APSARA_TEST_EQUAL_FATAL(dispatcher->GetInotifyDirInfo(largeWd)->mPath, "/large");
+        dispatcher->RemoveOneToOneMapEntry(largeWd);
+        APSARA_TEST_TRUE_FATAL(dispatcher->GetInotifyDirInfo(largeWd) == nullptr);
+
+        // wds of polling dirs are negative
+        dispatcher->AddOneToOneMapEntry(new DirInfo("/polling", 0, false, &mHandlers[0]), -2);
+        APSARA_TEST_EQUAL_FATAL(dispatcher->GetInotifyDirInfo(-2)->mPath, "/polling");
+        dispatcher->RemoveOneToOneMapEntry(-2);
+        APSARA_TEST_TRUE_FATAL(dispatcher->GetInotifyDirInfo(-2) == nullptr);
+    }
+
+    void TestReadInotifyEvents() {
+        LOG_INFO(sLogger, ("TestReadInotifyEvents() begin", time(NULL)));
+        EventDispatcher* dispatcher = EventDispatcher::GetInstance();
+        EventListener* listener = EventListener::GetInstance();
+        if (!listener->IsInit()) {
+            APSARA_TEST_TRUE_FATAL(listener->Init());
+        }
+        std::string dir = GetProcessExecutionDir() + "inotify_events";
+        boost::filesystem::remove_all(dir);
+        boost::filesystem::create_directories(dir);
+        std::string fileA = PathJoin(dir, "a.log");
+        std::string fileB = PathJoin(dir, "b.log");
+        std::ofstream(fileA) << "a\n";
+        std::ofstream(fileB) << "b\n";
+        int wd = listener->AddWatch(dir.c_str());
+        APSARA_TEST_TRUE_FATAL(EventListener::IsValidID(wd));
+        // wd may be used by the fake entries
+        dispatcher->RemoveOneToOneMapEntry(wd);
+        dispatcher->AddOneToOneMapEntry(new DirInfo(dir, 0, false, &mHandlers[0]), wd);
+
+        auto append = [](const std::string& path) { std::ofstream(path, std::ios::app) << "x\n"; };
+        auto readEvents = [&]() {
+            std::vector<Event*> events;
+            listener->ReadEvents(events);
+            std::vector<std::string> res;
+            for (auto* event : events) {
+                APSARA_TEST_EQUAL(dir, event->GetSource());
+                res.push_back(event->GetTypeString() + " " + event->GetObject());
+                delete event;
+            }
+            return res;
+        };
+
+        // writes to different files are interleaved, so that they are not merged by the kernel
+        for (int i = 0; i < 3; ++i) {
+            append(fileA);
+            append(fileB);
+        }
+        APSARA_TEST_EQUAL((std::vector<std::string>{"MODIFY a.log", "MODIFY b.log"}), readEvents());
+
+        // modify events around other events of the same file are kept in order
+        append(fileA);
+        remove(fileA.c_str());
+        append(fileA);
+        append(fileB);
+        rename(fileB.c_str(), (fileB + ".1").c_str());
+        rename((fileB + ".1").c_str(), fileB.c_str());
+        append(fileB);
+        APSARA_TEST_EQUAL((std::vector<std::string>{"MODIFY a.log",
+                                                    "DELETE a.log",
+                                                    "CREATE a.log",
+                                                    "MODIFY a.log",
+                                                    "MODIFY b.log",
+                                                    "MOVED_FROM b.log",
+                                                    "MOVED_TO b.log.1",
+                                                    "MOVED_FROM b.log.1",
+                                                    "MOVED_TO b.log",
+                                                    "MODIFY b.log"}),
+                          readEvents());
+
+        listener->RemoveWatch(wd);
+        dispatcher->RemoveOneToOneMapEntry(wd);
+        boost::filesystem::remove_all(dir);
+    }
 };
 
 APSARA_UNIT_TEST_CASE(EventDispatcherDirUnittest, TestFindAllSubDirAndHandler, 0);
 APSARA_UNIT_TEST_CASE(EventDispatcherDirUnittest, TestUnregisterAllDir, 0);
 APSARA_UNIT_TEST_CASE(EventDispatcherDirUnittest, TestStopAllDir, 0);
+APSARA_UNIT_TEST_CASE(EventDispatcherDirUnittest, TestGetInotifyDirInfo, 0);
+APSARA_UNIT_TEST_CASE(EventDispatcherDirUnittest, TestReadInotifyEvents, 0);
 } // end of namespace logtail
 
 int main(int argc, char** argv) {
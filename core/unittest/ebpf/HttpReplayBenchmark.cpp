@@ -0,0 +1,196 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstddef>
+#include <cstdlib>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/StringTools.h"
+#include "ebpf/plugin/network_observer/Connection.h"
+#include "ebpf/protocol/http/HttpParser.h"
+#include "ebpf/util/sampler/Sampler.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail::ebpf {
+
+// Replays recorded data event payloads through HTTPProtocolParser.
+//
+// A recording is a binary file made of frames, one frame per conn_data_event_t:
+//   uint32 request_len | uint32 response_len | request bytes | response bytes   (little endian)
+// Recordings can be passed with HTTP_REPLAY_FILES (comma separated paths). Without it a synthetic recording is
+// generated, in which every other exchange is split across several events to exercise the resume path.
+class HttpReplayBenchmark : public testing::Test {
+public:
+    void TestReplay();
+    void TestReplayWithoutResume();
+
+protected:
+    void SetUp() override {
+        const char* files = getenv("HTTP_REPLAY_FILES");
+        if (files != nullptr && files[0] != '\0') {
+            for (const auto& file : SplitString(files, ",")) {
+                LoadRecording(file);
+            }
+        } else {
+            string path = GetProcessExecutionDir() + "http_replay.bin";
+            WriteSyntheticRecording(path);
+            LoadRecording(path);
+        }
+        mConn = make_shared<Connection>(ConnId(1, 1000, 123456));
+    }
+
+    void TearDown() override {
+        for (auto* event : mEvents) {
+            free(event);
+        }
+        mEvents.clear();
+    }
+
+private:
+    class AlwaysSampler : public Sampler {
+    public:
+        bool ShouldSample(const std::array<uint64_t, 2>&) const override { return true; }
+    };
+
+    static void AppendFrame(string& out, const string& req, const string& resp) {
+        uint32_t lens[2] = {static_cast<uint32_t>(req.size()), static_cast<uint32_t>(resp.size())};
+        out.append(reinterpret_cast<const char*>(lens), sizeof(lens));
+        out += req;
+        out += resp;
+    }
+
+    static void WriteSyntheticRecording(const string& path) {
+        const string req = "GET /api/v1/users/12345/orders?limit=20 HTTP/1.1\r\n"
+                           "Host: order-service.default.svc.cluster.local\r\n"
+                           "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko)\r\n"
+                           "Accept: application/json\r\n"
+                           "Accept-Encoding: gzip, deflate\r\n"
+                           "X-Request-Id: 9f1c2b7e-6a4d-4f1b-8c1e-2d3b4a5c6d7e\r\n"
+                           "Cookie: session=abcdefghijklmnopqrstuvwxyz0123456789; theme=dark\r\n"
+                           "\r\n";
+        const string resp = "HTTP/1.1 200 OK\r\n"
+                            "Content-Type: application/json\r\n"
+                            "Content-Length: 62\r\n"
+                            "Server: envoy\r\n"
+                            "\r\n"
+                            "{\"orders\":[{\"id\":1,\"amount\":100},{\"id\":2,\"amount\":200}],\"n\":2}";
+        string out;
+        for (int i = 0; i < 10000; ++i) {
+            if (i % 2 == 0) {
+                AppendFrame(out, req, resp);
+            } else {
+                // headers of both directions cut in the middle
+                AppendFrame(out, req.substr(0, 100), resp.substr(0, 40));
+                AppendFrame(out, req.substr(100, 150), resp.substr(40));
+                AppendFrame(out, req.substr(250), "");
+            }
+        }
+        ofstream(path, ios::binary | ios::trunc) << out;
+    }
+
+    void LoadRecording(const string& path) {
+        string content;
+        if (!ReadFile(path, content)) {
+            return;
+        }
+        size_t pos = 0;
+        while (pos + 2 * sizeof(uint32_t) <= content.size()) {
+            uint32_t lens[2];
+            memcpy(lens, content.data() + pos, sizeof(lens));
+            pos += sizeof(lens);
+            if (pos + lens[0] + lens[1] > content.size()) {
+                break;
+            }
+            auto* event = static_cast<conn_data_event_t*>(malloc(offsetof(conn_data_event_t, msg) + lens[0] + lens[1]));
+            memcpy(event->msg, content.data() + pos, lens[0] + lens[1]);
+            event->request_len = lens[0];
+            event->response_len = lens[1];
+            event->protocol = support_proto_e::ProtoHTTP;
+            event->role = support_role_e::IsClient;
+            event->start_ts = 1;
+            event->end_ts = 2;
+            mEvents.push_back(event);
+            pos += lens[0] + lens[1];
+        }
+    }
+
+    static bool ReadFile(const string& path, string& content) {
+        ifstream in(path, ios::binary);
+        if (!in) {
+            return false;
+        }
+        content.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+        return true;
+    }
+
+    size_t Replay(const shared_ptr<Connection>& conn, size_t rounds) {
+        HTTPProtocolParser parser;
+        auto sampler = make_shared<AlwaysSampler>();
+        size_t records = 0;
+        for (size_t r = 0; r < rounds; ++r) {
+            for (auto* event : mEvents) {
+                records += parser.Parse(event, conn, sampler).size();
+            }
+        }
+        return records;
+    }
+
+    vector<conn_data_event_t*> mEvents;
+    shared_ptr<Connection> mConn;
+};
+
+void HttpReplayBenchmark::TestReplay() {
+    size_t bytes = 0;
+    for (auto* event : mEvents) {
+        bytes += event->request_len + event->response_len;
+    }
+    const size_t rounds = 100;
+    auto start = chrono::high_resolution_clock::now();
+    size_t records = Replay(mConn, rounds);
+    chrono::duration<double> elapsed = chrono::high_resolution_clock::now() - start;
+    cout << "[replay] simd level: " << phr_simd_level() << ", events: " << mEvents.size() * rounds
+         << ", records: " << records << ", elapsed: " << elapsed.count() << " seconds, "
+         << bytes * rounds / elapsed.count() / 1024 / 1024 << " MB/s" << endl;
+    if (getenv("HTTP_REPLAY_FILES") == nullptr) {
+        // every exchange of the synthetic recording yields one record, split ones included
+        APSARA_TEST_EQUAL(records, 10000UL * rounds);
+    }
+}
+
+void HttpReplayBenchmark::TestReplayWithoutResume() {
+    // without a connection nothing can be buffered, so split exchanges are dropped as before
+    const size_t rounds = 100;
+    auto start = chrono::high_resolution_clock::now();
+    size_t records = Replay(nullptr, rounds);
+    chrono::duration<double> elapsed = chrono::high_resolution_clock::now() - start;
+    cout << "[replay][no resume] records: " << records << ", elapsed: " << elapsed.count() << " seconds" << endl;
+    if (getenv("HTTP_REPLAY_FILES") == nullptr) {
+        APSARA_TEST_EQUAL(records, 5000UL * rounds);
+    }
+}
+
+UNIT_TEST_CASE(HttpReplayBenchmark, TestReplay)
+UNIT_TEST_CASE(HttpReplayBenchmark, TestReplayWithoutResume)
+
+} // namespace logtail::ebpf
+
+UNIT_TEST_MAIN
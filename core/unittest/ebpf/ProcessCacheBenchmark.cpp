@@ -0,0 +1,128 @@
+// Copyright 2025 LoongCollector Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "ebpf/plugin/ProcessCache.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+using namespace logtail;
+
+// the single mutex map ProcessCache used to be, as a baseline
+class LockedProcessCache {
+public:
+    shared_ptr<ProcessCacheValue> Lookup(const data_event_id& key) {
+        lock_guard<mutex> lock(mMutex);
+        auto it = mCache.find(key);
+        return it == mCache.end() ? nullptr : it->second;
+    }
+    void AddCache(const data_event_id& key, shared_ptr<ProcessCacheValue>&& value) {
+        lock_guard<mutex> lock(mMutex);
+        mCache.emplace(key, std::move(value));
+    }
+    void Remove(const data_event_id& key) {
+        lock_guard<mutex> lock(mMutex);
+        mCache.erase(key);
+    }
+
+private:
+    mutex mMutex;
+    unordered_map<data_event_id, shared_ptr<ProcessCacheValue>, DataEventIdHash, DataEventIdEqual> mCache;
+};
+
+class ProcessCacheBenchmark : public ::testing::Test {
+public:
+    void TestLookupWithChurn();
+
+private:
+    static constexpr uint32_t kLongLived = 10000;
+    static constexpr uint32_t kShortLivedPerRound = 5000;
+
+    // readers attach tags of long lived processes while a writer execs and reaps short lived ones,
+    // a fork bomb as seen by the process event thread
+    template <typename Cache, typename RemoveFn>
+    void Run(const string& name, Cache& cache, RemoveFn remove) {
+        for (uint32_t pid = 1; pid <= kLongLived; ++pid) {
+            cache.AddCache({pid, 1}, make_shared<ProcessCacheValue>());
+        }
+        const size_t readerCount = max(2U, thread::hardware_concurrency());
+        atomic_bool stop = false;
+        atomic_size_t lookups = 0;
+        vector<thread> readers;
+        for (size_t i = 0; i < readerCount; ++i) {
+            readers.emplace_back([&, i]() {
+                size_t local = 0;
+                uint32_t pid = i * 7919;
+                while (!stop.load(memory_order_relaxed)) {
+                    pid = pid % kLongLived + 1;
+                    if (cache.Lookup({pid, 1}) != nullptr) {
+                        ++local;
+                    }
+                }
+                lookups += local;
+            });
+        }
+
+        size_t churn = 0;
+        uint64_t ktime = 2;
+        auto start = chrono::high_resolution_clock::now();
+        chrono::duration<double> elapsed{};
+        while (elapsed.count() < 2.0) {
+            for (uint32_t pid = kLongLived + 1; pid <= kLongLived + kShortLivedPerRound; ++pid) {
+                cache.AddCache({pid, ktime}, make_shared<ProcessCacheValue>());
+            }
+            for (uint32_t pid = kLongLived + 1; pid <= kLongLived + kShortLivedPerRound; ++pid) {
+                remove(cache, data_event_id{pid, ktime});
+            }
+            churn += kShortLivedPerRound;
+            ++ktime;
+            elapsed = chrono::high_resolution_clock::now() - start;
+        }
+        stop = true;
+        for (auto& reader : readers) {
+            reader.join();
+        }
+        cout << name << ": readers: " << readerCount << ", lookups/s: " << lookups / elapsed.count()
+             << ", exec+exit/s: " << churn / elapsed.count() << ", elapsed: " << elapsed.count() << " seconds"
+             << endl;
+    }
+};
+
+void ProcessCacheBenchmark::TestLookupWithChurn() {
+    {
+        LockedProcessCache cache;
+        Run("locked map", cache, [](LockedProcessCache& c, const data_event_id& key) { c.Remove(key); });
+    }
+    {
+        ProcessCache cache;
+        Run("sharded cache", cache, [](ProcessCache& c, const data_event_id& key) {
+            c.DecRef(key, key.time);
+            c.ClearExpiredCache(key.time + kMaxCacheExpiredTimeout);
+        });
+        APSARA_TEST_EQUAL(size_t(kLongLived), cache.Size());
+    }
+}
+
+UNIT_TEST_CASE(ProcessCacheBenchmark, TestLookupWithChurn);
+
+UNIT_TEST_MAIN
@@ -12,7 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <atomic>
 #include <memory>
+#include <thread>
+#include <vector>
 
 #include "ebpf/plugin/ProcessCache.h"
 #include "type/table/BaseElements.h"
@@ -81,6 +84,8 @@ protected:
     void TestAddCache();
     void TestRefCount();
     void TestClearExpiredCache();
+    void TestGrowAndClear();
+    void TestConcurrentLookupWithChurn();
 
 private:
     ProcessCache mProcessCache;
@@ -150,8 +155,93 @@ void ProcessCacheUnittest::TestClearExpiredCache() {
     APSARA_TEST_TRUE(cacheValue == nullptr);
 }
 
+void ProcessCacheUnittest::TestGrowAndClear() {
+    ProcessCache cache(16);
+    const uint32_t count = 10000;
+    for (uint32_t pid = 1; pid <= count; ++pid) {
+        auto cacheValue = std::make_shared<ProcessCacheValue>();
+        cacheValue->mPPid = pid;
+        cache.AddCache({pid, pid * 1000UL}, std::move(cacheValue));
+    }
+    APSARA_TEST_EQUAL(size_t(count), cache.Size());
+    for (uint32_t pid = 1; pid <= count; ++pid) {
+        auto cacheValue = cache.Lookup({pid, pid * 1000UL});
+        APSARA_TEST_TRUE_FATAL(cacheValue != nullptr);
+        APSARA_TEST_EQUAL(pid, cacheValue->mPPid);
+    }
+    APSARA_TEST_FALSE(cache.Contains({1, 1001}));
+
+    // the first value added for a key wins
+    auto duplicate = std::make_shared<ProcessCacheValue>();
+    duplicate->mPPid = 0;
+    cache.AddCache({1, 1000}, std::move(duplicate));
+    APSARA_TEST_EQUAL(1U, cache.Lookup({1, 1000})->mPPid);
+    APSARA_TEST_EQUAL(size_t(count), cache.Size());
+
+    auto held = cache.Lookup({2, 2000});
+    cache.ClearCache();
+    APSARA_TEST_EQUAL(0UL, cache.Size());
+    APSARA_TEST_TRUE(cache.Lookup({2, 2000}) == nullptr);
+    // values handed out before stay valid
+    APSARA_TEST_EQUAL(2U, held->mPPid);
+}
+
+void ProcessCacheUnittest::TestConcurrentLookupWithChurn() {
+    ProcessCache cache(64);
+    const uint32_t kStable = 1000;
+    for (uint32_t pid = 1; pid <= kStable; ++pid) {
+        auto cacheValue = std::make_shared<ProcessCacheValue>();
+        cacheValue->mPPid = pid;
+        cache.AddCache({pid, 1}, std::move(cacheValue));
+    }
+    std::atomic_bool stop = false;
+    std::atomic_size_t misses = 0;
+    std::atomic_size_t wrong = 0;
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 2; ++i) {
+        readers.emplace_back([&, i]() {
+            uint32_t pid = i;
+            while (!stop) {
+                pid = pid % kStable + 1;
+                auto cacheValue = cache.Lookup({pid, 1});
+                if (cacheValue == nullptr) {
+                    ++misses;
+                } else if (cacheValue->mPPid != pid) {
+                    ++wrong;
+                }
+                // short lived processes come and go, whatever is seen must be consistent
+                auto churned = cache.Lookup({pid + kStable, 2});
+                if (churned != nullptr && churned->mPPid != pid + kStable) {
+                    ++wrong;
+                }
+            }
+        });
+    }
+    // exec and exit of short lived processes, growing the tables and emptying them again (shards never shrink)
+    for (int round = 0; round < 5; ++round) {
+        for (uint32_t pid = kStable + 1; pid <= kStable * 20; ++pid) {
+            auto cacheValue = std::make_shared<ProcessCacheValue>();
+            cacheValue->mPPid = pid;
+            cache.AddCache({pid, 2}, std::move(cacheValue));
+        }
+        for (uint32_t pid = kStable + 1; pid <= kStable * 20; ++pid) {
+            cache.DecRef({pid, 2}, 2);
+        }
+        cache.ClearExpiredCache(2 + kMaxCacheExpiredTimeout);
+        APSARA_TEST_EQUAL(size_t(kStable), cache.Size());
+    }
+    stop = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    APSARA_TEST_EQUAL(0UL, misses.load());
+    APSARA_TEST_EQUAL(0UL, wrong.load());
+}
+
 UNIT_TEST_CASE(ProcessCacheUnittest, TestAddCache);
 UNIT_TEST_CASE(ProcessCacheUnittest, TestRefCount);
 UNIT_TEST_CASE(ProcessCacheUnittest, TestClearExpiredCache);
+UNIT_TEST_CASE(ProcessCacheUnittest, TestGrowAndClear);
+UNIT_TEST_CASE(ProcessCacheUnittest, TestConcurrentLookupWithChurn);
 
 UNIT_TEST_MAIN
@@ -17,6 +17,7 @@
 #include <iostream>
 #include <random>
 
+#include "ebpf/plugin/network_observer/Connection.h"
 #include "ebpf/protocol/ProtocolParser.h"
 #include "ebpf/protocol/http/HttpParser.h"
 #include "logger/Logger.h"
@@ -36,6 +37,9 @@ public:
     void TestParsePartialRequests();
     void TestProtocolParserManager();
     void TestHttpParserEdgeCases();
+    void TestParseHeaderViews();
+    void TestParseSplitAcrossEvents();
+    void TestParseTruncatedBody();
 
     void RequestBenchmark();
     void RequestWithoutBodyBenchmark();
@@ -249,6 +253,154 @@ void ProtocolParserUnittest::TestHttpParserEdgeCases() {
     APSARA_TEST_EQUAL(state, ParseState::kInvalid);
 }
 
+void ProtocolParserUnittest::TestParseHeaderViews() {
+    std::string input = "GET /test HTTP/1.1\r\n"
+                        "Host: example.com\r\n"
+                        "Content-Length: 4\r\n"
+                        "\r\n"
+                        "body";
+    std::shared_ptr<HttpRecord> result = std::make_shared<HttpRecord>(nullptr);
+    {
+        std::string_view buf(input);
+        APSARA_TEST_EQUAL(http::ParseRequest(buf, result, true), ParseState::kSuccess);
+    }
+    // views must not refer to the input, which is released right after parsing
+    input.assign(input.size(), 'x');
+    APSARA_TEST_EQUAL(result->GetReqHeaders().size(), 2UL);
+    const StringView* host = FindHeader(result->GetReqHeaders(), "HOST");
+    APSARA_TEST_TRUE(host != nullptr);
+    APSARA_TEST_EQUAL(*host, "example.com");
+    APSARA_TEST_EQUAL(result->GetReqBody(), "body");
+    APSARA_TEST_EQUAL(result->GetReqHeaderMap().size(), 2UL);
+    APSARA_TEST_EQUAL(result->GetReqHeaderMap().find("content-length")->second, "4");
+}
+
+conn_data_event_t* CreateDataEvent(const std::string& req, const std::string& resp, uint64_t startTs) {
+    std::string msg = req + resp;
+    conn_data_event_t* evt = (conn_data_event_t*)malloc(offsetof(conn_data_event_t, msg) + msg.size());
+    memcpy(evt->msg, msg.data(), msg.size());
+    evt->request_len = req.size();
+    evt->response_len = resp.size();
+    evt->protocol = support_proto_e::ProtoHTTP;
+    evt->role = support_role_e::IsClient;
+    evt->start_ts = startTs;
+    evt->end_ts = startTs + 1;
+    return evt;
+}
+
+void ProtocolParserUnittest::TestParseSplitAcrossEvents() {
+    const std::string req = "POST /split HTTP/1.1\r\n"
+                            "Host: example.com\r\n"
+                            "Content-Length: 10\r\n"
+                            "\r\n"
+                            "0123456789";
+    const std::string resp = "HTTP/1.1 500 Internal Server Error\r\n"
+                             "Content-Length: 5\r\n"
+                             "\r\n"
+                             "error";
+    auto conn = std::make_shared<Connection>(ConnId(1, 1000, 123456));
+    HTTPProtocolParser parser;
+
+    // request headers cut off
+    auto* evt1 = CreateDataEvent(req.substr(0, 20), "", 100);
+    APSARA_TEST_TRUE(parser.Parse(evt1, conn, nullptr).empty());
+    APSARA_TEST_TRUE(conn->GetHttpStreamState().HasPending());
+    APSARA_TEST_TRUE(conn->GetHttpStreamState().mReqHeaderPending);
+    APSARA_TEST_EQUAL(conn->GetHttpStreamState().mReqScanned, 20UL);
+    free(evt1);
+
+    // response headers cut off, the request is complete
+    auto* evt2 = CreateDataEvent(req.substr(20), resp.substr(0, 30), 200);
+    APSARA_TEST_TRUE(parser.Parse(evt2, conn, nullptr).empty());
+    APSARA_TEST_FALSE(conn->GetHttpStreamState().mReqHeaderPending);
+    APSARA_TEST_TRUE(conn->GetHttpStreamState().mRespHeaderPending);
+    APSARA_TEST_EQUAL(conn->GetHttpStreamState().mRespScanned, 30UL);
+    free(evt2);
+
+    auto* evt3 = CreateDataEvent("", resp.substr(30), 300);
+    auto records = parser.Parse(evt3, conn, nullptr);
+    free(evt3);
+    APSARA_TEST_EQUAL(records.size(), 1UL);
+    APSARA_TEST_FALSE(conn->GetHttpStreamState().HasPending());
+    auto record = std::dynamic_pointer_cast<HttpRecord>(records[0]);
+    APSARA_TEST_TRUE(record != nullptr);
+    APSARA_TEST_EQUAL(record->GetStartTimeStamp(), 100UL);
+    APSARA_TEST_EQUAL(record->GetPath(), "/split");
+    APSARA_TEST_EQUAL(record->GetStatusCode(), 500);
+    APSARA_TEST_EQUAL(record->GetReqBody(), "0123456789");
+    APSARA_TEST_EQUAL(record->GetRespBody(), "error");
+
+    // a new exchange is not appended to the pending one
+    auto* evt4 = CreateDataEvent(req.substr(0, 20), "", 400);
+    APSARA_TEST_TRUE(parser.Parse(evt4, conn, nullptr).empty());
+    APSARA_TEST_TRUE(conn->GetHttpStreamState().HasPending());
+    free(evt4);
+    auto* evt5 = CreateDataEvent(req, resp, 500);
+    records = parser.Parse(evt5, conn, nullptr);
+    free(evt5);
+    APSARA_TEST_EQUAL(records.size(), 1UL);
+    APSARA_TEST_FALSE(conn->GetHttpStreamState().HasPending());
+    APSARA_TEST_EQUAL(records[0]->GetStartTimeStamp(), 500UL);
+
+    // the pending exchange is released when the connection is closed
+    auto* evt6 = CreateDataEvent(req.substr(0, 20), "", 600);
+    APSARA_TEST_TRUE(parser.Parse(evt6, conn, nullptr).empty());
+    APSARA_TEST_TRUE(conn->GetHttpStreamState().HasPending());
+    free(evt6);
+    struct conn_ctrl_event_t closeEvent = {};
+    closeEvent.type = EventClose;
+    conn->UpdateConnState(&closeEvent);
+    APSARA_TEST_FALSE(conn->GetHttpStreamState().HasPending());
+
+    // an exchange exceeding the pending limit is dropped and the state released
+    conn = std::make_shared<Connection>(ConnId(2, 1000, 123456));
+    std::string bigHeader = std::string(kMaxHttpPendingBytes / 2 + 1, 'a');
+    auto* evt7 = CreateDataEvent("GET /huge HTTP/1.1\r\nX-Big: " + bigHeader, "", 700);
+    APSARA_TEST_TRUE(parser.Parse(evt7, conn, nullptr).empty());
+    APSARA_TEST_TRUE(conn->GetHttpStreamState().HasPending());
+    free(evt7);
+    auto* evt8 = CreateDataEvent(bigHeader, "", 800);
+    APSARA_TEST_TRUE(parser.Parse(evt8, conn, nullptr).empty());
+    APSARA_TEST_FALSE(conn->GetHttpStreamState().HasPending());
+    free(evt8);
+}
+
+void ProtocolParserUnittest::TestParseTruncatedBody() {
+    // eBPF truncates payloads, so bodies shorter than Content-Length are expected
+    const std::string req = "POST /truncated HTTP/1.1\r\n"
+                            "Content-Length: 1000\r\n"
+                            "\r\n"
+                            "0123456789";
+    const std::string resp = "HTTP/1.1 503 Service Unavailable\r\n"
+                             "Content-Length: 1000\r\n"
+                             "\r\n"
+                             "retry";
+    auto conn = std::make_shared<Connection>(ConnId(1, 1000, 123456));
+    HTTPProtocolParser parser;
+
+    auto* evt1 = CreateDataEvent(req, resp, 100);
+    auto records = parser.Parse(evt1, conn, nullptr);
+    free(evt1);
+    APSARA_TEST_EQUAL(records.size(), 1UL);
+    APSARA_TEST_FALSE(conn->GetHttpStreamState().HasPending());
+    auto record = std::dynamic_pointer_cast<HttpRecord>(records[0]);
+    APSARA_TEST_EQUAL(record->GetStartTimeStamp(), 100UL);
+    APSARA_TEST_EQUAL(record->GetPath(), "/truncated");
+    APSARA_TEST_EQUAL(record->GetStatusCode(), 503);
+    APSARA_TEST_EQUAL(record->GetRespBody(), "retry");
+    APSARA_TEST_EQUAL(record->GetRespBodySize(), 1000UL);
+
+    // the next exchange is reported on its own
+    auto* evt2 = CreateDataEvent("GET /next HTTP/1.1\r\n\r\n", "HTTP/1.1 200 OK\r\n\r\n", 200);
+    records = parser.Parse(evt2, conn, nullptr);
+    free(evt2);
+    APSARA_TEST_EQUAL(records.size(), 1UL);
+    record = std::dynamic_pointer_cast<HttpRecord>(records[0]);
+    APSARA_TEST_EQUAL(record->GetStartTimeStamp(), 200UL);
+    APSARA_TEST_EQUAL(record->GetPath(), "/next");
+    APSARA_TEST_EQUAL(record->GetStatusCode(), 200);
+}
+
 const std::string REQ
     = "GET /wp-content/uploads/2010/03/hello-kitty-darth-vader-pink.jpg HTTP/1.1\r\n"
       "Host: www.kittyhell.com\r\n"
@@ -352,6 +504,9 @@ UNIT_TEST_CASE(ProtocolParserUnittest, TestParseInvalidRequests);
 UNIT_TEST_CASE(ProtocolParserUnittest, TestParsePartialRequests);
 UNIT_TEST_CASE(ProtocolParserUnittest, TestProtocolParserManager);
 UNIT_TEST_CASE(ProtocolParserUnittest, TestHttpParserEdgeCases);
+UNIT_TEST_CASE(ProtocolParserUnittest, TestParseHeaderViews);
+UNIT_TEST_CASE(ProtocolParserUnittest, TestParseSplitAcrossEvents);
+UNIT_TEST_CASE(ProtocolParserUnittest, TestParseTruncatedBody);
 UNIT_TEST_CASE(ProtocolParserUnittest, RequestBenchmark);
 UNIT_TEST_CASE(ProtocolParserUnittest, RequestWithoutBodyBenchmark);
 UNIT_TEST_CASE(ProtocolParserUnittest, ResponseBenchmark);
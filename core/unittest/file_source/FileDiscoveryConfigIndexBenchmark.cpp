@@ -0,0 +1,125 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "json/json.h"
+
+#include "collection_pipeline/CollectionPipelineContext.h"
+#include "file_server/FileDiscoveryConfigIndex.h"
+#include "file_server/FileDiscoveryOptions.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class FileDiscoveryConfigIndexBenchmark : public ::testing::Test {
+public:
+    void TestMatch();
+
+protected:
+    void SetUp() override {
+        // one config per tenant, a tenth of them with a wildcard segment
+        for (size_t i = 0; i < kConfigCount; ++i) {
+            Json::Value configJson;
+            string tenant = "/data/tenant" + to_string(i);
+            configJson["FilePaths"].append(
+                Json::Value(i % 10 == 0 ? tenant + "/*/logs/**/*.log" : tenant + "/logs/**/*.log"));
+            configJson["MaxDirSearchDepth"] = Json::Value(2);
+            configJson["ExcludeFiles"].append(Json::Value("*.tmp.log"));
+            auto opts = make_unique<FileDiscoveryOptions>();
+            APSARA_TEST_TRUE_FATAL(opts->Init(configJson, mCtx, "test"));
+            mConfigs["config" + to_string(i)] = make_pair(opts.get(), &mCtx);
+            mOptions.push_back(std::move(opts));
+        }
+        for (size_t i = 0; i < kPathCount; ++i) {
+            size_t tenant = i * 7919 % kConfigCount;
+            string dir = "/data/tenant" + to_string(tenant) + (tenant % 10 == 0 ? "/app/logs" : "/logs");
+            mPaths.push_back(i % 3 == 0 ? dir : dir + "/sub" + to_string(i % 5));
+        }
+    }
+
+private:
+    static constexpr size_t kConfigCount = 10000;
+    static constexpr size_t kPathCount = 100000;
+    // a full scan over all paths would take minutes, so it is timed on a sample
+    static constexpr size_t kLinearSampleCount = 1000;
+
+    CollectionPipelineContext mCtx;
+    vector<unique_ptr<FileDiscoveryOptions>> mOptions;
+    unordered_map<string, FileDiscoveryConfig> mConfigs;
+    vector<string> mPaths;
+};
+
+void FileDiscoveryConfigIndexBenchmark::TestMatch() {
+    const string name = "access.log";
+    vector<size_t> linearMatches;
+    auto start = chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < kLinearSampleCount; ++i) {
+        size_t cnt = 0;
+        for (const auto& item : mConfigs) {
+            if (item.second.first->IsMatch(mPaths[i], name)) {
+                ++cnt;
+            }
+        }
+        linearMatches.push_back(cnt);
+    }
+    chrono::duration<double> linearElapsed = chrono::high_resolution_clock::now() - start;
+
+    start = chrono::high_resolution_clock::now();
+    FileDiscoveryConfigIndex index(mConfigs);
+    chrono::duration<double> buildElapsed = chrono::high_resolution_clock::now() - start;
+
+    vector<FileDiscoveryConfig> candidates;
+    size_t total = 0;
+    start = chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < kPathCount; ++i) {
+        candidates.clear();
+        index.GetCandidates(mPaths[i], candidates);
+        size_t cnt = 0;
+        for (const auto& candidate : candidates) {
+            if (candidate.first->IsMatch(mPaths[i], name)) {
+                ++cnt;
+            }
+        }
+        if (i < kLinearSampleCount) {
+            APSARA_TEST_EQUAL(linearMatches[i], cnt);
+        }
+        total += cnt;
+    }
+    chrono::duration<double> indexElapsed = chrono::high_resolution_clock::now() - start;
+    APSARA_TEST_EQUAL(kPathCount, total);
+
+    double linearPerPath = linearElapsed.count() / kLinearSampleCount * 1e6;
+    double indexPerPath = indexElapsed.count() / kPathCount * 1e6;
+    cout << "configs: " << kConfigCount << ", paths: " << kPathCount << endl;
+    cout << "full scan: " << linearPerPath << " us per path, estimated total: " << linearPerPath * kPathCount / 1e6
+         << " seconds" << endl;
+    cout << "index: build " << buildElapsed.count() * 1000 << " ms, " << indexPerPath
+         << " us per path, total: " << indexElapsed.count() << " seconds, speedup: " << linearPerPath / indexPerPath
+         << endl;
+}
+
+UNIT_TEST_CASE(FileDiscoveryConfigIndexBenchmark, TestMatch)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,205 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "json/json.h"
+
+#include "collection_pipeline/CollectionPipelineContext.h"
+#include "file_server/ConfigManager.h"
+#include "file_server/FileDiscoveryConfigIndex.h"
+#include "file_server/FileDiscoveryOptions.h"
+#include "file_server/FileServer.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class FileDiscoveryConfigIndexUnittest : public testing::Test {
+public:
+    void TestSameMatchesAsFullScan();
+    void TestCandidatesPruned();
+    void TestRebuildOnChange();
+
+protected:
+    void SetUp() override {
+        AddConfig("normal", "/var/log/app/*.log", 2);
+        AddConfig("shallow", "/var/log/*.log", 0);
+        AddConfig("wildcard", "/var/*/nginx/*.log", 0);
+        AddConfig("recursive", "/home/admin/**/*.log", 0);
+        AddConfig("bracket", "/data/[ab]c/*/*.log", 0);
+        AddConfig("blacklist", "/var/log/app/*.log", -1, "/var/log/app/tmp");
+        auto* container = AddConfig("container", "/app/logs/*.log", 1);
+        container->SetEnableContainerDiscoveryFlag(true);
+        auto infos = make_shared<vector<ContainerInfo>>(2);
+        (*infos)[0].mRealBaseDir = "/host/c1/app/logs";
+        (*infos)[1].mRealBaseDir = "/host/c2/app/logs";
+        container->SetContainerInfo(infos);
+        auto* noContainer = AddConfig("no_container", "/app/logs/*.log", 1);
+        noContainer->SetEnableContainerDiscoveryFlag(true);
+        noContainer->SetContainerInfo(make_shared<vector<ContainerInfo>>());
+    }
+
+    void TearDown() override {
+        for (const auto& item : mConfigs) {
+            FileServer::GetInstance()->RemoveFileDiscoveryConfig(item.first);
+        }
+    }
+
+    FileDiscoveryOptions*
+    AddConfig(const string& name, const string& filePath, int maxDepth, const string& excludeDir = "") {
+        Json::Value configJson;
+        configJson["FilePaths"].append(Json::Value(filePath));
+        configJson["MaxDirSearchDepth"] = Json::Value(maxDepth);
+        if (!excludeDir.empty()) {
+            configJson["ExcludeDirs"].append(Json::Value(excludeDir));
+        }
+        auto opts = make_unique<FileDiscoveryOptions>();
+        APSARA_TEST_TRUE(opts->Init(configJson, mCtx, "test"));
+        auto* res = opts.get();
+        mOptions.push_back(std::move(opts));
+        mConfigs[name] = make_pair(res, &mCtx);
+        return res;
+    }
+
+    vector<FileDiscoveryConfig> FullScan(const string& path, const string& name) const {
+        vector<FileDiscoveryConfig> res;
+        for (const auto& item : mConfigs) {
+            if (item.second.first->IsMatch(path, name)) {
+                res.push_back(item.second);
+            }
+        }
+        return res;
+    }
+
+    vector<FileDiscoveryConfig>
+    IndexScan(const FileDiscoveryConfigIndex& index, const string& path, const string& name) const {
+        vector<FileDiscoveryConfig> candidates;
+        index.GetCandidates(path, candidates);
+        vector<FileDiscoveryConfig> res;
+        for (const auto& candidate : candidates) {
+            if (candidate.first->IsMatch(path, name)) {
+                res.push_back(candidate);
+            }
+        }
+        return res;
+    }
+
+    CollectionPipelineContext mCtx;
+    vector<unique_ptr<FileDiscoveryOptions>> mOptions;
+    unordered_map<string, FileDiscoveryConfig> mConfigs;
+};
+
+void FileDiscoveryConfigIndexUnittest::TestSameMatchesAsFullScan() {
+    FileDiscoveryConfigIndex index(mConfigs);
+    APSARA_TEST_EQUAL(mConfigs.size(), index.Size());
+    const vector<string> paths = {"/",
+                                  "/var",
+                                  "/var/log",
+                                  "/var/log/app",
+                                  "/var/log/app/a",
+                                  "/var/log/app/a/b",
+                                  "/var/log/app/a/b/c",
+                                  "/var/log/app/tmp",
+                                  "/var/log/application",
+                                  "/var/www/nginx",
+                                  "/var/www/nginx/sub",
+                                  "/var//log/app",
+                                  "/home/admin",
+                                  "/home/admin/x/y/z",
+                                  "/data/ac/x",
+                                  "/data/cc/x",
+                                  "/app/logs",
+                                  "/host/c1/app/logs",
+                                  "/host/c1/app/logs/sub",
+                                  "/host/c1/app/logs/sub/sub",
+                                  "/host/c3/app/logs",
+                                  "/other"};
+    for (const auto& path : paths) {
+        for (const char* name : {"", "a.log", "a.txt"}) {
+            APSARA_TEST_TRUE_DESC(FullScan(path, name) == IndexScan(index, path, name), path + "/" + name);
+        }
+    }
+}
+
+void FileDiscoveryConfigIndexUnittest::TestCandidatesPruned() {
+    FileDiscoveryConfigIndex index(mConfigs);
+    vector<FileDiscoveryConfig> candidates;
+    index.GetCandidates("/other/dir", candidates);
+    APSARA_TEST_TRUE(candidates.empty());
+
+    // wildcard config is registered under /var, the rest under /var/log and below
+    index.GetCandidates("/var/log/app/a", candidates);
+    APSARA_TEST_EQUAL(4U, candidates.size());
+    candidates.clear();
+    index.GetCandidates("/var/www", candidates);
+    APSARA_TEST_EQUAL(1U, candidates.size());
+    APSARA_TEST_TRUE(mConfigs["wildcard"] == candidates[0]);
+    candidates.clear();
+
+    // literal prefix stops before the bracket expression
+    index.GetCandidates("/data/bc", candidates);
+    APSARA_TEST_EQUAL(1U, candidates.size());
+    APSARA_TEST_TRUE(mConfigs["bracket"] == candidates[0]);
+    candidates.clear();
+
+    // container configs are registered under the real base dir of each container
+    index.GetCandidates("/app/logs", candidates);
+    APSARA_TEST_TRUE(candidates.empty());
+    index.GetCandidates("/host/c2/app/logs/sub", candidates);
+    APSARA_TEST_EQUAL(1U, candidates.size());
+    APSARA_TEST_TRUE(mConfigs["container"] == candidates[0]);
+}
+
+void FileDiscoveryConfigIndexUnittest::TestRebuildOnChange() {
+    auto* configManager = ConfigManager::GetInstance();
+    vector<FileDiscoveryConfig> related;
+    configManager->GetRelatedConfigs("/var/log/app", related);
+    APSARA_TEST_TRUE(related.empty());
+
+    for (const auto& item : mConfigs) {
+        FileServer::GetInstance()->AddFileDiscoveryConfig(item.first, item.second.first, item.second.second);
+    }
+    configManager->GetRelatedConfigs("/var/log/app", related);
+    APSARA_TEST_TRUE(FullScan("/var/log/app", "") == related);
+    related.clear();
+
+    FileServer::GetInstance()->RemoveFileDiscoveryConfig("blacklist");
+    configManager->GetRelatedConfigs("/var/log/app", related);
+    APSARA_TEST_EQUAL(1U, related.size());
+    APSARA_TEST_TRUE(mConfigs["normal"] == related[0]);
+    related.clear();
+
+    configManager->GetRelatedConfigs("/host/c3/app/logs", related);
+    APSARA_TEST_TRUE(related.empty());
+    auto infos = make_shared<vector<ContainerInfo>>(1);
+    (*infos)[0].mRealBaseDir = "/host/c3/app/logs";
+    mConfigs["no_container"].first->SetContainerInfo(infos);
+    configManager->GetRelatedConfigs("/host/c3/app/logs", related);
+    APSARA_TEST_EQUAL(1U, related.size());
+    APSARA_TEST_TRUE(mConfigs["no_container"] == related[0]);
+}
+
+UNIT_TEST_CASE(FileDiscoveryConfigIndexUnittest, TestSameMatchesAsFullScan)
+UNIT_TEST_CASE(FileDiscoveryConfigIndexUnittest, TestCandidatesPruned)
+UNIT_TEST_CASE(FileDiscoveryConfigIndexUnittest, TestRebuildOnChange)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
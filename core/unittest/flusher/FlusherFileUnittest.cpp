@@ -0,0 +1,259 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "json/json.h"
+
+#include "collection_pipeline/CollectionPipeline.h"
+#include "collection_pipeline/CollectionPipelineContext.h"
+#include "collection_pipeline/queue/QueueKeyManager.h"
+#include "collection_pipeline/queue/SenderQueueManager.h"
+#include "common/JsonUtil.h"
+#include "plugin/flusher/file/FlusherFile.h"
+#include "runner/sink/file/FileSink.h"
+#include "runner/sink/file/RotatingFileWriter.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class FlusherFileUnittest : public testing::Test {
+public:
+    void TestWriterBuffer();
+    void TestWriterRotateBySize();
+    void TestWriterWriteFailure();
+    void TestWriterRotatedFilePath();
+    void OnSuccessfulInit();
+    void TestSendAndWrite();
+
+protected:
+    void SetUp() override {
+        filesystem::remove_all(mDir);
+        ctx.SetConfigName("test_config");
+        ctx.SetPipeline(pipeline);
+    }
+
+    void TearDown() override {
+        QueueKeyManager::GetInstance()->Clear();
+        SenderQueueManager::GetInstance()->Clear();
+        filesystem::remove_all(mDir);
+    }
+
+private:
+    static string ReadFile(const filesystem::path& path) {
+        ifstream fin(path, ios::binary);
+        stringstream ss;
+        ss << fin.rdbuf();
+        return ss.str();
+    }
+
+    const filesystem::path mDir = "./flusher_file_test";
+    CollectionPipeline pipeline;
+    CollectionPipelineContext ctx;
+};
+
+void FlusherFileUnittest::TestWriterBuffer() {
+    const auto filePath = mDir / "sub" / "a.log";
+    RotatingFileWriter writer(filePath.string(), 1024, 2, 0, 10);
+    // parent dirs are created on first write, and small data stays in buffer
+    APSARA_TEST_TRUE(writer.Write("abc\n"));
+    APSARA_TEST_TRUE(filesystem::exists(filePath));
+    APSARA_TEST_EQUAL("", ReadFile(filePath));
+    APSARA_TEST_TRUE(writer.Write("def\n"));
+    APSARA_TEST_EQUAL("", ReadFile(filePath));
+    // buffer full
+    APSARA_TEST_TRUE(writer.Write("ghi\n"));
+    APSARA_TEST_EQUAL("abc\ndef\n", ReadFile(filePath));
+    // data larger than buffer is written directly
+    APSARA_TEST_TRUE(writer.Write("0123456789\n"));
+    APSARA_TEST_EQUAL("abc\ndef\nghi\n0123456789\n", ReadFile(filePath));
+    APSARA_TEST_TRUE(writer.Write("jkl\n"));
+    APSARA_TEST_TRUE(writer.Flush());
+    APSARA_TEST_EQUAL("abc\ndef\nghi\n0123456789\njkl\n", ReadFile(filePath));
+}
+
+void FlusherFileUnittest::TestWriterRotateBySize() {
+    const auto filePath = mDir / "a.log";
+    {
+        RotatingFileWriter writer(filePath.string(), 10, 2, 0, 1024);
+        APSARA_TEST_TRUE(writer.Write("1234\n"));
+        APSARA_TEST_TRUE(writer.Write("5678\n"));
+        // an item is never split, so the file is rotated before it
+        APSARA_TEST_TRUE(writer.Write("abcd\n"));
+        APSARA_TEST_EQUAL("1234\n5678\n", ReadFile(mDir / "a.1.log"));
+        // an item larger than max file size takes a file on its own
+        APSARA_TEST_TRUE(writer.Write("0123456789abcdef\n"));
+        APSARA_TEST_TRUE(writer.Write("efgh\n"));
+        APSARA_TEST_TRUE(writer.Flush());
+        APSARA_TEST_EQUAL("efgh\n", ReadFile(filePath));
+        APSARA_TEST_EQUAL("0123456789abcdef\n", ReadFile(mDir / "a.1.log"));
+        APSARA_TEST_EQUAL("abcd\n", ReadFile(mDir / "a.2.log"));
+        APSARA_TEST_FALSE(filesystem::exists(mDir / "a.3.log"));
+    }
+    {
+        // existing file is appended
+        RotatingFileWriter writer(filePath.string(), 10, 2, 0, 1024);
+        APSARA_TEST_TRUE(writer.Write("ijk\n"));
+        APSARA_TEST_TRUE(writer.Flush());
+        APSARA_TEST_EQUAL("efgh\nijk\n", ReadFile(filePath));
+    }
+}
+
+void FlusherFileUnittest::TestWriterWriteFailure() {
+    const auto filePath = mDir / "a.log";
+    RotatingFileWriter writer(filePath.string(), 10, 2, 0, 1024);
+    APSARA_TEST_TRUE(writer.Write("1234\n"));
+    // make writing fail
+    fclose(writer.mFile);
+    writer.mFile = fopen(filePath.string().c_str(), "rb");
+    setvbuf(writer.mFile, nullptr, _IONBF, 0);
+    APSARA_TEST_FALSE(writer.Flush());
+    APSARA_TEST_EQUAL(0U, writer.mFileSize);
+
+    // data failed to write does not count for rotation
+    fclose(writer.mFile);
+    writer.mFile = fopen(filePath.string().c_str(), "ab");
+    setvbuf(writer.mFile, nullptr, _IONBF, 0);
+    APSARA_TEST_TRUE(writer.Write("abcd\n"));
+    APSARA_TEST_TRUE(writer.Write("efgh\n"));
+    APSARA_TEST_TRUE(writer.Flush());
+    APSARA_TEST_EQUAL(10U, writer.mFileSize);
+    APSARA_TEST_EQUAL("abcd\nefgh\n", ReadFile(filePath));
+    APSARA_TEST_FALSE(filesystem::exists(mDir / "a.1.log"));
+}
+
+void FlusherFileUnittest::TestWriterRotatedFilePath() {
+    APSARA_TEST_EQUAL("a.1.log", RotatingFileWriter("a.log", 0, 1).GetRotatedFilePath(1));
+    APSARA_TEST_EQUAL("dir/a.json.2.zst", RotatingFileWriter("dir/a.json.zst", 0, 1).GetRotatedFilePath(2));
+    APSARA_TEST_EQUAL("dir/a.1", RotatingFileWriter("dir/a", 0, 1).GetRotatedFilePath(1));
+    APSARA_TEST_EQUAL("dir/.a.1", RotatingFileWriter("dir/.a", 0, 1).GetRotatedFilePath(1));
+    APSARA_TEST_EQUAL("dir.d/a.1", RotatingFileWriter("dir.d/a", 0, 1).GetRotatedFilePath(1));
+}
+
+void FlusherFileUnittest::OnSuccessfulInit() {
+    unique_ptr<FlusherFile> flusher;
+    Json::Value configJson, optionalGoPipeline;
+    string configStr, errorMsg;
+
+    // only mandatory param
+    configStr = R"(
+        {
+            "Type": "flusher_file",
+            "FilePath": "./flusher_file_test/a.log"
+        }
+    )";
+    APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+    flusher.reset(new FlusherFile());
+    flusher->SetContext(ctx);
+    flusher->SetMetricsRecordRef(FlusherFile::sName, "1");
+    APSARA_TEST_TRUE(flusher->Init(configJson, optionalGoPipeline));
+    APSARA_TEST_EQUAL(SinkType::FILE, flusher->GetSinkType());
+    APSARA_TEST_EQUAL(10 * 1024 * 1024U, flusher->mMaxFileSize);
+    APSARA_TEST_EQUAL(10U, flusher->mMaxFiles);
+    APSARA_TEST_EQUAL(0U, flusher->mRotateInterval);
+    APSARA_TEST_EQUAL(nullptr, flusher->mCompressor);
+    APSARA_TEST_NOT_EQUAL(nullptr, flusher->GetFileWriter());
+    APSARA_TEST_NOT_EQUAL(nullptr, SenderQueueManager::GetInstance()->GetQueue(flusher->GetQueueKey()));
+
+    // valid optional param
+    configStr = R"(
+        {
+            "Type": "flusher_file",
+            "FilePath": "./flusher_file_test/a.log",
+            "MaxFileSize": 1024,
+            "MaxFiles": 3,
+            "RotateInterval": 3600,
+            "CompressType": "zstd"
+        }
+    )";
+    APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+    flusher.reset(new FlusherFile());
+    flusher->SetContext(ctx);
+    flusher->SetMetricsRecordRef(FlusherFile::sName, "1");
+    APSARA_TEST_TRUE(flusher->Init(configJson, optionalGoPipeline));
+    APSARA_TEST_EQUAL(1024U, flusher->mMaxFileSize);
+    APSARA_TEST_EQUAL(3U, flusher->mMaxFiles);
+    APSARA_TEST_EQUAL(3600U, flusher->mRotateInterval);
+    APSARA_TEST_EQUAL(CompressType::ZSTD, flusher->mCompressor->GetCompressType());
+
+    // lz4 blocks cannot be concatenated in a file
+    configJson["CompressType"] = "lz4";
+    flusher.reset(new FlusherFile());
+    flusher->SetContext(ctx);
+    flusher->SetMetricsRecordRef(FlusherFile::sName, "1");
+    APSARA_TEST_TRUE(flusher->Init(configJson, optionalGoPipeline));
+    APSARA_TEST_EQUAL(nullptr, flusher->mCompressor);
+
+    // missing FilePath
+    configJson.removeMember("FilePath");
+    flusher.reset(new FlusherFile());
+    flusher->SetContext(ctx);
+    flusher->SetMetricsRecordRef(FlusherFile::sName, "1");
+    APSARA_TEST_FALSE(flusher->Init(configJson, optionalGoPipeline));
+}
+
+void FlusherFileUnittest::TestSendAndWrite() {
+    Json::Value configJson, optionalGoPipeline;
+    string errorMsg;
+    APSARA_TEST_TRUE(ParseJsonTable(R"({"Type": "flusher_file", "FilePath": "./flusher_file_test/a.log"})",
+                                    configJson,
+                                    errorMsg));
+    FlusherFile flusher;
+    flusher.SetContext(ctx);
+    flusher.SetMetricsRecordRef(FlusherFile::sName, "1");
+    APSARA_TEST_TRUE(flusher.Init(configJson, optionalGoPipeline));
+
+    for (int i = 0; i < 2; ++i) {
+        PipelineEventGroup group(make_shared<SourceBuffer>());
+        auto e = group.AddLogEvent();
+        e->SetTimestamp(1234567890 + i);
+        e->SetContent(string("key"), string("value") + to_string(i));
+        APSARA_TEST_TRUE(flusher.Send(std::move(group)));
+    }
+    // data is batched instead of being pushed to queue group by group
+    vector<SenderQueueItem*> items;
+    SenderQueueManager::GetInstance()->GetAvailableItems(items, 80);
+    APSARA_TEST_TRUE(items.empty());
+
+    APSARA_TEST_TRUE(flusher.FlushAll());
+    SenderQueueManager::GetInstance()->GetAvailableItems(items, 80);
+    APSARA_TEST_EQUAL(1U, items.size());
+    const string expected
+        = "{\"__time__\":1234567890,\"key\":\"value0\"}\n{\"__time__\":1234567891,\"key\":\"value1\"}\n";
+    APSARA_TEST_EQUAL(expected, items[0]->mData);
+
+    // the sink removes the item once it is buffered, and only flushes the buffer later
+    FileSink::GetInstance()->Write(make_unique<FileSinkRequest>(items[0], flusher.GetFileWriter()));
+    APSARA_TEST_TRUE(SenderQueueManager::GetInstance()->IsAllQueueEmpty());
+    APSARA_TEST_EQUAL("", ReadFile(mDir / "a.log"));
+    FileSink::GetInstance()->FlushWriters();
+    APSARA_TEST_EQUAL(expected, ReadFile(mDir / "a.log"));
+}
+
+UNIT_TEST_CASE(FlusherFileUnittest, TestWriterBuffer)
+UNIT_TEST_CASE(FlusherFileUnittest, TestWriterRotateBySize)
+UNIT_TEST_CASE(FlusherFileUnittest, TestWriterWriteFailure)
+UNIT_TEST_CASE(FlusherFileUnittest, TestWriterRotatedFilePath)
+UNIT_TEST_CASE(FlusherFileUnittest, OnSuccessfulInit)
+UNIT_TEST_CASE(FlusherFileUnittest, TestSendAndWrite)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
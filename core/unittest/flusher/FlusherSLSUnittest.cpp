@@ -888,6 +888,13 @@ void FlusherSLSUnittest::TestBuildRequest() {
 #else
         APSARA_TEST_EQUAL("test_project.test_endpoint", item.mCurrentHost);
 #endif
+
+        // retry reuses the md5 of the body calculated on the first sending
+        APSARA_TEST_EQUAL(CalcMD5(body), item.GetContentMd5());
+        auto md5 = req->mHeader[CONTENT_MD5];
+        APSARA_TEST_TRUE(flusher.BuildRequest(&item, req, &keepItem, &errMsg));
+        APSARA_TEST_EQUAL(md5, req->mHeader[CONTENT_MD5]);
+        APSARA_TEST_FALSE(req->mHeader[AUTHORIZATION].empty());
     }
     // arms_traces telemetry type
     {
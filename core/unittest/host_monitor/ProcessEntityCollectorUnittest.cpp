@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "host_monitor/Constants.h"
+#include "host_monitor/ProcfsSnapshot.h"
 #include "host_monitor/collector/ProcessEntityCollector.h"
 #include "unittest/Unittest.h"
 
@@ -43,11 +44,13 @@ protected:
 
 void ProcessEntityCollectorUnittest::TestGetNewProcessStat() const {
     PROCESS_DIR = ".";
-    auto collector = ProcessEntityCollector();
-    auto ptr = collector.ReadNewProcessStat(1);
-    APSARA_TEST_NOT_EQUAL(nullptr, ptr);
-    APSARA_TEST_EQUAL(1, ptr->stat.pid);
-    APSARA_TEST_EQUAL("cat", ptr->stat.name);
+    auto snapshot = ProcfsSnapshot::GetInstance()->GetProcessStats();
+    APSARA_TEST_NOT_EQUAL_FATAL(nullptr, snapshot);
+    auto it = find_if(snapshot->mProcesses.begin(), snapshot->mProcesses.end(), [](const ProcessStat& stat) {
+        return stat.pid == 1;
+    });
+    APSARA_TEST_TRUE_FATAL(it != snapshot->mProcesses.end());
+    APSARA_TEST_EQUAL("cat", it->name);
 }
 
 void ProcessEntityCollectorUnittest::TestSortProcessByCpu() const {
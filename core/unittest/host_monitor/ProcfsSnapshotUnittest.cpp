@@ -0,0 +1,201 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "boost/filesystem/operations.hpp"
+
+#include "common/Flags.h"
+#include "host_monitor/Constants.h"
+#include "host_monitor/ProcfsSnapshot.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT32(procfs_snapshot_ttl_ms);
+DECLARE_FLAG_INT32(procfs_snapshot_max_cached_fds);
+DECLARE_FLAG_INT32(process_collect_silent_count);
+
+using namespace std;
+
+namespace logtail {
+
+class ProcfsSnapshotUnittest : public testing::Test {
+public:
+    void TestParseSystemStat() const;
+    void TestProcessStatsSharedWithinTick() const;
+    void TestVanishedProcessClosed() const;
+    void TestMaxCachedFds() const;
+    void TestSystemStatNotBlockedByScan() const;
+    void TestScanPerformance() const;
+
+protected:
+    void SetUp() override {
+        bfs::remove_all(mRoot);
+        for (int pid = 1; pid <= 3; ++pid) {
+            WriteProcessStat(pid, "proc" + to_string(pid));
+        }
+        ofstream(mRoot + "/stat", ios::trunc) << "cpu  10 20 30 40\ncpu0 10 20 30 40\nbtime 1731142542\n";
+        PROCESS_DIR = mRoot;
+        INT32_FLAG(procfs_snapshot_ttl_ms) = 60 * 1000;
+        INT32_FLAG(procfs_snapshot_max_cached_fds) = 4096;
+        ProcfsSnapshot::GetInstance()->CloseAll();
+    }
+
+    void TearDown() override {
+        ProcfsSnapshot::GetInstance()->CloseAll();
+        bfs::remove_all(mRoot);
+        PROCESS_DIR = "/proc";
+        INT32_FLAG(procfs_snapshot_ttl_ms) = 500;
+    }
+
+    void WriteProcessStat(int pid, const string& name) const {
+        bfs::create_directories(mRoot + "/" + to_string(pid));
+        ofstream(mRoot + "/" + to_string(pid) + "/stat", ios::trunc)
+            << pid << " (" << name << ") S 1 1 1 0 -1 4194560 100 0 2 0 " << pid * 10 << " " << pid * 20
+            << " 0 0 20 0 1 0 18938584 4505600 171 18446744073709551615 4194304 4238788 140727020025920 0 0 0 0 0 0 0 "
+               "0 0 17 3 0 0 0 0 0\n";
+    }
+
+private:
+    const string mRoot = "./procfs_snapshot";
+};
+
+void ProcfsSnapshotUnittest::TestParseSystemStat() const {
+    const string content = "cpu  1195061569 1728645 418424132 203670447952 14723544 0 773400 0 0 0\n"
+                           "cpu0 14708487 14216 4613031 2108180843 57199 0 424744 0 1 2\n"
+                           "cpua a b c d e f 424744 0 1 2\n"
+                           "cpu1 14708487 14216 4613031 2108180843\n"
+                           "intr 1 2 3 4 5\n"
+                           "btime 1731142542\n"
+                           "processes 1000";
+    SystemStatSnapshot snapshot;
+    APSARA_TEST_TRUE(ProcfsSnapshot::ParseSystemStat(content.data(), content.size(), snapshot));
+    APSARA_TEST_EQUAL_FATAL(3UL, snapshot.mCPUs.size());
+    APSARA_TEST_EQUAL(-1, snapshot.mCPUs[0].index);
+    APSARA_TEST_EQUAL(203670447952, snapshot.mCPUs[0].idle);
+    APSARA_TEST_EQUAL(0, snapshot.mCPUs[1].index);
+    APSARA_TEST_EQUAL(2, snapshot.mCPUs[1].guestNice);
+    APSARA_TEST_EQUAL(1, snapshot.mCPUs[2].index);
+    APSARA_TEST_EQUAL(2108180843, snapshot.mCPUs[2].idle);
+    APSARA_TEST_EQUAL(0, snapshot.mCPUs[2].iowait);
+    APSARA_TEST_EQUAL(1731142542, snapshot.mBootTime);
+}
+
+void ProcfsSnapshotUnittest::TestProcessStatsSharedWithinTick() const {
+    auto* procfs = ProcfsSnapshot::GetInstance();
+    auto snapshot1 = procfs->GetProcessStats();
+    APSARA_TEST_NOT_EQUAL_FATAL(nullptr, snapshot1);
+    APSARA_TEST_EQUAL(3UL, snapshot1->mProcesses.size());
+    APSARA_TEST_EQUAL(3UL, procfs->mProcessStatFds.size());
+    // another collector in the same tick gets the same snapshot without touching procfs
+    auto snapshot2 = procfs->GetProcessStats();
+    APSARA_TEST_EQUAL(snapshot1.get(), snapshot2.get());
+
+    shared_ptr<const SystemStatSnapshot> system1;
+    shared_ptr<const SystemStatSnapshot> system2;
+    string errorMessage;
+    APSARA_TEST_TRUE(procfs->GetSystemStat(system1, errorMessage));
+    APSARA_TEST_TRUE(procfs->GetSystemStat(system2, errorMessage));
+    APSARA_TEST_EQUAL(system1.get(), system2.get());
+    APSARA_TEST_EQUAL(2UL, system1->mCPUs.size());
+    APSARA_TEST_EQUAL(1731142542, system1->mBootTime);
+
+    // next tick, the previous snapshot stays valid for its holders
+    INT32_FLAG(procfs_snapshot_ttl_ms) = 0;
+    WriteProcessStat(4, "proc4");
+    auto snapshot3 = procfs->GetProcessStats();
+    APSARA_TEST_NOT_EQUAL(snapshot1.get(), snapshot3.get());
+    APSARA_TEST_EQUAL(4UL, snapshot3->mProcesses.size());
+    APSARA_TEST_EQUAL(3UL, snapshot1->mProcesses.size());
+}
+
+void ProcfsSnapshotUnittest::TestVanishedProcessClosed() const {
+    auto* procfs = ProcfsSnapshot::GetInstance();
+    INT32_FLAG(procfs_snapshot_ttl_ms) = 0;
+    APSARA_TEST_EQUAL(3UL, procfs->GetProcessStats()->mProcesses.size());
+    bfs::remove_all(mRoot + "/2");
+    auto snapshot = procfs->GetProcessStats();
+    APSARA_TEST_EQUAL(2UL, snapshot->mProcesses.size());
+    APSARA_TEST_EQUAL(2UL, procfs->mProcessStatFds.size());
+    APSARA_TEST_TRUE(procfs->mProcessStatFds.find(2) == procfs->mProcessStatFds.end());
+    for (const auto& stat : snapshot->mProcesses) {
+        APSARA_TEST_NOT_EQUAL(2, stat.pid);
+        APSARA_TEST_EQUAL("proc" + to_string(stat.pid), stat.name);
+    }
+
+    // cached fds see content rewritten in place
+    WriteProcessStat(1, "renamed");
+    snapshot = procfs->GetProcessStats();
+    APSARA_TEST_EQUAL(2UL, snapshot->mProcesses.size());
+    for (const auto& stat : snapshot->mProcesses) {
+        APSARA_TEST_EQUAL(stat.pid == 1 ? "renamed" : "proc" + to_string(stat.pid), stat.name);
+    }
+}
+
+void ProcfsSnapshotUnittest::TestMaxCachedFds() const {
+    auto* procfs = ProcfsSnapshot::GetInstance();
+    INT32_FLAG(procfs_snapshot_max_cached_fds) = 1;
+    auto snapshot = procfs->GetProcessStats();
+    APSARA_TEST_EQUAL(3UL, snapshot->mProcesses.size());
+    APSARA_TEST_EQUAL(1UL, procfs->mProcessStatFds.size());
+}
+
+void ProcfsSnapshotUnittest::TestSystemStatNotBlockedByScan() const {
+    auto* procfs = ProcfsSnapshot::GetInstance();
+    // sleep after each process, so that the scan takes about 300ms
+    INT32_FLAG(process_collect_silent_count) = 0;
+    auto scan = async(launch::async, [procfs]() { return procfs->GetProcessStats(); });
+    this_thread::sleep_for(chrono::milliseconds(50));
+
+    auto start = chrono::steady_clock::now();
+    shared_ptr<const SystemStatSnapshot> systemStat;
+    string errorMessage;
+    APSARA_TEST_TRUE(procfs->GetSystemStat(systemStat, errorMessage));
+    APSARA_TEST_TRUE(chrono::steady_clock::now() - start < chrono::milliseconds(100));
+    APSARA_TEST_EQUAL(1731142542, systemStat->mBootTime);
+
+    APSARA_TEST_EQUAL(3UL, scan.get()->mProcesses.size());
+    INT32_FLAG(process_collect_silent_count) = 1000;
+}
+
+void ProcfsSnapshotUnittest::TestScanPerformance() const {
+    PROCESS_DIR = "/proc";
+    INT32_FLAG(procfs_snapshot_ttl_ms) = 0;
+    auto* procfs = ProcfsSnapshot::GetInstance();
+    procfs->GetProcessStats();
+    const int rounds = 100;
+    size_t processes = 0;
+    auto start = chrono::high_resolution_clock::now();
+    for (int i = 0; i < rounds; ++i) {
+        processes = procfs->GetProcessStats()->mProcesses.size();
+    }
+    chrono::duration<double> elapsed = chrono::high_resolution_clock::now() - start;
+    cout << "procfs scan, processes: " << processes << ", elapsed: " << elapsed.count() / rounds * 1000
+         << " ms per scan" << endl;
+}
+
+UNIT_TEST_CASE(ProcfsSnapshotUnittest, TestParseSystemStat)
+UNIT_TEST_CASE(ProcfsSnapshotUnittest, TestProcessStatsSharedWithinTick)
+UNIT_TEST_CASE(ProcfsSnapshotUnittest, TestVanishedProcessClosed)
+UNIT_TEST_CASE(ProcfsSnapshotUnittest, TestMaxCachedFds)
+UNIT_TEST_CASE(ProcfsSnapshotUnittest, TestSystemStatNotBlockedByScan)
+UNIT_TEST_CASE(ProcfsSnapshotUnittest, TestScanPerformance)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,228 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "spdlog/async.h"
+#include "spdlog/details/os.h"
+#include "spdlog/sinks/ostream_sink.h"
+
+#include "common/Flags.h"
+#include "logger/BinaryLogger.h"
+#include "logger/Logger.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_BOOL(enable_binary_logger);
+DECLARE_FLAG_INT32(binary_logger_thread_buffer_size_kb);
+DECLARE_FLAG_INT32(binary_logger_flush_interval_ms);
+
+using namespace std;
+
+namespace logtail {
+
+class BinaryLoggerUnittest : public ::testing::Test {
+public:
+    void TestRing();
+    void TestFormat();
+    void TestInPlace();
+    void TestThreadExit();
+    void TestNested();
+    void TestFlushLevel();
+    void TestAsyncLogger();
+    void TestFlushOnCrash();
+
+protected:
+    void SetUp() override {
+        mSink = make_shared<spdlog::sinks::ostream_sink_mt>(mOutput);
+        mLogger = make_shared<spdlog::logger>("binary_logger_unittest", mSink);
+        mLogger->set_pattern("[%l]\t%v");
+        mLogger->set_level(spdlog::level::info);
+        BOOL_FLAG(enable_binary_logger) = true;
+        BinaryLogger::GetInstance()->Start();
+    }
+
+    void TearDown() override {
+        BinaryLogger::GetInstance()->Stop();
+        BOOL_FLAG(enable_binary_logger) = false;
+        INT32_FLAG(binary_logger_thread_buffer_size_kb) = 256;
+        INT32_FLAG(binary_logger_flush_interval_ms) = 20;
+    }
+
+    ostringstream mOutput;
+    shared_ptr<spdlog::sinks::ostream_sink_mt> mSink;
+    Logger::logger mLogger;
+};
+
+void BinaryLoggerUnittest::TestRing() {
+    BinaryLogRing ring(64);
+    string record;
+    APSARA_TEST_FALSE(ring.TryPop(record));
+    // records wrap around the end of the buffer
+    for (int i = 0; i < 100; ++i) {
+        string data(10 + i % 20, 'a' + i % 26);
+        APSARA_TEST_TRUE(ring.TryPush(data.data(), data.size()));
+        APSARA_TEST_TRUE(ring.TryPop(record));
+        APSARA_TEST_EQUAL(data, record);
+    }
+    string data(40, 'x');
+    APSARA_TEST_TRUE(ring.TryPush(data.data(), data.size()));
+    APSARA_TEST_FALSE(ring.TryPush(data.data(), data.size()));
+    APSARA_TEST_TRUE(ring.TryPop(record));
+    APSARA_TEST_FALSE(ring.TryPop(record));
+}
+
+void BinaryLoggerUnittest::TestFormat() {
+    string str = "string";
+    int evaluated = 0;
+    LOG_INFO(mLogger,
+             ("int", -1)("uint", 2U)("bool", true)("char", 'c')("double", 1.25)("literal", "text")("string", str)(
+                 "cstr", str.c_str())("ptr", static_cast<const void*>(nullptr)));
+    LOG_DEBUG(mLogger, ("evaluated", ++evaluated));
+    BinaryLogger::GetInstance()->Stop();
+    APSARA_TEST_EQUAL(0, evaluated);
+
+    string binaryOutput = mOutput.str();
+    mOutput.str("");
+    LOG_INFO(mLogger,
+             ("int", -1)("uint", 2U)("bool", true)("char", 'c')("double", 1.25)("literal", "text")("string", str)(
+                 "cstr", str.c_str())("ptr", static_cast<const void*>(nullptr)));
+    string output = mOutput.str();
+    // line numbers differ
+    APSARA_TEST_EQUAL(output.substr(output.find('\t', output.find(':'))),
+                      binaryOutput.substr(binaryOutput.find('\t', binaryOutput.find(':'))));
+    APSARA_TEST_NOT_EQUAL(string::npos,
+                          binaryOutput.find("\tint:-1\tuint:2\tbool:true\tchar:c\tdouble:1.25\tliteral:text\tstring:"
+                                            "string\tcstr:string\tptr:"));
+}
+
+void BinaryLoggerUnittest::TestInPlace() {
+    BinaryLogger::GetInstance()->Stop();
+    INT32_FLAG(binary_logger_thread_buffer_size_kb) = 4;
+    BinaryLogger::GetInstance()->Start();
+    // the ring is not drained before the thread exits, so that later records are formatted in place
+    thread([this]() {
+        BinaryLogger::GetInstance()->mInPlaceCnt = 0;
+        string value(1024, 'a');
+        for (int i = 0; i < 100; ++i) {
+            LOG_WARNING(mLogger, ("index", i)("value", value));
+        }
+        APSARA_TEST_TRUE(BinaryLogger::GetInstance()->mInPlaceCnt.load() > 0);
+    }).join();
+    BinaryLogger::GetInstance()->Stop();
+    string output = mOutput.str();
+    for (int i = 0; i < 100; ++i) {
+        APSARA_TEST_NOT_EQUAL(string::npos, output.find("\tindex:" + to_string(i) + "\tvalue:"));
+    }
+}
+
+void BinaryLoggerUnittest::TestThreadExit() {
+    thread([this]() { LOG_ERROR(mLogger, ("thread", "exited")); }).join();
+    BinaryLogger::GetInstance()->Stop();
+    APSARA_TEST_NOT_EQUAL(string::npos, mOutput.str().find("\tthread:exited"));
+    // the ring of the exited thread is released after drained
+    lock_guard<mutex> lock(BinaryLogger::GetInstance()->mRingsMux);
+    for (const auto& ring : BinaryLogger::GetInstance()->mRings) {
+        APSARA_TEST_FALSE(ring->IsClosed());
+    }
+}
+
+void BinaryLoggerUnittest::TestNested() {
+    auto inner = [this]() {
+        LOG_INFO(mLogger, ("inner", "value"));
+        return 1;
+    };
+    LOG_INFO(mLogger, ("outer", "first")("nested", inner())("outer", "last"));
+    BinaryLogger::GetInstance()->Stop();
+    string output = mOutput.str();
+    auto innerPos = output.find("\tinner:value\n");
+    auto outerPos = output.find("\touter:first\tnested:1\touter:last\n");
+    APSARA_TEST_NOT_EQUAL(string::npos, innerPos);
+    APSARA_TEST_NOT_EQUAL(string::npos, outerPos);
+    APSARA_TEST_TRUE(innerPos < outerPos);
+}
+
+void BinaryLoggerUnittest::TestFlushLevel() {
+    // same as Logger::LoadConfig
+    mLogger->flush_on(spdlog::level::info);
+    BinaryLogger::GetInstance()->mInPlaceCnt = 0;
+    LOG_INFO(mLogger, ("index", 0));
+    LOG_WARNING(mLogger, ("index", 1));
+    LOG_ERROR(mLogger, ("index", 2));
+    APSARA_TEST_EQUAL(0U, BinaryLogger::GetInstance()->mInPlaceCnt.load());
+    BinaryLogger::GetInstance()->Stop();
+    string output = mOutput.str();
+    auto pos0 = output.find("\tindex:0\n");
+    auto pos1 = output.find("\tindex:1\n");
+    auto pos2 = output.find("\tindex:2\n");
+    APSARA_TEST_NOT_EQUAL(string::npos, pos0);
+    APSARA_TEST_TRUE(pos0 < pos1);
+    APSARA_TEST_TRUE(pos1 < pos2);
+}
+
+void BinaryLoggerUnittest::TestAsyncLogger() {
+    ostringstream output;
+    {
+        auto pool = make_shared<spdlog::details::thread_pool>(128, 1);
+        auto sink = make_shared<spdlog::sinks::ostream_sink_mt>(output);
+        Logger::logger logger = make_shared<spdlog::async_logger>(
+            "binary_logger_async_unittest", sink, pool, spdlog::async_overflow_policy::block);
+        logger->set_pattern("[%t]\t%v");
+        logger->set_level(spdlog::level::info);
+        LOG_INFO(logger, ("async", "value"));
+        BinaryLogger::GetInstance()->Stop();
+        // the pool writes pending messages before it is released
+    }
+    // thread id of the logging thread instead of the background thread
+    APSARA_TEST_EQUAL(0U, output.str().find("[" + to_string(spdlog::details::os::thread_id()) + "]\t"));
+    APSARA_TEST_NOT_EQUAL(string::npos, output.str().find("\tasync:value"));
+}
+
+void BinaryLoggerUnittest::TestFlushOnCrash() {
+    // keep records in the ring
+    INT32_FLAG(binary_logger_flush_interval_ms) = 3600000;
+    BinaryLogger::GetInstance()->Stop();
+    BinaryLogger::GetInstance()->Start();
+    // the background thread drains once after started
+    this_thread::sleep_for(chrono::milliseconds(100));
+    LOG_INFO(mLogger, ("crash", "value"));
+    APSARA_TEST_EQUAL(string::npos, mOutput.str().find("\tcrash:value"));
+    BinaryLogger::GetInstance()->FlushOnCrash();
+    APSARA_TEST_NOT_EQUAL(string::npos, mOutput.str().find("\tcrash:value"));
+
+    // skipped if another thread is draining
+    LOG_INFO(mLogger, ("crash", "again"));
+    {
+        lock_guard<mutex> lock(BinaryLogger::GetInstance()->mDrainMux);
+        BinaryLogger::GetInstance()->FlushOnCrash();
+    }
+    APSARA_TEST_EQUAL(string::npos, mOutput.str().find("\tcrash:again"));
+    BinaryLogger::GetInstance()->Stop();
+    APSARA_TEST_NOT_EQUAL(string::npos, mOutput.str().find("\tcrash:again"));
+}
+
+UNIT_TEST_CASE(BinaryLoggerUnittest, TestRing)
+UNIT_TEST_CASE(BinaryLoggerUnittest, TestFormat)
+UNIT_TEST_CASE(BinaryLoggerUnittest, TestInPlace)
+UNIT_TEST_CASE(BinaryLoggerUnittest, TestThreadExit)
+UNIT_TEST_CASE(BinaryLoggerUnittest, TestNested)
+UNIT_TEST_CASE(BinaryLoggerUnittest, TestFlushLevel)
+UNIT_TEST_CASE(BinaryLoggerUnittest, TestAsyncLogger)
+UNIT_TEST_CASE(BinaryLoggerUnittest, TestFlushOnCrash)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -14,8 +14,13 @@
 
 #include <cstdlib>
 
+#include <thread>
+#include <vector>
+
+#include "common/Flags.h"
 #include "common/JsonUtil.h"
 #include "common/TimeUtil.h"
+#include "common/memory/ChunkPool.h"
 #include "models/LogEvent.h"
 #include "models/PipelineEventGroup.h"
 
@@ -29,12 +34,15 @@ void* __wrap_memcpy(void* dest, const void* src, size_t n) {
 }
 #endif
 
+DECLARE_FLAG_BOOL(enable_chunk_pool);
+
 namespace logtail {
 
 class EventGroupBenchmark {
 public:
     void TestEraseInLoop();
     void TestWriteIndexInLoop();
+    void TestSourceBufferAllocation(bool enableChunkPool);
 };
 
 void EraseInLoop(PipelineEventGroup& logGroup) {
@@ -102,15 +110,53 @@ void EventGroupBenchmark::TestWriteIndexInLoop() {
     printf("%s costs %lums\n", __func__, timeelapsed);
 }
 
+// event groups are created by input threads and destructed by processor or flusher threads
+void EventGroupBenchmark::TestSourceBufferAllocation(bool enableChunkPool) {
+    BOOL_FLAG(enable_chunk_pool) = enableChunkPool;
+    auto statBefore = ChunkPool::GetInstance()->GetStat();
+    std::string content(200, 'a');
+    uint64_t starttime = GetCurrentTimeInMilliSeconds();
+    for (int round = 0; round < 100; ++round) {
+        std::vector<PipelineEventGroup> eventGroups;
+        std::thread([&]() {
+            for (int i = 0; i < 100; ++i) {
+                eventGroups.emplace_back(std::make_shared<SourceBuffer>());
+                for (int j = 0; j < 1000; ++j) {
+                    auto& group = eventGroups.back();
+                    auto sb = group.GetSourceBuffer()->CopyString(content);
+                    group.AddLogEvent()->SetContentNoCopy(StringView("content"), StringView(sb.data, sb.size));
+                }
+            }
+        }).join();
+        std::thread([&]() { eventGroups.clear(); }).join();
+    }
+    uint64_t timeelapsed = GetCurrentTimeInMilliSeconds() - starttime;
+    auto stat = ChunkPool::GetInstance()->GetStat();
+    printf("%s with chunk pool %s costs %lums, thread cache hit %lu, shared cache hit %lu, miss %lu, free %lu\n",
+           __func__,
+           enableChunkPool ? "enabled" : "disabled",
+           timeelapsed,
+           stat.mThreadCacheHitCnt - statBefore.mThreadCacheHitCnt,
+           stat.mSharedCacheHitCnt - statBefore.mSharedCacheHitCnt,
+           stat.mMissCnt - statBefore.mMissCnt,
+           stat.mFreeCnt - statBefore.mFreeCnt);
+}
+
 } // namespace logtail
 
 int main(int argc, char* argv[]) {
     logtail::EventGroupBenchmark benchmark;
     benchmark.TestEraseInLoop();
     benchmark.TestWriteIndexInLoop();
+    benchmark.TestSourceBufferAllocation(false);
+    benchmark.TestSourceBufferAllocation(true);
     /* Result:
        TestEraseInLoop costs 453ms
        TestWriteIndexInLoop costs 22ms
+       TestSourceBufferAllocation with chunk pool disabled costs 6862ms, thread cache hit 0, shared cache hit 0, miss
+       60000, free 60000
+       TestSourceBufferAllocation with chunk pool enabled costs 3903ms, thread cache hit 49499, shared cache hit 10001,
+       miss 500, free 0
      */
     return 0;
 }
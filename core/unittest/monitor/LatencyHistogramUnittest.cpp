@@ -0,0 +1,68 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <vector>
+
+#include "monitor/metric_models/LatencyHistogram.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class LatencyHistogramUnittest : public ::testing::Test {
+public:
+    void TestCollect();
+    void TestLargeLatency();
+};
+
+void LatencyHistogramUnittest::TestCollect() {
+    LatencyHistogram histogram;
+    vector<uint64_t> res;
+    APSARA_TEST_FALSE(histogram.Collect({50, 99}, res));
+
+    for (int i = 0; i < 98; ++i) {
+        histogram.Add(chrono::microseconds(10));
+    }
+    histogram.Add(chrono::microseconds(1000));
+    histogram.Add(chrono::microseconds(1000));
+    APSARA_TEST_TRUE(histogram.Collect({50, 99, 100}, res));
+    APSARA_TEST_EQUAL(3U, res.size());
+    // 10us is in [8, 16), 1000us is in [512, 1024)
+    APSARA_TEST_EQUAL(12U, res[0]);
+    APSARA_TEST_EQUAL(768U, res[1]);
+    APSARA_TEST_EQUAL(1024U, res[2]);
+
+    // reset after collection
+    APSARA_TEST_FALSE(histogram.Collect({50}, res));
+    histogram.Add(chrono::nanoseconds(100));
+    APSARA_TEST_TRUE(histogram.Collect({50}, res));
+    APSARA_TEST_EQUAL(0U, res[0]);
+}
+
+void LatencyHistogramUnittest::TestLargeLatency() {
+    LatencyHistogram histogram;
+    vector<uint64_t> res;
+    histogram.Add(chrono::hours(24 * 365));
+    APSARA_TEST_TRUE(histogram.Collect({100}, res));
+    APSARA_TEST_EQUAL(1ULL << (LatencyHistogram::kBucketNum - 1), res[0]);
+}
+
+UNIT_TEST_CASE(LatencyHistogramUnittest, TestCollect)
+UNIT_TEST_CASE(LatencyHistogramUnittest, TestLargeLatency)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
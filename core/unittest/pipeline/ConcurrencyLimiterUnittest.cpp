@@ -13,8 +13,12 @@
 // limitations under the License.
 
 #include "collection_pipeline/limiter/ConcurrencyLimiter.h"
+#include "common/Flags.h"
 #include "unittest/Unittest.h"
 
+DECLARE_FLAG_BOOL(enable_concurrency_response_time_limit);
+DECLARE_FLAG_INT32(concurrency_min_response_time_reset_interval_sec);
+
 using namespace std;
 
 namespace logtail {
@@ -22,6 +26,22 @@ namespace logtail {
 class ConcurrencyLimiterUnittest : public testing::Test {
 public:
     void TestLimiter() const;
+    void TestResponseTime() const;
+
+protected:
+    void TearDown() override {
+        BOOL_FLAG(enable_concurrency_response_time_limit) = true;
+        INT32_FLAG(concurrency_min_response_time_reset_interval_sec) = 600;
+    }
+
+private:
+    static void SendAll(ConcurrencyLimiter& limiter, chrono::system_clock::time_point time, int64_t responseTimeMs) {
+        for (uint32_t i = 0; i < limiter.GetStatisticThreshold(); i++) {
+            limiter.PostPop();
+            limiter.OnSuccess(time, chrono::milliseconds(responseTimeMs));
+            limiter.OnSendDone();
+        }
+    }
 };
 
 void ConcurrencyLimiterUnittest::TestLimiter() const {
@@ -140,7 +160,53 @@ void ConcurrencyLimiterUnittest::TestLimiter() const {
     APSARA_TEST_EQUAL(expect, sConcurrencyLimiter->GetCurrentLimit());
 }
 
+void ConcurrencyLimiterUnittest::TestResponseTime() const {
+    auto curSystemTime = chrono::system_clock::now();
+    ConcurrencyLimiter limiter("", 80, 1);
+    limiter.SetCurrentLimit(40);
+
+    // within tolerance
+    SendAll(limiter, curSystemTime, 100);
+    APSARA_TEST_EQUAL(100.0, limiter.GetMinResponseTimeMs());
+    APSARA_TEST_EQUAL(100.0, limiter.GetRecentResponseTimeMs());
+    APSARA_TEST_EQUAL(41U, limiter.GetCurrentLimit());
+    SendAll(limiter, curSystemTime, 150);
+    APSARA_TEST_EQUAL(42U, limiter.GetCurrentLimit());
+
+    // backend slows down without failure, fall back by gradient
+    SendAll(limiter, curSystemTime, 250);
+    APSARA_TEST_EQUAL(100.0, limiter.GetMinResponseTimeMs());
+    APSARA_TEST_EQUAL(250.0, limiter.GetRecentResponseTimeMs());
+    APSARA_TEST_EQUAL(33U, limiter.GetCurrentLimit());
+    // at most half at a time
+    SendAll(limiter, curSystemTime, 2000);
+    APSARA_TEST_EQUAL(16U, limiter.GetCurrentLimit());
+
+    // backend recovers
+    SendAll(limiter, curSystemTime, 120);
+    APSARA_TEST_EQUAL(17U, limiter.GetCurrentLimit());
+
+    // response time is not measured
+    SendAll(limiter, curSystemTime, 0);
+    APSARA_TEST_EQUAL(120.0, limiter.GetRecentResponseTimeMs());
+    APSARA_TEST_EQUAL(18U, limiter.GetCurrentLimit());
+
+    // disabled
+    BOOL_FLAG(enable_concurrency_response_time_limit) = false;
+    SendAll(limiter, curSystemTime, 2000);
+    APSARA_TEST_EQUAL(2000.0, limiter.GetRecentResponseTimeMs());
+    APSARA_TEST_EQUAL(19U, limiter.GetCurrentLimit());
+    BOOL_FLAG(enable_concurrency_response_time_limit) = true;
+
+    // min response time is reset to follow the backend
+    INT32_FLAG(concurrency_min_response_time_reset_interval_sec) = 0;
+    SendAll(limiter, curSystemTime + chrono::seconds(1), 1000);
+    APSARA_TEST_EQUAL(1000.0, limiter.GetMinResponseTimeMs());
+    APSARA_TEST_EQUAL(20U, limiter.GetCurrentLimit());
+}
+
 UNIT_TEST_CASE(ConcurrencyLimiterUnittest, TestLimiter)
+UNIT_TEST_CASE(ConcurrencyLimiterUnittest, TestResponseTime)
 
 } // namespace logtail
 
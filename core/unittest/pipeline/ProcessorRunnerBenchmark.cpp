@@ -0,0 +1,154 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "json/json.h"
+
+#include "collection_pipeline/CollectionPipeline.h"
+#include "collection_pipeline/CollectionPipelineManager.h"
+#include "collection_pipeline/plugin/PluginRegistry.h"
+#include "collection_pipeline/queue/ProcessQueueManager.h"
+#include "collection_pipeline/queue/QueueKeyManager.h"
+#include "common/JsonUtil.h"
+#include "config/CollectionConfig.h"
+#include "runner/ProcessorRunner.h"
+#include "unittest/Unittest.h"
+#include "unittest/plugin/PluginMock.h"
+
+using namespace std;
+
+namespace logtail {
+
+class ProcessorRunnerBenchmark : public ::testing::Test {
+public:
+    void TestThroughput();
+
+protected:
+    static void SetUpTestCase() {
+        PluginRegistry::GetInstance()->LoadPlugins();
+        LoadPluginMock();
+    }
+
+    static void TearDownTestCase() { PluginRegistry::GetInstance()->UnloadPlugins(); }
+
+    void SetUp() override {
+        const string configStr = R"(
+            {
+                "inputs": [
+                    {
+                        "Type": "input_mock"
+                    }
+                ],
+                "processors": [
+                    {
+                        "Type": "processor_mock"
+                    },
+                    {
+                        "Type": "processor_mock"
+                    },
+                    {
+                        "Type": "processor_mock"
+                    }
+                ],
+                "flushers": [
+                    {
+                        "Type": "flusher_mock"
+                    }
+                ]
+            }
+        )";
+        unique_ptr<Json::Value> configJson(new Json::Value());
+        string errorMsg;
+        APSARA_TEST_TRUE_FATAL(ParseJsonTable(configStr, *configJson, errorMsg));
+        CollectionConfig config(mConfigName, std::move(configJson));
+        APSARA_TEST_TRUE_FATAL(config.Parse());
+        mPipeline = make_shared<CollectionPipeline>();
+        APSARA_TEST_TRUE_FATAL(mPipeline->Init(std::move(config)));
+        CollectionPipelineManager::GetInstance()->mPipelineNameEntityMap[mConfigName] = mPipeline;
+
+        mKey = QueueKeyManager::GetInstance()->GetKey(mConfigName);
+        ProcessQueueManager::GetInstance()->CreateOrUpdateCircularQueue(
+            mKey, 0, kQueueCapacity, mPipeline->GetContext());
+        ProcessQueueManager::GetInstance()->EnablePop(mConfigName);
+    }
+
+    void TearDown() override {
+        ProcessQueueManager::GetInstance()->DeleteQueue(mKey);
+        CollectionPipelineManager::GetInstance()->mPipelineNameEntityMap.clear();
+        mPipeline.reset();
+        QueueKeyManager::GetInstance()->Clear();
+    }
+
+private:
+    // circular queue capacity counts events
+    static constexpr size_t kQueueCapacity = 10000;
+    static constexpr size_t kTotalEvents = 200000;
+
+    // pushes groups of groupSize events into the process queue and times how fast the runner drains them, returns
+    // events per second
+    double Run(size_t groupSize, size_t batchSize) {
+        const string content(100, 'a');
+        vector<unique_ptr<ProcessQueueItem>> items;
+        string configName;
+        size_t remaining = kTotalEvents / groupSize;
+        chrono::duration<double> elapsed{};
+        while (remaining > 0) {
+            // filling the queue is not what is measured
+            size_t cnt = min(remaining, kQueueCapacity / groupSize);
+            for (size_t i = 0; i < cnt; ++i) {
+                PipelineEventGroup group(make_shared<SourceBuffer>());
+                for (size_t j = 0; j < groupSize; ++j) {
+                    group.AddLogEvent()->SetContent(string("content"), content);
+                }
+                ProcessQueueManager::GetInstance()->PushQueue(mKey,
+                                                              make_unique<ProcessQueueItem>(std::move(group), 0));
+            }
+            remaining -= cnt;
+
+            auto start = chrono::high_resolution_clock::now();
+            items.clear();
+            while (ProcessQueueManager::GetInstance()->PopItems(0, batchSize, 512 * 1024, items, configName)) {
+                ProcessorRunner::GetInstance()->ProcessItems(items, configName);
+                items.clear();
+            }
+            elapsed += chrono::high_resolution_clock::now() - start;
+        }
+        return kTotalEvents / groupSize * groupSize / elapsed.count();
+    }
+
+    const string mConfigName = "test_config";
+    shared_ptr<CollectionPipeline> mPipeline;
+    QueueKey mKey = 0;
+};
+
+void ProcessorRunnerBenchmark::TestThroughput() {
+    for (size_t groupSize : {1, 10, 100, 1000}) {
+        double single = Run(groupSize, 1);
+        double batched = Run(groupSize, 64);
+        cout << "group size: " << groupSize << ", events/s one group at a time: " << single
+             << ", events/s 64 groups at a time: " << batched << ", speedup: " << batched / single << endl;
+    }
+    APSARA_TEST_TRUE(ProcessQueueManager::GetInstance()->IsAllQueueEmpty());
+}
+
+UNIT_TEST_CASE(ProcessorRunnerBenchmark, TestThroughput)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
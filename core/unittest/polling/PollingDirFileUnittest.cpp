@@ -0,0 +1,200 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <utime.h>
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "boost/filesystem.hpp"
+#include "json/json.h"
+
+#include "collection_pipeline/CollectionPipelineContext.h"
+#include "common/FileSystemUtil.h"
+#include "common/Flags.h"
+#include "common/RuntimeUtil.h"
+#include "file_server/FileDiscoveryOptions.h"
+#include "file_server/FileServer.h"
+#include "file_server/polling/PollingDirFile.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT32(polling_full_scan_round);
+
+using namespace std;
+
+namespace logtail {
+
+class PollingDirFileUnittest : public ::testing::Test {
+public:
+    void TestSkipUnchangedDir();
+    void TestListChangedDir();
+    void TestFullScanRound();
+
+protected:
+    void SetUp() override {
+        mRootDir = GetProcessExecutionDir() + "polling_dir_file";
+        boost::filesystem::remove_all(mRootDir);
+        boost::filesystem::create_directories(PathJoin(mRootDir, "sub"));
+        ofstream(PathJoin(mRootDir, "a.log")) << "a\n";
+        ofstream(PathJoin(mRootDir, "b.txt")) << "b\n";
+        ofstream(PathJoin(PathJoin(mRootDir, "sub"), "c.log")) << "c\n";
+        // LMD of a directory must be older than the listing, otherwise it is listed again.
+        setModifyTime(mRootDir, -10);
+        setModifyTime(PathJoin(mRootDir, "sub"), -10);
+
+        Json::Value config;
+        config["FilePaths"].append(PathJoin(mRootDir, "**" + PATH_SEPARATOR + "*.log"));
+        config["MaxDirSearchDepth"] = 1;
+        mCtx.SetConfigName("test_config");
+        APSARA_TEST_TRUE_FATAL(mDiscoveryOpts.Init(config, mCtx, "test"));
+        FileServer::GetInstance()->AddFileDiscoveryConfig("test_config", &mDiscoveryOpts, &mCtx);
+
+        INT32_FLAG(polling_full_scan_round) = 10;
+        PollingDirFile::GetInstance()->ClearCache();
+        PollingDirFile::GetInstance()->mRuningFlag = true;
+        PollingDirFile::GetInstance()->mHoldOnFlag = false;
+    }
+
+    void TearDown() override {
+        PollingDirFile::GetInstance()->mRuningFlag = false;
+        PollingDirFile::GetInstance()->ClearCache();
+        FileServer::GetInstance()->RemoveFileDiscoveryConfig("test_config");
+        boost::filesystem::remove_all(mRootDir);
+        INT32_FLAG(polling_full_scan_round) = 10;
+    }
+
+private:
+    static void setModifyTime(const string& path, int32_t offset) {
+        struct utimbuf times;
+        times.actime = times.modtime = time(nullptr) + offset;
+        utime(path.c_str(), &times);
+    }
+
+    // poll runs one round on the base path, and returns names of files to be pushed to PollingModify.
+    vector<string> poll() {
+        auto* polling = PollingDirFile::GetInstance();
+        ++polling->mCurrentRound;
+        polling->mStatCount = 0;
+        polling->mNewFileVec.clear();
+        fsutil::PathStat baseDirStat;
+        APSARA_TEST_TRUE(fsutil::PathStat::stat(mRootDir, baseDirStat));
+        APSARA_TEST_TRUE(polling->PollingNormalConfigPath(
+            make_pair(&mDiscoveryOpts, &mCtx), mRootDir, string(), baseDirStat, 0));
+        vector<string> res;
+        for (const auto& file : polling->mNewFileVec) {
+            res.push_back(PathJoin(file.mFileDir, file.mFileName));
+        }
+        sort(res.begin(), res.end());
+        return res;
+    }
+
+    const DirCheckCache& dirCache(const string& dirPath) {
+        return PollingDirFile::GetInstance()->mDirCacheMap[dirPath];
+    }
+
+    string mRootDir;
+    FileDiscoveryOptions mDiscoveryOpts;
+    CollectionPipelineContext mCtx;
+};
+
+void PollingDirFileUnittest::TestSkipUnchangedDir() {
+    // round 1: everything is listed and considered as old data
+    APSARA_TEST_TRUE(poll().empty());
+    int64_t rootListTime = dirCache(mRootDir).mListTime;
+    int64_t subListTime = dirCache(PathJoin(mRootDir, "sub")).mListTime;
+    APSARA_TEST_TRUE(rootListTime > 0);
+    APSARA_TEST_TRUE(subListTime > 0);
+    APSARA_TEST_EQUAL(vector<string>{"sub"}, dirCache(mRootDir).mSubDirs);
+    APSARA_TEST_EQUAL(vector<string>{"a.log"}, dirCache(mRootDir).mFiles);
+    APSARA_TEST_EQUAL(vector<string>{"c.log"}, dirCache(PathJoin(mRootDir, "sub")).mFiles);
+
+    // round 2: directories are not listed, but cached files are still stated and pushed
+    vector<string> expected = {PathJoin(mRootDir, "a.log"), PathJoin(PathJoin(mRootDir, "sub"), "c.log")};
+    APSARA_TEST_EQUAL(expected, poll());
+    APSARA_TEST_EQUAL(rootListTime, dirCache(mRootDir).mListTime);
+    APSARA_TEST_EQUAL(subListTime, dirCache(PathJoin(mRootDir, "sub")).mListTime);
+
+    // appending to a file does not change LMD of its directory, the file should still be refreshed
+    auto filePath = PathJoin(mRootDir, "a.log");
+    ofstream(filePath, ios::app) << "a\n";
+    int64_t sec = 0, nsec = 0;
+    fsutil::PathStat fileStat;
+    APSARA_TEST_TRUE(fsutil::PathStat::stat(filePath, fileStat));
+    fileStat.GetLastWriteTime(sec, nsec);
+    poll();
+    APSARA_TEST_EQUAL(rootListTime, dirCache(mRootDir).mListTime);
+    APSARA_TEST_EQUAL(sec * 1000000000 + nsec,
+                      PollingDirFile::GetInstance()->mFileCacheMap[filePath].GetLastModifyTime());
+}
+
+void PollingDirFileUnittest::TestListChangedDir() {
+    poll();
+    int64_t rootListTime = dirCache(mRootDir).mListTime;
+    int64_t subListTime = dirCache(PathJoin(mRootDir, "sub")).mListTime;
+
+    // a new file changes LMD of the directory, so it is listed again
+    ofstream(PathJoin(mRootDir, "d.log")) << "d\n";
+    setModifyTime(mRootDir, -5);
+    vector<string> res = poll();
+    APSARA_TEST_TRUE(find(res.begin(), res.end(), PathJoin(mRootDir, "d.log")) != res.end());
+    APSARA_TEST_TRUE(dirCache(mRootDir).mListTime > rootListTime);
+    APSARA_TEST_EQUAL((vector<string>{"a.log", "d.log"}), [&] {
+        auto files = dirCache(mRootDir).mFiles;
+        sort(files.begin(), files.end());
+        return files;
+    }());
+    APSARA_TEST_EQUAL(subListTime, dirCache(PathJoin(mRootDir, "sub")).mListTime);
+
+    // LMD too close to the last listing, entries added in the same tick might be missed
+    poll();
+    rootListTime = dirCache(mRootDir).mListTime;
+    setModifyTime(mRootDir, 10);
+    poll();
+    APSARA_TEST_TRUE(dirCache(mRootDir).mListTime > rootListTime);
+    rootListTime = dirCache(mRootDir).mListTime;
+    poll();
+    APSARA_TEST_TRUE(dirCache(mRootDir).mListTime > rootListTime);
+}
+
+void PollingDirFileUnittest::TestFullScanRound() {
+    INT32_FLAG(polling_full_scan_round) = 3;
+    poll();
+    int64_t rootListTime = dirCache(mRootDir).mListTime;
+    poll();
+    APSARA_TEST_EQUAL(rootListTime, dirCache(mRootDir).mListTime);
+    // round 3 lists all directories
+    poll();
+    APSARA_TEST_TRUE(dirCache(mRootDir).mListTime > rootListTime);
+    rootListTime = dirCache(mRootDir).mListTime;
+    poll();
+    APSARA_TEST_EQUAL(rootListTime, dirCache(mRootDir).mListTime);
+
+    // 1 means always listing
+    INT32_FLAG(polling_full_scan_round) = 1;
+    poll();
+    APSARA_TEST_TRUE(dirCache(mRootDir).mListTime > rootListTime);
+    rootListTime = dirCache(mRootDir).mListTime;
+    poll();
+    APSARA_TEST_TRUE(dirCache(mRootDir).mListTime > rootListTime);
+}
+
+UNIT_TEST_CASE(PollingDirFileUnittest, TestSkipUnchangedDir)
+UNIT_TEST_CASE(PollingDirFileUnittest, TestListChangedDir)
+UNIT_TEST_CASE(PollingDirFileUnittest, TestFullScanRound)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
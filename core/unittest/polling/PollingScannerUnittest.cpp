@@ -0,0 +1,145 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "boost/filesystem.hpp"
+
+#include "common/Flags.h"
+#include "common/RuntimeUtil.h"
+#include "file_server/polling/PollingScanner.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT32(polling_getdents_buffer_size_kb);
+DECLARE_FLAG_INT32(polling_parallel_stat_min_count);
+
+using namespace std;
+
+namespace logtail {
+
+class PollingScannerUnittest : public ::testing::Test {
+public:
+    void TestReadDir();
+    void TestStatEntries();
+    void TestStatFiles();
+
+protected:
+    void SetUp() override {
+        mRootDir = GetProcessExecutionDir() + "polling_scanner";
+        boost::filesystem::remove_all(mRootDir);
+        boost::filesystem::create_directories(PathJoin(mRootDir, "dir"));
+        for (int i = 0; i < 100; ++i) {
+            ofstream(PathJoin(mRootDir, "file" + to_string(i) + ".log")) << string(i, 'a');
+        }
+        ofstream(PathJoin(mRootDir, ".hidden"));
+        boost::filesystem::create_symlink(PathJoin(mRootDir, "dir"), PathJoin(mRootDir, "link"));
+    }
+
+    void TearDown() override {
+        boost::filesystem::remove_all(mRootDir);
+        INT32_FLAG(polling_getdents_buffer_size_kb) = 128;
+        INT32_FLAG(polling_parallel_stat_min_count) = 1024;
+    }
+
+private:
+    string mRootDir;
+};
+
+void PollingScannerUnittest::TestReadDir() {
+    // small buffer to read the directory by several calls
+    INT32_FLAG(polling_getdents_buffer_size_kb) = 1;
+    vector<PollingEntry> entries;
+    APSARA_TEST_TRUE(PollingScanner::GetInstance()->ReadDir(mRootDir, entries));
+    APSARA_TEST_EQUAL(102U, entries.size());
+    for (const auto& entry : entries) {
+        if (entry.mName == "dir") {
+            APSARA_TEST_EQUAL(fsutil::Entry::Type::DIR, entry.mType);
+            APSARA_TEST_FALSE(entry.mIsSymbolic);
+        } else if (entry.mName == "link") {
+            APSARA_TEST_EQUAL(fsutil::Entry::Type::UNKNOWN, entry.mType);
+            APSARA_TEST_TRUE(entry.mIsSymbolic);
+        } else {
+            APSARA_TEST_EQUAL(fsutil::Entry::Type::REG_FILE, entry.mType);
+            APSARA_TEST_EQUAL(0U, entry.mName.find("file"));
+        }
+    }
+
+    entries.clear();
+    APSARA_TEST_FALSE(PollingScanner::GetInstance()->ReadDir(PathJoin(mRootDir, "not_exist"), entries));
+    APSARA_TEST_EQUAL(ENOENT, errno);
+}
+
+void PollingScannerUnittest::TestStatEntries() {
+    vector<PollingEntry> entries(3);
+    entries[0].mName = "link";
+    entries[0].mNeedStat = true;
+    entries[1].mName = "file10.log";
+    entries[1].mNeedStat = true;
+    entries[2].mName = "not_exist";
+    entries[2].mNeedStat = true;
+    PollingScanner::GetInstance()->StatEntries(mRootDir, entries);
+    APSARA_TEST_TRUE(entries[0].mStat.mSucceeded);
+    APSARA_TEST_TRUE(entries[0].mStat.mStat.IsDir());
+    APSARA_TEST_TRUE(entries[1].mStat.mSucceeded);
+    APSARA_TEST_TRUE(entries[1].mStat.mStat.IsRegFile());
+    APSARA_TEST_EQUAL(10, entries[1].mStat.mStat.GetFileSize());
+    fsutil::PathStat expected;
+    APSARA_TEST_TRUE(fsutil::PathStat::stat(PathJoin(mRootDir, "file10.log"), expected));
+    APSARA_TEST_TRUE(expected.GetDevInode() == entries[1].mStat.mStat.GetDevInode());
+    int64_t sec, nsec, expectedSec, expectedNsec;
+    entries[1].mStat.mStat.GetLastWriteTime(sec, nsec);
+    expected.GetLastWriteTime(expectedSec, expectedNsec);
+    APSARA_TEST_EQUAL(expectedSec, sec);
+    APSARA_TEST_EQUAL(expectedNsec, nsec);
+    APSARA_TEST_FALSE(entries[2].mStat.mSucceeded);
+    APSARA_TEST_EQUAL(ENOENT, entries[2].mStat.mErrno);
+}
+
+void PollingScannerUnittest::TestStatFiles() {
+    // split across worker threads
+    INT32_FLAG(polling_parallel_stat_min_count) = 10;
+    vector<SplitedFilePath> paths;
+    for (int i = 0; i < 100; ++i) {
+        paths.emplace_back(mRootDir, "file" + to_string(i) + ".log");
+    }
+    paths.emplace_back(mRootDir, "not_exist");
+    paths.emplace_back(PathJoin(mRootDir, "not_exist"), "file0.log");
+    paths.emplace_back(PathJoin(mRootDir, "link"), "not_exist");
+    vector<const SplitedFilePath*> files;
+    for (const auto& path : paths) {
+        files.push_back(&path);
+    }
+    vector<PollingStat> stats;
+    PollingScanner::GetInstance()->StatFiles(files, stats);
+    APSARA_TEST_EQUAL(files.size(), stats.size());
+    for (int i = 0; i < 100; ++i) {
+        APSARA_TEST_TRUE(stats[i].mSucceeded);
+        APSARA_TEST_EQUAL(i, stats[i].mStat.GetFileSize());
+    }
+    for (size_t i = 100; i < stats.size(); ++i) {
+        APSARA_TEST_FALSE(stats[i].mSucceeded);
+        APSARA_TEST_EQUAL(ENOENT, stats[i].mErrno);
+    }
+}
+
+UNIT_TEST_CASE(PollingScannerUnittest, TestReadDir)
+UNIT_TEST_CASE(PollingScannerUnittest, TestStatEntries)
+UNIT_TEST_CASE(PollingScannerUnittest, TestStatFiles)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,131 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <cstring>
+
+#include <iostream>
+#include <sstream>
+
+#include "collection_pipeline/plugin/instance/ProcessorInstance.h"
+#include "config/CollectionConfig.h"
+#include "models/LogEvent.h"
+#include "plugin/processor/ProcessorParseDelimiterNative.h"
+#include "unittest/Unittest.h"
+
+
+using namespace logtail;
+
+
+std::string formatSize(long long size) {
+    static const char* units[] = {" B", "KB", "MB", "GB", "TB"};
+    int index = 0;
+    double doubleSize = static_cast<double>(size);
+    while (doubleSize >= 1024.0 && index < 4) {
+        doubleSize /= 1024.0;
+        index++;
+    }
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1) << std::setw(6) << std::setfill(' ') << doubleSize << " " << units[index];
+    return ss.str();
+}
+
+static void BM_Delimiter(const std::string& separator, const std::string& data, int size, int batchSize) {
+    CollectionPipelineContext mContext;
+    mContext.SetConfigName("project##config_0");
+
+    Json::Value config;
+    config["SourceKey"] = "content";
+    config["Separator"] = separator;
+    config["Quote"] = "\"";
+    config["Keys"] = Json::arrayValue;
+    for (int i = 0; i < 10; ++i) {
+        config["Keys"].append("key" + std::to_string(i));
+    }
+    ProcessorParseDelimiterNative processor;
+    processor.SetContext(mContext);
+    processor.SetMetricsRecordRef(ProcessorParseDelimiterNative::sName, "1");
+    std::cout << "log size:\t" << formatSize(data.size() * size) << std::endl;
+
+    // make events
+    Json::Value root;
+    Json::Value events;
+    for (int i = 0; i < size; i++) {
+        Json::Value event;
+        event["type"] = 1;
+        event["timestamp"] = 1234567890;
+        event["timestampNanosecond"] = 0;
+        {
+            Json::Value contents;
+            contents["content"] = data;
+            event["contents"] = std::move(contents);
+        }
+        events.append(event);
+    }
+
+    root["events"] = events;
+    Json::StreamWriterBuilder builder;
+    builder["commentStyle"] = "None";
+    std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
+    std::ostringstream oss;
+    writer->write(root, &oss);
+    std::string inJson = oss.str();
+
+    bool init = processor.Init(config);
+    if (init) {
+        int count = 0;
+        uint64_t durationTime = 0;
+        for (int i = 0; i < batchSize; i++) {
+            count++;
+            auto sourceBuffer = std::make_shared<SourceBuffer>();
+            PipelineEventGroup eventGroup(sourceBuffer);
+            eventGroup.FromJsonString(inJson);
+
+            uint64_t startTime = GetCurrentTimeInMicroSeconds();
+            processor.Process(eventGroup);
+            durationTime += GetCurrentTimeInMicroSeconds() - startTime;
+        }
+        std::cout << "durationTime: " << durationTime << std::endl;
+        std::cout << "process: "
+                  << formatSize(data.size() * (uint64_t)count * 1000000 * (uint64_t)size / durationTime) << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+#ifdef NDEBUG
+    std::cout << "release" << std::endl;
+#else
+    std::cout << "debug" << std::endl;
+#endif
+    std::string unquoted = "2024-04-08 12:48:59.665,POST,/PutData?Category=YunOsAccountOpLog&AccessKeyId=U0Ujpek"
+                           "&Date=Fri%2C%2028%20Jun%202013%2006%3A53%3A30%20GMT,0.024,18204,200,37,-,"
+                           "Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36 (KHTML; like Gecko),"
+                           "10.200.98.220";
+    std::string quoted = "\"2024-04-08 12:48:59.665\",\"POST\",\"/PutData?Category=YunOsAccountOpLog,AccessKeyId\","
+                         "\"0.024\",\"18204\",\"200\",\"37\",\"-\","
+                         "\"Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36 (KHTML, \"\"like\"\" "
+                         "Gecko)\","
+                         "\"10.200.98.220\"";
+    std::string multiChar = "2024-04-08 12:48:59.665|#|POST|#|/PutData?Category=YunOsAccountOpLog|#|0.024|#|18204|#|"
+                            "200|#|37|#|-|#|Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36 (KHTML, like "
+                            "Gecko)|#|10.200.98.220";
+    std::cout << "unquoted" << std::endl;
+    BM_Delimiter(",", unquoted, 512, 100);
+    std::cout << "quoted" << std::endl;
+    BM_Delimiter(",", quoted, 512, 100);
+    std::cout << "multi-char separator" << std::endl;
+    BM_Delimiter("|#|", multiChar, 512, 100);
+    return 0;
+}
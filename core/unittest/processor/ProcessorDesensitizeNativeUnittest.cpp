@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #include "collection_pipeline/plugin/instance/ProcessorInstance.h"
+#include "common/Flags.h"
 #include "common/JsonUtil.h"
 #include "models/LogEvent.h"
 #include "plugin/processor/ProcessorDesensitizeNative.h"
@@ -20,6 +21,8 @@
 #include "plugin/processor/inner/ProcessorSplitMultilineLogStringNative.h"
 #include "unittest/Unittest.h"
 
+DECLARE_FLAG_INT64(desensitize_rule_set_max_mem);
+
 namespace logtail {
 
 class ProcessorDesensitizeNativeUnittest : public ::testing::Test {
@@ -32,6 +35,7 @@ public:
     void TestCastSensWordFail();
     void TestCastSensWordLoggroup();
     void TestCastSensWordMulti();
+    void TestCastSensWordRules();
     void TestMultipleLines();
     void TestMultipleLinesWithProcessorMergeMultilineLogNative();
 
@@ -50,6 +54,8 @@ UNIT_TEST_CASE(ProcessorDesensitizeNativeUnittest, TestCastSensWordLoggroup);
 
 UNIT_TEST_CASE(ProcessorDesensitizeNativeUnittest, TestCastSensWordMulti);
 
+UNIT_TEST_CASE(ProcessorDesensitizeNativeUnittest, TestCastSensWordRules);
+
 UNIT_TEST_CASE(ProcessorDesensitizeNativeUnittest, TestMultipleLines);
 
 UNIT_TEST_CASE(ProcessorDesensitizeNativeUnittest, TestMultipleLinesWithProcessorMergeMultilineLogNative);
@@ -1275,6 +1281,121 @@ void ProcessorDesensitizeNativeUnittest::TestCastSensWordLoggroup() {
     APSARA_TEST_STREQ_FATAL(CompactJson(expectJson).c_str(), CompactJson(outJson).c_str());
 }
 
+void ProcessorDesensitizeNativeUnittest::TestCastSensWordRules() {
+    Json::Value config;
+    config["SourceKey"] = "cast1";
+    config["ReplacingAll"] = true;
+    config["Rules"] = Json::arrayValue;
+    {
+        Json::Value rule;
+        rule["Method"] = "const";
+        rule["ReplacingString"] = "****";
+        rule["ContentPatternBeforeReplacedString"] = "phone:";
+        rule["ReplacedContentPattern"] = "\\d{11}";
+        config["Rules"].append(rule);
+    }
+    {
+        Json::Value rule;
+        rule["Method"] = "md5";
+        rule["ContentPatternBeforeReplacedString"] = "pwd=";
+        rule["ReplacedContentPattern"] = "[^,]+";
+        config["Rules"].append(rule);
+    }
+    {
+        Json::Value rule;
+        rule["Method"] = "const";
+        rule["ReplacingString"] = "<token>";
+        rule["ContentPatternBeforeReplacedString"] = "token=";
+        rule["ReplacedContentPattern"] = "[^,]+";
+        config["Rules"].append(rule);
+    }
+    {
+        // overlapped with the token rule, which starts first
+        Json::Value rule;
+        rule["Method"] = "const";
+        rule["ReplacingString"] = "#";
+        rule["ContentPatternBeforeReplacedString"] = "_";
+        rule["ReplacedContentPattern"] = "\\d{3}";
+        config["Rules"].append(rule);
+    }
+    // with a tiny max mem, the regex set of rules can not be built and every rule is searched
+    int64_t defaultMaxMem = INT64_FLAG(desensitize_rule_set_max_mem);
+    for (int64_t maxMem : {defaultMaxMem, int64_t(1024)}) {
+        INT64_FLAG(desensitize_rule_set_max_mem) = maxMem;
+        ProcessorDesensitizeNative& processor = *(new ProcessorDesensitizeNative);
+        ProcessorInstance processorInstance(&processor, getPluginMeta());
+        APSARA_TEST_TRUE_FATAL(processorInstance.Init(config, mContext));
+        INT64_FLAG(desensitize_rule_set_max_mem) = defaultMaxMem;
+        APSARA_TEST_EQUAL(4U, processor.mRules.size());
+        APSARA_TEST_EQUAL(maxMem == defaultMaxMem, processor.mRuleSet != nullptr);
+        // make events
+        auto sourceBuffer = std::make_shared<SourceBuffer>();
+        PipelineEventGroup eventGroup(sourceBuffer);
+        std::string inJson = R"({
+            "events" :
+            [
+                {
+                    "contents" :
+                    {
+                        "cast1" : "phone:13812345678,pwd=abc,token=tk_123,pwd=xyz"
+                    },
+                    "timestampNanosecond" : 0,
+                    "timestamp" : 12345678901,
+                    "type" : 1
+                },
+                {
+                    "contents" :
+                    {
+                        "cast1" : "nothing sensitive"
+                    },
+                    "timestampNanosecond" : 0,
+                    "timestamp" : 12345678901,
+                    "type" : 1
+                }
+            ]
+        })";
+        eventGroup.FromJsonString(inJson);
+        // run function
+        std::vector<PipelineEventGroup> eventGroupList;
+        eventGroupList.emplace_back(std::move(eventGroup));
+        processorInstance.Process(eventGroupList);
+
+        // judge result
+        std::string expectJson = R"({
+            "events" :
+            [
+                {
+                    "contents" :
+                    {
+                        "cast1" : "phone:****,pwd=900150983CD24FB0D6963F7D28E17F72,token=<token>,pwd=D16FB36F0911F878998C136191AF705E"
+                    },
+                    "timestamp" : 12345678901,
+                    "timestampNanosecond" : 0,
+                    "type" : 1
+                },
+                {
+                    "contents" :
+                    {
+                        "cast1" : "nothing sensitive"
+                    },
+                    "timestamp" : 12345678901,
+                    "timestampNanosecond" : 0,
+                    "type" : 1
+                }
+            ]
+        })";
+        std::string outJson = eventGroupList[0].ToJsonString();
+        APSARA_TEST_STREQ_FATAL(CompactJson(expectJson).c_str(), CompactJson(outJson).c_str());
+    }
+    {
+        // invalid rule
+        config["Rules"][1].removeMember("Method");
+        ProcessorDesensitizeNative& processor = *(new ProcessorDesensitizeNative);
+        ProcessorInstance processorInstance(&processor, getPluginMeta());
+        APSARA_TEST_FALSE_FATAL(processorInstance.Init(config, mContext));
+    }
+}
+
 void ProcessorDesensitizeNativeUnittest::TestCastSensWordMulti() {
     // case 1
     {
@@ -37,6 +37,7 @@ public:
     void TestInit();
     void TestProcessWholeLine();
     void TestProcessWholeLinePart();
+    void TestProcessLongFields();
     void TestProcessKeyOverwritten();
     void TestUploadRawLog();
     void TestAddLog();
@@ -53,6 +54,7 @@ public:
 UNIT_TEST_CASE(ProcessorParseApsaraNativeUnittest, TestInit);
 UNIT_TEST_CASE(ProcessorParseApsaraNativeUnittest, TestProcessWholeLine);
 UNIT_TEST_CASE(ProcessorParseApsaraNativeUnittest, TestProcessWholeLinePart);
+UNIT_TEST_CASE(ProcessorParseApsaraNativeUnittest, TestProcessLongFields);
 UNIT_TEST_CASE(ProcessorParseApsaraNativeUnittest, TestProcessKeyOverwritten);
 UNIT_TEST_CASE(ProcessorParseApsaraNativeUnittest, TestUploadRawLog);
 UNIT_TEST_CASE(ProcessorParseApsaraNativeUnittest, TestAddLog);
@@ -790,6 +792,65 @@ void ProcessorParseApsaraNativeUnittest::TestProcessWholeLinePart() {
     APSARA_TEST_EQUAL_FATAL(uint64_t(1), processor.mOutFailedEventsTotal->GetValue());
 }
 
+void ProcessorParseApsaraNativeUnittest::TestProcessLongFields() {
+    // make config
+    Json::Value config;
+    config["SourceKey"] = "content";
+    config["KeepingSourceWhenParseFail"] = true;
+    config["KeepingSourceWhenParseSucceed"] = false;
+    config["CopingRawLog"] = false;
+    config["RenamedSourceKey"] = "rawLog";
+    config["Timezone"] = "";
+    // make events
+    auto sourceBuffer = std::make_shared<SourceBuffer>();
+    PipelineEventGroup eventGroup(sourceBuffer);
+    std::string inJson = R"({
+        "events" :
+        [
+            {
+                "contents" :
+                {
+                    "content" : "[2023-09-04 13:15:04.862181]\t[INFO]\t[385658]\t/build/core/application/Application.cpp:312\t\turl:http://example.com:8080/path?a=b\tfield_without_colon_longer_than_a_block\tlong_key_of_many_bytes:long value with spaces and : colons\tempty_value:\ttrailing_key:trailing_value"
+                },
+                "timestamp" : 12345678901,
+                "type" : 1
+            }
+        ]
+    })";
+    eventGroup.FromJsonString(inJson);
+    // run function
+    ProcessorParseApsaraNative& processor = *(new ProcessorParseApsaraNative);
+    processor.SetContext(mContext);
+    ProcessorInstance processorInstance(&processor, getPluginMeta());
+    APSARA_TEST_TRUE_FATAL(processorInstance.Init(config, mContext));
+    std::vector<PipelineEventGroup> eventGroupList;
+    eventGroupList.emplace_back(std::move(eventGroup));
+    processorInstance.Process(eventGroupList);
+
+    std::string expectJson = R"({
+        "events": [
+            {
+                "contents": {
+                    "/build/core/application/Application.cpp": "312",
+                    "__LEVEL__": "INFO",
+                    "__THREAD__": "385658",
+                    "empty_value": "",
+                    "long_key_of_many_bytes": "long value with spaces and : colons",
+                    "microtime": "1693833304862181",
+                    "trailing_key": "trailing_value",
+                    "url": "http://example.com:8080/path?a=b"
+                },
+                "timestamp": 1693833304,
+                "timestampNanosecond": 862181000,
+                "type": 1
+            }
+        ]
+    })";
+    // judge result
+    std::string outJson = eventGroupList[0].ToJsonString();
+    APSARA_TEST_STREQ_FATAL(CompactJson(expectJson).c_str(), CompactJson(outJson).c_str());
+}
+
 void ProcessorParseApsaraNativeUnittest::TestProcessKeyOverwritten() {
     // make config
     Json::Value config;
@@ -14,6 +14,8 @@
 
 #include <cstdlib>
 
+#include <tuple>
+
 #include "collection_pipeline/plugin/instance/ProcessorInstance.h"
 #include "common/JsonUtil.h"
 #include "config/CollectionConfig.h"
@@ -21,6 +23,8 @@
 #include "plugin/processor/ProcessorParseRegexNative.h"
 #include "unittest/Unittest.h"
 
+DECLARE_FLAG_BOOL(enable_re2_regex_parser);
+
 namespace logtail {
 
 class ProcessorParseRegexNativeUnittest : public ::testing::Test {
@@ -35,6 +39,7 @@ public:
     void TestProcessEventKeyCountUnmatch();
     void TestProcessRegexRaw();
     void TestProcessRegexContent();
+    void TestRegexEngine();
 
 protected:
     void SetUp() override { ctx.SetConfigName("test_config"); }
@@ -651,6 +656,48 @@ void ProcessorParseRegexNativeUnittest::TestProcessEventKeyCountUnmatch() {
     APSARA_TEST_EQUAL_FATAL(0, processor.mOutFailedEventsTotal->GetValue());
 }
 
+void ProcessorParseRegexNativeUnittest::TestRegexEngine() {
+    // regex, content, whether RE2 is used
+    std::vector<std::tuple<std::string, std::string, bool>> cases = {
+        {R"((\w+)\s+\[([^\]]*)\]\s+(.*))", "GET [2024-01-01 00:00:00] multi\nline", true},
+        {R"((\d+)(?:-(\d+))?(.*))", "12", true},
+        {R"((\w+):\s(.*)$)", "key: first\nkey: second", true},
+        {R"((\w+)=\1 (.*))", "a=a rest", false},
+        {R"((\w+)(?=\s)(.*))", "look ahead", false},
+        {R"((\w+)\t(\w+))", "unmatched", true},
+    };
+    for (const auto& [regex, content, useRE2] : cases) {
+        std::vector<std::string> outJsons;
+        for (bool enableRE2 : {true, false}) {
+            BOOL_FLAG(enable_re2_regex_parser) = enableRE2;
+            Json::Value config;
+            config["SourceKey"] = "content";
+            config["Regex"] = regex;
+            config["Keys"] = Json::arrayValue;
+            config["Keys"].append("key1");
+            config["Keys"].append("key2");
+            config["KeepingSourceWhenParseFail"] = true;
+            config["KeepingSourceWhenParseSucceed"] = false;
+            ProcessorParseRegexNative& processor = *(new ProcessorParseRegexNative);
+            ProcessorInstance processorInstance(&processor, getPluginMeta());
+            APSARA_TEST_TRUE_FATAL(processorInstance.Init(config, ctx));
+            APSARA_TEST_EQUAL(enableRE2 && useRE2, processor.mRE2 != nullptr);
+
+            auto sourceBuffer = std::make_shared<SourceBuffer>();
+            PipelineEventGroup eventGroup(sourceBuffer);
+            auto* event = eventGroup.AddLogEvent();
+            event->SetTimestamp(12345678901);
+            event->SetContent(std::string("content"), content);
+            std::vector<PipelineEventGroup> eventGroupList;
+            eventGroupList.emplace_back(std::move(eventGroup));
+            processorInstance.Process(eventGroupList);
+            outJsons.push_back(eventGroupList[0].ToJsonString());
+        }
+        APSARA_TEST_EQUAL(outJsons[0], outJsons[1]);
+    }
+    BOOL_FLAG(enable_re2_regex_parser) = true;
+}
+
 UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, TestInit)
 UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, OnSuccessfulInit)
 UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, TestProcessWholeLine)
@@ -661,6 +708,7 @@ UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, TestProcessEventDiscardUnmatch
 UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, TestProcessEventKeyCountUnmatch)
 UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, TestProcessRegexRaw)
 UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, TestProcessRegexContent)
+UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, TestRegexEngine)
 
 } // namespace logtail
 
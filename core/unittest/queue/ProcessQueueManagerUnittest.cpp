@@ -34,6 +34,7 @@ public:
     void TestSetQueueUpstreamAndDownStream();
     void TestPushQueue();
     void TestPopItem();
+    void TestPopItems();
     void TestIsAllQueueEmpty();
     void OnPipelineUpdate();
 
@@ -323,6 +324,72 @@ void ProcessQueueManagerUnittest::TestPopItem() {
     APSARA_TEST_TRUE(sProcessQueueManager->mCurrentQueueIndex.second == sProcessQueueManager->mQueues[key1].first);
 }
 
+void ProcessQueueManagerUnittest::TestPopItems() {
+    vector<unique_ptr<ProcessQueueItem>> items;
+    string configName;
+    CollectionPipelineContext ctx;
+
+    ctx.SetConfigName("test_config_1");
+    QueueKey key1 = QueueKeyManager::GetInstance()->GetKey("test_config_1");
+    sProcessQueueManager->CreateOrUpdateCircularQueue(key1, 0, 100, ctx);
+    sProcessQueueManager->EnablePop("test_config_1");
+    ctx.SetConfigName("test_config_2");
+    QueueKey key2 = QueueKeyManager::GetInstance()->GetKey("test_config_2");
+    sProcessQueueManager->CreateOrUpdateCircularQueue(key2, 0, 100, ctx);
+    sProcessQueueManager->EnablePop("test_config_2");
+    ctx.SetConfigName("test_config_3");
+    ExactlyOnceQueueManager::GetInstance()->CreateOrUpdateQueue(3, 0, ctx, vector<RangeCheckpointPtr>(5));
+    ExactlyOnceQueueManager::GetInstance()->EnablePopProcessQueue("test_config_3");
+
+    for (size_t i = 0; i < 5; ++i) {
+        auto item = GenerateItem();
+        item->mEventGroup.AddLogEvent();
+        sProcessQueueManager->PushQueue(key1, std::move(item));
+    }
+    sProcessQueueManager->PushQueue(key2, GenerateItem());
+    sProcessQueueManager->mCurrentQueueIndex = {0, sProcessQueueManager->mQueues[key1].first};
+
+    // limited by count, and items only come from one queue
+    APSARA_TEST_TRUE(sProcessQueueManager->PopItems(0, 3, 1024 * 1024, items, configName));
+    APSARA_TEST_EQUAL("test_config_1", configName);
+    APSARA_TEST_EQUAL(3U, items.size());
+    APSARA_TEST_TRUE(sProcessQueueManager->mCurrentQueueIndex.second == sProcessQueueManager->mQueues[key2].first);
+
+    // limited by size, the item reaching the limit is still popped
+    items.clear();
+    sProcessQueueManager->mCurrentQueueIndex = {0, sProcessQueueManager->mQueues[key1].first};
+    APSARA_TEST_TRUE(sProcessQueueManager->PopItems(0, 10, 1, items, configName));
+    APSARA_TEST_EQUAL("test_config_1", configName);
+    APSARA_TEST_EQUAL(1U, items.size());
+
+    // drained to empty
+    items.clear();
+    sProcessQueueManager->mCurrentQueueIndex = {0, sProcessQueueManager->mQueues[key1].first};
+    APSARA_TEST_TRUE(sProcessQueueManager->PopItems(0, 10, 1024 * 1024, items, configName));
+    APSARA_TEST_EQUAL("test_config_1", configName);
+    APSARA_TEST_EQUAL(1U, items.size());
+
+    items.clear();
+    APSARA_TEST_TRUE(sProcessQueueManager->PopItems(0, 10, 1024 * 1024, items, configName));
+    APSARA_TEST_EQUAL("test_config_2", configName);
+    APSARA_TEST_EQUAL(1U, items.size());
+
+    // exactly once queue is popped one item at a time
+    sProcessQueueManager->PushQueue(3, GenerateItem());
+    sProcessQueueManager->PushQueue(3, GenerateItem());
+    items.clear();
+    APSARA_TEST_TRUE(sProcessQueueManager->PopItems(0, 10, 1024 * 1024, items, configName));
+    APSARA_TEST_EQUAL("test_config_3", configName);
+    APSARA_TEST_EQUAL(1U, items.size());
+    items.clear();
+    APSARA_TEST_TRUE(sProcessQueueManager->PopItems(0, 10, 1024 * 1024, items, configName));
+    APSARA_TEST_EQUAL(1U, items.size());
+
+    items.clear();
+    APSARA_TEST_FALSE(sProcessQueueManager->PopItems(0, 10, 1024 * 1024, items, configName));
+    APSARA_TEST_TRUE(items.empty());
+}
+
 void ProcessQueueManagerUnittest::TestIsAllQueueEmpty() {
     CollectionPipelineContext ctx;
     ctx.SetConfigName("test_config_1");
@@ -475,6 +542,7 @@ UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestDeleteQueue)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestSetQueueUpstreamAndDownStream)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestPushQueue)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestPopItem)
+UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestPopItems)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestIsAllQueueEmpty)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, OnPipelineUpdate)
 
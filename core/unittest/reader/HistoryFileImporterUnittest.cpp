@@ -0,0 +1,273 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "json/json.h"
+
+#include "checkpoint/AdhocCheckpointManager.h"
+#include "checkpoint/AdhocJobCheckpoint.h"
+#include "collection_pipeline/CollectionPipelineContext.h"
+#include "collection_pipeline/queue/ProcessQueueManager.h"
+#include "common/FileSystemUtil.h"
+#include "common/Flags.h"
+#include "common/HashUtil.h"
+#include "constants/Constants.h"
+#include "file_server/FileDiscoveryOptions.h"
+#include "file_server/FileTagOptions.h"
+#include "file_server/MultilineOptions.h"
+#include "file_server/reader/FileReaderOptions.h"
+#include "file_server/event_handler/HistoryFileImporter.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT64(history_file_import_chunk_size);
+DECLARE_FLAG_INT32(history_file_import_thread_count);
+
+using namespace std;
+
+namespace logtail {
+
+class HistoryFileImporterUnittest : public testing::Test {
+public:
+    void TestSplitFiles();
+    void TestSplitFilesFromStartPos();
+    void TestSplitMultilineFile();
+    void TestChunkCheckpoint();
+    void TestImportChunks();
+    void TestResumeImport();
+
+protected:
+    void SetUp() override {
+        mDir = (bfs::path(GetProcessExecutionDir()) / "HistoryFileImporterUnittest").string();
+        bfs::remove_all(mDir);
+        bfs::create_directories(mDir);
+        // lines of different length, so that chunk ends rarely fall on a line feed
+        ofstream fout(PathJoin(mDir, "a.log"), ios::binary);
+        for (int i = 0; i < 1000; ++i) {
+            mContent += "line " + to_string(i) + string(i % 37, 'x') + "\n";
+        }
+        fout << mContent << "no line feed";
+        mContent += "no line feed";
+        fout.close();
+        mEvent.mConfigName = "test";
+        mEvent.mDirName = mDir;
+        mEvent.mFileName = "a.log";
+        mEvent.mMultilineConfig = make_pair(&mMultilineOpts, &mCtx);
+        mEvent.mReaderConfig = make_pair(&mReaderOpts, &mCtx);
+        mEvent.mDiscoveryconfig = make_pair(&mDiscoveryOpts, &mCtx);
+        mEvent.mTagConfig = make_pair(&mTagOpts, &mCtx);
+        mReaderOpts.mInputType = FileReaderOptions::InputType::InputFile;
+        mCtx.SetConfigName("test");
+        mCtx.SetProcessQueueKey(0);
+        ProcessQueueManager::GetInstance()->CreateOrUpdateBoundedQueue(0, 0, mCtx);
+        ProcessQueueManager::GetInstance()->EnablePop("test");
+        INT64_FLAG(history_file_import_chunk_size) = 1000;
+    }
+
+    void TearDown() override {
+        INT64_FLAG(history_file_import_chunk_size) = 256 * 1024 * 1024;
+        INT32_FLAG(history_file_import_thread_count) = 1;
+        bfs::remove_all(mDir);
+    }
+
+    // Run import while draining the process queue, which is far smaller than the file. Returns the content read,
+    // ordered by file offset and joined by the line feeds removed by the reader.
+    template <typename F>
+    string Import(F&& import) {
+        vector<pair<uint64_t, string>> contents;
+        atomic_bool done{false};
+        thread consumer([&]() {
+            while (true) {
+                bool finished = done.load();
+                unique_ptr<ProcessQueueItem> item;
+                string configName;
+                if (!ProcessQueueManager::GetInstance()->PopItem(0, item, configName)) {
+                    if (finished) {
+                        break;
+                    }
+                    this_thread::sleep_for(chrono::milliseconds(1));
+                    continue;
+                }
+                for (const auto& e : item->mEventGroup.GetEvents()) {
+                    const auto& log = e.Cast<LogEvent>();
+                    contents.emplace_back(log.GetPosition().first, log.GetContent(DEFAULT_CONTENT_KEY).to_string());
+                }
+            }
+        });
+        import();
+        done = true;
+        consumer.join();
+        sort(contents.begin(), contents.end());
+        string res;
+        for (const auto& content : contents) {
+            if (!res.empty()) {
+                res += "\n";
+            }
+            res += content.second;
+        }
+        return res;
+    }
+
+    void CheckChunks(const vector<AdhocFileCheckpointPtr>& chunks, int64_t startPos) {
+        APSARA_TEST_FALSE(chunks.empty());
+        int64_t begin = startPos;
+        for (const auto& chunk : chunks) {
+            APSARA_TEST_EQUAL(begin, chunk->mOffset);
+            APSARA_TEST_TRUE(chunk->mOffset < chunk->mSize);
+            APSARA_TEST_EQUAL(STATUS_WAITING, chunk->mStatus);
+            if (chunk->mSize < static_cast<int64_t>(mContent.size())) {
+                APSARA_TEST_EQUAL('\n', mContent[chunk->mSize - 1]);
+                APSARA_TEST_TRUE(chunk->mSize - chunk->mOffset >= INT64_FLAG(history_file_import_chunk_size));
+            }
+            begin = chunk->mSize;
+        }
+        APSARA_TEST_EQUAL(static_cast<int64_t>(mContent.size()), begin);
+    }
+
+    string mDir;
+    string mContent;
+    CollectionPipelineContext mCtx;
+    MultilineOptions mMultilineOpts;
+    FileReaderOptions mReaderOpts;
+    FileDiscoveryOptions mDiscoveryOpts;
+    FileTagOptions mTagOpts;
+    HistoryFileEvent mEvent;
+};
+
+void HistoryFileImporterUnittest::TestSplitFiles() {
+    HistoryFileImporter importer;
+    auto chunks = importer.SplitFiles(mEvent, "job", {"a.log", "not_exist.log"});
+    APSARA_TEST_TRUE(chunks.size() > 1U);
+    CheckChunks(chunks, 0);
+    for (const auto& chunk : chunks) {
+        APSARA_TEST_TRUE(chunks[0]->mDevInode == chunk->mDevInode);
+        APSARA_TEST_EQUAL(chunks[0]->mSignatureHash, chunk->mSignatureHash);
+    }
+}
+
+void HistoryFileImporterUnittest::TestSplitFilesFromStartPos() {
+    HistoryFileImporter importer;
+    mEvent.mStartPos = 12345;
+    CheckChunks(importer.SplitFiles(mEvent, "job", {"a.log"}), 12345);
+
+    // a chunk size larger than the file gives a single chunk
+    INT64_FLAG(history_file_import_chunk_size) = 1024 * 1024;
+    auto chunks = importer.SplitFiles(mEvent, "job", {"a.log"});
+    APSARA_TEST_EQUAL(1U, chunks.size());
+    CheckChunks(chunks, 12345);
+}
+
+void HistoryFileImporterUnittest::TestSplitMultilineFile() {
+    Json::Value config;
+    config["StartPattern"] = "line \\d+";
+    APSARA_TEST_TRUE_FATAL(mMultilineOpts.Init(config, mCtx, "test"));
+    HistoryFileImporter importer;
+    auto chunks = importer.SplitFiles(mEvent, "job", {"a.log"});
+    APSARA_TEST_EQUAL(1U, chunks.size());
+    CheckChunks(chunks, 0);
+}
+
+void HistoryFileImporterUnittest::TestChunkCheckpoint() {
+    HistoryFileImporter importer;
+    auto chunks = importer.SplitFiles(mEvent, "job", {"a.log"});
+    AdhocJobCheckpoint job("job");
+    for (const auto& chunk : chunks) {
+        job.AddFileCheckpoint(chunk);
+    }
+    chunks[0]->mStatus = STATUS_FINISHED;
+    chunks[1]->mOffset += 10;
+    const string path = PathJoin(mDir, "job");
+    job.Dump(path, false);
+
+    AdhocJobCheckpoint loaded("job");
+    APSARA_TEST_TRUE_FATAL(loaded.Load(path));
+    const auto& list = loaded.GetFileCheckpointList();
+    APSARA_TEST_EQUAL(chunks.size(), list.size());
+    APSARA_TEST_EQUAL(STATUS_FINISHED, list[0]->mStatus);
+    // unfinished chunks keep their progress and range
+    for (size_t i = 1; i < list.size(); ++i) {
+        APSARA_TEST_EQUAL(STATUS_WAITING, list[i]->mStatus);
+        APSARA_TEST_EQUAL(chunks[i]->mOffset, list[i]->mOffset);
+        APSARA_TEST_EQUAL(chunks[i]->mSize, list[i]->mSize);
+        APSARA_TEST_EQUAL(chunks[i]->mSignatureHash, list[i]->mSignatureHash);
+        APSARA_TEST_EQUAL(chunks[i]->mSignatureSize, list[i]->mSignatureSize);
+    }
+}
+
+void HistoryFileImporterUnittest::TestImportChunks() {
+    HistoryFileImporter importer;
+    auto chunks = importer.SplitFiles(mEvent, "job", {"a.log"});
+    APSARA_TEST_TRUE(chunks.size() > 1U);
+    mutex chunkMux;
+    string content = Import([&]() {
+        for (const auto& chunk : chunks) {
+            importer.ImportChunk(mEvent, *chunk, chunkMux);
+        }
+    });
+    // the last line without a line feed is read at the end of the file, not lost
+    APSARA_TEST_EQUAL(mContent, content);
+    for (const auto& chunk : chunks) {
+        APSARA_TEST_EQUAL(STATUS_FINISHED, chunk->mStatus);
+        APSARA_TEST_EQUAL(chunk->mSize, chunk->mOffset);
+    }
+}
+
+void HistoryFileImporterUnittest::TestResumeImport() {
+    INT32_FLAG(history_file_import_thread_count) = 2;
+    HistoryFileImporter importer;
+    const string jobName
+        = "history_" + ToString(HashString(mEvent.mConfigName + "*" + mEvent.mDirName + "*" + mEvent.mFileName));
+    const string path = AdhocCheckpointManager::GetInstance()->GetJobCheckpointPath(jobName);
+
+    // interrupted after the first chunk and the first line of the second one
+    auto chunks = importer.SplitFiles(mEvent, jobName, {"a.log"});
+    APSARA_TEST_TRUE_FATAL(chunks.size() > 2U);
+    chunks[0]->mStatus = STATUS_FINISHED;
+    chunks[0]->mOffset = chunks[0]->mSize;
+    chunks[1]->mStatus = STATUS_LOADING;
+    chunks[1]->mOffset = mContent.find('\n', chunks[1]->mOffset) + 1;
+    AdhocJobCheckpoint job(jobName);
+    for (const auto& chunk : chunks) {
+        job.AddFileCheckpoint(chunk);
+    }
+    job.Dump(path, false);
+
+    string content = Import([&]() { importer.ProcessEventInParallel(mEvent, {"a.log"}); });
+    APSARA_TEST_EQUAL(mContent.substr(chunks[1]->mOffset), content);
+    // the import is complete, so it is not resumed again
+    APSARA_TEST_FALSE(CheckExistance(path));
+
+    content = Import([&]() { importer.ProcessEventInParallel(mEvent, {"a.log"}); });
+    APSARA_TEST_EQUAL(mContent, content);
+    APSARA_TEST_FALSE(CheckExistance(path));
+}
+
+UNIT_TEST_CASE(HistoryFileImporterUnittest, TestSplitFiles)
+UNIT_TEST_CASE(HistoryFileImporterUnittest, TestSplitFilesFromStartPos)
+UNIT_TEST_CASE(HistoryFileImporterUnittest, TestSplitMultilineFile)
+UNIT_TEST_CASE(HistoryFileImporterUnittest, TestChunkCheckpoint)
+UNIT_TEST_CASE(HistoryFileImporterUnittest, TestImportChunks)
+UNIT_TEST_CASE(HistoryFileImporterUnittest, TestResumeImport)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
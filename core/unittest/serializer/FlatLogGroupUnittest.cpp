@@ -0,0 +1,149 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+
+#include "common/Flags.h"
+#include "constants/TagConstants.h"
+#include "go_pipeline/FlatLogGroup.h"
+#include "models/MetricEvent.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT32(max_send_log_group_size);
+
+using namespace std;
+
+namespace logtail {
+
+class FlatLogGroupUnittest : public ::testing::Test {
+public:
+    void TestSerialize();
+    void TestSerializeWithoutNanosecond();
+    void TestSerializeFailed();
+
+protected:
+    void SetUp() override {
+        mGroup.reset(new PipelineEventGroup(make_shared<SourceBuffer>()));
+        mGroup->SetTag(LOG_RESERVED_KEY_TOPIC, string("topic"));
+        mGroup->SetTag(string("key"), string("value"));
+        auto* e = mGroup->AddLogEvent();
+        e->SetTimestamp(1234567890, 1);
+        e->SetContent(string("content_key"), string("content_value"));
+        e->SetContent(string("empty"), string(""));
+        e = mGroup->AddLogEvent();
+        e->SetTimestamp(1234567891);
+    }
+
+    // a reader of the layout described in go_pipeline/FlatLogGroup.h
+    class Reader {
+    public:
+        explicit Reader(const string& data) : mData(data) {}
+
+        uint8_t ReadUInt8() { return static_cast<uint8_t>(mData.at(mPos++)); }
+        uint32_t ReadUInt32() {
+            uint32_t res = 0;
+            for (int i = 0; i < 4; ++i) {
+                res |= static_cast<uint32_t>(ReadUInt8()) << (i * 8);
+            }
+            return res;
+        }
+        string ReadString() {
+            uint32_t size = ReadUInt32();
+            string res = mData.substr(mPos, size);
+            mPos += size;
+            return res;
+        }
+        bool AtEnd() const { return mPos == mData.size(); }
+
+    private:
+        const string& mData;
+        size_t mPos = 0;
+    };
+
+    unique_ptr<PipelineEventGroup> mGroup;
+};
+
+void FlatLogGroupUnittest::TestSerialize() {
+    string res, errorMsg;
+    APSARA_TEST_TRUE(SerializeFlatLogGroup(*mGroup, true, "logstore", res, errorMsg));
+    Reader reader(res);
+    APSARA_TEST_EQUAL(FLAT_LOG_GROUP_MAGIC, reader.ReadUInt32());
+    APSARA_TEST_EQUAL(2U, reader.ReadUInt32());
+    APSARA_TEST_EQUAL(2U, reader.ReadUInt32());
+    APSARA_TEST_EQUAL(1U, reader.ReadUInt32());
+    APSARA_TEST_EQUAL("logstore", reader.ReadString());
+    APSARA_TEST_EQUAL("topic", reader.ReadString());
+    APSARA_TEST_EQUAL("key", reader.ReadString());
+    APSARA_TEST_EQUAL("value", reader.ReadString());
+
+    APSARA_TEST_EQUAL(1234567890U, reader.ReadUInt32());
+    APSARA_TEST_EQUAL(2U, reader.ReadUInt32());
+    APSARA_TEST_EQUAL(1U, reader.ReadUInt8());
+    APSARA_TEST_EQUAL(1U, reader.ReadUInt32());
+    APSARA_TEST_EQUAL("content_key", reader.ReadString());
+    APSARA_TEST_EQUAL("content_value", reader.ReadString());
+    APSARA_TEST_EQUAL("empty", reader.ReadString());
+    APSARA_TEST_EQUAL("", reader.ReadString());
+
+    APSARA_TEST_EQUAL(1234567891U, reader.ReadUInt32());
+    APSARA_TEST_EQUAL(0U, reader.ReadUInt32());
+    APSARA_TEST_EQUAL(0U, reader.ReadUInt8());
+    APSARA_TEST_TRUE(reader.AtEnd());
+}
+
+void FlatLogGroupUnittest::TestSerializeWithoutNanosecond() {
+    string res, errorMsg;
+    APSARA_TEST_TRUE(SerializeFlatLogGroup(*mGroup, false, "logstore", res, errorMsg));
+    Reader reader(res);
+    for (int i = 0; i < 4; ++i) {
+        reader.ReadUInt32();
+    }
+    for (int i = 0; i < 4; ++i) {
+        reader.ReadString();
+    }
+    APSARA_TEST_EQUAL(1234567890U, reader.ReadUInt32());
+    APSARA_TEST_EQUAL(2U, reader.ReadUInt32());
+    APSARA_TEST_EQUAL(0U, reader.ReadUInt8());
+    for (int i = 0; i < 4; ++i) {
+        reader.ReadString();
+    }
+    APSARA_TEST_EQUAL(1234567891U, reader.ReadUInt32());
+    APSARA_TEST_EQUAL(0U, reader.ReadUInt32());
+    APSARA_TEST_EQUAL(0U, reader.ReadUInt8());
+    APSARA_TEST_TRUE(reader.AtEnd());
+}
+
+void FlatLogGroupUnittest::TestSerializeFailed() {
+    string res, errorMsg;
+    {
+        // log group too large
+        INT32_FLAG(max_send_log_group_size) = 10;
+        APSARA_TEST_FALSE(SerializeFlatLogGroup(*mGroup, true, "logstore", res, errorMsg));
+        INT32_FLAG(max_send_log_group_size) = 10 * 1024 * 1024;
+    }
+    {
+        // unsupported event type
+        mGroup->AddMetricEvent();
+        APSARA_TEST_FALSE(SerializeFlatLogGroup(*mGroup, true, "logstore", res, errorMsg));
+    }
+}
+
+UNIT_TEST_CASE(FlatLogGroupUnittest, TestSerialize)
+UNIT_TEST_CASE(FlatLogGroupUnittest, TestSerializeWithoutNanosecond)
+UNIT_TEST_CASE(FlatLogGroupUnittest, TestSerializeFailed)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -26,6 +26,7 @@ namespace logtail {
 class JsonSerializerUnittest : public ::testing::Test {
 public:
     void TestSerializeEventGroup();
+    void TestSerializeEscape();
 
 protected:
     static void SetUpTestCase() { sFlusher = make_unique<FlusherMock>(); }
@@ -203,6 +204,31 @@ void JsonSerializerUnittest::TestSerializeEventGroup() {
     }
 }
 
+void JsonSerializerUnittest::TestSerializeEscape() {
+    JsonEventGroupSerializer serializer(sFlusher.get());
+    PipelineEventGroup group(make_shared<SourceBuffer>());
+    group.SetTag(string("tag\""), string("va\\lue"));
+    LogEvent* e = group.AddLogEvent();
+    e->SetContent(string("key"), string("a\nb\tc\x01\x1f/\b\f\r"));
+    e->SetContent(string("nul"), string("a\0b", 3));
+    e->SetTimestamp(1234567890);
+    e = group.AddLogEvent();
+    e->SetContent(string("key"), string("\xe4\xb8\xad"));
+    e->SetTimestamp(1234567891);
+    BatchedEvents batch(std::move(group.MutableEvents()),
+                        std::move(group.GetSizedTags()),
+                        std::move(group.GetSourceBuffer()),
+                        group.GetMetadata(EventGroupMetaKey::SOURCE_ID),
+                        std::move(group.GetExactlyOnceCheckpoint()));
+    string res;
+    string errorMsg;
+    APSARA_TEST_TRUE(serializer.DoSerialize(std::move(batch), res, errorMsg));
+    APSARA_TEST_EQUAL("{\"tag\\\"\":\"va\\\\lue\",\"__time__\":1234567890,\"key\":\"a\\nb\\tc\\u0001\\u001F/\\b\\f\\r\","
+                      "\"nul\":\"a\\u0000b\"}\n"
+                      "{\"tag\\\"\":\"va\\\\lue\",\"__time__\":1234567891,\"key\":\"\xe4\xb8\xad\"}\n",
+                      res);
+}
+
 
 BatchedEvents
 JsonSerializerUnittest::createBatchedLogEvents(bool enableNanosecond, bool withEmptyContent, bool withNonEmptyContent) {
@@ -371,6 +397,7 @@ BatchedEvents JsonSerializerUnittest::createBatchedSpanEvents() {
 }
 
 UNIT_TEST_CASE(JsonSerializerUnittest, TestSerializeEventGroup)
+UNIT_TEST_CASE(JsonSerializerUnittest, TestSerializeEscape)
 
 } // namespace logtail
 
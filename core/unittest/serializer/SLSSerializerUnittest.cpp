@@ -26,6 +26,7 @@ class SLSSerializerUnittest : public ::testing::Test {
 public:
     void TestSerializeEventGroup();
     void TestSerializeEventGroupList();
+    void TestSerializeSpanAndMetricContents();
 
 protected:
     static void SetUpTestCase() { sFlusher = make_unique<FlusherSLS>(); }
@@ -440,6 +441,80 @@ void SLSSerializerUnittest::TestSerializeEventGroupList() {
 }
 
 
+void SLSSerializerUnittest::TestSerializeSpanAndMetricContents() {
+    SLSEventGroupSerializer serializer(sFlusher.get());
+    {
+        PipelineEventGroup group(make_shared<SourceBuffer>());
+        auto span = group.AddSpanEvent();
+        span->SetTimestamp(1234567890);
+        span->SetTag(string("a"), string("1"));
+        span->SetTag(string("b"), string("2"));
+        span->SetScopeTag(string("b"), string("3"));
+        span->SetScopeTag(string("c"), string("4\n"));
+        auto link = span->AddLink();
+        link->SetTraceId("trace");
+        link->SetSpanId("span");
+        link->SetTag(string("key"), string("value"));
+        auto event = span->AddEvent();
+        event->SetName("event");
+        event->SetTimestampNs(1000);
+        span->SetStartTimeNs(1000);
+        span->SetEndTimeNs(3000);
+        // span without any attribute, link or event
+        span = group.AddSpanEvent();
+        span->SetTimestamp(1234567890);
+        BatchedEvents batch(std::move(group.MutableEvents()),
+                            std::move(group.GetSizedTags()),
+                            std::move(group.GetSourceBuffer()),
+                            group.GetMetadata(EventGroupMetaKey::SOURCE_ID),
+                            std::move(group.GetExactlyOnceCheckpoint()));
+
+        string res, errorMsg;
+        APSARA_TEST_TRUE(serializer.DoSerialize(std::move(batch), res, errorMsg));
+        sls_logs::LogGroup logGroup;
+        APSARA_TEST_TRUE(logGroup.ParseFromString(res));
+        APSARA_TEST_EQUAL(2, logGroup.logs_size());
+        // scope tags take precedence over tags with the same key
+        APSARA_TEST_EQUAL("{\"a\":\"1\",\"b\":\"3\",\"c\":\"4\\n\"}", logGroup.logs(0).contents(7).value());
+        APSARA_TEST_EQUAL("[{\"attributes\":{\"key\":\"value\"},\"spanId\":\"span\",\"traceId\":\"trace\"}]",
+                          logGroup.logs(0).contents(8).value());
+        APSARA_TEST_EQUAL("[{\"name\":\"event\",\"timestamp\":1000}]", logGroup.logs(0).contents(9).value());
+        APSARA_TEST_EQUAL("1000", logGroup.logs(0).contents(10).value());
+        APSARA_TEST_EQUAL("3000", logGroup.logs(0).contents(11).value());
+        APSARA_TEST_EQUAL("2000", logGroup.logs(0).contents(12).value());
+        APSARA_TEST_EQUAL("null", logGroup.logs(1).contents(7).value());
+        APSARA_TEST_EQUAL("", logGroup.logs(1).contents(8).value());
+        APSARA_TEST_EQUAL("", logGroup.logs(1).contents(9).value());
+    }
+    {
+        // metric values are formatted the same as to_string
+        const vector<double> values = {0.0, -1.5, 1e20, 123456.7890123, 1e-7};
+        PipelineEventGroup group(make_shared<SourceBuffer>());
+        for (auto value : values) {
+            auto e = group.AddMetricEvent();
+            e->SetName("name");
+            e->SetTimestamp(1234567890);
+            e->SetTag(string("key"), string("value"));
+            e->SetValue(UntypedSingleValue{value});
+        }
+        BatchedEvents batch(std::move(group.MutableEvents()),
+                            std::move(group.GetSizedTags()),
+                            std::move(group.GetSourceBuffer()),
+                            group.GetMetadata(EventGroupMetaKey::SOURCE_ID),
+                            std::move(group.GetExactlyOnceCheckpoint()));
+
+        string res, errorMsg;
+        APSARA_TEST_TRUE(serializer.DoSerialize(std::move(batch), res, errorMsg));
+        sls_logs::LogGroup logGroup;
+        APSARA_TEST_TRUE(logGroup.ParseFromString(res));
+        APSARA_TEST_EQUAL(static_cast<int>(values.size()), logGroup.logs_size());
+        for (size_t i = 0; i < values.size(); ++i) {
+            APSARA_TEST_EQUAL(to_string(values[i]), logGroup.logs(i).contents(2).value());
+            APSARA_TEST_EQUAL("1234567890", logGroup.logs(i).contents(1).value());
+        }
+    }
+}
+
 BatchedEvents
 SLSSerializerUnittest::CreateBatchedLogEvents(bool enableNanosecond, bool withEmptyContent, bool withNonEmptyContent) {
     PipelineEventGroup group(make_shared<SourceBuffer>());
@@ -603,6 +678,7 @@ BatchedEvents SLSSerializerUnittest::CreateBatchedSpanEvents() {
 
 UNIT_TEST_CASE(SLSSerializerUnittest, TestSerializeEventGroup)
 UNIT_TEST_CASE(SLSSerializerUnittest, TestSerializeEventGroupList)
+UNIT_TEST_CASE(SLSSerializerUnittest, TestSerializeSpanAndMetricContents)
 
 } // namespace logtail
 
@@ -0,0 +1,128 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package protocol
+
+import (
+	"encoding/binary"
+	"errors"
+	"unsafe"
+)
+
+// FlatLogGroupMagic marks a log group in the flat layout written by core/go_pipeline/FlatLogGroup.cpp.
+const FlatLogGroupMagic uint32 = 0x31474C46
+
+var errFlatLogGroupTruncated = errors.New("flat log group truncated")
+
+type flatReader struct {
+	data []byte
+	pos  int
+	err  error
+}
+
+func (r *flatReader) uint8() uint8 {
+	if r.err != nil || r.pos+1 > len(r.data) {
+		r.err = errFlatLogGroupTruncated
+		return 0
+	}
+	v := r.data[r.pos]
+	r.pos++
+	return v
+}
+
+func (r *flatReader) uint32() uint32 {
+	if r.err != nil || r.pos+4 > len(r.data) {
+		r.err = errFlatLogGroupTruncated
+		return 0
+	}
+	v := binary.LittleEndian.Uint32(r.data[r.pos:])
+	r.pos += 4
+	return v
+}
+
+func (r *flatReader) string() string {
+	n := int(r.uint32())
+	if r.err != nil || n > len(r.data)-r.pos {
+		r.err = errFlatLogGroupTruncated
+		return ""
+	}
+	if n == 0 {
+		return ""
+	}
+	b := r.data[r.pos : r.pos+n]
+	r.pos += n
+	return *(*string)(unsafe.Pointer(&b)) //nolint:gosec
+}
+
+// UnmarshalFlat decodes a log group in the flat layout, see core/go_pipeline/FlatLogGroup.h for the layout.
+//
+// The data passed through cgo belongs to C++ and is freed once the call returns, so it is copied once, and all keys
+// and values of the log group then point into that copy instead of being allocated one by one. Logs and contents are
+// also allocated in one slice each. As a result, the copy is kept alive as long as any string of the group is.
+func (m *LogGroup) UnmarshalFlat(data []byte) error {
+	buf := make([]byte, len(data))
+	copy(buf, data)
+	r := &flatReader{data: buf}
+	if r.uint32() != FlatLogGroupMagic {
+		if r.err != nil {
+			return r.err
+		}
+		return errors.New("invalid flat log group magic")
+	}
+	logCnt := int(r.uint32())
+	contentCnt := int(r.uint32())
+	tagCnt := int(r.uint32())
+	// every log takes at least 9 bytes, and every content or tag at least 8, which bounds the counts of a corrupted
+	// buffer before anything is allocated
+	if r.err != nil || logCnt*9+contentCnt*8+tagCnt*8 > len(buf)-r.pos {
+		return errFlatLogGroupTruncated
+	}
+	m.Category = r.string()
+	m.Topic = r.string()
+
+	tags := make([]LogTag, tagCnt)
+	m.LogTags = make([]*LogTag, tagCnt)
+	for i := range tags {
+		tags[i].Key = r.string()
+		tags[i].Value = r.string()
+		m.LogTags[i] = &tags[i]
+	}
+
+	logs := make([]Log, logCnt)
+	contents := make([]Log_Content, contentCnt)
+	contentPtrs := make([]*Log_Content, contentCnt)
+	m.Logs = make([]*Log, logCnt)
+	for i := range logs {
+		log := &logs[i]
+		log.Time = r.uint32()
+		n := int(r.uint32())
+		if r.uint8() != 0 {
+			ns := r.uint32()
+			log.TimeNs = &ns
+		}
+		if r.err != nil || n > len(contents) {
+			return errFlatLogGroupTruncated
+		}
+		log.Contents = contentPtrs[:n:n]
+		for j := 0; j < n; j++ {
+			contents[j].Key = r.string()
+			contents[j].Value = r.string()
+			log.Contents[j] = &contents[j]
+		}
+		contents = contents[n:]
+		contentPtrs = contentPtrs[n:]
+		m.Logs[i] = log
+	}
+	return r.err
+}
@@ -0,0 +1,120 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package protocol
+
+import (
+	"encoding/binary"
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+	"github.com/stretchr/testify/require"
+)
+
+// encodeFlat mirrors SerializeFlatLogGroup in core/go_pipeline/FlatLogGroup.cpp
+func encodeFlat(logGroup *LogGroup) []byte {
+	var buf []byte
+	addUint32 := func(v uint32) {
+		buf = binary.LittleEndian.AppendUint32(buf, v)
+	}
+	addString := func(s string) {
+		addUint32(uint32(len(s)))
+		buf = append(buf, s...)
+	}
+	contentCnt := 0
+	for _, log := range logGroup.Logs {
+		contentCnt += len(log.Contents)
+	}
+	addUint32(FlatLogGroupMagic)
+	addUint32(uint32(len(logGroup.Logs)))
+	addUint32(uint32(contentCnt))
+	addUint32(uint32(len(logGroup.LogTags)))
+	addString(logGroup.Category)
+	addString(logGroup.Topic)
+	for _, tag := range logGroup.LogTags {
+		addString(tag.Key)
+		addString(tag.Value)
+	}
+	for _, log := range logGroup.Logs {
+		addUint32(log.Time)
+		addUint32(uint32(len(log.Contents)))
+		if log.TimeNs != nil {
+			buf = append(buf, 1)
+			addUint32(*log.TimeNs)
+		} else {
+			buf = append(buf, 0)
+		}
+		for _, content := range log.Contents {
+			addString(content.Key)
+			addString(content.Value)
+		}
+	}
+	return buf
+}
+
+func TestLogGroupUnmarshalFlat(t *testing.T) {
+	ns := uint32(123456789)
+	expected := &LogGroup{
+		Category: "logstore",
+		Topic:    "topic",
+		LogTags:  []*LogTag{{Key: "__hostname__", Value: "host"}, {Key: "__path__", Value: ""}},
+		Logs: []*Log{
+			{Time: 1700000000, TimeNs: &ns, Contents: []*Log_Content{{Key: "content", Value: "hello"}, {Key: "level", Value: "INFO"}}},
+			{Time: 1700000001},
+			{Time: 1700000002, Contents: []*Log_Content{{Key: "", Value: "world"}}},
+		},
+	}
+	data := encodeFlat(expected)
+
+	logGroup := &LogGroup{}
+	require.NoError(t, logGroup.UnmarshalFlat(data))
+	assert.Equal(t, expected.Category, logGroup.Category)
+	assert.Equal(t, expected.Topic, logGroup.Topic)
+	assert.Equal(t, expected.LogTags, logGroup.LogTags)
+	require.Len(t, logGroup.Logs, len(expected.Logs))
+	for i, log := range logGroup.Logs {
+		assert.Equal(t, expected.Logs[i].Time, log.Time)
+		assert.Equal(t, expected.Logs[i].TimeNs, log.TimeNs)
+		assert.Equal(t, len(expected.Logs[i].Contents), len(log.Contents))
+		for j, content := range log.Contents {
+			assert.Equal(t, *expected.Logs[i].Contents[j], *content)
+		}
+	}
+
+	// strings must not point into the buffer owned by the caller
+	for i := range data {
+		data[i] = 0
+	}
+	assert.Equal(t, "hello", logGroup.Logs[0].Contents[0].Value)
+	assert.Equal(t, "host", logGroup.LogTags[0].Value)
+}
+
+func TestLogGroupUnmarshalFlatInvalid(t *testing.T) {
+	data := encodeFlat(&LogGroup{
+		Category: "logstore",
+		Logs:     []*Log{{Time: 1, Contents: []*Log_Content{{Key: "key", Value: "value"}}}},
+	})
+	for i := 0; i < len(data); i++ {
+		assert.Error(t, (&LogGroup{}).UnmarshalFlat(data[:i]))
+	}
+
+	invalidMagic := append([]byte{}, data...)
+	invalidMagic[0] = 0
+	assert.Error(t, (&LogGroup{}).UnmarshalFlat(invalidMagic))
+
+	// the content count of a log exceeds the total in the header
+	invalidCount := append([]byte{}, data...)
+	binary.LittleEndian.PutUint32(invalidCount[8:], 0)
+	assert.Error(t, (&LogGroup{}).UnmarshalFlat(invalidCount))
+}
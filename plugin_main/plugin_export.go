@@ -199,6 +199,18 @@ func ProcessLogGroup(configName string, logBytes []byte, packID string) int {
 	return config.ProcessLogGroup(logBytes, util.StringDeepCopy(packID))
 }
 
+//export ProcessFlatLogGroup
+func ProcessFlatLogGroup(configName string, data []byte, packID string) int {
+	pluginmanager.LogtailConfigLock.RLock()
+	config, flag := pluginmanager.LogtailConfig[configName]
+	pluginmanager.LogtailConfigLock.RUnlock()
+	if !flag {
+		logger.Error(context.Background(), "PLUGIN_ALARM", "config not found", configName)
+		return -1
+	}
+	return config.ProcessFlatLogGroup(data, util.StringDeepCopy(packID))
+}
+
 //export StopAllPipelines
 func StopAllPipelines(withInputFlag int) {
 	logger.Info(context.Background(), "Stop all", "start", "with input", withInputFlag)
@@ -273,6 +273,21 @@ func (lc *LogstoreConfig) ProcessLogGroup(logByte []byte, packID string) int {
 	return 0
 }
 
+// ProcessFlatLogGroup is ProcessLogGroup for log groups in the flat layout, see protocol.LogGroup.UnmarshalFlat.
+func (lc *LogstoreConfig) ProcessFlatLogGroup(data []byte, packID string) int {
+	logGroup := &protocol.LogGroup{}
+	if err := logGroup.UnmarshalFlat(data); err != nil {
+		logger.Error(lc.Context.GetRuntimeContext(), "WRONG_PROTOBUF_ALARM",
+			"cannot process flat log group passed by core, err", err)
+		return -1
+	}
+	lc.PluginRunner.ReceiveLogGroup(pipeline.LogGroupWithContext{
+		LogGroup: logGroup,
+		Context:  map[string]interface{}{ctxKeySource: packID}},
+	)
+	return 0
+}
+
 func hasDockerStdoutInput(plugins map[string]interface{}) bool {
 	inputs, exists := plugins["inputs"]
 	if !exists {